@@ -0,0 +1,146 @@
+#include <stdio.h>
+
+#define HC_BVH_IMPL
+#include "../hc_bvh.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+#define TRIANGLE_COUNT 2000
+#define RAY_COUNT 2000
+
+/* Deterministic values in [-1, 1] */
+static float next_random(void)
+{
+    static uint32_t state = 12345;
+    state = state * 1664525u + 1013904223u;
+    return (float)(state >> 8) / (float)(1 << 23) - 1.0f;
+}
+
+/* Closest hit over every triangle (Moller-Trumbore in double), returns the triangle or -1 */
+static int reference_intersect(const float* vertices, const float* o, const float* d, float tmax, double* t_hit)
+{
+    int found = -1;
+    double best = tmax;
+
+    for (int i = 0; i < TRIANGLE_COUNT; i++) {
+        const float *v0 = vertices + 9 * i, *v1 = v0 + 3, *v2 = v0 + 6;
+        double e1[3], e2[3], s[3], p[3], q[3];
+        for (int a = 0; a < 3; a++) {
+            e1[a] = v1[a] - v0[a], e2[a] = v2[a] - v0[a], s[a] = o[a] - v0[a];
+        }
+        p[0] = d[1] * e2[2] - d[2] * e2[1], p[1] = d[2] * e2[0] - d[0] * e2[2], p[2] = d[0] * e2[1] - d[1] * e2[0];
+        double det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+        if (fabs(det) < 1e-12) continue;
+
+        double u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) / det;
+        q[0] = s[1] * e1[2] - s[2] * e1[1], q[1] = s[2] * e1[0] - s[0] * e1[2], q[2] = s[0] * e1[1] - s[1] * e1[0];
+        double v = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) / det;
+        double t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) / det;
+
+        if (u >= 0.0 && v >= 0.0 && u + v <= 1.0 && t > 0.0 && t < best) {
+            best = t;
+            found = i;
+        }
+    }
+
+    *t_hit = best;
+    return found;
+}
+
+/* Compares the closest hits and the occlusion tests of the tree with brute force */
+static void check_rays(const hc_bvh_t* bvh, const float* vertices)
+{
+    int hits = 0;
+    for (int r = 0; r < RAY_COUNT; r++) {
+        float o[3] = { 12.0f * next_random(), 12.0f * next_random(), 12.0f * next_random() };
+        float d[3] = { next_random(), next_random(), next_random() };
+        float tmax = (r % 4 == 0) ? 5.0f : HUGE_VALF;
+
+        double t;
+        int expected = reference_intersect(vertices, o, d, tmax, &t);
+
+        hc_bvh_hit_t hit;
+        bool found = hc_bvh_intersect(bvh, o, d, tmax, &hit);
+        CHECK(found == (expected >= 0));
+        if (found && expected >= 0) {
+            // Same distance, the triangle may differ where two of them cross
+            CHECK(fabs(hit.t - t) < 1e-4 * (1.0 + t));
+
+            // The barycentric coordinates give the hit point
+            const float *v0 = vertices + 9 * hit.triangle, *v1 = v0 + 3, *v2 = v0 + 6;
+            for (int a = 0; a < 3; a++) {
+                float point = v0[a] + hit.u * (v1[a] - v0[a]) + hit.v * (v2[a] - v0[a]);
+                CHECK(fabsf(point - (o[a] + hit.t * d[a])) < 1e-3f);
+            }
+            hits++;
+        }
+
+        CHECK(hc_bvh_occluded(bvh, o, d, tmax) == found);
+    }
+
+    // Many rays go through the soup, not all
+    CHECK(hits > RAY_COUNT / 4 && hits < RAY_COUNT);
+}
+
+int main(void)
+{
+    /* Random triangle soup, as a plain list of vertices */
+
+    static float vertices[TRIANGLE_COUNT * 9];
+    for (int i = 0; i < TRIANGLE_COUNT; i++) {
+        float c[3] = { 10.0f * next_random(), 10.0f * next_random(), 10.0f * next_random() };
+        for (int k = 0; k < 9; k++) vertices[9 * i + k] = c[k % 3] + 2.0f * next_random();
+    }
+
+    hc_bvh_t bvh;
+    CHECK(hc_bvh_build(&bvh, vertices, NULL, TRIANGLE_COUNT, 0, 0) == HC_BVH_SUCCESS);
+    CHECK(bvh.nodes != NULL && bvh.qnodes == NULL && bvh.triangle_count == TRIANGLE_COUNT);
+    CHECK(bvh.node_count <= 2 * TRIANGLE_COUNT - 1);
+    check_rays(&bvh, vertices);
+    hc_bvh_destroy(&bvh);
+
+    CHECK(hc_bvh_build(&bvh, vertices, NULL, TRIANGLE_COUNT, HC_BVH_QBVH, 2) == HC_BVH_SUCCESS);
+    CHECK(bvh.nodes == NULL && bvh.qnodes != NULL);
+    check_rays(&bvh, vertices);
+    hc_bvh_destroy(&bvh);
+
+    /* Indexed mesh: the two triangles of the unit square at z = 0 */
+
+    const float quad[] = { 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0 };
+    const uint32_t indices[] = { 0, 1, 2, 0, 2, 3 };
+
+    for (int flags = 0; flags <= HC_BVH_QBVH; flags++) {
+        CHECK(hc_bvh_build(&bvh, quad, indices, 2, flags, 0) == HC_BVH_SUCCESS);
+
+        float o[3] = { 0.25f, 0.75f, 2.0f }, d[3] = { 0.0f, 0.0f, -0.5f };
+        hc_bvh_hit_t hit;
+        CHECK(hc_bvh_intersect(&bvh, o, d, HUGE_VALF, &hit));
+        CHECK(hit.triangle == 1 && fabsf(hit.t - 4.0f) < 1e-5f);        // In units of the direction length
+        CHECK(fabsf(hit.u - 0.25f) < 1e-5f && fabsf(hit.v - 0.5f) < 1e-5f);
+
+        // Limited by tmax, missing, or pointing away
+        CHECK(!hc_bvh_intersect(&bvh, o, d, 3.9f, &hit) && !hc_bvh_occluded(&bvh, o, d, 3.9f));
+        CHECK(hc_bvh_occluded(&bvh, o, d, 4.1f));
+        o[0] = 1.5f;
+        CHECK(!hc_bvh_intersect(&bvh, o, d, HUGE_VALF, NULL));
+        o[0] = 0.5f, d[2] = 0.5f;
+        CHECK(!hc_bvh_occluded(&bvh, o, d, HUGE_VALF));
+
+        hc_bvh_destroy(&bvh);
+    }
+
+    /* Empty and invalid input */
+
+    CHECK(hc_bvh_build(&bvh, NULL, NULL, 0, 0, 0) == HC_BVH_SUCCESS);
+    float o[3] = { 0 }, d[3] = { 0, 0, 1 };
+    CHECK(!hc_bvh_intersect(&bvh, o, d, HUGE_VALF, NULL) && !hc_bvh_occluded(&bvh, o, d, HUGE_VALF));
+    hc_bvh_destroy(&bvh);
+
+    CHECK(hc_bvh_build(NULL, quad, indices, 2, 0, 0) == HC_BVH_ERROR_INVALID);
+    CHECK(hc_bvh_build(&bvh, NULL, NULL, 2, 0, 0) == HC_BVH_ERROR_INVALID);
+
+    if (failures == 0) printf("All BVH checks passed\n");
+    return failures != 0;
+}
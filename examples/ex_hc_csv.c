@@ -0,0 +1,104 @@
+#include <stdio.h>
+
+#define HC_CSV_IMPL
+#include "../hc_csv.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+/* Checks that a field, once unescaped, equals 'expected' */
+static bool field_equals(const hc_csv_t* csv, const hc_csv_field_t* field, const char* expected)
+{
+    char buffer[256];
+    if (field->length > sizeof(buffer)) return false;
+    size_t n = hc_csv_field_unescape(csv, field, buffer);
+    return n == strlen(expected) && memcmp(buffer, expected, n) == 0;
+}
+
+int main(void)
+{
+    const hc_csv_field_t *fields;
+    size_t count;
+
+    /* Quoted fields, embedded separators and line endings */
+
+    const char *text =
+        "name,comment,score\r\n"
+        "alice,\"likes \"\"quotes\"\"\",10\n"
+        "bob,\"multi\nline, with comma\",\n"
+        ",,\n"
+        "carol,plain,7";
+
+    hc_csv_t csv;
+    hc_csv_init(&csv, text, strlen(text), ',', '"');
+
+    CHECK(hc_csv_next(&csv, &fields, &count) == HC_CSV_RECORD);
+    CHECK(count == 3 && field_equals(&csv, &fields[0], "name") && field_equals(&csv, &fields[2], "score"));
+
+    CHECK(hc_csv_next(&csv, &fields, &count) == HC_CSV_RECORD);
+    CHECK(count == 3 && field_equals(&csv, &fields[0], "alice"));
+    CHECK(fields[1].escaped && field_equals(&csv, &fields[1], "likes \"quotes\""));
+    CHECK(!fields[2].escaped && fields[2].length == 2 && memcmp(fields[2].data, "10", 2) == 0);
+
+    CHECK(hc_csv_next(&csv, &fields, &count) == HC_CSV_RECORD);
+    CHECK(count == 3 && !fields[1].escaped && field_equals(&csv, &fields[1], "multi\nline, with comma"));
+    CHECK(fields[2].length == 0);
+
+    CHECK(hc_csv_next(&csv, &fields, &count) == HC_CSV_RECORD);
+    CHECK(count == 3 && fields[0].length == 0 && fields[1].length == 0 && fields[2].length == 0);
+
+    // Last record without final newline
+    CHECK(hc_csv_next(&csv, &fields, &count) == HC_CSV_RECORD);
+    CHECK(count == 3 && field_equals(&csv, &fields[2], "7"));
+
+    CHECK(hc_csv_next(&csv, &fields, &count) == HC_CSV_END);
+    hc_csv_destroy(&csv);
+
+    /* TSV with single quotes */
+
+    text = "a\t'b\tc'\t\"d\"\n";
+    hc_csv_init(&csv, text, strlen(text), '\t', '\'');
+    CHECK(hc_csv_next(&csv, &fields, &count) == HC_CSV_RECORD);
+    CHECK(count == 3 && field_equals(&csv, &fields[1], "b\tc") && field_equals(&csv, &fields[2], "\"d\""));
+    CHECK(hc_csv_next(&csv, &fields, &count) == HC_CSV_END);
+    hc_csv_destroy(&csv);
+
+    // An unterminated quote is reported instead of a truncated record
+    text = "x,\"never closed\ny,z\n";
+    hc_csv_init(&csv, text, strlen(text), ',', '"');
+    CHECK(hc_csv_next(&csv, &fields, &count) == HC_CSV_ERROR_UNTERMINATED_QUOTE);
+    hc_csv_destroy(&csv);
+
+    /* Many records, so that quoted regions straddle the 64-byte blocks */
+
+    static char big[64 * 1024];
+    size_t length = 0;
+    int records = 0;
+    while (length + 100 < sizeof(big)) {
+        length += (size_t)sprintf(big + length, "%d,\"q,%d\n\"\"x\"\"\",%*s\n", records, records, records % 50, "");
+        records++;
+    }
+
+    hc_csv_init(&csv, big, length, ',', '"');
+    int parsed = 0;
+    int ret;
+    while ((ret = hc_csv_next(&csv, &fields, &count)) == HC_CSV_RECORD) {
+        char expected[64];
+        sprintf(expected, "%d", parsed);
+        bool ok = (count == 3) && field_equals(&csv, &fields[0], expected);
+        sprintf(expected, "q,%d\n\"x\"", parsed);
+        ok = ok && fields[1].escaped && field_equals(&csv, &fields[1], expected);
+        ok = ok && fields[2].length == (size_t)(parsed % 50);
+        if (!ok) {
+            CHECK(ok);
+            break;
+        }
+        parsed++;
+    }
+    CHECK(ret == HC_CSV_END && parsed == records);
+    hc_csv_destroy(&csv);
+
+    if (failures == 0) printf("All CSV checks passed\n");
+    return failures != 0;
+}
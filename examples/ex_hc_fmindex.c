@@ -0,0 +1,123 @@
+#define HC_FMINDEX_IMPL
+#include "../hc_fmindex.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+static const char* sort_text;
+static size_t sort_length;
+
+static int compare_suffixes(const void* a, const void* b)
+{
+    uint32_t i = *(const uint32_t*)a, j = *(const uint32_t*)b;
+    size_t n = sort_length - (i > j ? i : j);
+    int cmp = memcmp(sort_text + i, sort_text + j, n);
+    if (cmp != 0) return cmp;
+    return (i > j) ? -1 : 1;    // The shorter suffix is a prefix of the other one
+}
+
+static int compare_positions(const void* a, const void* b)
+{
+    size_t i = *(const size_t*)a, j = *(const size_t*)b;
+    return (i > j) - (i < j);
+}
+
+/* All occurrences (overlapping ones included) found by brute force */
+static size_t reference_locate(const char* text, size_t n, const char* pattern, size_t m, size_t* positions)
+{
+    size_t count = 0;
+    for (size_t i = 0; i + m <= n; i++) {
+        if (memcmp(text + i, pattern, m) == 0) positions[count++] = i;
+    }
+    return count;
+}
+
+static void check_queries(const hc_fmindex_t* index, const char* text, size_t n)
+{
+    static const char* patterns[] = { "a", "an", "ana", "banana", "nab", "b", "ab", "x", "bananaban" };
+    static size_t expected[4096], positions[4096];
+
+    for (size_t k = 0; k < sizeof(patterns) / sizeof(patterns[0]); k++) {
+        size_t m = strlen(patterns[k]);
+        size_t count = reference_locate(text, n, patterns[k], m, expected);
+
+        CHECK(hc_fmindex_count(index, patterns[k], m) == count);
+        CHECK(hc_fmindex_locate(index, patterns[k], m, positions, 4096) == count);
+
+        // Positions come in suffix order
+        qsort(positions, count, sizeof(size_t), compare_positions);
+        CHECK(memcmp(positions, expected, count * sizeof(size_t)) == 0);
+
+        // Only the first positions are written, all occurrences are still counted
+        CHECK(hc_fmindex_locate(index, patterns[k], m, positions, 1) == count);
+    }
+
+    CHECK(hc_fmindex_count(index, "a", 0) == 0);
+}
+
+int main(void)
+{
+    /* Suffix array */
+
+    const char* small = "mississippi";
+    size_t n = strlen(small);
+    uint32_t sa[12], expected_sa[12];
+
+    CHECK(hc_fmindex_suffix_array(small, n, sa) == HC_FMINDEX_SUCCESS);
+
+    for (uint32_t i = 0; i <= n; i++) expected_sa[i] = i;
+    sort_text = small;
+    sort_length = n;
+    qsort(expected_sa, n + 1, sizeof(uint32_t), compare_suffixes);
+    CHECK(memcmp(sa, expected_sa, sizeof(sa)) == 0);
+    CHECK(sa[0] == n);  // The empty suffix comes first
+
+    /* Index over a repetitive text, larger than the sampling rates */
+
+    static char text[3000];
+    for (size_t i = 0; i < sizeof(text); i++) {
+        text[i] = (i % 13 < 6) ? "banana"[i % 13] : "abn"[(i * 7) % 3];
+    }
+
+    hc_fmindex_t index;
+    CHECK(hc_fmindex_build(&index, text, sizeof(text)) == HC_FMINDEX_SUCCESS);
+    CHECK(hc_fmindex_size(&index) > 0 && hc_fmindex_data(&index) != NULL);
+    check_queries(&index, text, sizeof(text));
+
+    /* Serialization, the block is used in place or read back from a file */
+
+    hc_fmindex_t loaded;
+    CHECK(hc_fmindex_load(&loaded, hc_fmindex_data(&index), hc_fmindex_size(&index)) == HC_FMINDEX_SUCCESS);
+    check_queries(&loaded, text, sizeof(text));
+    hc_fmindex_destroy(&loaded);
+
+    const char* path = "ex_hc_fmindex.bin";
+    CHECK(hc_fmindex_save(&index, path) == HC_FMINDEX_SUCCESS);
+    CHECK(hc_fmindex_load_file(&loaded, path) == HC_FMINDEX_SUCCESS);
+    check_queries(&loaded, text, sizeof(text));
+    hc_fmindex_destroy(&loaded);
+    remove(path);
+
+    // Corrupted or truncated data is rejected
+    size_t size = hc_fmindex_size(&index);
+    uint64_t *copy = malloc(size);
+    memcpy(copy, hc_fmindex_data(&index), size);
+    CHECK(hc_fmindex_load(&loaded, copy, size - 8) == HC_FMINDEX_ERROR_INVALID_DATA);
+    ((char*)copy)[0] ^= 1;
+    CHECK(hc_fmindex_load(&loaded, copy, size) == HC_FMINDEX_ERROR_INVALID_DATA);
+    free(copy);
+
+    CHECK(hc_fmindex_load_file(&loaded, "missing/ex_hc_fmindex.bin") == HC_FMINDEX_ERROR_IO);
+
+    hc_fmindex_destroy(&index);
+
+    /* Empty text */
+
+    CHECK(hc_fmindex_build(&index, "", 0) == HC_FMINDEX_SUCCESS);
+    CHECK(hc_fmindex_count(&index, "a", 1) == 0);
+    hc_fmindex_destroy(&index);
+
+    if (failures == 0) printf("All FM-index checks passed\n");
+    return failures != 0;
+}
@@ -0,0 +1,122 @@
+#include <stdio.h>
+
+#define HC_GAPBUF_IMPL
+#include "../hc_gapbuf.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+/* Compares the buffer with the expected text through each way of reading it */
+static void check_text(hc_gapbuf_t* buf, const char* expected)
+{
+    size_t n = strlen(expected);
+    CHECK(hc_gapbuf_length(buf) == n);
+
+    hc_gapbuf_span_t before, after;
+    hc_gapbuf_halves(buf, &before, &after);
+    CHECK(before.length == hc_gapbuf_cursor(buf) && before.length + after.length == n);
+    CHECK(memcmp(before.data, expected, before.length) == 0);
+    CHECK(memcmp(after.data, expected + before.length, after.length) == 0);
+
+    for (size_t i = 0; i < n; i++) {
+        if (hc_gapbuf_at(buf, i) != expected[i]) {
+            CHECK(hc_gapbuf_at(buf, i) == expected[i]);
+            break;
+        }
+    }
+
+    // A copy straddling the gap
+    char part[64];
+    size_t start = n / 3;
+    size_t copied = hc_gapbuf_copy(buf, start, sizeof(part), part);
+    CHECK(copied == ((n - start < sizeof(part)) ? n - start : sizeof(part)));
+    CHECK(memcmp(part, expected + start, copied) == 0);
+}
+
+int main(void)
+{
+    hc_gapbuf_t buf = hc_gapbuf_create_from("Hello World", 11);
+    CHECK(buf.data != NULL && hc_gapbuf_cursor(&buf) == 11);
+    check_text(&buf, "Hello World");
+
+    hc_gapbuf_move_to(&buf, 5);
+    CHECK(hc_gapbuf_insert(&buf, ",", 1) == HC_GAPBUF_SUCCESS);
+    CHECK(hc_gapbuf_cursor(&buf) == 6);
+    check_text(&buf, "Hello, World");
+
+    hc_gapbuf_move_by(&buf, 1);
+    CHECK(hc_gapbuf_delete_forward(&buf, 5) == 5);
+    CHECK(hc_gapbuf_insert(&buf, "there", 5) == HC_GAPBUF_SUCCESS);
+    CHECK(hc_gapbuf_insert_char(&buf, '!') == HC_GAPBUF_SUCCESS);
+    check_text(&buf, "Hello, there!");
+
+    // Deletions and moves are clamped to the text
+    CHECK(hc_gapbuf_delete_forward(&buf, 100) == 0);
+    hc_gapbuf_move_by(&buf, -100);
+    CHECK(hc_gapbuf_cursor(&buf) == 0);
+    CHECK(hc_gapbuf_delete_backward(&buf, 3) == 0);
+    hc_gapbuf_move_to(&buf, 1000);
+    CHECK(hc_gapbuf_cursor(&buf) == 13);
+    CHECK(hc_gapbuf_delete_backward(&buf, 8) == 8);
+    check_text(&buf, "Hello");
+
+    CHECK(strcmp(hc_gapbuf_flatten(&buf), "Hello") == 0);
+    hc_gapbuf_destroy(&buf);
+
+    /* Random edits compared with a plain array */
+
+    static char expected[20000];
+    size_t length = 0, cursor = 0;
+    unsigned seed = 12345;
+
+    buf = hc_gapbuf_create(0);
+    CHECK(hc_gapbuf_reserve(&buf, 8) == HC_GAPBUF_SUCCESS);
+
+    for (int step = 0; step < 5000; step++) {
+        seed = seed * 1103515245u + 12345u;
+        unsigned r = seed >> 16;
+
+        switch (r % 4) {
+            case 0: {
+                char text[40];
+                size_t n = r % sizeof(text);
+                for (size_t i = 0; i < n; i++) text[i] = 'a' + (char)((r + i) % 26);
+                if (length + n >= sizeof(expected)) break;
+                CHECK(hc_gapbuf_insert(&buf, text, n) == HC_GAPBUF_SUCCESS);
+                memmove(expected + cursor + n, expected + cursor, length - cursor);
+                memcpy(expected + cursor, text, n);
+                length += n, cursor += n;
+            } break;
+            case 1: {
+                size_t n = r % 16;
+                if (n > cursor) n = cursor;
+                CHECK(hc_gapbuf_delete_backward(&buf, r % 16) == n);
+                memmove(expected + cursor - n, expected + cursor, length - cursor);
+                length -= n, cursor -= n;
+            } break;
+            case 2: {
+                size_t n = r % 16;
+                if (n > length - cursor) n = length - cursor;
+                CHECK(hc_gapbuf_delete_forward(&buf, r % 16) == n);
+                memmove(expected + cursor, expected + cursor + n, length - cursor - n);
+                length -= n;
+            } break;
+            case 3: {
+                cursor = length ? (r * 31) % (length + 1) : 0;
+                hc_gapbuf_move_to(&buf, cursor);
+            } break;
+        }
+
+        CHECK(hc_gapbuf_cursor(&buf) == cursor);
+    }
+
+    expected[length] = '\0';
+    check_text(&buf, expected);
+    CHECK(strcmp(hc_gapbuf_flatten(&buf), expected) == 0);
+    CHECK(hc_gapbuf_cursor(&buf) == length);
+    hc_gapbuf_destroy(&buf);
+
+    if (failures == 0) printf("All gap buffer checks passed\n");
+    return failures != 0;
+}
@@ -0,0 +1,150 @@
+#include <stdio.h>
+
+#define HC_GRID_IMPL
+#include "../hc_grid.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+#define POINT_COUNT 3000
+
+/* Deterministic values in [-1, 1] */
+static float next_random(void)
+{
+    static uint32_t state = 12345;
+    state = state * 1664525u + 1013904223u;
+    return (float)(state >> 8) / (float)(1 << 23) - 1.0f;
+}
+
+static int compare_u32(const void* a, const void* b)
+{
+    uint32_t i = *(const uint32_t*)a, j = *(const uint32_t*)b;
+    return (i > j) - (i < j);
+}
+
+static float distance2(const float* a, const float* b)
+{
+    float dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/* Points within 'radius' of 'center' by brute force, in increasing index order */
+static size_t reference_radius(const float* points, uint32_t count, const float* center, float radius, uint32_t skip, uint32_t* indices)
+{
+    size_t found = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (i != skip && distance2(points + 3 * i, center) <= radius * radius) indices[found++] = i;
+    }
+    return found;
+}
+
+/* Compares the queries of a grid built over 'points' with brute force */
+static void check_queries(const hc_grid_t* grid, const float* points, uint32_t count)
+{
+    static uint32_t expected[POINT_COUNT], found[POINT_COUNT];
+    float distances[POINT_COUNT];
+
+    for (int q = 0; q < 200; q++) {
+        float center[3] = { 12.0f * next_random(), 12.0f * next_random(), 12.0f * next_random() };
+        float radius = (q % 10 == 0) ? 15.0f : 2.0f * (1.0f + next_random());
+
+        // Radius query, the order is unspecified
+        size_t n = reference_radius(points, count, center, radius, UINT32_MAX, expected);
+        CHECK(hc_grid_query_radius(grid, center, radius, found, POINT_COUNT) == n);
+        qsort(found, n, sizeof(uint32_t), compare_u32);
+        CHECK(memcmp(found, expected, n * sizeof(uint32_t)) == 0);
+
+        // The total is returned even when the indices don't fit
+        CHECK(hc_grid_query_radius(grid, center, radius, found, n / 2) == n);
+        CHECK(hc_grid_query_radius(grid, center, radius, NULL, 0) == n);
+
+        // k nearest, nearest first, optionally limited by a radius
+        size_t k = (size_t)(q % 70) + 1;
+        float max_radius = (q % 3 == 0) ? radius : HUGE_VALF;
+        size_t m = hc_grid_query_knn(grid, center, max_radius, found, distances, k);
+
+        size_t within = (max_radius < HUGE_VALF) ? n : count;
+        CHECK(m == ((within < k) ? within : k));
+
+        float kth = (m > 0) ? distances[m - 1] : 0.0f;
+        size_t closer = 0;
+        for (uint32_t i = 0; i < count; i++) closer += (sqrtf(distance2(points + 3 * i, center)) < kth);
+        CHECK(closer < m || m == 0);
+
+        for (size_t i = 0; i < m; i++) {
+            CHECK(fabsf(distances[i] - sqrtf(distance2(points + 3 * found[i], center))) < 1e-4f);
+            if (i > 0) CHECK(distances[i] >= distances[i - 1]);
+        }
+    }
+
+    // Every neighbor list, each point excluded from its own
+    uint32_t *offsets, *neighbors;
+    CHECK(hc_grid_neighbors(grid, 1.0f, &offsets, &neighbors, 0) == HC_GRID_SUCCESS);
+    CHECK(offsets[0] == 0);
+    for (uint32_t i = 0; i < count; i++) {
+        size_t n = reference_radius(points, count, points + 3 * i, 1.0f, i, expected);
+        uint32_t *list = neighbors + offsets[i];
+        size_t length = offsets[i + 1] - offsets[i];
+        qsort(list, length, sizeof(uint32_t), compare_u32);
+        if (length != n || memcmp(list, expected, n * sizeof(uint32_t)) != 0) {
+            CHECK(length == n && memcmp(list, expected, n * sizeof(uint32_t)) == 0);
+            break;
+        }
+    }
+    HC_FREE(offsets);
+    HC_FREE(neighbors);
+}
+
+int main(void)
+{
+    /* Random points, a few of them far away from the others */
+
+    static float points[POINT_COUNT * 3];
+    for (int i = 0; i < POINT_COUNT * 3; i++) {
+        points[i] = 10.0f * next_random();
+        if (i % 997 == 0) points[i] *= 50.0f;
+    }
+
+    hc_grid_t grid = hc_grid_create(1.0f);
+    CHECK(hc_grid_build(&grid, points, POINT_COUNT, 0) == HC_GRID_SUCCESS);
+    CHECK(grid.count == POINT_COUNT && grid.table_mask + 1 >= POINT_COUNT);
+    check_queries(&grid, points, POINT_COUNT);
+
+    // Rebuilt over fewer points without reallocating
+    uint32_t *indices = grid.indices;
+    CHECK(hc_grid_build(&grid, points, POINT_COUNT / 3, 2) == HC_GRID_SUCCESS);
+    CHECK(grid.indices == indices && grid.count == POINT_COUNT / 3);
+    check_queries(&grid, points, POINT_COUNT / 3);
+
+    // Cells much smaller than the queries
+    hc_grid_destroy(&grid);
+    grid = hc_grid_create(0.05f);
+    CHECK(hc_grid_build(&grid, points, POINT_COUNT, 0) == HC_GRID_SUCCESS);
+    check_queries(&grid, points, POINT_COUNT);
+
+    /* Empty grid and invalid input */
+
+    float center[3] = { 0.0f, 0.0f, 0.0f };
+    uint32_t found[4];
+    CHECK(hc_grid_build(&grid, NULL, 0, 0) == HC_GRID_SUCCESS);
+    CHECK(hc_grid_query_radius(&grid, center, 100.0f, found, 4) == 0);
+    CHECK(hc_grid_query_knn(&grid, center, HUGE_VALF, found, NULL, 4) == 0);
+
+    uint32_t *offsets, *neighbors;
+    CHECK(hc_grid_neighbors(&grid, 1.0f, &offsets, &neighbors, 0) == HC_GRID_SUCCESS);
+    CHECK(offsets[0] == 0);
+    HC_FREE(offsets);
+    HC_FREE(neighbors);
+    hc_grid_destroy(&grid);
+
+    grid = hc_grid_create(0.0f);
+    CHECK(hc_grid_build(&grid, points, POINT_COUNT, 0) == HC_GRID_ERROR_INVALID);
+    grid = hc_grid_create(1.0f);
+    CHECK(hc_grid_build(&grid, NULL, 3, 0) == HC_GRID_ERROR_INVALID);
+    CHECK(hc_grid_neighbors(&grid, -1.0f, &offsets, &neighbors, 0) == HC_GRID_ERROR_INVALID);
+    hc_grid_destroy(&grid);
+
+    if (failures == 0) printf("All grid checks passed\n");
+    return failures != 0;
+}
@@ -0,0 +1,89 @@
+#include <stdio.h>
+
+#define HC_MATCH_IMPL
+#include "../hc_match.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+static bool regex_matches(const char* pattern, int flags, const char* text)
+{
+    hc_match_t m;
+    if (hc_match_compile_regex(&m, pattern, flags) != HC_MATCH_SUCCESS) {
+        printf("failed to compile \"%s\"\n", pattern);
+        failures++;
+        return false;
+    }
+    bool result = hc_match_exec_cstr(&m, text);
+    hc_match_destroy(&m);
+    return result;
+}
+
+static bool glob_matches(const char* pattern, int flags, const char* text)
+{
+    hc_match_t m;
+    if (hc_match_compile_glob(&m, pattern, flags) != HC_MATCH_SUCCESS) {
+        printf("failed to compile \"%s\"\n", pattern);
+        failures++;
+        return false;
+    }
+    bool result = hc_match_exec_cstr(&m, text);
+    hc_match_destroy(&m);
+    return result;
+}
+
+static int regex_error(const char* pattern)
+{
+    hc_match_t m;
+    int ret = hc_match_compile_regex(&m, pattern, 0);
+    hc_match_destroy(&m);
+    return ret;
+}
+
+int main(void)
+{
+    /* Regular expressions */
+
+    CHECK(regex_matches("b+c", 0, "abbbcd"));
+    CHECK(!regex_matches("b+c", 0, "acd"));
+    CHECK(regex_matches("^(cat|dog)s?$", 0, "dogs"));
+    CHECK(!regex_matches("^(cat|dog)s?$", 0, "hotdogs"));
+    CHECK(regex_matches("^[a-f0-9]{2,4}$", 0, "c0de"));
+    CHECK(!regex_matches("^[a-f0-9]{2,4}$", 0, "c0ffee"));
+    CHECK(regex_matches("^\\d+\\.\\d*$", 0, "3.14"));
+    CHECK(!regex_matches("^\\d+\\.\\d*$", 0, "3x14"));
+    CHECK(regex_matches("^[^\\s]+\\s\\w+$", 0, "hello world"));
+    CHECK(regex_matches("^HELLO$", HC_MATCH_ICASE, "hello"));
+    CHECK(!regex_matches("^HELLO$", 0, "hello"));
+
+    // The lazy DFA keeps linear time on patterns that blow up a backtracker
+    char text[64];
+    memset(text, 'a', sizeof(text) - 1);
+    text[sizeof(text) - 1] = '\0';
+    CHECK(!regex_matches("^(a|aa)*b$", 0, text));
+
+    // Only escaped punctuation is taken literally
+    CHECK(regex_matches("^a\\\\b$", 0, "a\\b"));
+    CHECK(regex_matches("^[\\]x]+$", 0, "]x]"));
+    CHECK(regex_error("\\b") == HC_MATCH_ERROR_SYNTAX);
+    CHECK(regex_error("\\x41") == HC_MATCH_ERROR_SYNTAX);
+    CHECK(regex_error("(a)\\1") == HC_MATCH_ERROR_SYNTAX);
+    CHECK(regex_error("[\\u]") == HC_MATCH_ERROR_SYNTAX);
+
+    CHECK(regex_error("a|b$") == HC_MATCH_ERROR_SYNTAX);
+    CHECK(regex_error("(ab") == HC_MATCH_ERROR_SYNTAX);
+    CHECK(regex_error("[z-a]") == HC_MATCH_ERROR_SYNTAX);
+    CHECK(regex_error("(a{1000}){1000}") == HC_MATCH_ERROR_TOO_COMPLEX);
+
+    /* Globs */
+
+    CHECK(glob_matches("*.txt", 0, "notes.txt"));
+    CHECK(!glob_matches("*.txt", 0, "notes.txt.bak"));
+    CHECK(glob_matches("file?.[ch]", 0, "file1.h"));
+    CHECK(!glob_matches("file?.[!ch]", 0, "file1.h"));
+    CHECK(glob_matches("*.TXT", HC_MATCH_ICASE, "notes.txt"));
+
+    if (failures == 0) printf("All match checks passed\n");
+    return failures != 0;
+}
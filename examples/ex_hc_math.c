@@ -0,0 +1,893 @@
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "../hc_math.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+static bool near(float a, float b, float tolerance)
+{
+    return fabsf(a - b) <= tolerance * (1.0f + fabsf(b));
+}
+
+static bool near_n(const float* a, const float* b, size_t n, float tolerance)
+{
+    for (size_t i = 0; i < n; i++) {
+        if (!near(a[i], b[i], tolerance)) return false;
+    }
+    return true;
+}
+
+/* Deterministic values in [-1, 1] */
+static float next_random(void)
+{
+    static uint32_t state = 12345;
+    state = state * 1664525u + 1013904223u;
+    return (float)(state >> 8) / (float)(1 << 23) - 1.0f;
+}
+
+static void fill_random(float* values, size_t n)
+{
+    for (size_t i = 0; i < n; i++) values[i] = next_random();
+}
+
+/* Row vector times matrix, the convention of hc_vec4_transform */
+static void reference_transform(float* dst, const float* v, const float* mat)
+{
+    for (int j = 0; j < 4; j++) {
+        double sum = 0.0;
+        for (int k = 0; k < 4; k++) sum += (double)v[k] * mat[k * 4 + j];
+        dst[j] = (float)sum;
+    }
+}
+
+static void reference_mul(float* dst, const float* left, const float* right)
+{
+    for (int i = 0; i < 4; i++) {
+        reference_transform(dst + 4 * i, left + 4 * i, right);
+    }
+}
+
+/* Matrix product and vector transform */
+
+static void check_mat4_mul(void)
+{
+    for (int it = 0; it < 100; it++) {
+        hc_mat4_t a, b, expected, result;
+        fill_random(a, 16);
+        fill_random(b, 16);
+        reference_mul(expected, a, b);
+
+        hc_mat4_mul(result, a, b);
+        CHECK(near_n(result, expected, 16, 1e-5f));
+
+        hc_mat4_mul_r(result, a, b);
+        CHECK(near_n(result, expected, 16, 1e-5f));
+
+        // The destination may be one of the operands
+        hc_mat4_t left, right;
+        hc_mat4_copy(left, a);
+        hc_mat4_copy(right, b);
+        hc_mat4_mul(left, left, b);
+        hc_mat4_mul(right, a, right);
+        CHECK(near_n(left, expected, 16, 1e-5f) && near_n(right, expected, 16, 1e-5f));
+
+        hc_vec4_t v, tv;
+        fill_random(v, 4);
+        reference_transform(expected, v, a);
+        hc_vec4_transform_r(tv, v, a);
+        CHECK(near_n(tv, expected, 4, 1e-5f));
+        hc_vec4_transform(v, v, a);
+        CHECK(near_n(v, expected, 4, 1e-5f));
+    }
+
+    // A translation moves points but not directions
+    hc_mat4_t translation;
+    hc_mat4_translate(translation, 1.0f, 2.0f, 3.0f);
+    hc_vec4_t point = { 1.0f, 1.0f, 1.0f, 1.0f }, dir = { 1.0f, 1.0f, 1.0f, 0.0f };
+    hc_vec4_transform(point, point, translation);
+    hc_vec4_transform(dir, dir, translation);
+    CHECK(point[0] == 2.0f && point[1] == 3.0f && point[2] == 4.0f && point[3] == 1.0f);
+    CHECK(dir[0] == 1.0f && dir[1] == 1.0f && dir[2] == 1.0f && dir[3] == 0.0f);
+
+    hc_mat4_t identity, product;
+    hc_mat4_identity(identity);
+    hc_mat4_mul(product, translation, identity);
+    CHECK(memcmp(product, translation, sizeof(product)) == 0);
+}
+
+/* Batched transforms, compared with the single-vector functions */
+
+#define BATCH_COUNT 37      // Not a multiple of the SIMD widths, so that the tails are used
+
+static void check_transform_batch(void)
+{
+    hc_mat4_t mat;
+    fill_random(mat, 16);
+
+    static float src[BATCH_COUNT * 8], dst[BATCH_COUNT * 8], expected[BATCH_COUNT * 8];
+    fill_random(src, BATCH_COUNT * 8);
+
+    // Packed vectors, then one vector every 8 floats
+    for (size_t stride = 0; stride <= 8 * sizeof(float); stride += 8 * sizeof(float)) {
+        size_t step = stride ? 8 : 2;
+        for (size_t i = 0; i < BATCH_COUNT; i++) {
+            hc_vec2_transform(expected + i * step, src + i * step, mat);
+        }
+        hc_vec2_transform_batch(dst, src, BATCH_COUNT, stride, mat);
+        for (size_t i = 0; i < BATCH_COUNT; i++) {
+            CHECK(near_n(dst + i * step, expected + i * step, 2, 1e-5f));
+        }
+
+        step = stride ? 8 : 3;
+        for (size_t i = 0; i < BATCH_COUNT; i++) {
+            hc_vec3_transform_wt(expected + i * step, src + i * step, 0.0f, mat);
+        }
+        hc_vec3_transform_wt_batch(dst, src, BATCH_COUNT, stride, 0.0f, mat);
+        for (size_t i = 0; i < BATCH_COUNT; i++) {
+            CHECK(near_n(dst + i * step, expected + i * step, 3, 1e-5f));
+        }
+
+        step = stride ? 8 : 4;
+        for (size_t i = 0; i < BATCH_COUNT; i++) {
+            hc_vec4_transform(expected + i * step, src + i * step, mat);
+        }
+        hc_vec4_transform_batch(dst, src, BATCH_COUNT, stride, mat);
+        for (size_t i = 0; i < BATCH_COUNT; i++) {
+            CHECK(near_n(dst + i * step, expected + i * step, 4, 1e-5f));
+        }
+    }
+
+    // In place
+    float points[BATCH_COUNT * 3];
+    fill_random(points, BATCH_COUNT * 3);
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        hc_vec3_transform(expected + i * 3, points + i * 3, mat);
+    }
+    hc_vec3_transform_batch(points, points, BATCH_COUNT, 0, mat);
+    CHECK(near_n(points, expected, BATCH_COUNT * 3, 1e-5f));
+
+    // Structure of arrays
+    float x[BATCH_COUNT], y[BATCH_COUNT], z[BATCH_COUNT];
+    float rx[BATCH_COUNT], ry[BATCH_COUNT], rz[BATCH_COUNT];
+    fill_random(x, BATCH_COUNT);
+    fill_random(y, BATCH_COUNT);
+    fill_random(z, BATCH_COUNT);
+
+    for (int translate = 0; translate < 2; translate++) {
+        if (translate) hc_vec3_transform_soa(rx, ry, rz, x, y, z, BATCH_COUNT, mat);
+        else hc_vec3_transform_wt_soa(rx, ry, rz, x, y, z, BATCH_COUNT, 0.0f, mat);
+
+        for (size_t i = 0; i < BATCH_COUNT; i++) {
+            hc_vec3_t v = { x[i], y[i], z[i] }, r = { rx[i], ry[i], rz[i] };
+            hc_vec3_transform_wt(v, v, translate ? 1.0f : 0.0f, mat);
+            CHECK(near_n(r, v, 3, 1e-5f));
+        }
+    }
+}
+
+/* Quaternions */
+
+static void random_quat(hc_quat_t q)
+{
+    hc_vec3_t axis;
+    fill_random(axis, 3);
+    hc_quat_from_axis_angle(q, axis, 3.0f * next_random());
+}
+
+/* Angle between two rotations, ignoring the sign of the quaternions */
+static float quat_angle(const hc_quat_t a, const hc_quat_t b)
+{
+    float d = fminf(fabsf(hc_quat_dot(a, b)), 1.0f);
+    return 2.0f * acosf(d);
+}
+
+static void check_quat(void)
+{
+    hc_vec3_t axis = { 0.0f, 0.0f, 2.0f };      // Normalized by hc_quat_from_axis_angle
+    hc_quat_t q, r, identity;
+    hc_quat_from_axis_angle(q, axis, (float)HC_PI / 2.0f);
+    hc_quat_identity(identity);
+
+    // A quarter turn around Z, as a quaternion and as a matrix
+    hc_vec3_t v = { 1.0f, 0.0f, 0.0f }, rotated;
+    hc_vec3_rotate(rotated, v, q);
+    CHECK(near(rotated[0], 0.0f, 1e-6f) && near(rotated[1], 1.0f, 1e-6f) && near(rotated[2], 0.0f, 1e-6f));
+
+    hc_mat4_t rotation, from_quat;
+    hc_vec3_t unit_z = { 0.0f, 0.0f, 1.0f };
+    hc_mat4_rotate(rotation, unit_z, (float)HC_PI / 2.0f);
+    hc_quat_to_mat4(from_quat, q);
+    CHECK(near_n(from_quat, rotation, 16, 1e-6f));
+
+    hc_quat_from_mat4(r, rotation);
+    CHECK(quat_angle(r, q) < 1e-3f);
+
+    // Euler angles follow h_rotate_zyx_mat4()
+    hc_vec3_t angles = { 0.3f, -0.7f, 1.1f };
+    hc_mat4_t euler;
+    h_rotate_zyx_mat4(euler, angles);
+    hc_quat_from_euler(r, angles);
+    hc_quat_to_mat4(from_quat, r);
+    CHECK(near_n(from_quat, euler, 16, 1e-5f));
+
+    // The product applies the right operand first
+    hc_quat_t a, b, ab;
+    random_quat(a);
+    random_quat(b);
+    hc_quat_mul(ab, a, b);
+    hc_vec3_t va, vb, vab;
+    fill_random(v, 3);
+    hc_vec3_rotate(vb, v, b);
+    hc_vec3_rotate(va, vb, a);
+    hc_vec3_rotate(vab, v, ab);
+    CHECK(near_n(vab, va, 3, 1e-5f));
+
+    hc_quat_conjugate(r, a);
+    hc_quat_mul(r, r, a);
+    CHECK(quat_angle(r, identity) < 1e-3f);
+
+    hc_quat_t scaled;
+    hc_quat_set(scaled, 2.0f * a[0], 2.0f * a[1], 2.0f * a[2], 2.0f * a[3]);
+    hc_quat_invert(r, scaled);
+    hc_quat_mul(r, scaled, r);
+    CHECK(near_n(r, identity, 4, 1e-5f));
+    hc_quat_normalize(r, scaled);
+    CHECK(near_n(r, a, 4, 1e-6f));
+
+    // Interpolations stay on the shortest arc between the ends
+    for (int i = 0; i <= 10; i++) {
+        float t = (float)i / 10.0f;
+        hc_quat_t slerp, fast, nlerp;
+        hc_quat_slerp(slerp, a, b, t);
+        hc_quat_slerp_fast(fast, a, b, t);
+        hc_quat_nlerp(nlerp, a, b, t);
+
+        float total = quat_angle(a, b);
+        CHECK(near(quat_angle(a, slerp), t * total, 1e-3f));
+        CHECK(quat_angle(fast, slerp) < 2e-3f);
+        CHECK(near(hc_quat_dot(nlerp, nlerp), 1.0f, 1e-5f));
+        CHECK(quat_angle(a, nlerp) <= total + 1e-3f);
+    }
+
+    /* Batches, compared with the single quaternion functions */
+
+    float q1[BATCH_COUNT * 4], q2[BATCH_COUNT * 4], out[BATCH_COUNT * 16];
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        random_quat(q1 + 4 * i);
+        random_quat(q2 + 4 * i);
+    }
+
+    hc_quat_mul_batch(out, q1, q2, BATCH_COUNT);
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        hc_quat_mul(r, q1 + 4 * i, q2 + 4 * i);
+        CHECK(near_n(out + 4 * i, r, 4, 1e-6f));
+    }
+
+    hc_quat_nlerp_batch(out, q1, q2, BATCH_COUNT, 0.3f);
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        hc_quat_nlerp(r, q1 + 4 * i, q2 + 4 * i, 0.3f);
+        CHECK(near_n(out + 4 * i, r, 4, 1e-5f));
+    }
+
+    hc_quat_slerp_fast_batch(out, q1, q2, BATCH_COUNT, 0.7f);
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        hc_quat_slerp_fast(r, q1 + 4 * i, q2 + 4 * i, 0.7f);
+        CHECK(near_n(out + 4 * i, r, 4, 1e-5f));
+    }
+
+    hc_quat_to_mat4_batch(out, q1, BATCH_COUNT);
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        hc_quat_to_mat4(from_quat, q1 + 4 * i);
+        CHECK(near_n(out + 16 * i, from_quat, 16, 1e-6f));
+    }
+
+    float points[BATCH_COUNT * 3];
+    fill_random(points, BATCH_COUNT * 3);
+    hc_vec3_rotate_batch(out, points, BATCH_COUNT, 0, a);
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        hc_vec3_rotate(rotated, points + 3 * i, a);
+        CHECK(near_n(out + 3 * i, rotated, 3, 1e-5f));
+    }
+}
+
+/* Affine and rigid inverses */
+
+/* Rotation followed by a translation, with a non-uniform scaling first unless 'scale' is 0 */
+static void random_affine(hc_mat4_t dst, float scale)
+{
+    hc_quat_t q;
+    hc_mat4_t scaling, rotation, translation;
+    random_quat(q);
+    hc_quat_to_mat4(rotation, q);
+    hc_mat4_translate(translation, 10.0f * next_random(), 10.0f * next_random(), 10.0f * next_random());
+    hc_mat4_mul(dst, rotation, translation);
+    if (scale != 0.0f) {
+        hc_mat4_scale(scaling, scale, 0.5f * scale, 2.0f * scale);
+        hc_mat4_mul(dst, scaling, dst);
+    }
+}
+
+static void check_affine_invert(void)
+{
+    hc_mat4_t affine[BATCH_COUNT], rigid[BATCH_COUNT], expected, result;
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        random_affine(affine[i], 0.5f + next_random() * 0.25f);
+        random_affine(rigid[i], 0.0f);
+    }
+
+    hc_mat4_t inverses[BATCH_COUNT];
+    hc_mat4_invert_affine_batch(inverses[0], affine[0], BATCH_COUNT);
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        hc_mat4_invert(expected, affine[i]);
+        hc_mat4_invert_affine(result, affine[i]);
+        CHECK(near_n(result, expected, 16, 1e-4f));
+        CHECK(near_n(inverses[i], expected, 16, 1e-4f));
+    }
+
+    hc_mat4_invert_rigid_batch(inverses[0], rigid[0], BATCH_COUNT);
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        hc_mat4_invert(expected, rigid[i]);
+        hc_mat4_invert_rigid(result, rigid[i]);
+        CHECK(near_n(result, expected, 16, 1e-4f));
+        CHECK(near_n(inverses[i], expected, 16, 1e-4f));
+    }
+
+    // In place
+    hc_mat4_invert(expected, affine[0]);
+    hc_mat4_invert_affine(affine[0], affine[0]);
+    CHECK(near_n(affine[0], expected, 16, 1e-4f));
+
+    /* 3x4 matrices, compared with the 4x4 ones they come from */
+
+    hc_mat4_t a4, b4;
+    random_affine(a4, 0.8f);
+    random_affine(b4, 0.0f);
+
+    hc_mat3x4_t a, b, m;
+    hc_mat3x4_from_mat4(a, a4);
+    hc_mat3x4_from_mat4(b, b4);
+    hc_mat3x4_to_mat4(result, a);
+    CHECK(near_n(result, a4, 16, 0.0f));
+
+    hc_mat3x4_identity(m);
+    hc_mat3x4_mul(m, a, m);
+    CHECK(near_n(m, a, 12, 1e-6f));
+
+    hc_mat3x4_mul(m, a, b);
+    hc_mat4_mul(expected, a4, b4);
+    hc_mat3x4_to_mat4(result, m);
+    CHECK(near_n(result, expected, 16, 1e-5f));
+
+    hc_mat3x4_invert(m, a);
+    hc_mat4_invert(expected, a4);
+    hc_mat3x4_to_mat4(result, m);
+    CHECK(near_n(result, expected, 16, 1e-4f));
+
+    hc_mat3x4_invert_rigid(m, b);
+    hc_mat4_invert(expected, b4);
+    hc_mat3x4_to_mat4(result, m);
+    CHECK(near_n(result, expected, 16, 1e-4f));
+
+    hc_vec3_t v, r, e;
+    fill_random(v, 3);
+    hc_mat3x4_transform(r, v, a);
+    hc_vec3_transform(e, v, a4);
+    CHECK(near_n(r, e, 3, 1e-5f));
+    hc_mat3x4_transform_dir(r, v, a);
+    hc_vec3_transform_wt(e, v, 0.0f, a4);
+    CHECK(near_n(r, e, 3, 1e-5f));
+
+    // Batches
+    hc_mat3x4_t left[BATCH_COUNT], right[BATCH_COUNT], out[BATCH_COUNT];
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        hc_mat3x4_from_mat4(left[i], affine[i]);
+        hc_mat3x4_from_mat4(right[i], rigid[i]);
+    }
+
+    hc_mat3x4_mul_batch(out[0], left[0], right[0], BATCH_COUNT);
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        hc_mat3x4_mul(m, left[i], right[i]);
+        CHECK(near_n(out[i], m, 12, 1e-6f));
+    }
+
+    hc_mat3x4_invert_batch(out[0], left[0], BATCH_COUNT);
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        hc_mat3x4_invert(m, left[i]);
+        CHECK(near_n(out[i], m, 12, 1e-6f));
+    }
+
+    hc_mat3x4_invert_rigid_batch(out[0], right[0], BATCH_COUNT);
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        hc_mat3x4_invert_rigid(m, right[i]);
+        CHECK(near_n(out[i], m, 12, 1e-6f));
+    }
+
+    float points[BATCH_COUNT * 3], transformed[BATCH_COUNT * 3];
+    fill_random(points, BATCH_COUNT * 3);
+    hc_mat3x4_transform_batch(transformed, points, BATCH_COUNT, 0, a);
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        hc_mat3x4_transform(r, points + 3 * i, a);
+        CHECK(near_n(transformed + 3 * i, r, 3, 1e-6f));
+    }
+}
+
+/* Double precision */
+
+static void check_double(void)
+{
+    // Same functions as for floats, with a 'd' before the type
+    hc_dvec3_t a, b, sum;
+    hc_dvec3_set(a, 1e8, 2.0, 3.0);
+    hc_dvec3_set(b, 0.25, 0.5, 0.75);
+    hc_dvec3_add(sum, a, b);
+    CHECK(sum[0] == 100000000.25 && sum[1] == 2.5 && sum[2] == 3.75);
+    CHECK(hc_dvec3_distance(sum, a) == hc_dvec3_length(b));
+
+    for (int it = 0; it < 50; it++) {
+        hc_mat4_t fl, fr;
+        fill_random(fl, 16);
+        fill_random(fr, 16);
+
+        hc_dmat4_t left, right, product, product_r;
+        hc_dmat4_from_mat4(left, fl);
+        hc_dmat4_from_mat4(right, fr);
+        hc_dmat4_mul(product, left, right);
+        hc_dmat4_mul_r(product_r, left, right);
+
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                double expected = 0.0;
+                for (int k = 0; k < 4; k++) expected += left[i * 4 + k] * right[k * 4 + j];
+                CHECK(fabs(product[i * 4 + j] - expected) < 1e-12);
+                CHECK(fabs(product_r[i * 4 + j] - expected) < 1e-12);
+            }
+        }
+
+        hc_dmat4_mul(left, left, right);
+        CHECK(memcmp(left, product, sizeof(product)) == 0);
+
+        hc_dvec4_t v = { 1.5, -2.0, 0.5, 1.0 }, tv;
+        hc_dvec4_transform_r(tv, v, right);
+        for (int j = 0; j < 4; j++) {
+            double expected = v[0] * right[j] + v[1] * right[4 + j] + v[2] * right[8 + j] + v[3] * right[12 + j];
+            CHECK(fabs(tv[j] - expected) < 1e-12);
+        }
+        hc_dvec4_transform(v, v, right);
+        CHECK(memcmp(v, tv, sizeof(v)) == 0);
+
+        hc_mat4_t back;
+        hc_mat4_from_dmat4(back, right);
+        CHECK(memcmp(back, fr, sizeof(back)) == 0);
+    }
+
+    // Far from the origin, floats lose the small offsets that doubles keep
+    hc_dmat4_t model;
+    hc_dmat4_translate(model, 1e7 + 0.125, -3e6, 0.0);
+    hc_dvec3_t camera = { 1e7, -3e6 - 0.5, 0.0 };
+
+    hc_mat4_t relative;
+    hc_mat4_from_dmat4_relative(relative, model, camera);
+    CHECK(relative[12] == 0.125f && relative[13] == 0.5f && relative[14] == 0.0f && relative[15] == 1.0f);
+
+    hc_vec3_t point;
+    hc_dvec3_t dpoint = { 1e7 + 0.125, 1.0, 2.0 };
+    hc_vec3_from_dvec3(point, dpoint);
+    CHECK(point[0] == 1e7f && point[1] == 1.0f);
+    hc_dvec3_from_vec3(dpoint, point);
+    CHECK(dpoint[0] == 1e7 && dpoint[2] == 2.0);
+}
+
+/* Fast approximations */
+
+/* Error of 'value' in units in the last place of the float closest to 'exact' */
+static double ulp_error(float value, double exact)
+{
+    float f = fabsf((float)exact);
+    double ulp = (f < 1.17549435e-38f) ? 1.40129846e-45 : (double)(nextafterf(f, INFINITY) - f);
+    return fabs((double)value - exact) / ulp;
+}
+
+static void check_fast(void)
+{
+    double max_sin = 0.0, max_cos = 0.0, max_tan = 0.0, max_atan2 = 0.0;
+    double max_exp = 0.0, max_log = 0.0, max_pow = 0.0;
+
+    for (int i = 0; i <= 200000; i++) {
+        float x = -8192.0f + 16384.0f * (float)i / 200000.0f;
+        float s, c;
+        hc_fast_sincosf(x, &s, &c);
+        max_sin = fmax(max_sin, ulp_error(hc_fast_sinf(x), sin(x)));
+        max_cos = fmax(max_cos, ulp_error(hc_fast_cosf(x), cos(x)));
+        max_tan = fmax(max_tan, ulp_error(hc_fast_tanf(x), tan(x)));
+        CHECK(s == hc_fast_sinf(x) && c == hc_fast_cosf(x));
+
+        float y = next_random() * 100.0f, z = next_random() * 100.0f;
+        max_atan2 = fmax(max_atan2, ulp_error(hc_fast_atan2f(y, z), atan2(y, z)));
+
+        float e = -87.0f + 175.0f * (float)i / 200000.0f;
+        max_exp = fmax(max_exp, ulp_error(hc_fast_expf(e), exp(e)));
+
+        float l = ldexpf(1.0f + (float)i / 200000.0f, i % 200 - 100);
+        max_log = fmax(max_log, ulp_error(hc_fast_logf(l), log(l)));
+
+        float p = 0.5f + 2.0f * (float)i / 200000.0f, q = next_random() * 1.4f;
+        max_pow = fmax(max_pow, ulp_error(hc_fast_powf(p, q), pow(p, q)));
+    }
+
+    // The documented bounds
+    CHECK(max_sin <= 2.5 && max_cos <= 2.5 && max_tan <= 3.5 && max_atan2 <= 3.5);
+    CHECK(max_exp <= 1.01 && max_log <= 1.0 && max_pow <= 2.0);
+
+    // Special values
+    CHECK(hc_fast_expf(100.0f) == INFINITY && hc_fast_expf(-200.0f) == 0.0f);
+    CHECK(hc_fast_logf(0.0f) == -INFINITY && isnan(hc_fast_logf(-1.0f)));
+    CHECK(hc_fast_powf(0.0f, 0.0f) == 1.0f && hc_fast_powf(1.0f, NAN) == 1.0f && isnan(hc_fast_powf(-2.0f, 0.5f)));
+    CHECK(hc_fast_atan2f(0.0f, -1.0f) == 3.14159265f && hc_fast_atan2f(-1.0f, 0.0f) == -1.57079633f);
+    CHECK(isnan(hc_fast_atan2f(NAN, 1.0f)));
+
+#if defined(HC_MATH_SSE2)
+    // The register forms compute the same formulas, up to the last bit with FMA
+    float in[8], out[8];
+    for (int i = 0; i < 8; i++) in[i] = 0.37f + 1.9f * (float)i;
+
+    _mm_storeu_ps(out, hc_fast_sin_ps(_mm_loadu_ps(in)));
+    for (int i = 0; i < 4; i++) CHECK(ulp_error(out[i], hc_fast_sinf(in[i])) <= 1.0);
+    _mm_storeu_ps(out, hc_fast_log_ps(_mm_loadu_ps(in)));
+    for (int i = 0; i < 4; i++) CHECK(ulp_error(out[i], hc_fast_logf(in[i])) <= 1.0);
+    _mm_storeu_ps(out, hc_fast_atan2_ps(_mm_loadu_ps(in), _mm_loadu_ps(in + 4)));
+    for (int i = 0; i < 4; i++) CHECK(ulp_error(out[i], hc_fast_atan2f(in[i], in[i + 4])) <= 1.0);
+#endif
+
+#if defined(HC_MATH_AVX2)
+    _mm256_storeu_ps(out, hc_fast_exp256_ps(_mm256_loadu_ps(in)));
+    for (int i = 0; i < 8; i++) CHECK(ulp_error(out[i], hc_fast_expf(in[i])) <= 1.0);
+    _mm256_storeu_ps(out, hc_fast_tan256_ps(_mm256_loadu_ps(in)));
+    for (int i = 0; i < 8; i++) CHECK(ulp_error(out[i], hc_fast_tanf(in[i])) <= 1.0);
+#endif
+}
+
+/* Frustum culling */
+
+#define CULL_COUNT 101
+
+/* 1 if the point is inside the clip volume of 'mat', 0 if outside, -1 if too close to a plane to tell */
+static int reference_clip(const hc_vec3_t point, const hc_mat4_t mat)
+{
+    float v[4] = { point[0], point[1], point[2], 1.0f }, clip[4];
+    reference_transform(clip, v, mat);
+    int inside = 1;
+    for (int j = 0; j < 3; j++) {
+        float margin = 1e-3f * (fabsf(clip[3]) + fabsf(clip[j]));
+        float distance = clip[3] - fabsf(clip[j]);
+        if (fabsf(distance) < margin) return -1;
+        if (distance < 0.0f) inside = 0;
+    }
+    return inside;
+}
+
+static void check_frustum(void)
+{
+    hc_mat4_t projection, view, mat;
+    hc_frustum_t frustum;
+
+    // Looking down -z, near plane at 1, far plane at 30
+    hc_mat4_perspective(projection, 1.0f, 1.5f, 1.0f, 30.0f);
+    hc_frustum_from_mat4(frustum, projection);
+
+    for (int i = 0; i < 6; i++) {
+        const float* p = frustum + 4 * i;
+        CHECK(near(p[0] * p[0] + p[1] * p[1] + p[2] * p[2], 1.0f, 1e-5f));
+    }
+    CHECK(near(frustum[16] * 0.0f + frustum[17] * 0.0f + frustum[18] * -3.0f + frustum[19], 2.0f, 1e-4f));
+    CHECK(near(frustum[20] * 0.0f + frustum[21] * 0.0f + frustum[22] * -3.0f + frustum[23], 27.0f, 1e-3f));
+
+    hc_vec3_t center = { 0.0f, 0.0f, -10.0f }, extents = { 0.5f, 0.5f, 0.5f };
+    CHECK(hc_frustum_test_sphere(frustum, center, 0.0f) == 1);
+    CHECK(hc_frustum_test_aabb(frustum, center, extents) == 1);
+
+    // Behind the camera, beyond the far plane, or crossing the near plane
+    center[2] = 10.0f;
+    CHECK(hc_frustum_test_sphere(frustum, center, 5.0f) == 0 && hc_frustum_test_aabb(frustum, center, extents) == 0);
+    center[2] = -40.0f;
+    CHECK(hc_frustum_test_sphere(frustum, center, 5.0f) == 0 && hc_frustum_test_aabb(frustum, center, extents) == 0);
+    center[2] = -0.5f;
+    CHECK(hc_frustum_test_sphere(frustum, center, 0.6f) == 1 && hc_frustum_test_aabb(frustum, center, extents) == 1);
+    CHECK(hc_frustum_test_sphere(frustum, center, 0.4f) == 0);
+
+    // A moved camera, the planes are in world space
+    random_affine(view, 0.0f);
+    hc_mat4_mul(mat, view, projection);
+    hc_frustum_from_mat4(frustum, mat);
+
+    float x[CULL_COUNT], y[CULL_COUNT], z[CULL_COUNT], radius[CULL_COUNT], zeros[CULL_COUNT];
+    float ex[CULL_COUNT], ey[CULL_COUNT], ez[CULL_COUNT];
+    for (int i = 0; i < CULL_COUNT; i++) {
+        x[i] = 20.0f * next_random(), y[i] = 20.0f * next_random(), z[i] = 20.0f * next_random();
+        radius[i] = 2.0f + 2.0f * next_random();
+        ex[i] = 1.0f + next_random(), ey[i] = 1.0f + next_random(), ez[i] = 1.0f + next_random();
+        zeros[i] = 0.0f;
+    }
+
+    int sphere_visible = 0, aabb_visible = 0;
+    for (int i = 0; i < CULL_COUNT; i++) {
+        hc_vec3_t c = { x[i], y[i], z[i] }, e = { ex[i], ey[i], ez[i] };
+        int inside = reference_clip(c, mat);
+        if (inside >= 0) CHECK(hc_frustum_test_sphere(frustum, c, 0.0f) == inside);
+        if (inside == 1) CHECK(hc_frustum_test_sphere(frustum, c, radius[i]) && hc_frustum_test_aabb(frustum, c, e));
+        sphere_visible += hc_frustum_test_sphere(frustum, c, radius[i]);
+        aabb_visible += hc_frustum_test_aabb(frustum, c, e);
+    }
+    CHECK(sphere_visible > 0 && sphere_visible < CULL_COUNT);
+    CHECK(aabb_visible > 0 && aabb_visible < CULL_COUNT);
+
+    // The batch forms agree with the single tests, with indices and/or mask
+    uint32_t indices[CULL_COUNT], mask[(CULL_COUNT + 31) / 32];
+    memset(mask, 0xff, sizeof(mask));
+    CHECK(hc_frustum_cull_spheres(frustum, x, y, z, radius, CULL_COUNT, indices, mask) == (size_t)sphere_visible);
+    size_t k = 0;
+    for (int i = 0; i < CULL_COUNT; i++) {
+        hc_vec3_t c = { x[i], y[i], z[i] };
+        int visible = hc_frustum_test_sphere(frustum, c, radius[i]);
+        CHECK((int)((mask[i / 32] >> (i % 32)) & 1) == visible);
+        if (visible) CHECK(indices[k++] == (uint32_t)i);
+    }
+    CHECK(hc_frustum_cull_spheres(frustum, x, y, z, radius, CULL_COUNT, NULL, NULL) == (size_t)sphere_visible);
+
+    size_t points = 0;
+    for (int i = 0; i < CULL_COUNT; i++) {
+        hc_vec3_t c = { x[i], y[i], z[i] };
+        points += (size_t)hc_frustum_test_sphere(frustum, c, 0.0f);
+    }
+    CHECK(hc_frustum_cull_spheres(frustum, x, y, z, zeros, CULL_COUNT, NULL, mask) == points);
+
+    memset(mask, 0xff, sizeof(mask));
+    CHECK(hc_frustum_cull_aabbs(frustum, x, y, z, ex, ey, ez, CULL_COUNT, indices, mask) == (size_t)aabb_visible);
+    k = 0;
+    for (int i = 0; i < CULL_COUNT; i++) {
+        hc_vec3_t c = { x[i], y[i], z[i] }, e = { ex[i], ey[i], ez[i] };
+        int visible = hc_frustum_test_aabb(frustum, c, e);
+        CHECK((int)((mask[i / 32] >> (i % 32)) & 1) == visible);
+        if (visible) CHECK(indices[k++] == (uint32_t)i);
+    }
+    CHECK(hc_frustum_cull_aabbs(frustum, x, y, z, ex, ey, ez, CULL_COUNT, indices, NULL) == (size_t)aabb_visible);
+}
+
+/* Vector streams, over each layout */
+
+enum { SOA, PACKED, STRIDED, LAYOUT_COUNT };
+
+/* Stream over 'buffer' (room for BATCH_COUNT * 5 floats) with the given layout */
+static hc_vec3_stream_t make_stream(float* buffer, int layout)
+{
+    switch (layout) {
+        case SOA: return hc_vec3_stream_soa(buffer, buffer + BATCH_COUNT, buffer + 2 * BATCH_COUNT);
+        case PACKED: return hc_vec3_stream_aos(buffer, 0);
+        default: return hc_vec3_stream_aos(buffer, 5 * sizeof(float));
+    }
+}
+
+static void stream_get(const hc_vec3_stream_t* s, size_t i, float* v)
+{
+    hc_vec3_stream_t r = hc_vec3_stream_advance(s, i);
+    v[0] = *r.x, v[1] = *r.y, v[2] = *r.z;
+}
+
+static void check_streams(void)
+{
+    static float buffers[3][BATCH_COUNT * 5];
+    float values[2][BATCH_COUNT][3], scalars[BATCH_COUNT];
+    for (size_t i = 0; i < BATCH_COUNT; i++) {
+        fill_random(values[0][i], 3);
+        fill_random(values[1][i], 3);
+    }
+    values[0][5][0] = values[0][5][1] = values[0][5][2] = 0.0f;     // Zero vectors are normalized as they are
+
+    // The square roots follow HC_RSQRT_PRECISION
+    float sqrt_tolerance = (HC_RSQRT_PRECISION == HC_RSQRT_EXACT) ? 1e-5f : 1e-3f;
+
+    for (int la = 0; la < LAYOUT_COUNT; la++) {
+        for (int lb = 0; lb < LAYOUT_COUNT; lb++) {
+            for (int ld = 0; ld < LAYOUT_COUNT; ld++) {
+                hc_vec3_stream_t sa = make_stream(buffers[0], la), sb = make_stream(buffers[1], lb);
+                hc_vec3_stream_t dst = make_stream(buffers[2], ld);
+                hc_vec3_cstream_t a = hc_vec3_stream_const(sa), b = hc_vec3_stream_const(sb);
+
+                for (size_t i = 0; i < BATCH_COUNT; i++) {
+                    hc_vec3_stream_t ra = hc_vec3_stream_advance(&sa, i), rb = hc_vec3_stream_advance(&sb, i);
+                    *ra.x = values[0][i][0], *ra.y = values[0][i][1], *ra.z = values[0][i][2];
+                    *rb.x = values[1][i][0], *rb.y = values[1][i][1], *rb.z = values[1][i][2];
+                }
+
+                for (int op = HC_VEC3_STREAM_ADD; op <= HC_VEC3_STREAM_DISTANCE; op++) {
+                    switch (op) {
+                        case HC_VEC3_STREAM_ADD: hc_vec3_stream_add(dst, a, b, BATCH_COUNT); break;
+                        case HC_VEC3_STREAM_SUB: hc_vec3_stream_sub(dst, a, b, BATCH_COUNT); break;
+                        case HC_VEC3_STREAM_SCALE: hc_vec3_stream_scale(dst, a, 1.5f, BATCH_COUNT); break;
+                        case HC_VEC3_STREAM_MADD: hc_vec3_stream_madd(dst, a, b, -0.25f, BATCH_COUNT); break;
+                        case HC_VEC3_STREAM_DOT: hc_vec3_stream_dot(scalars, a, b, BATCH_COUNT); break;
+                        case HC_VEC3_STREAM_CROSS: hc_vec3_stream_cross(dst, a, b, BATCH_COUNT); break;
+                        case HC_VEC3_STREAM_LENGTH: hc_vec3_stream_length(scalars, a, BATCH_COUNT); break;
+                        case HC_VEC3_STREAM_NORMALIZE: hc_vec3_stream_normalize(dst, a, BATCH_COUNT); break;
+                        case HC_VEC3_STREAM_LERP: hc_vec3_stream_lerp(dst, a, b, 0.3f, BATCH_COUNT); break;
+                        case HC_VEC3_STREAM_DISTANCE: hc_vec3_stream_distance(scalars, a, b, BATCH_COUNT); break;
+                    }
+
+                    bool ok = true;
+                    for (size_t i = 0; i < BATCH_COUNT; i++) {
+                        const float *va = values[0][i], *vb = values[1][i];
+                        hc_vec3_t expected, got;
+                        float tolerance = 1e-5f;
+                        switch (op) {
+                            case HC_VEC3_STREAM_ADD: hc_vec3_add(expected, va, vb); break;
+                            case HC_VEC3_STREAM_SUB: hc_vec3_sub(expected, va, vb); break;
+                            case HC_VEC3_STREAM_SCALE: hc_vec3_scale(expected, va, 1.5f); break;
+                            case HC_VEC3_STREAM_MADD: for (int k = 0; k < 3; k++) expected[k] = va[k] - 0.25f * vb[k]; break;
+                            case HC_VEC3_STREAM_CROSS: hc_vec3_cross(expected, va, vb); break;
+                            case HC_VEC3_STREAM_LERP: for (int k = 0; k < 3; k++) expected[k] = va[k] + (vb[k] - va[k]) * 0.3f; break;
+                            case HC_VEC3_STREAM_NORMALIZE:
+                                memcpy(expected, va, sizeof(expected));
+                                if (hc_vec3_length(va) > 0.0f) hc_vec3_scale(expected, va, 1.0f / hc_vec3_length(va));
+                                tolerance = sqrt_tolerance;
+                                break;
+                            case HC_VEC3_STREAM_DOT: ok = ok && near(scalars[i], hc_vec3_dot(va, vb), 1e-5f); continue;
+                            case HC_VEC3_STREAM_LENGTH: ok = ok && near(scalars[i], hc_vec3_length(va), sqrt_tolerance); continue;
+                            case HC_VEC3_STREAM_DISTANCE: ok = ok && near(scalars[i], hc_vec3_distance(va, vb), sqrt_tolerance); continue;
+                        }
+                        stream_get(&dst, i, got);
+                        ok = ok && near_n(got, expected, 3, tolerance);
+                    }
+                    if (!ok) {
+                        printf("stream operation %d differs (layouts %d, %d -> %d)\n", op, la, lb, ld);
+                        failures++;
+                    }
+                }
+            }
+        }
+    }
+
+    // In place, as in 'position += velocity * dt', starting past the first vectors
+    float x[BATCH_COUNT], y[BATCH_COUNT], z[BATCH_COUNT], velocities[BATCH_COUNT * 3];
+    fill_random(x, BATCH_COUNT);
+    fill_random(y, BATCH_COUNT);
+    fill_random(z, BATCH_COUNT);
+    fill_random(velocities, BATCH_COUNT * 3);
+
+    hc_vec3_stream_t positions = hc_vec3_stream_soa(x, y, z);
+    hc_vec3_cstream_t v = hc_vec3_cstream_aos(velocities, 0);
+    hc_vec3_stream_t rest = hc_vec3_stream_advance(&positions, 3);
+    hc_vec3_cstream_t rest_v = hc_vec3_cstream_advance(&v, 3);
+
+    float expected_x[BATCH_COUNT];
+    for (size_t i = 0; i < BATCH_COUNT; i++) expected_x[i] = (i < 3) ? x[i] : x[i] + velocities[3 * i] * 0.5f;
+    hc_vec3_stream_madd(rest, hc_vec3_stream_const(rest), rest_v, 0.5f, BATCH_COUNT - 3);
+    CHECK(near_n(x, expected_x, BATCH_COUNT, 1e-5f));
+
+    const float packed[6] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+    hc_vec3_cstream_t c = hc_vec3_cstream_soa(packed, packed + 2, packed + 4);
+    hc_vec3_cstream_t c1 = hc_vec3_cstream_advance(&c, 1);
+    CHECK(*c1.x == 2.0f && *c1.y == 4.0f && *c1.z == 6.0f);
+    CHECK(hc_vec3_stream_advance(NULL, 1).x == NULL);
+}
+
+/* Reciprocal square roots and the batches using them */
+
+#if HC_RSQRT_PRECISION == HC_RSQRT_EXACT
+#   define RSQRT_TOLERANCE 1e-6f
+#elif HC_RSQRT_PRECISION == HC_RSQRT_NEWTON
+#   define RSQRT_TOLERANCE 5e-6f
+#else
+#   define RSQRT_TOLERANCE 2e-3f    // 12 bits estimate, 9 bits without SIMD
+#endif
+
+static bool near_relative(float value, double exact)
+{
+    return fabs(value - exact) <= RSQRT_TOLERANCE * fabs(exact);
+}
+
+static void check_rsqrt(void)
+{
+    // Positive normal numbers over the whole range
+    for (int i = 0; i < 1000; i++) {
+        float v = ldexpf(1.0f + 0.5f * (next_random() + 1.0f), i % 250 - 125);
+        if (!near_relative(hc_rsqrtf(v), 1.0 / sqrt(v))) {
+            CHECK(near_relative(hc_rsqrtf(v), 1.0 / sqrt(v)));
+            break;
+        }
+    }
+
+#if defined(HC_MATH_SSE2)
+    float x[16], r[16];
+    for (int i = 0; i < 16; i++) x[i] = ldexpf(1.0f + 0.5f * (next_random() + 1.0f), 8 * i - 60);
+
+    _mm_storeu_ps(r, hc_rsqrt_ps(_mm_loadu_ps(x)));
+    for (int i = 0; i < 4; i++) CHECK(near_relative(r[i], 1.0 / sqrt(x[i])));
+    _mm_storeu_ps(r, hc_sqrt_ps(_mm_setr_ps(x[0], 0.0f, x[2], 4.0f)));
+    CHECK(near_relative(r[0], sqrt(x[0])) && r[1] == 0.0f && near_relative(r[2], sqrt(x[2])) && near_relative(r[3], 2.0));
+
+#   if defined(HC_MATH_AVX)
+    _mm256_storeu_ps(r, hc_rsqrt256_ps(_mm256_loadu_ps(x)));
+    for (int i = 0; i < 8; i++) CHECK(near_relative(r[i], 1.0 / sqrt(x[i])));
+    _mm256_storeu_ps(r, hc_sqrt256_ps(_mm256_loadu_ps(x)));
+    for (int i = 0; i < 8; i++) CHECK(near_relative(r[i], sqrt(x[i])));
+#   endif
+
+#   if defined(HC_MATH_AVX512)
+    _mm512_storeu_ps(r, hc_rsqrt512_ps(_mm512_loadu_ps(x)));
+    for (int i = 0; i < 16; i++) CHECK(near_relative(r[i], 1.0 / sqrt(x[i])));
+    x[3] = 0.0f;
+    _mm512_storeu_ps(r, hc_sqrt512_ps(_mm512_loadu_ps(x)));
+    for (int i = 0; i < 16; i++) CHECK(near_relative(r[i], sqrt(x[i])));
+#   endif
+#endif
+
+    // Batch normalization and distances, packed then one vector every 8 floats, zero vectors unchanged
+    static float src[BATCH_COUNT * 8], other[BATCH_COUNT * 8], dst[BATCH_COUNT * 8], distances[BATCH_COUNT];
+    fill_random(src, BATCH_COUNT * 8);
+    fill_random(other, BATCH_COUNT * 8);
+    memset(src + 8, 0, 4 * sizeof(float));
+
+    for (size_t stride = 0; stride <= 8 * sizeof(float); stride += 8 * sizeof(float)) {
+        for (size_t n = 2; n <= 4; n++) {
+            size_t step = stride ? 8 : n;
+            if (n == 2) hc_vec2_normalize_batch(dst, src, BATCH_COUNT, stride);
+            else if (n == 3) hc_vec3_normalize_batch(dst, src, BATCH_COUNT, stride);
+            else hc_vec4_normalize_batch(dst, src, BATCH_COUNT, stride);
+
+            bool ok = true;
+            for (size_t i = 0; i < BATCH_COUNT; i++) {
+                const float *v = src + i * step, *d = dst + i * step;
+                double length = 0.0;
+                for (size_t k = 0; k < n; k++) length += (double)v[k] * v[k];
+                length = sqrt(length);
+                for (size_t k = 0; k < n; k++) {
+                    ok = ok && ((length == 0.0) ? d[k] == v[k] : fabs(d[k] - v[k] / length) <= 2.0 * RSQRT_TOLERANCE);
+                }
+            }
+            if (!ok) {
+                printf("hc_vec%zu_normalize_batch differs (stride %zu)\n", n, stride);
+                failures++;
+            }
+
+            if (n == 4) continue;
+            if (n == 2) hc_vec2_distance_batch(distances, src, other, BATCH_COUNT, stride);
+            else hc_vec3_distance_batch(distances, src, other, BATCH_COUNT, stride);
+
+            for (size_t i = 0; i < BATCH_COUNT; i++) {
+                const float *a = src + i * step, *b = other + i * step;
+                double sq = 0.0;
+                for (size_t k = 0; k < n; k++) sq += ((double)a[k] - b[k]) * ((double)a[k] - b[k]);
+                ok = ok && fabs(distances[i] - sqrt(sq)) <= 2.0 * RSQRT_TOLERANCE * (sqrt(sq) + 1e-6);
+            }
+            if (!ok) {
+                printf("hc_vec%zu_distance_batch differs (stride %zu)\n", n, stride);
+                failures++;
+            }
+        }
+    }
+
+    // In place
+    float points[BATCH_COUNT * 3];
+    fill_random(points, BATCH_COUNT * 3);
+    hc_vec3_normalize_batch(points, points, BATCH_COUNT, 0);
+    for (size_t i = 0; i < BATCH_COUNT; i++) CHECK(fabsf(hc_vec3_length(points + 3 * i) - 1.0f) <= 2.0f * RSQRT_TOLERANCE);
+}
+
+int main(void)
+{
+    check_mat4_mul();
+    check_transform_batch();
+    check_quat();
+    check_affine_invert();
+    check_double();
+    check_fast();
+    check_frustum();
+    check_streams();
+    check_rsqrt();
+
+    if (failures == 0) printf("All math checks passed (HC_SIMD level %d)\n", HC_SIMD);
+    return failures != 0;
+}
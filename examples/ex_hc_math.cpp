@@ -0,0 +1,153 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "../hc_math.hpp"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+/* Component-wise comparison of any two vectors of the same size */
+template <class A, class B, std::size_t N>
+static bool near(const hc::VecExpr<A, N>& a, const hc::VecExpr<B, N>& b, float tolerance = 1e-5f)
+{
+    for (std::size_t i = 0; i < N; i++) {
+        float x = a.self()[i], y = b.self()[i];
+        if (std::fabs(x - y) > tolerance * (1.0f + std::fabs(y))) return false;
+    }
+    return true;
+}
+
+static bool near(float a, float b, float tolerance = 1e-5f)
+{
+    return std::fabs(a - b) <= tolerance * (1.0f + std::fabs(b));
+}
+
+/* Deterministic values in [-1, 1] */
+static float next_random()
+{
+    static uint32_t state = 12345;
+    state = state * 1664525u + 1013904223u;
+    return (float)(state >> 8) / (float)(1 << 23) - 1.0f;
+}
+
+static hc::Vec3 random_vec3()
+{
+    float x = next_random(), y = next_random(), z = next_random();
+    return hc::Vec3(x, y, z);
+}
+
+// The expressions and constructors are usable in constant expressions
+static_assert(hc::Vec3(1, 2, 3) * 2.0f - hc::Vec3(1, 1, 1) == hc::Vec3(1, 3, 5), "constexpr expression");
+static_assert(hc::dot(hc::Vec2(1, 2), hc::Vec2(3, 4)) == 11.0f, "constexpr dot");
+static_assert(hc::Mat4::translate(1, 2, 3)(0, 3) == 1.0f && hc::Mat4::translate(1, 2, 3)[14] == 3.0f, "constexpr matrix");
+static_assert(hc::Vec4(hc::Vec3(1, 2, 3), 1.0f).w() == 1.0f, "constexpr extension");
+
+int main()
+{
+    /* Vector expressions */
+
+    hc::Vec3 a = random_vec3(), b = random_vec3(), c = random_vec3();
+    float s = 0.75f;
+
+    hc::Vec3 r = a * s + b - c / 2.0f;
+    for (int i = 0; i < 3; i++) CHECK(near(r[i], a[i] * s + b[i] - c[i] / 2.0f));
+    CHECK(near(-a + a, hc::Vec3()));
+
+    // The destination may be an operand
+    hc::Vec3 d = a;
+    d = d * 2.0f + d;
+    CHECK(near(d, a * 3.0f));
+    d += b, d -= b, d *= hc::Vec3(2, 2, 2), d /= 2.0f;
+    CHECK(near(d, a * 3.0f));
+
+    CHECK(near(hc::dot(a, b), a.x() * b.x() + a.y() * b.y() + a.z() * b.z()));
+    hc::Vec3 n = hc::cross(a, b);
+    CHECK(near(hc::dot(n, a), 0.0f) && near(hc::dot(n, b), 0.0f));
+    CHECK(near(hc::length(a), std::sqrt(hc::length_sq(a))));
+    CHECK(near(hc::distance(a, b), hc::length(b - a)));
+    CHECK(near(hc::length(hc::normalize(a * 10.0f)), 1.0f, 1e-3f) && hc::normalize(hc::Vec3()) == hc::Vec3());
+    CHECK(near(hc::lerp(a, b, 0.25f), a * 0.75f + b * 0.25f));
+
+    // Same layout as the C types
+    hc_vec3_t cv = { 1.0f, 2.0f, 3.0f };
+    hc::Vec3 from_c(cv);
+    CHECK(from_c == hc::Vec3(1, 2, 3));
+    hc_vec3_add(cv, cv, r.v);
+    CHECK(near(hc::Vec3(cv), from_c + r));
+
+    /* Matrices and quaternions */
+
+    hc::Mat4 m1 = hc::Mat4::rotate(hc::Vec3(0, 0, 1), 0.5f) * hc::Mat4::scale(2, 1, 1);
+    hc::Mat4 m2 = hc::Mat4::translate(1, -2, 3);
+    hc::Vec4 p(a, 1.0f);
+
+    // 'a * b' applies 'b' then 'a'
+    CHECK(near((m2 * m1) * p, m2 * (m1 * p)));
+    CHECK(near(hc::transform_point(m2, a), a + hc::Vec3(1, -2, 3)));
+    CHECK(near(hc::transform_direction(m2, a), a));
+    CHECK(near(m1.inverted() * (m1 * p), p, 1e-4f));
+    CHECK(m1.transposed().transposed() == m1 && hc::Mat4::identity() * m1 == m1);
+    CHECK(m2(1, 3) == -2.0f);
+
+    hc::Quat q1 = hc::Quat::from_axis_angle(hc::Vec3(1, 2, 3), 0.7f), q2 = hc::Quat::from_euler(hc::Vec3(0.3f, -0.2f, 1.0f));
+    CHECK(near((q1 * q2) * a, q1 * (q2 * a)));
+    CHECK(near(q1.conjugate() * (q1 * a), a));
+    CHECK(near(hc::Vec4(hc::transform_direction(q1.to_mat4(), a), 0.0f), hc::Vec4(q1 * a, 0.0f)));
+    CHECK(std::fabs(std::fabs(hc::dot(hc::Quat::from_mat4(q1.to_mat4()), q1)) - 1.0f) < 1e-4f);
+    CHECK(std::fabs(hc::dot(hc::slerp(q1, q2, 1.0f), q2)) > 0.9999f);
+    CHECK(near(hc::dot(hc::nlerp(q1, q2, 0.5f), hc::nlerp(q1, q2, 0.5f)), 1.0f));
+    CHECK(near(hc::dot(hc::normalize(hc::Quat(1, 2, 3, 4)), hc::normalize(hc::Quat(1, 2, 3, 4))), 1.0f));
+
+    /* Spans */
+
+    const std::size_t count = 37;
+    std::vector<hc::Vec3> positions(count), velocities(count + 5), expected(count);
+    for (std::size_t i = 0; i < velocities.size(); i++) velocities[i] = random_vec3();
+    for (std::size_t i = 0; i < count; i++) positions[i] = random_vec3();
+
+    // One loop over the arrays, stopping at the shortest span
+    hc::Span<hc::Vec3> pos(positions);
+    for (std::size_t i = 0; i < count; i++) expected[i] = positions[i] + velocities[i] * 0.5f;
+    pos += hc::Span<const hc::Vec3>(velocities) * 0.5f;
+    bool ok = true;
+    for (std::size_t i = 0; i < count; i++) ok = ok && near(positions[i], expected[i]);
+    CHECK(ok);
+
+    // A vector repeated over the span, and assignments to a part of it
+    pos.subspan(10, 5) = hc::Vec3(1, 2, 3);
+    CHECK(positions[9] == expected[9] && positions[10] == hc::Vec3(1, 2, 3) && positions[14] == hc::Vec3(1, 2, 3));
+    CHECK(positions[15] == expected[15]);
+    pos = pos * 2.0f - pos;
+    CHECK(positions[10] == hc::Vec3(1, 2, 3));
+
+    // Arrays of the C type
+    hc_vec3_t raw[4] = { { 1, 0, 0 }, { 0, 2, 0 }, { 0, 0, 3 }, { 0, 0, 0 } };
+    hc::Span<hc::Vec3> raw_span(raw, 4);
+    raw_span *= 2.0f;
+    CHECK(raw[2][2] == 6.0f && raw_span[1] == hc::Vec3(0, 4, 0));
+
+    // Batch functions through the C kernels
+    std::vector<hc::Vec3> normals(count);
+    std::vector<float> distances(count);
+    hc::normalize(hc::Span<hc::Vec3>(normals), hc::Span<const hc::Vec3>(positions));
+    hc::distance(distances.data(), hc::Span<const hc::Vec3>(positions), hc::Span<const hc::Vec3>(velocities));
+    for (std::size_t i = 0; i < count; i++) {
+        CHECK(near(normals[i], hc::normalize(positions[i]), 1e-3f));
+        CHECK(near(distances[i], hc::distance(positions[i], velocities[i]), 1e-3f));
+    }
+
+    std::vector<hc::Vec2> flat(count);
+    for (std::size_t i = 0; i < count; i++) flat[i] = hc::Vec2(positions[i].x(), positions[i].y());
+    hc::transform(hc::Span<hc::Vec3>(expected), hc::Span<const hc::Vec3>(positions), m1);
+    hc::transform(hc::Span<hc::Vec2>(flat), hc::Span<const hc::Vec2>(flat), m2);
+    for (std::size_t i = 0; i < count; i++) {
+        CHECK(near(expected[i], hc::transform_point(m1, positions[i])));
+        CHECK(near(flat[i], hc::Vec2(positions[i].x() + 1.0f, positions[i].y() - 2.0f)));
+    }
+
+    if (failures == 0) std::printf("All C++ math checks passed\n");
+    return failures != 0;
+}
@@ -0,0 +1,73 @@
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+// Kernels selected at runtime, a baseline build still uses AVX2/AVX-512 when the CPU has them
+#define HC_MATH_DISPATCH_IMPL
+#include "../hc_math.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+#define COUNT 53
+#define RESULT_SIZE (COUNT * 15)
+
+static float src[COUNT * 4], x[COUNT], y[COUNT], z[COUNT];
+
+/* Runs every dispatched kernel, the results being written in 'out' */
+static void run_kernels(float* out)
+{
+    hc_mat4_t mat = {
+        0.8f, 0.1f, -0.3f, 0.0f,
+        -0.2f, 0.9f, 0.4f, 0.0f,
+        0.5f, -0.6f, 0.7f, 0.0f,
+        1.5f, -2.0f, 3.0f, 1.0f
+    };
+
+    hc_vec2_transform_batch(out, src, COUNT, 0, mat);
+    hc_vec3_transform_batch(out + COUNT * 2, src, COUNT, 0, mat);
+    hc_vec4_transform_batch(out + COUNT * 5, src, COUNT, 0, mat);
+    hc_vec3_transform_soa(out + COUNT * 9, out + COUNT * 10, out + COUNT * 11, x, y, z, COUNT, mat);
+    hc_vec3_stream_madd(hc_vec3_stream_aos(out + COUNT * 12, 0), hc_vec3_cstream_soa(x, y, z), hc_vec3_cstream_aos(src, 0), 0.5f, COUNT);
+}
+
+int main(void)
+{
+    for (int i = 0; i < COUNT * 4; i++) src[i] = (float)((i * 37) % 101) / 50.0f - 1.0f;
+    for (int i = 0; i < COUNT; i++) {
+        x[i] = src[i], y[i] = src[COUNT + i], z[i] = src[2 * COUNT + i];
+    }
+
+    // The kernels are selected on first use
+    CHECK(hc_math_kernels.level == -1);
+    static float first[RESULT_SIZE];
+    run_kernels(first);
+    CHECK(hc_math_kernels.level >= HC_SIMD);
+
+    // Every level gives the same results as the kernels selected on first use
+    int previous = -1;
+    for (int max_level = HC_SIMD_NONE; max_level <= HC_SIMD_AVX512; max_level++) {
+        int level = hc_math_dispatch_init(max_level);
+        CHECK(level == hc_math_kernels.level);
+        CHECK(level >= HC_SIMD && (level <= max_level || level == HC_SIMD));
+        CHECK(level >= previous);
+        previous = level;
+
+        static float results[RESULT_SIZE];
+        run_kernels(results);
+
+        for (int i = 0; i < RESULT_SIZE; i++) {
+            if (fabsf(results[i] - first[i]) > 1e-5f * (1.0f + fabsf(first[i]))) {
+                printf("level %d differs at %d: %g instead of %g\n", level, i, results[i], first[i]);
+                failures++;
+                break;
+            }
+        }
+    }
+
+    printf("Best kernels on this CPU: HC_SIMD level %d\n", previous);
+
+    if (failures == 0) printf("All dispatch checks passed\n");
+    return failures != 0;
+}
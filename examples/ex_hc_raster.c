@@ -0,0 +1,211 @@
+#include <stdio.h>
+#include <string.h>
+
+#define HC_RASTER_IMPL
+#include "../hc_raster.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+#define WIDTH 100
+#define HEIGHT 75
+
+/* What the spans wrote, one entry per pixel */
+typedef struct {
+    int min_x, min_y, max_x, max_y;     // Scissor the spans must stay within
+    int coverage[HEIGHT][WIDTH];
+    float depth[HEIGHT][WIDTH];
+    float attribs[HEIGHT][WIDTH][2];
+    int span_count;
+} target_t;
+
+static void write_span(const hc_raster_span_t* span, void* user)
+{
+    target_t *t = user;
+    t->span_count++;
+
+    CHECK(span->x % 8 == 0 && span->mask != 0 && span->mask <= 0xFF);
+    for (int i = 0; i < 8; i++) {
+        if (!(span->mask & (1u << i))) continue;
+        int x = span->x + i, y = span->y;
+        if (x < t->min_x || x >= t->max_x || y < t->min_y || y >= t->max_y) {
+            printf("pixel (%d, %d) outside the scissor\n", x, y);
+            failures++;
+            continue;
+        }
+        t->coverage[y][x]++;
+        t->depth[y][x] = span->depth[i];
+        t->attribs[y][x][0] = span->attribs[0][i];
+        t->attribs[y][x][1] = span->attribs[1][i];
+    }
+}
+
+static hc_raster_state_t make_state(target_t* t, int attrib_count, hc_raster_interp_t interp)
+{
+    memset(t, 0, sizeof(*t));
+    t->max_x = WIDTH, t->max_y = HEIGHT;
+    hc_raster_state_t state = { 0, 0, WIDTH, HEIGHT, attrib_count, interp, write_span, t };
+    return state;
+}
+
+/* Deterministic values in [0, 1) */
+static float next_random(void)
+{
+    static uint32_t state = 12345;
+    state = state * 1664525u + 1013904223u;
+    return (float)(state >> 8) / (float)(1 << 24);
+}
+
+/* Snaps a coordinate like the rasterizer does, so that the reference sees the same triangle */
+static float snap(float x)
+{
+    return floorf(x * HC_RASTER_SUBPIXEL + 0.5f) / HC_RASTER_SUBPIXEL;
+}
+
+/* Screen space weights of the vertices at (px, py), in double */
+static void reference_weights(const hc_raster_vertex_t* v[3], double px, double py, double* l)
+{
+    double area = ((double)v[1]->x - v[0]->x) * ((double)v[2]->y - v[0]->y) - ((double)v[1]->y - v[0]->y) * ((double)v[2]->x - v[0]->x);
+    for (int k = 0; k < 3; k++) {
+        const hc_raster_vertex_t *a = v[(k + 1) % 3], *b = v[(k + 2) % 3];
+        l[k] = (((double)b->x - a->x) * (py - a->y) - ((double)b->y - a->y) * (px - a->x)) / area;
+    }
+}
+
+/* Checks the coverage, depth and perspective corrected attributes of one triangle */
+static void check_triangle(const hc_raster_vertex_t* v1, const hc_raster_vertex_t* v2, const hc_raster_vertex_t* v3, hc_raster_interp_t interp)
+{
+    static target_t t;
+    hc_raster_state_t state = make_state(&t, 2, interp);
+    CHECK(hc_raster_triangle(&state, v1, v2, v3) == HC_RASTER_SUCCESS);
+
+    const hc_raster_vertex_t *v[3] = { v1, v2, v3 };
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            double l[3];
+            reference_weights(v, x + 0.5, y + 0.5, l);
+
+            // Pixels on an edge belong to one of the triangles sharing it
+            double lowest = fmin(l[0], fmin(l[1], l[2]));
+            if (fabs(lowest) < 1e-9) continue;
+            int inside = lowest > 0.0;
+            if (t.coverage[y][x] != inside) {
+                printf("pixel (%d, %d) covered %d times instead of %d\n", x, y, t.coverage[y][x], inside);
+                failures++;
+                return;
+            }
+            if (!inside) continue;
+
+            double z = l[0] * v1->z + l[1] * v2->z + l[2] * v3->z;
+            CHECK(fabs(t.depth[y][x] - z) < 1e-4);
+
+            for (int a = 0; a < 2; a++) {
+                double expected;
+                if (interp == HC_RASTER_SMOOTH) {
+                    double num = 0.0, den = 0.0;
+                    for (int k = 0; k < 3; k++) {
+                        num += l[k] * v[k]->attribs[a] / v[k]->w;
+                        den += l[k] / v[k]->w;
+                    }
+                    expected = num / den;
+                } else {
+                    // Weights are compared after perspective correction, skip near ties
+                    double q[3], sorted_max = -1.0, second = -1.0;
+                    int best = 0;
+                    for (int k = 0; k < 3; k++) {
+                        q[k] = l[k] / v[k]->w;
+                        if (q[k] > sorted_max) second = sorted_max, sorted_max = q[k], best = k;
+                        else if (q[k] > second) second = q[k];
+                    }
+                    if (sorted_max - second < 1e-3 * sorted_max) continue;
+                    expected = v[best]->attribs[a];
+                }
+                CHECK(fabs(t.attribs[y][x][a] - expected) < 1e-3 * (1.0 + fabs(expected)));
+            }
+        }
+    }
+}
+
+int main(void)
+{
+    static target_t t;
+
+    /* Random triangles, smooth and flat, with perspective */
+
+    for (int it = 0; it < 50; it++) {
+        float attribs[3][2];
+        hc_raster_vertex_t v[3];
+        for (int k = 0; k < 3; k++) {
+            attribs[k][0] = 10.0f * next_random();
+            attribs[k][1] = -5.0f * next_random();
+            v[k].x = snap(-10.0f + (WIDTH + 20) * next_random());
+            v[k].y = snap(-10.0f + (HEIGHT + 20) * next_random());
+            v[k].z = next_random();
+            v[k].w = (it % 2) ? 0.5f + 4.0f * next_random() : 1.0f;
+            v[k].attribs = attribs[k];
+        }
+        check_triangle(&v[0], &v[1], &v[2], (it % 3 == 2) ? HC_RASTER_FLAT : HC_RASTER_SMOOTH);
+
+        // Both windings are drawn
+        check_triangle(&v[0], &v[2], &v[1], HC_RASTER_SMOOTH);
+    }
+
+    /* A fan covering a polygon, every pixel inside exactly once */
+
+    hc_raster_state_t state = make_state(&t, 0, HC_RASTER_SMOOTH);
+    hc_raster_vertex_t center = { 50.0f, 37.5f, 0.0f, 1.0f, NULL }, ring[12];
+    for (int k = 0; k < 12; k++) {
+        float angle = (float)k * 6.2831853f / 12.0f;
+        ring[k] = (hc_raster_vertex_t) { 50.0f + 30.0f * cosf(angle), 37.5f + 30.0f * sinf(angle), 0.0f, 1.0f, NULL };
+    }
+    for (int k = 0; k < 12; k++) {
+        CHECK(hc_raster_triangle(&state, &center, &ring[k], &ring[(k + 1) % 12]) == HC_RASTER_SUCCESS);
+    }
+
+    int covered = 0;
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            CHECK(t.coverage[y][x] <= 1);
+            covered += t.coverage[y][x];
+            float dx = x + 0.5f - 50.0f, dy = y + 0.5f - 37.5f;
+            if (dx * dx + dy * dy < 28.0f * 28.0f) CHECK(t.coverage[y][x] == 1);
+        }
+    }
+    CHECK(covered > 2500 && covered < 2830);    // Between the areas of the dodecagon and of its circle
+
+    /* Scissor rectangle */
+
+    state = make_state(&t, 0, HC_RASTER_SMOOTH);
+    state.min_x = t.min_x = 13, state.min_y = t.min_y = 20;
+    state.max_x = t.max_x = 41, state.max_y = t.max_y = 33;
+    hc_raster_vertex_t a = { 0.0f, 0.0f, 0.0f, 1.0f, NULL }, b = { 200.0f, 0.0f, 0.0f, 1.0f, NULL }, c = { 0.0f, 200.0f, 0.0f, 1.0f, NULL };
+    CHECK(hc_raster_triangle(&state, &a, &b, &c) == HC_RASTER_SUCCESS);
+    covered = 0;
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) covered += t.coverage[y][x];
+    }
+    CHECK(covered == (41 - 13) * (33 - 20));
+
+    // Degenerate triangles draw nothing
+    state = make_state(&t, 0, HC_RASTER_SMOOTH);
+    CHECK(hc_raster_triangle(&state, &a, &b, &b) == HC_RASTER_SUCCESS && t.span_count == 0);
+
+    /* Invalid input */
+
+    hc_raster_vertex_t behind = { 10.0f, 10.0f, 0.0f, 0.0f, NULL }, far = { 1e6f, 10.0f, 0.0f, 1.0f, NULL };
+    CHECK(hc_raster_triangle(&state, &a, &b, &behind) == HC_RASTER_ERROR_INVALID);
+    CHECK(hc_raster_triangle(&state, &a, &b, &far) == HC_RASTER_ERROR_INVALID);
+
+    state.attrib_count = 1;     // Vertices without attributes
+    CHECK(hc_raster_triangle(&state, &a, &b, &c) == HC_RASTER_ERROR_INVALID);
+    state.attrib_count = HC_RASTER_MAX_ATTRIBS + 1;
+    CHECK(hc_raster_triangle(&state, &a, &b, &c) == HC_RASTER_ERROR_INVALID);
+    state.attrib_count = 0;
+    state.span = NULL;
+    CHECK(hc_raster_triangle(&state, &a, &b, &c) == HC_RASTER_ERROR_INVALID);
+    CHECK(t.span_count == 0);
+
+    if (failures == 0) printf("All raster checks passed\n");
+    return failures != 0;
+}
@@ -0,0 +1,222 @@
+#include <stdio.h>
+#include <math.h>
+
+// Small levels are split among threads too, when compiled with OpenMP
+#define HC_SCENE_PARALLEL_LEVEL 16
+#define HC_SCENE_IMPL
+#include "../hc_scene.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+#define NODE_COUNT 500
+
+/* Model of the scene: parent, local transform and state of each id */
+static uint32_t parents[NODE_COUNT];
+static float translations[NODE_COUNT][3], rotations[NODE_COUNT][4], scales[NODE_COUNT][3];
+static bool alive[NODE_COUNT];
+
+/* Deterministic values in [-1, 1] */
+static float next_random(void)
+{
+    static uint32_t state = 12345;
+    state = state * 1664525u + 1013904223u;
+    return (float)(state >> 8) / (float)(1 << 23) - 1.0f;
+}
+
+/* Gives a node a random local transform, in the scene and in the model */
+static void randomize_local(hc_scene_t* scene, uint32_t id)
+{
+    float length = 0.0f;
+    for (int a = 0; a < 4; a++) {
+        rotations[id][a] = next_random();
+        length += rotations[id][a] * rotations[id][a];
+    }
+    for (int a = 0; a < 4; a++) rotations[id][a] /= sqrtf(length);
+    for (int a = 0; a < 3; a++) {
+        translations[id][a] = 2.0f * next_random();
+        scales[id][a] = 1.0f + 0.2f * next_random();
+    }
+    CHECK(hc_scene_set_local(scene, id, translations[id], rotations[id], scales[id]) == HC_SCENE_SUCCESS);
+}
+
+/* World matrix of a node from the model, column-major, in double */
+static void reference_world(uint32_t id, double* m)
+{
+    const float *q = rotations[id], *s = scales[id], *t = translations[id];
+    double x = q[0], y = q[1], z = q[2], w = q[3];
+    double local[16] = {
+        (1 - 2 * (y * y + z * z)) * s[0], 2 * (x * y + w * z) * s[0], 2 * (x * z - w * y) * s[0], 0,
+        2 * (x * y - w * z) * s[1], (1 - 2 * (x * x + z * z)) * s[1], 2 * (y * z + w * x) * s[1], 0,
+        2 * (x * z + w * y) * s[2], 2 * (y * z - w * x) * s[2], (1 - 2 * (x * x + y * y)) * s[2], 0,
+        t[0], t[1], t[2], 1
+    };
+
+    if (parents[id] == HC_SCENE_NONE) {
+        memcpy(m, local, sizeof(local));
+        return;
+    }
+
+    double parent[16];
+    reference_world(parents[id], parent);
+    for (int j = 0; j < 4; j++) {
+        for (int r = 0; r < 4; r++) {
+            double v = 0.0;
+            for (int k = 0; k < 4; k++) v += parent[k * 4 + r] * local[j * 4 + k];
+            m[j * 4 + r] = v;
+        }
+    }
+}
+
+static bool is_descendant(uint32_t id, uint32_t ancestor)
+{
+    for (uint32_t p = id; p != HC_SCENE_NONE; p = parents[p]) {
+        if (p == ancestor) return true;
+    }
+    return false;
+}
+
+/* Compares every world matrix with the model, and returns how many nodes changed */
+static uint32_t check_worlds(const hc_scene_t* scene)
+{
+    uint32_t changed = 0;
+    for (uint32_t id = 0; id < NODE_COUNT; id++) {
+        const float *world = hc_scene_world(scene, id);
+        if (!alive[id]) {
+            CHECK(world == NULL && !hc_scene_changed(scene, id));
+            continue;
+        }
+
+        double expected[16];
+        reference_world(id, expected);
+        bool ok = world != NULL;
+        for (int i = 0; ok && i < 16; i++) ok = fabs(world[i] - expected[i]) < 1e-3 * (1.0 + fabs(expected[i]));
+        if (!ok) {
+            printf("node %u: wrong world matrix\n", id);
+            failures++;
+        }
+        changed += hc_scene_changed(scene, id);
+    }
+
+    // The changed runs cover exactly the changed nodes
+    uint32_t covered = 0;
+    for (uint32_t r = 0; r < scene->changed_count; r++) {
+        uint32_t begin = scene->changed[2 * r], end = scene->changed[2 * r + 1];
+        CHECK(begin < end && (r == 0 || scene->changed[2 * r - 1] <= begin || end <= scene->changed[2 * r - 2]));
+        for (uint32_t i = begin; i < end; i++) CHECK(hc_scene_changed(scene, scene->id[i]));
+        covered += end - begin;
+    }
+    CHECK(covered == changed);
+    return changed;
+}
+
+/* Sets the local transform of some nodes, checks that exactly them and their descendants are recomputed */
+static void check_partial_update(hc_scene_t* scene, const uint32_t* moved, int count)
+{
+    for (int i = 0; i < count; i++) randomize_local(scene, moved[i]);
+    CHECK(hc_scene_update(scene, 0) == HC_SCENE_SUCCESS);
+
+    uint32_t expected = 0;
+    for (uint32_t id = 0; id < NODE_COUNT; id++) {
+        if (!alive[id]) continue;
+        bool below = false;
+        for (int i = 0; i < count; i++) below = below || is_descendant(id, moved[i]);
+        CHECK(hc_scene_changed(scene, id) == below);
+        expected += below;
+    }
+    CHECK(check_worlds(scene) == expected);
+}
+
+int main(void)
+{
+    hc_scene_t scene = hc_scene_create(8);
+
+    /* Random hierarchy, parents added before their children */
+
+    for (uint32_t i = 0; i < NODE_COUNT; i++) {
+        uint32_t parent = (i < 5 || i % 17 == 0) ? HC_SCENE_NONE : (uint32_t)((next_random() + 1.0f) * 0.5f * (float)(i - 1));
+        uint32_t id = hc_scene_add(&scene, parent);
+        CHECK(id == i);
+        parents[i] = parent;
+        alive[i] = true;
+        randomize_local(&scene, id);
+    }
+
+    CHECK(hc_scene_update(&scene, 0) == HC_SCENE_SUCCESS);
+    CHECK(check_worlds(&scene) == NODE_COUNT);
+
+    // Nothing to recompute
+    CHECK(hc_scene_update(&scene, 0) == HC_SCENE_SUCCESS);
+    CHECK(scene.changed_count == 0 && check_worlds(&scene) == 0);
+
+    /* Dirty tracking: changed nodes and their descendants only */
+
+    uint32_t moved[] = { 0, 42, 43, 310, 499 };
+    check_partial_update(&scene, moved, 1);
+    check_partial_update(&scene, moved + 1, 4);
+
+    // NULL components are left unchanged
+    float translation[3] = { 5.0f, 6.0f, 7.0f };
+    CHECK(hc_scene_set_local(&scene, 7, translation, NULL, NULL) == HC_SCENE_SUCCESS);
+    memcpy(translations[7], translation, sizeof(translation));
+    CHECK(hc_scene_update(&scene, 0) == HC_SCENE_SUCCESS);
+    check_worlds(&scene);
+    CHECK(hc_scene_changed(&scene, 7));
+
+    /* Reparenting, never under a descendant */
+
+    uint32_t node = 0;
+    while (node < NODE_COUNT && (parents[node] == HC_SCENE_NONE || !is_descendant(NODE_COUNT - 1, node))) node++;
+    if (node < NODE_COUNT) CHECK(hc_scene_set_parent(&scene, node, NODE_COUNT - 1) == HC_SCENE_ERROR_INVALID);
+    CHECK(hc_scene_set_parent(&scene, 3, 3) == HC_SCENE_ERROR_INVALID);
+
+    CHECK(hc_scene_set_parent(&scene, 100, 4) == HC_SCENE_SUCCESS);
+    parents[100] = 4;
+    CHECK(hc_scene_set_parent(&scene, 200, HC_SCENE_NONE) == HC_SCENE_SUCCESS);
+    parents[200] = HC_SCENE_NONE;
+    CHECK(hc_scene_update(&scene, 0) == HC_SCENE_SUCCESS);
+    check_worlds(&scene);
+    CHECK(hc_scene_changed(&scene, 100) && hc_scene_changed(&scene, 200));
+
+    /* Removal of subtrees, the ids being reused */
+
+    uint32_t removed = 0;
+    CHECK(hc_scene_remove(&scene, 4) == HC_SCENE_SUCCESS);
+    CHECK(hc_scene_remove(&scene, 250) == HC_SCENE_SUCCESS);
+    for (uint32_t id = 0; id < NODE_COUNT; id++) {
+        if (is_descendant(id, 4) || is_descendant(id, 250)) {
+            alive[id] = false;
+            removed++;
+        }
+    }
+    CHECK(hc_scene_update(&scene, 0) == HC_SCENE_SUCCESS);
+    check_worlds(&scene);
+    CHECK(hc_scene_remove(&scene, 4) == HC_SCENE_ERROR_INVALID);
+
+    for (uint32_t i = 0; i < removed; i++) {
+        uint32_t id = hc_scene_add(&scene, 0);
+        CHECK(id < NODE_COUNT && !alive[id]);
+        if (id >= NODE_COUNT) break;
+        parents[id] = 0;
+        alive[id] = true;
+        randomize_local(&scene, id);
+    }
+    CHECK(hc_scene_update(&scene, 0) == HC_SCENE_SUCCESS);
+    check_worlds(&scene);
+
+    check_partial_update(&scene, moved, 5);
+
+    /* Invalid nodes */
+
+    CHECK(hc_scene_add(&scene, NODE_COUNT + 10) == HC_SCENE_NONE);
+    CHECK(hc_scene_world(&scene, NODE_COUNT + 10) == NULL);
+    CHECK(hc_scene_set_local(&scene, HC_SCENE_NONE, translation, NULL, NULL) == HC_SCENE_ERROR_INVALID);
+    CHECK(hc_scene_set_parent(&scene, 1, NODE_COUNT + 10) == HC_SCENE_ERROR_INVALID);
+    CHECK(hc_scene_update(NULL, 0) == HC_SCENE_ERROR_INVALID);
+
+    hc_scene_destroy(&scene);
+
+    if (failures == 0) printf("All scene checks passed\n");
+    return failures != 0;
+}
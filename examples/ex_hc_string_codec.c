@@ -0,0 +1,142 @@
+#define HC_STRING_IMPL
+#include "../hc_string.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+int main(void)
+{
+    /* One-shot conversions, appended to the destination */
+
+    hc_string_t str = hc_string_create_from_cstr("b64:");
+    CHECK(hc_string_append_base64(&str, "Hello, World!", 13) == HC_STRING_SUCCESS);
+    CHECK(strcmp(str.data, "b64:SGVsbG8sIFdvcmxkIQ==") == 0);
+    hc_string_destroy(&str);
+
+    str = hc_string_create_from_cstr("hex:");
+    CHECK(hc_string_append_hex(&str, "\x00\x7f\xff", 3) == HC_STRING_SUCCESS);
+    CHECK(strcmp(str.data, "hex:007fff") == 0);
+    hc_string_destroy(&str);
+
+    str = (hc_string_t) { 0 };
+    CHECK(hc_string_decode_base64(&str, "SGVsbG8sIFdvcmxkIQ==", 20) == HC_STRING_SUCCESS);
+    CHECK(str.length == 13 && strcmp(str.data, "Hello, World!") == 0);
+    CHECK(hc_string_decode_hex(&str, "2A2b", 4) == HC_STRING_SUCCESS);
+    CHECK(strcmp(str.data, "Hello, World!*+") == 0);
+
+    // Nothing is appended if the input is invalid
+    CHECK(hc_string_decode_base64(&str, "QR==", 4) == HC_STRING_ERROR_INVALID_SRC);
+    CHECK(hc_string_decode_base64(&str, "QQ=", 3) == HC_STRING_ERROR_INVALID_SRC);
+    CHECK(hc_string_decode_base64(&str, "QQ==QQ==", 8) == HC_STRING_ERROR_INVALID_SRC);
+    CHECK(hc_string_decode_hex(&str, "abc", 3) == HC_STRING_ERROR_INVALID_SRC);
+    CHECK(hc_string_decode_hex(&str, "4g", 2) == HC_STRING_ERROR_INVALID_SRC);
+    CHECK(str.length == 15 && strcmp(str.data, "Hello, World!*+") == 0);
+    hc_string_destroy(&str);
+
+    /* Round trips of every byte value, long enough for the SIMD paths */
+
+    unsigned char bytes[1000];
+    for (size_t i = 0; i < sizeof(bytes); i++) {
+        bytes[i] = (unsigned char)(i * 7 + (i >> 8));
+    }
+
+    for (size_t size = 1; size <= sizeof(bytes); size += 111) {
+        hc_string_t encoded = { 0 }, decoded = { 0 };
+        CHECK(hc_string_append_base64(&encoded, bytes, size) == HC_STRING_SUCCESS);
+        CHECK(encoded.length == (size + 2) / 3 * 4);
+        CHECK(hc_string_decode_base64(&decoded, encoded.data, encoded.length) == HC_STRING_SUCCESS);
+        CHECK(decoded.length == size && memcmp(decoded.data, bytes, size) == 0);
+        hc_string_destroy(&encoded);
+        hc_string_destroy(&decoded);
+
+        CHECK(hc_string_append_hex(&encoded, bytes, size) == HC_STRING_SUCCESS);
+        CHECK(encoded.length == size * 2);
+        CHECK(hc_string_decode_hex(&decoded, encoded.data, encoded.length) == HC_STRING_SUCCESS);
+        CHECK(decoded.length == size && memcmp(decoded.data, bytes, size) == 0);
+        hc_string_destroy(&encoded);
+        hc_string_destroy(&decoded);
+    }
+
+    /* Chunked conversions, split at every possible place */
+
+    hc_string_t reference = { 0 };
+    hc_string_append_base64(&reference, bytes, 100);
+
+    for (size_t split = 0; split <= 100; split++) {
+        hc_string_codec_t codec = { 0 };
+        hc_string_t encoded = { 0 };
+        CHECK(hc_string_base64_encode_update(&codec, &encoded, bytes, split) == HC_STRING_SUCCESS);
+        CHECK(hc_string_base64_encode_update(&codec, &encoded, bytes + split, 100 - split) == HC_STRING_SUCCESS);
+        CHECK(hc_string_base64_encode_final(&codec, &encoded) == HC_STRING_SUCCESS);
+        CHECK(hc_string_compare(&encoded, &reference));
+        hc_string_destroy(&encoded);
+    }
+
+    for (size_t split = 0; split <= reference.length; split++) {
+        hc_string_codec_t codec = { 0 };
+        hc_string_t decoded = { 0 };
+        CHECK(hc_string_base64_decode_update(&codec, &decoded, reference.data, split) == HC_STRING_SUCCESS);
+        CHECK(hc_string_base64_decode_update(&codec, &decoded, reference.data + split, reference.length - split) == HC_STRING_SUCCESS);
+        CHECK(hc_string_base64_decode_final(&codec, &decoded) == HC_STRING_SUCCESS);
+        CHECK(decoded.length == 100 && memcmp(decoded.data, bytes, 100) == 0);
+        hc_string_destroy(&decoded);
+    }
+
+    hc_string_t hex = { 0 };
+    hc_string_append_hex(&hex, bytes, 50);
+    for (size_t split = 0; split <= hex.length; split++) {
+        hc_string_codec_t codec = { 0 };
+        hc_string_t decoded = { 0 };
+        CHECK(hc_string_hex_decode_update(&codec, &decoded, hex.data, split) == HC_STRING_SUCCESS);
+        CHECK(hc_string_hex_decode_update(&codec, &decoded, hex.data + split, hex.length - split) == HC_STRING_SUCCESS);
+        CHECK(hc_string_hex_decode_final(&codec, &decoded) == HC_STRING_SUCCESS);
+        CHECK(decoded.length == 50 && memcmp(decoded.data, bytes, 50) == 0);
+        hc_string_destroy(&decoded);
+    }
+
+    // An odd number of digits or a truncated base64 group is only an error at the end
+    hc_string_codec_t codec = { 0 };
+    str = (hc_string_t) { 0 };
+    CHECK(hc_string_hex_decode_update(&codec, &str, "414", 3) == HC_STRING_SUCCESS);
+    CHECK(hc_string_hex_decode_final(&codec, &str) == HC_STRING_ERROR_INVALID_SRC);
+    hc_string_destroy(&str);
+
+    codec = (hc_string_codec_t) { 0 };
+    CHECK(hc_string_base64_decode_update(&codec, &str, "QUJ", 3) == HC_STRING_SUCCESS);
+    CHECK(hc_string_base64_decode_final(&codec, &str) == HC_STRING_ERROR_INVALID_SRC);
+    hc_string_destroy(&str);
+
+    // An invalid chunk leaves the destination and the codec as they were
+    const char* bad_base64[] = { "QUJD!!!!", "QUJDRA==QUJD", "QU=D", "QUJDREVGR0hJSktMTU5PUFFSU1RVVldYWVphYmNkZWZnaGlqa2xtbm9wcXJzdHV2d3h5ejAxMjM0NTY3ODk*" };
+    for (size_t i = 0; i < sizeof(bad_base64) / sizeof(bad_base64[0]); i++) {
+        codec = (hc_string_codec_t) { 0 };
+        str = hc_string_create_from_cstr("prefix");
+        CHECK(hc_string_base64_decode_update(&codec, &str, "QUJD", 4) == HC_STRING_SUCCESS);
+        hc_string_codec_t before = codec;
+        CHECK(hc_string_base64_decode_update(&codec, &str, bad_base64[i], strlen(bad_base64[i])) == HC_STRING_ERROR_INVALID_SRC);
+        CHECK(str.length == 9 && strlen(str.data) == 9 && strcmp(str.data, "prefixABC") == 0);
+        CHECK(memcmp(&codec, &before, sizeof(codec)) == 0);
+        CHECK(hc_string_base64_decode_update(&codec, &str, "RA==", 4) == HC_STRING_SUCCESS);
+        CHECK(strcmp(str.data, "prefixABCD") == 0);
+        hc_string_destroy(&str);
+    }
+
+    const char* bad_hex[] = { "1g0", "14142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f60ZZ", "1 0" };
+    for (size_t i = 0; i < sizeof(bad_hex) / sizeof(bad_hex[0]); i++) {
+        codec = (hc_string_codec_t) { 0 };
+        str = hc_string_create_from_cstr("p");
+        CHECK(hc_string_hex_decode_update(&codec, &str, "414", 3) == HC_STRING_SUCCESS);
+        CHECK(hc_string_hex_decode_update(&codec, &str, bad_hex[i], strlen(bad_hex[i])) == HC_STRING_ERROR_INVALID_SRC);
+        CHECK(str.length == 2 && strlen(str.data) == 2 && strcmp(str.data, "pA") == 0);
+        CHECK(hc_string_hex_decode_update(&codec, &str, "2", 1) == HC_STRING_SUCCESS);
+        CHECK(strcmp(str.data, "pAB") == 0);
+        hc_string_destroy(&str);
+    }
+
+    hc_string_destroy(&reference);
+    hc_string_destroy(&hex);
+
+    if (failures == 0) printf("All base64 and hex checks passed\n");
+    return failures != 0;
+}
@@ -0,0 +1,74 @@
+#define HC_STRING_IMPL
+#include "../hc_string.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+int main(void)
+{
+    /* JSON escaping, appended to the destination */
+
+    hc_string_t json = hc_string_create_from_cstr("\"text\": \"");
+    const char raw[] = "say \"hi\"\\\n\ttab\x01 caf\xc3\xa9";
+    CHECK(hc_string_append_escaped(&json, raw, sizeof(raw) - 1) == HC_STRING_SUCCESS);
+    CHECK(hc_string_append_char(&json, '"') == HC_STRING_SUCCESS);
+    CHECK(strcmp(json.data, "\"text\": \"say \\\"hi\\\"\\\\\\n\\ttab\\u0001 caf\xc3\xa9\"") == 0);
+    hc_string_destroy(&json);
+
+    // Long inputs go through the bulk scan, escapes at both ends of a block
+    char long_raw[300];
+    for (int i = 0; i < 300; i++) long_raw[i] = (i % 37 == 0) ? '"' : 'a' + i % 26;
+
+    hc_string_t escaped = { 0 };
+    CHECK(hc_string_append_escaped(&escaped, long_raw, sizeof(long_raw)) == HC_STRING_SUCCESS);
+    CHECK(escaped.length == sizeof(long_raw) + 9);
+
+    hc_string_t unescaped = { 0 };
+    CHECK(hc_string_append_unescaped(&unescaped, escaped.data, escaped.length) == HC_STRING_SUCCESS);
+    CHECK(unescaped.length == sizeof(long_raw) && memcmp(unescaped.data, long_raw, sizeof(long_raw)) == 0);
+    hc_string_destroy(&escaped);
+    hc_string_destroy(&unescaped);
+
+    /* Unescaping, with \u escapes decoded to UTF-8 */
+
+    const char src[] = "a\\/b\\u00e9\\u20AC\\ud83d\\ude00\\b\\f\\r";
+    hc_string_t str = hc_string_create_from_cstr(">");
+    CHECK(hc_string_append_unescaped(&str, src, sizeof(src) - 1) == HC_STRING_SUCCESS);
+    CHECK(strcmp(str.data, ">a/b\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\b\f\r") == 0);
+
+    // Invalid escapes append nothing
+    const char* invalid[] = { "\\x41", "end\\", "\\u12", "\\u12g4", "\\ud83d", "\\ud83d\\u0041", "\\ude00" };
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        CHECK(hc_string_append_unescaped(&str, invalid[i], strlen(invalid[i])) == HC_STRING_ERROR_INVALID_SRC);
+    }
+    CHECK(strcmp(str.data, ">a/b\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\b\f\r") == 0);
+    hc_string_destroy(&str);
+
+    /* In-place unescaping */
+
+    str = hc_string_create_from_cstr("line\\nnext \\\"quoted\\\"");
+    CHECK(hc_string_unescape(&str) == HC_STRING_SUCCESS);
+    CHECK(strcmp(str.data, "line\nnext \"quoted\"") == 0 && str.length == 18);
+
+    // An invalid escape leaves the string unchanged
+    hc_string_t bad = hc_string_create_from_cstr("bad \\q escape");
+    CHECK(hc_string_unescape(&bad) == HC_STRING_ERROR_INVALID_SRC);
+    CHECK(strcmp(bad.data, "bad \\q escape") == 0);
+
+    // Unescaping a shared string leaves the other references alone
+    hc_string_t frozen = hc_string_create_from_cstr("tab\\there");
+    hc_string_freeze(&frozen);
+    hc_string_t copy = hc_string_copy(&frozen);
+    CHECK(hc_string_unescape(&copy) == HC_STRING_SUCCESS);
+    CHECK(strcmp(copy.data, "tab\there") == 0);
+    CHECK(strcmp(frozen.data, "tab\\there") == 0);
+
+    hc_string_destroy(&str);
+    hc_string_destroy(&bad);
+    hc_string_destroy(&frozen);
+    hc_string_destroy(&copy);
+
+    if (failures == 0) printf("All escape checks passed\n");
+    return failures != 0;
+}
@@ -0,0 +1,95 @@
+#define HC_STRING_IMPL
+#include "../hc_string.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+/* Plain dynamic programming reference, small inputs only */
+static size_t reference_distance(const char* a, const char* b)
+{
+    size_t n = strlen(a), m = strlen(b);
+    size_t row[256];
+
+    for (size_t j = 0; j <= m; j++) row[j] = j;
+
+    for (size_t i = 1; i <= n; i++) {
+        size_t diag = row[0];
+        row[0] = i;
+        for (size_t j = 1; j <= m; j++) {
+            size_t up = row[j];
+            size_t best = diag + (a[i - 1] != b[j - 1]);
+            if (up + 1 < best) best = up + 1;
+            if (row[j - 1] + 1 < best) best = row[j - 1] + 1;
+            row[j] = best;
+            diag = up;
+        }
+    }
+
+    return row[m];
+}
+
+int main(void)
+{
+    hc_string_t kitten = hc_string_create_from_cstr("kitten");
+    hc_string_t sitting = hc_string_create_from_cstr("sitting");
+    hc_string_t empty = hc_string_create_from_cstr("");
+
+    CHECK(hc_string_edit_distance(&kitten, &sitting) == 3);
+    CHECK(hc_string_edit_distance(&sitting, &kitten) == 3);
+    CHECK(hc_string_edit_distance(&kitten, &kitten) == 0);
+    CHECK(hc_string_edit_distance(&kitten, &empty) == 6);
+
+    // Past the bound the result is only known to be larger than it
+    CHECK(hc_string_edit_distance_bounded(&kitten, &sitting, 3) == 3);
+    CHECK(hc_string_edit_distance_bounded(&kitten, &sitting, 2) == 3);
+    CHECK(hc_string_edit_distance_bounded(&kitten, &sitting, 1) == 2);
+
+    // Strings longer than one 64-bit block
+    char long_a[201], long_b[201];
+    for (int i = 0; i < 200; i++) {
+        long_a[i] = "acgt"[(i * 7) % 4];
+        long_b[i] = "acgt"[(i * 7 + (i % 9 == 0)) % 4];
+    }
+    long_a[200] = long_b[200] = '\0';
+    long_b[150] = '\0';
+
+    hc_string_t la = hc_string_create_from_cstr(long_a);
+    hc_string_t lb = hc_string_create_from_cstr(long_b);
+    CHECK(hc_string_edit_distance(&la, &lb) == reference_distance(long_a, long_b));
+    hc_string_destroy(&la);
+    hc_string_destroy(&lb);
+
+    // A compiled pattern compared against many strings
+    static const char* words[] = { "receive", "recieve", "deceive", "relieve", "recipe", "" };
+    hc_string_pattern_t pattern;
+    CHECK(hc_string_pattern_create(&pattern, "receive", 7) == HC_STRING_SUCCESS);
+    for (size_t i = 0; i < sizeof(words) / sizeof(words[0]); i++) {
+        size_t expected = reference_distance("receive", words[i]);
+        size_t d = hc_string_pattern_distance(&pattern, words[i], strlen(words[i]), 2);
+        CHECK(d == (expected <= 2 ? expected : 3));
+    }
+
+    size_t end = 0, distance = 0;
+    const char* text = "we will recieve it tomorrow";
+    CHECK(hc_string_pattern_search(&pattern, text, strlen(text), 2, &end, &distance));
+    CHECK(distance == 2 && end == 13);  // First end within the bound, "recie" is two deletions away
+    CHECK(!hc_string_pattern_search(&pattern, text, strlen(text), 1, NULL, NULL));
+    hc_string_pattern_destroy(&pattern);
+
+    // Substring search with errors
+    hc_string_t sentence = hc_string_create_from_cstr("The quick brown fox jumps over the lazy dog");
+    CHECK(hc_string_fuzzy_find(&sentence, "brwn fox", 1, &end, &distance));
+    CHECK(distance == 1 && end == 19);
+    CHECK(hc_string_fuzzy_find(&sentence, "lazy", 0, &end, &distance));
+    CHECK(distance == 0 && end == 39);
+    CHECK(!hc_string_fuzzy_find(&sentence, "lazy cat", 1, NULL, NULL));
+
+    hc_string_destroy(&kitten);
+    hc_string_destroy(&sitting);
+    hc_string_destroy(&empty);
+    hc_string_destroy(&sentence);
+
+    if (failures == 0) printf("All fuzzy matching checks passed\n");
+    return failures != 0;
+}
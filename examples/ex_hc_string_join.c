@@ -0,0 +1,100 @@
+#define HC_STRING_IMPL
+#include "../hc_string.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+int main(void)
+{
+    /* Views */
+
+    hc_string_t hello = hc_string_create_from_cstr("Hello");
+    hc_string_view_t view = hc_string_view(&hello);
+    CHECK(view.data == hello.data && view.length == 5);
+
+    view = hc_string_view_cstr("World");
+    CHECK(view.length == 5 && memcmp(view.data, "World", 5) == 0);
+
+    hc_string_t empty = { 0 };
+    view = hc_string_view(&empty);
+    CHECK(view.data == NULL && view.length == 0);
+    view = hc_string_view_cstr(NULL);
+    CHECK(view.data == NULL && view.length == 0);
+
+    /* Concatenation of several pieces at once */
+
+    hc_string_view_t pieces[] = {
+        hc_string_view_cstr(", "),
+        { "World!!!", 5 },          // Views need not be null-terminated
+        hc_string_view_cstr("!"),
+    };
+    CHECK(hc_string_concat_many(&hello, pieces, 3) == HC_STRING_SUCCESS);
+    CHECK(strcmp(hello.data, "Hello, World!") == 0 && hello.length == 13);
+
+    // Pieces may point into the destination itself, even when it has to grow
+    hc_string_t echo = hc_string_create_from_cstr("echo");
+    hc_string_view_t self[] = { hc_string_view_cstr(" "), hc_string_view(&echo), hc_string_view_cstr(" "), hc_string_view(&echo) };
+    CHECK(hc_string_concat_many(&echo, self, 4) == HC_STRING_SUCCESS);
+    CHECK(strcmp(echo.data, "echo echo echo") == 0);
+
+    // A shared destination is detached first
+    hc_string_freeze(&echo);
+    hc_string_t shared = hc_string_copy(&echo);
+    CHECK(hc_string_concat_many(&echo, pieces + 2, 1) == HC_STRING_SUCCESS);
+    CHECK(strcmp(echo.data, "echo echo echo!") == 0);
+    CHECK(strcmp(shared.data, "echo echo echo") == 0);
+
+    CHECK(hc_string_concat_many(&hello, NULL, 1) == HC_STRING_ERROR_INVALID_SRC);
+    CHECK(hc_string_concat_many(NULL, pieces, 1) == HC_STRING_ERROR_INVALID_DST);
+
+    /* Reserve */
+
+    hc_string_t buffer = { 0 };
+    CHECK(hc_string_reserve(&buffer, 64) == HC_STRING_SUCCESS);
+    CHECK(buffer.capacity >= 64 && buffer.length == 0 && buffer.data[0] == '\0');
+
+    char *data = buffer.data;
+    for (int i = 0; i < 63; i++) {
+        hc_string_append_char(&buffer, 'a' + i % 26);
+    }
+    CHECK(buffer.data == data && buffer.length == 63);  // No reallocation within the reserved capacity
+
+    CHECK(hc_string_reserve(&buffer, 16) == HC_STRING_SUCCESS);
+    CHECK(buffer.capacity >= 64 && buffer.length == 63);
+
+    /* Joins */
+
+    const char* words[] = { "a", "", "b", "c" };
+    hc_string_t joined = hc_string_join_cstr(words, 4, ", ");
+    CHECK(joined.data && strcmp(joined.data, "a, , b, c") == 0 && joined.length == 9);
+    hc_string_destroy(&joined);
+
+    hc_string_t strings[] = { hello, shared };
+    joined = hc_string_join(strings, 2, " | ");
+    CHECK(joined.data && strcmp(joined.data, "Hello, World! | echo echo echo") == 0);
+    hc_string_destroy(&joined);
+
+    joined = hc_string_join_view(pieces, 3, NULL);
+    CHECK(joined.data && strcmp(joined.data, ", World!") == 0);
+    hc_string_destroy(&joined);
+
+    joined = hc_string_join_cstr(NULL, 0, "-");
+    CHECK(joined.data && joined.length == 0 && joined.data[0] == '\0');
+    hc_string_destroy(&joined);
+
+    // More pieces than the stack buffer of the joins
+    const char* many[100];
+    for (int i = 0; i < 100; i++) many[i] = "x";
+    joined = hc_string_join_cstr(many, 100, "");
+    CHECK(joined.data && joined.length == 100 && strspn(joined.data, "x") == 100);
+    hc_string_destroy(&joined);
+
+    hc_string_destroy(&hello);
+    hc_string_destroy(&echo);
+    hc_string_destroy(&shared);
+    hc_string_destroy(&buffer);
+
+    if (failures == 0) printf("All join checks passed\n");
+    return failures != 0;
+}
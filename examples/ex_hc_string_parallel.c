@@ -0,0 +1,73 @@
+// Small chunks so that this short text is split and matches straddle the boundaries
+#define HC_STRING_PARALLEL_CHUNK 64
+
+#define HC_STRING_IMPL
+#include "../hc_string.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+/* Greedy non-overlapping matches, scanned left to right */
+static size_t reference_find_all(const char* text, const char* keyword, size_t* positions, size_t max_positions)
+{
+    size_t n = strlen(text), m = strlen(keyword), count = 0;
+    for (size_t i = 0; i + m <= n;) {
+        if (memcmp(text + i, keyword, m) == 0) {
+            if (count < max_positions) positions[count] = i;
+            count++;
+            i += m;
+        } else {
+            i++;
+        }
+    }
+    return count;
+}
+
+int main(void)
+{
+    // Runs of 'a' make overlapping candidates cross every chunk boundary
+    hc_string_t text = hc_string_create(0);
+    for (int i = 0; i < 200; i++) {
+        hc_string_concat(&text, (i % 3) ? "aaaaaaa b  " : "the cat sat\t\n");
+    }
+
+    const char* keywords[] = { "aa", "aaa", "a b", "cat", " ", "missing", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa" };
+    static size_t expected[4096], positions[4096];
+
+    for (size_t k = 0; k < sizeof(keywords) / sizeof(keywords[0]); k++) {
+        for (int threads = 1; threads <= 4; threads++) {
+            size_t count = reference_find_all(text.data, keywords[k], expected, 4096);
+            CHECK(hc_string_occurrences_parallel(&text, keywords[k], threads) == count);
+            CHECK((size_t)hc_string_occurrences(&text, keywords[k]) == count);
+
+            memset(positions, 0xff, sizeof(positions));
+            CHECK(hc_string_find_all_parallel(&text, keywords[k], positions, 4096, threads) == count);
+            CHECK(memcmp(positions, expected, count * sizeof(size_t)) == 0);
+
+            // Only the first positions are stored, all matches are still counted
+            memset(positions, 0xff, sizeof(positions));
+            CHECK(hc_string_find_all_parallel(&text, keywords[k], positions, 5, threads) == count);
+            CHECK(memcmp(positions, expected, (count < 5 ? count : 5) * sizeof(size_t)) == 0);
+            CHECK(positions[5] == (size_t)-1);
+        }
+    }
+
+    for (int threads = 0; threads <= 4; threads++) {
+        CHECK(hc_string_word_count_parallel(&text, threads) == (size_t)hc_string_word_count(&text));
+    }
+
+    hc_string_t words = hc_string_create_from_cstr("  one two\tthree\nfour  ");
+    CHECK(hc_string_word_count_parallel(&words, 2) == 4);
+
+    hc_string_t empty = { 0 };
+    CHECK(hc_string_word_count_parallel(&empty, 2) == 0);
+    CHECK(hc_string_occurrences_parallel(&empty, "a", 2) == 0);
+    CHECK(hc_string_occurrences_parallel(&text, "", 2) == 0);
+
+    hc_string_destroy(&text);
+    hc_string_destroy(&words);
+
+    if (failures == 0) printf("All parallel search checks passed\n");
+    return failures != 0;
+}
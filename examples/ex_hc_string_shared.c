@@ -0,0 +1,60 @@
+#define HC_STRING_IMPL
+#include "../hc_string.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+int main(void)
+{
+    hc_string_t str = hc_string_create_from_cstr("Hello, World!");
+    CHECK(!hc_string_is_shared(&str));
+
+    // A frozen string is copied by reference
+    CHECK(hc_string_freeze(&str) == HC_STRING_SUCCESS);
+    CHECK(hc_string_is_shared(&str));
+    CHECK(strcmp(str.data, "Hello, World!") == 0);
+
+    hc_string_t copy = hc_string_copy(&str);
+    CHECK(hc_string_is_shared(&copy));
+    CHECK(copy.data == str.data);
+
+    // Freezing twice does nothing
+    CHECK(hc_string_freeze(&copy) == HC_STRING_SUCCESS);
+    CHECK(copy.data == str.data);
+
+    // Writing to a copy detaches it, the other reference is unchanged
+    CHECK(hc_string_concat(&copy, " Bye.") == HC_STRING_SUCCESS);
+    CHECK(!hc_string_is_shared(&copy));
+    CHECK(strcmp(copy.data, "Hello, World! Bye.") == 0);
+    CHECK(strcmp(str.data, "Hello, World!") == 0);
+    CHECK(hc_string_is_shared(&str));
+
+    hc_string_t other = hc_string_copy(&str);
+    hc_string_replace(&other, "World", "there");
+    CHECK(strcmp(other.data, "Hello, there!") == 0);
+    CHECK(strcmp(str.data, "Hello, World!") == 0);
+
+    // The last reference takes its bytes back
+    CHECK(hc_string_make_unique(&str) == HC_STRING_SUCCESS);
+    CHECK(!hc_string_is_shared(&str));
+    CHECK(strcmp(str.data, "Hello, World!") == 0);
+    CHECK(hc_string_append_char(&str, '!') == HC_STRING_SUCCESS);
+    CHECK(strcmp(str.data, "Hello, World!!") == 0);
+
+    // A plain string is already unique
+    CHECK(hc_string_make_unique(&copy) == HC_STRING_SUCCESS);
+    CHECK(!hc_string_is_shared(&copy));
+
+    hc_string_t empty = { 0 };
+    CHECK(hc_string_freeze(&empty) == HC_STRING_ERROR_INVALID_DST);
+    CHECK(hc_string_make_unique(&empty) == HC_STRING_ERROR_INVALID_DST);
+    CHECK(!hc_string_is_shared(&empty));
+
+    hc_string_destroy(&str);
+    hc_string_destroy(&copy);
+    hc_string_destroy(&other);
+
+    if (failures == 0) printf("All shared string checks passed\n");
+    return failures != 0;
+}
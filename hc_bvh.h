@@ -0,0 +1,798 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2024-2025 Le Juez Victor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Bounding volume hierarchy over triangle meshes, for ray queries.
+ *
+ * The tree is built top-down with the surface area heuristic evaluated on
+ * HC_BVH_BINS bins per axis. When compiled with OpenMP (3.0 or later), the
+ * subtrees of at least HC_BVH_TASK_SIZE triangles are built as parallel tasks.
+ *
+ * Nodes take 32 bytes: bounds, then either the index of the first of the two
+ * children (stored next to each other) or the range of the leaf triangles.
+ * With HC_BVH_QBVH, the binary tree is collapsed into 4-wide nodes whose
+ * children boxes are tested together with SIMD, which is usually faster.
+ *
+ * The vertices are arrays of hc_vec3_t (x, y, z packed), the ray origin and
+ * direction are hc_vec3_t (any float[3]). Triangles are copied in the leaf
+ * order with their edges precomputed, so the mesh isn't needed after the
+ * build; the hits report the index of the triangle in the mesh.
+ *
+ * NOTE: A built tree is read-only, it can be queried by several threads at once.
+ */
+
+#ifndef HC_BVH_H
+#define HC_BVH_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+/* Macros and defintions */
+
+#ifndef HC_MALLOC
+#   define HC_MALLOC(sz) malloc(sz)
+#endif
+
+#ifndef HC_CALLOC
+#   define HC_CALLOC(nb, sz) calloc(nb, sz)
+#endif
+
+#ifndef HC_REALLOC
+#   define HC_REALLOC(ptr, new_sz) realloc(ptr, new_sz)
+#endif
+
+#ifndef HC_FREE
+#   define HC_FREE(ptr) free(ptr)
+#endif
+
+#ifndef HC_BVH_BINS
+#   define HC_BVH_BINS 16              // Candidate split planes per axis and node, plus one
+#endif
+
+#ifndef HC_BVH_MAX_LEAF_SIZE
+#   define HC_BVH_MAX_LEAF_SIZE 4      // Triangles per leaf at most
+#endif
+
+#ifndef HC_BVH_TASK_SIZE
+#   define HC_BVH_TASK_SIZE 16384      // Subtrees built by a parallel task have at least this many triangles
+#endif
+
+/* SIMD support (define HC_BVH_NO_SIMD to only use the scalar paths) */
+
+#ifndef HC_BVH_NO_SIMD
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define HC_BVH_SSE2
+#       include <immintrin.h>
+#   endif
+#endif // HC_BVH_NO_SIMD
+
+/* Multi-threading (tasks need OpenMP 3.0) */
+
+#if defined(_OPENMP)
+#   include <omp.h>
+#   if _OPENMP >= 200805
+#       define HC_BVH_TASKS
+#   endif
+#endif
+
+/* Types definitions */
+
+enum hc_retcode_bvh {
+    HC_BVH_ERROR_TOO_LARGE          = -3,
+    HC_BVH_ERROR_OUT_OF_MEMORY      = -2,
+    HC_BVH_ERROR_INVALID            = -1,
+    HC_BVH_SUCCESS                  = 0
+};
+
+enum hc_flags_bvh {
+    HC_BVH_QBVH                     = 1 << 0    // Collapse the tree into 4-wide nodes
+};
+
+typedef struct {
+    float min[3];
+    uint32_t left_first;    // First child (inner node) or first triangle (leaf)
+    float max[3];
+    uint32_t count;         // Triangles of the leaf, 0 for inner nodes
+} hc_bvh_node_t;
+
+typedef struct {
+    float bounds[6][4];     // min x, y, z then max x, y, z of the 4 children (empty boxes are inverted)
+    uint32_t child[4];      // Node index, or first triangle for leaves
+    uint32_t count[4];      // Triangles of the leaf children, 0 for inner nodes and empty slots
+} hc_bvh_qnode_t;
+
+typedef struct {
+    float t;                // Distance along the ray, in units of the direction length
+    float u, v;             // Barycentric coordinates of the hit, relative to the 2nd and 3rd vertex
+    uint32_t triangle;      // Index of the triangle in the mesh
+} hc_bvh_hit_t;
+
+typedef struct {
+    hc_bvh_node_t *nodes;   // Binary nodes, NULL once collapsed into 'qnodes'
+    uint32_t node_count;
+    hc_bvh_qnode_t *qnodes; // 4-wide nodes (HC_BVH_QBVH), NULL otherwise
+    uint32_t qnode_count;
+    float *triangles;       // First vertex and two edges of each triangle, in leaf order
+    uint32_t *indices;      // Mesh index of each triangle, in leaf order
+    uint32_t triangle_count;
+} hc_bvh_t;
+
+/* Function declarations */
+
+int hc_bvh_build(hc_bvh_t* bvh, const float* vertices, const uint32_t* indices, uint32_t triangle_count, int flags, int num_threads);
+void hc_bvh_destroy(hc_bvh_t* bvh);
+bool hc_bvh_intersect(const hc_bvh_t* bvh, const float origin[3], const float direction[3], float tmax, hc_bvh_hit_t* hit);
+bool hc_bvh_occluded(const hc_bvh_t* bvh, const float origin[3], const float direction[3], float tmax);
+
+#endif // HC_BVH_H
+
+#ifdef HC_BVH_IMPL
+
+/* Private definitions */
+
+#define HC_BVH_MAX_SAH_DEPTH 32     // Deeper nodes are split in halves, bounding the depth to 64
+#define HC_BVH_STACK_SIZE 256       // Enough for 3 pushes per level of a 4-wide tree of depth 64
+
+typedef struct {
+    float min[3];
+    float max[3];
+} hc_bvh_aabb_t;
+
+typedef struct {
+    hc_bvh_aabb_t bounds;
+    hc_bvh_aabb_t centroids;
+    uint32_t count;
+} hc_bvh_bin_t;
+
+typedef struct {
+    float min[3];
+    float max[3];
+    uint32_t index;         // Triangle in the mesh
+} hc_bvh_ref_t;
+
+typedef struct {
+    hc_bvh_t *bvh;
+    hc_bvh_ref_t *refs;     // Bounds of the triangles, partitioned along with the nodes
+    uint32_t node_count;    // Allocated nodes
+} hc_bvh_builder_t;
+
+typedef struct {
+    uint32_t index;         // Node, or first triangle if 'count' isn't 0
+    uint32_t count;
+    float t;                // Entry distance of the box
+} hc_bvh_entry_t;
+
+/* Bounding boxes */
+
+static inline void hc_bvh_aabb_reset(hc_bvh_aabb_t* box)
+{
+    for (int i = 0; i < 3; i++) {
+        box->min[i] = HUGE_VALF;
+        box->max[i] = -HUGE_VALF;
+    }
+}
+
+static inline void hc_bvh_aabb_grow(hc_bvh_aabb_t* box, const float* min, const float* max)
+{
+    // Selects rather than branches, which mispredict on unsorted triangles
+    for (int i = 0; i < 3; i++) {
+        box->min[i] = (min[i] < box->min[i]) ? min[i] : box->min[i];
+        box->max[i] = (max[i] > box->max[i]) ? max[i] : box->max[i];
+    }
+}
+
+static inline float hc_bvh_aabb_area(const float* min, const float* max)
+{
+    float dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+    return (dx < 0.0f) ? 0.0f : dx * dy + dy * dz + dz * dx;
+}
+
+/* Builder */
+
+static uint32_t hc_bvh_alloc_nodes(hc_bvh_builder_t* b)
+{
+    uint32_t index;
+#ifdef HC_BVH_TASKS
+#   pragma omp atomic capture
+#endif
+    { index = b->node_count; b->node_count += 2; }
+    return index;
+}
+
+static inline void hc_bvh_centroid(const hc_bvh_ref_t* ref, float* c)
+{
+    for (int a = 0; a < 3; a++) {
+        c[a] = 0.5f * (ref->min[a] + ref->max[a]);
+    }
+}
+
+static void hc_bvh_range_bounds(const hc_bvh_builder_t* b, uint32_t first, uint32_t count, hc_bvh_aabb_t* bounds, hc_bvh_aabb_t* centroids)
+{
+    hc_bvh_aabb_reset(bounds);
+    hc_bvh_aabb_reset(centroids);
+
+    for (uint32_t i = first; i < first + count; i++) {
+        float c[3];
+        hc_bvh_centroid(&b->refs[i], c);
+        hc_bvh_aabb_grow(bounds, b->refs[i].min, b->refs[i].max);
+        hc_bvh_aabb_grow(centroids, c, c);
+    }
+}
+
+static inline int hc_bvh_bin_of(float c, float min, float scale, int bin_count)
+{
+    int bin = (int)((c - min) * scale);
+    return (bin < bin_count - 1) ? bin : bin_count - 1;
+}
+
+/*
+ * Builds the subtree of 'node_index' over the triangles [first, first + count),
+ * whose bounds are already set in the node. The children bounds come from the
+ * bins, so each level reads the triangles once to bin them and once to partition.
+ */
+static void hc_bvh_build_node(hc_bvh_builder_t* b, uint32_t node_index, uint32_t first, uint32_t count,
+                              const hc_bvh_aabb_t* centroids, int depth)
+{
+    hc_bvh_node_t *node = &b->bvh->nodes[node_index];
+    hc_bvh_ref_t *refs = b->refs;
+
+    node->left_first = first;
+    node->count = count;
+    if (count <= 1) return;
+
+    // Best split over the bins of the three axes
+    int best_axis = -1, best_split = 0;
+    float best_cost = HUGE_VALF;
+    hc_bvh_aabb_t best_boxes[2], best_centroids[2];
+
+    // Small nodes use fewer bins, their setup would cost more than binning the triangles
+    int bin_count = (count < HC_BVH_BINS) ? (int)count : HC_BVH_BINS;
+    float scale[3];
+    bool binned[3] = { false, false, false };
+    for (int axis = 0; axis < 3; axis++) {
+        float extent = centroids->max[axis] - centroids->min[axis];
+        binned[axis] = (depth < HC_BVH_MAX_SAH_DEPTH) && (extent > 0.0f);
+        scale[axis] = binned[axis] ? bin_count / extent : 0.0f;
+    }
+
+    if (binned[0] || binned[1] || binned[2]) {
+        hc_bvh_bin_t bins[3][HC_BVH_BINS];
+        for (int axis = 0; axis < 3; axis++) {
+            for (int k = 0; k < bin_count; k++) {
+                hc_bvh_aabb_reset(&bins[axis][k].bounds);
+                hc_bvh_aabb_reset(&bins[axis][k].centroids);
+                bins[axis][k].count = 0;
+            }
+        }
+
+        for (uint32_t i = first; i < first + count; i++) {
+            float c[3];
+            hc_bvh_centroid(&refs[i], c);
+            for (int axis = 0; axis < 3; axis++) {
+                if (!binned[axis]) continue;
+                hc_bvh_bin_t *bin = &bins[axis][hc_bvh_bin_of(c[axis], centroids->min[axis], scale[axis], bin_count)];
+                hc_bvh_aabb_grow(&bin->bounds, refs[i].min, refs[i].max);
+                hc_bvh_aabb_grow(&bin->centroids, c, c);
+                bin->count++;
+            }
+        }
+
+        for (int axis = 0; axis < 3; axis++) {
+            if (!binned[axis]) continue;
+
+            // Costs of the planes after each bin: sweep from the right, then from the left
+            const hc_bvh_bin_t *axis_bins = bins[axis];
+            float right_cost[HC_BVH_BINS];
+            hc_bvh_aabb_t box;
+            hc_bvh_aabb_reset(&box);
+            uint32_t n = 0;
+            for (int k = bin_count - 1; k > 0; k--) {
+                hc_bvh_aabb_grow(&box, axis_bins[k].bounds.min, axis_bins[k].bounds.max);
+                n += axis_bins[k].count;
+                right_cost[k - 1] = n ? n * hc_bvh_aabb_area(box.min, box.max) : HUGE_VALF;
+            }
+
+            hc_bvh_aabb_reset(&box);
+            n = 0;
+            for (int k = 0; k < bin_count - 1; k++) {
+                hc_bvh_aabb_grow(&box, axis_bins[k].bounds.min, axis_bins[k].bounds.max);
+                n += axis_bins[k].count;
+                if (n == 0 || n == count) continue;
+
+                float cost = n * hc_bvh_aabb_area(box.min, box.max) + right_cost[k];
+                if (cost < best_cost) {
+                    best_cost = cost, best_axis = axis, best_split = k + 1;
+                }
+            }
+        }
+
+        // Children bounds of the best split
+        if (best_axis >= 0) {
+            for (int side = 0; side < 2; side++) {
+                hc_bvh_aabb_reset(&best_boxes[side]);
+                hc_bvh_aabb_reset(&best_centroids[side]);
+            }
+            for (int k = 0; k < bin_count; k++) {
+                const hc_bvh_bin_t *bin = &bins[best_axis][k];
+                int side = (k >= best_split);
+                hc_bvh_aabb_grow(&best_boxes[side], bin->bounds.min, bin->bounds.max);
+                hc_bvh_aabb_grow(&best_centroids[side], bin->centroids.min, bin->centroids.max);
+            }
+        }
+    }
+
+    // Keep a leaf when it's cheaper than the split, with a traversal cost of one intersection
+    float area = hc_bvh_aabb_area(node->min, node->max);
+    if (count <= HC_BVH_MAX_LEAF_SIZE && count * area <= area + best_cost) return;
+
+    uint32_t left_count;
+    if (best_axis >= 0) {
+        float min = centroids->min[best_axis];
+        uint32_t i = first, j = first + count;
+        while (i < j) {
+            float c[3];
+            hc_bvh_centroid(&refs[i], c);
+            if (hc_bvh_bin_of(c[best_axis], min, scale[best_axis], bin_count) < best_split) {
+                i++;
+            } else {
+                hc_bvh_ref_t tmp = refs[i];
+                refs[i] = refs[--j];
+                refs[j] = tmp;
+            }
+        }
+        left_count = i - first;
+    } else {
+        // No usable split (same centroids, or too deep): halves in any order
+        left_count = count / 2;
+        hc_bvh_range_bounds(b, first, left_count, &best_boxes[0], &best_centroids[0]);
+        hc_bvh_range_bounds(b, first + left_count, count - left_count, &best_boxes[1], &best_centroids[1]);
+    }
+
+    uint32_t left = hc_bvh_alloc_nodes(b);
+    node->left_first = left;
+    node->count = 0;
+
+    for (int side = 0; side < 2; side++) {
+        hc_bvh_node_t *child = &b->bvh->nodes[left + side];
+        memcpy(child->min, best_boxes[side].min, sizeof(child->min));
+        memcpy(child->max, best_boxes[side].max, sizeof(child->max));
+    }
+
+#ifdef HC_BVH_TASKS
+    // The locals, 'best_centroids' included, are copied into the task (firstprivate)
+#   pragma omp task if (left_count >= HC_BVH_TASK_SIZE)
+#endif
+    hc_bvh_build_node(b, left, first, left_count, &best_centroids[0], depth + 1);
+    hc_bvh_build_node(b, left + 1, first + left_count, count - left_count, &best_centroids[1], depth + 1);
+}
+
+/*
+ * Collapses the binary subtree of the inner node 'node_index' into 4-wide nodes:
+ * the children of the inner child with the largest area replace it, until
+ * there are 4 children or only leaves. Returns the index of the 4-wide node.
+ */
+static uint32_t hc_bvh_collapse(hc_bvh_t* bvh, uint32_t node_index)
+{
+    const hc_bvh_node_t *nodes = bvh->nodes;
+    uint32_t slots[4] = { nodes[node_index].left_first, nodes[node_index].left_first + 1, 0, 0 };
+    int n = 2;
+
+    while (n < 4) {
+        int best = -1;
+        float best_area = -1.0f;
+        for (int k = 0; k < n; k++) {
+            const hc_bvh_node_t *child = &nodes[slots[k]];
+            float area = hc_bvh_aabb_area(child->min, child->max);
+            if (child->count == 0 && area > best_area) {
+                best = k, best_area = area;
+            }
+        }
+        if (best < 0) break;
+
+        uint32_t left = nodes[slots[best]].left_first;
+        slots[best] = left;
+        slots[n++] = left + 1;
+    }
+
+    uint32_t qindex = bvh->qnode_count++;
+    for (int k = 0; k < 4; k++) {
+        hc_bvh_qnode_t *q = &bvh->qnodes[qindex];
+        if (k >= n) {
+            for (int a = 0; a < 3; a++) {
+                q->bounds[a][k] = HUGE_VALF;
+                q->bounds[a + 3][k] = -HUGE_VALF;
+            }
+            q->child[k] = 0;
+            q->count[k] = 0;
+            continue;
+        }
+
+        const hc_bvh_node_t *child = &nodes[slots[k]];
+        for (int a = 0; a < 3; a++) {
+            q->bounds[a][k] = child->min[a];
+            q->bounds[a + 3][k] = child->max[a];
+        }
+        q->count[k] = child->count;
+        q->child[k] = child->count ? child->left_first : hc_bvh_collapse(bvh, slots[k]);
+    }
+    return qindex;
+}
+
+static int hc_bvh_build_qbvh(hc_bvh_t* bvh)
+{
+    // A tree with n leaves has n - 1 inner nodes, each 4-wide node replaces one of them at least
+    bvh->qnodes = HC_MALLOC(((bvh->node_count + 1) / 2) * sizeof(hc_bvh_qnode_t));
+    if (!bvh->qnodes) return HC_BVH_ERROR_OUT_OF_MEMORY;
+
+    hc_bvh_node_t *root = &bvh->nodes[0];
+    if (root->count) {
+        // Single leaf: one 4-wide node with one child
+        hc_bvh_qnode_t *q = &bvh->qnodes[0];
+        for (int k = 0; k < 4; k++) {
+            for (int a = 0; a < 3; a++) {
+                q->bounds[a][k] = k ? HUGE_VALF : root->min[a];
+                q->bounds[a + 3][k] = k ? -HUGE_VALF : root->max[a];
+            }
+            q->child[k] = k ? 0 : root->left_first;
+            q->count[k] = k ? 0 : root->count;
+        }
+        bvh->qnode_count = 1;
+    } else {
+        hc_bvh_collapse(bvh, 0);
+    }
+
+    HC_FREE(bvh->nodes);
+    bvh->nodes = NULL;
+    return HC_BVH_SUCCESS;
+}
+
+/* Traversal */
+
+/* Möller-Trumbore test against a triangle stored as its first vertex and two edges */
+static inline bool hc_bvh_intersect_triangle(const float* tri, const float* o, const float* d, float tmax, float* t, float* u, float* v)
+{
+    const float *v0 = tri, *e1 = tri + 3, *e2 = tri + 6;
+
+    float p[3] = { d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0] };
+    float det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+    if (fabsf(det) < 1e-20f) return false;
+
+    float inv = 1.0f / det;
+    float s[3] = { o[0] - v0[0], o[1] - v0[1], o[2] - v0[2] };
+    float bu = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inv;
+    if (bu < 0.0f || bu > 1.0f) return false;
+
+    float q[3] = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+    float bv = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) * inv;
+    if (bv < 0.0f || bu + bv > 1.0f) return false;
+
+    float dist = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inv;
+    if (!(dist > 0.0f && dist < tmax)) return false;
+
+    *t = dist, *u = bu, *v = bv;
+    return true;
+}
+
+/* Tests the leaf triangles, stops at the first hit if 'any' is set */
+static inline bool hc_bvh_intersect_leaf(const hc_bvh_t* bvh, uint32_t first, uint32_t count,
+                                         const float* o, const float* d, bool any, hc_bvh_hit_t* hit)
+{
+    bool found = false;
+    for (uint32_t i = first; i < first + count; i++) {
+        float t, u, v;
+        if (hc_bvh_intersect_triangle(bvh->triangles + 9 * (size_t)i, o, d, hit->t, &t, &u, &v)) {
+            hit->t = t, hit->u = u, hit->v = v;
+            hit->triangle = bvh->indices[i];
+            found = true;
+            if (any) break;
+        }
+    }
+    return found;
+}
+
+/* Inverse of the direction, whose null components are replaced by tiny ones to avoid NaNs */
+static inline void hc_bvh_inv_direction(const float* d, float* inv)
+{
+    for (int a = 0; a < 3; a++) {
+        float c = (fabsf(d[a]) < 1e-20f) ? (d[a] < 0.0f ? -1e-20f : 1e-20f) : d[a];
+        inv[a] = 1.0f / c;
+    }
+}
+
+/* Entry distance of the box, or HUGE_VALF if the ray misses it before 'tmax' */
+static inline float hc_bvh_box_entry(const float* min, const float* max, const float* o, const float* inv, float tmax)
+{
+    float tnear = 0.0f, tfar = tmax;
+    for (int a = 0; a < 3; a++) {
+        float t1 = (min[a] - o[a]) * inv[a];
+        float t2 = (max[a] - o[a]) * inv[a];
+        float lo = (t1 < t2) ? t1 : t2, hi = (t1 < t2) ? t2 : t1;
+        tnear = (lo > tnear) ? lo : tnear;
+        tfar = (hi < tfar) ? hi : tfar;
+    }
+    return (tnear <= tfar) ? tnear : HUGE_VALF;
+}
+
+static bool hc_bvh_traverse_binary(const hc_bvh_t* bvh, const float* o, const float* d, bool any, hc_bvh_hit_t* hit)
+{
+    const hc_bvh_node_t *nodes = bvh->nodes;
+    hc_bvh_entry_t stack[HC_BVH_STACK_SIZE];
+    int top = 0;
+    bool found = false;
+
+    float inv[3];
+    hc_bvh_inv_direction(d, inv);
+
+    float t = hc_bvh_box_entry(nodes[0].min, nodes[0].max, o, inv, hit->t);
+    if (t == HUGE_VALF) return false;
+    stack[top++] = (hc_bvh_entry_t) { 0, 0, t };
+
+    while (top > 0) {
+        hc_bvh_entry_t entry = stack[--top];
+        if (entry.t >= hit->t) continue;        // Farther than the closest hit found since the push
+
+        const hc_bvh_node_t *node = &nodes[entry.index];
+        while (node->count == 0) {
+            const hc_bvh_node_t *left = &nodes[node->left_first], *right = left + 1;
+            float tl = hc_bvh_box_entry(left->min, left->max, o, inv, hit->t);
+            float tr = hc_bvh_box_entry(right->min, right->max, o, inv, hit->t);
+
+            if (tl > tr) {
+                const hc_bvh_node_t *tmp = left; left = right; right = tmp;
+                float tt = tl; tl = tr; tr = tt;
+            }
+            if (tl == HUGE_VALF) goto next;
+            if (tr != HUGE_VALF) stack[top++] = (hc_bvh_entry_t) { (uint32_t)(right - nodes), 0, tr };
+            node = left;
+        }
+
+        if (hc_bvh_intersect_leaf(bvh, node->left_first, node->count, o, d, any, hit)) {
+            found = true;
+            if (any) return true;
+        }
+    next:;
+    }
+    return found;
+}
+
+static bool hc_bvh_traverse_qbvh(const hc_bvh_t* bvh, const float* o, const float* d, bool any, hc_bvh_hit_t* hit)
+{
+    hc_bvh_entry_t stack[HC_BVH_STACK_SIZE];
+    int top = 0;
+    bool found = false;
+
+    float inv[3];
+    hc_bvh_inv_direction(d, inv);
+
+    // The near planes are the min or the max bounds, depending on the direction signs
+    int near_row[3], far_row[3];
+    for (int a = 0; a < 3; a++) {
+        near_row[a] = inv[a] < 0.0f ? a + 3 : a;
+        far_row[a] = inv[a] < 0.0f ? a : a + 3;
+    }
+
+#if defined(HC_BVH_SSE2)
+    const __m128 ox = _mm_set1_ps(o[0]), oy = _mm_set1_ps(o[1]), oz = _mm_set1_ps(o[2]);
+    const __m128 ix = _mm_set1_ps(inv[0]), iy = _mm_set1_ps(inv[1]), iz = _mm_set1_ps(inv[2]);
+#endif
+
+    stack[top++] = (hc_bvh_entry_t) { 0, 0, 0.0f };
+
+    while (top > 0) {
+        hc_bvh_entry_t entry = stack[--top];
+        if (entry.t >= hit->t) continue;
+
+        if (entry.count) {
+            if (hc_bvh_intersect_leaf(bvh, entry.index, entry.count, o, d, any, hit)) {
+                found = true;
+                if (any) return true;
+            }
+            continue;
+        }
+
+        const hc_bvh_qnode_t *q = &bvh->qnodes[entry.index];
+        float tnear[4];
+        int mask = 0;
+
+#if defined(HC_BVH_SSE2)
+        __m128 tn = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(q->bounds[near_row[0]]), ox), ix);
+        tn = _mm_max_ps(tn, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(q->bounds[near_row[1]]), oy), iy));
+        tn = _mm_max_ps(tn, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(q->bounds[near_row[2]]), oz), iz));
+        tn = _mm_max_ps(tn, _mm_setzero_ps());
+
+        __m128 tf = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(q->bounds[far_row[0]]), ox), ix);
+        tf = _mm_min_ps(tf, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(q->bounds[far_row[1]]), oy), iy));
+        tf = _mm_min_ps(tf, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(q->bounds[far_row[2]]), oz), iz));
+        tf = _mm_min_ps(tf, _mm_set1_ps(hit->t));
+
+        mask = _mm_movemask_ps(_mm_cmple_ps(tn, tf));
+        _mm_storeu_ps(tnear, tn);
+#else
+        for (int k = 0; k < 4; k++) {
+            float tn = 0.0f, tf = hit->t;
+            for (int a = 0; a < 3; a++) {
+                float t1 = (q->bounds[near_row[a]][k] - o[a]) * inv[a];
+                float t2 = (q->bounds[far_row[a]][k] - o[a]) * inv[a];
+                if (t1 > tn) tn = t1;
+                if (t2 < tf) tf = t2;
+            }
+            tnear[k] = tn;
+            if (tn <= tf) mask |= 1 << k;
+        }
+#endif
+
+        // Push the hit children, farthest first so that the nearest is popped next
+        hc_bvh_entry_t hits[4];
+        int n = 0;
+        for (int k = 0; k < 4; k++) {
+            if (!(mask & (1 << k))) continue;
+            hc_bvh_entry_t e = { q->child[k], q->count[k], tnear[k] };
+            int j = n++;
+            while (j > 0 && hits[j - 1].t < e.t) {
+                hits[j] = hits[j - 1];
+                j--;
+            }
+            hits[j] = e;
+        }
+        for (int k = 0; k < n; k++) stack[top++] = hits[k];
+    }
+    return found;
+}
+
+/* Public functions */
+
+int hc_bvh_build(hc_bvh_t* bvh, const float* vertices, const uint32_t* indices, uint32_t triangle_count, int flags, int num_threads)
+{
+    if (!bvh) return HC_BVH_ERROR_INVALID;
+    memset(bvh, 0, sizeof(hc_bvh_t));
+
+    if (triangle_count == 0) return HC_BVH_SUCCESS;
+    if (!vertices) return HC_BVH_ERROR_INVALID;
+    if (triangle_count > UINT32_MAX / 2) return HC_BVH_ERROR_TOO_LARGE;
+
+#ifdef _OPENMP
+    int threads = num_threads > 0 ? num_threads : omp_get_max_threads();
+#else
+    (void)num_threads;
+#endif
+
+    hc_bvh_builder_t b = { bvh, NULL, 1 };
+    size_t n = triangle_count;
+
+    b.refs = HC_MALLOC(n * sizeof(hc_bvh_ref_t));
+    bvh->nodes = HC_MALLOC((2 * n - 1) * sizeof(hc_bvh_node_t));
+    bvh->indices = HC_MALLOC(n * sizeof(uint32_t));
+    bvh->triangles = HC_MALLOC(9 * n * sizeof(float));
+
+    if (!b.refs || !bvh->nodes || !bvh->indices || !bvh->triangles) {
+        HC_FREE(b.refs);
+        hc_bvh_destroy(bvh);
+        return HC_BVH_ERROR_OUT_OF_MEMORY;
+    }
+
+#ifdef _OPENMP
+#   pragma omp parallel for num_threads(threads)
+#endif
+    for (long long k = 0; k < (long long)n; k++) {
+        size_t i = (size_t)k;
+        hc_bvh_ref_t *ref = &b.refs[i];
+        const float *v = vertices + 3 * (size_t)(indices ? indices[3 * i] : 3 * i);
+        memcpy(ref->min, v, sizeof(ref->min));
+        memcpy(ref->max, v, sizeof(ref->max));
+        for (int j = 1; j < 3; j++) {
+            v = vertices + 3 * (size_t)(indices ? indices[3 * i + j] : 3 * i + j);
+            for (int a = 0; a < 3; a++) {
+                if (v[a] < ref->min[a]) ref->min[a] = v[a];
+                if (v[a] > ref->max[a]) ref->max[a] = v[a];
+            }
+        }
+        ref->index = (uint32_t)i;
+    }
+
+    hc_bvh_aabb_t bounds, centroids;
+    hc_bvh_range_bounds(&b, 0, triangle_count, &bounds, &centroids);
+    memcpy(bvh->nodes[0].min, bounds.min, sizeof(bounds.min));
+    memcpy(bvh->nodes[0].max, bounds.max, sizeof(bounds.max));
+
+#ifdef HC_BVH_TASKS
+#   pragma omp parallel num_threads(threads)
+#   pragma omp single
+#endif
+    hc_bvh_build_node(&b, 0, 0, triangle_count, &centroids, 0);
+
+    bvh->node_count = b.node_count;
+    bvh->triangle_count = triangle_count;
+
+    // Triangles in leaf order, as the first vertex and the edges to the two others
+#ifdef _OPENMP
+#   pragma omp parallel for num_threads(threads)
+#endif
+    for (long long k = 0; k < (long long)n; k++) {
+        size_t t = b.refs[k].index;
+        bvh->indices[k] = (uint32_t)t;
+        float *dst = bvh->triangles + 9 * (size_t)k;
+        const float *v[3];
+        for (int j = 0; j < 3; j++) {
+            v[j] = vertices + 3 * (size_t)(indices ? indices[3 * t + j] : 3 * t + j);
+        }
+        for (int a = 0; a < 3; a++) {
+            dst[a] = v[0][a];
+            dst[3 + a] = v[1][a] - v[0][a];
+            dst[6 + a] = v[2][a] - v[0][a];
+        }
+    }
+    HC_FREE(b.refs);
+
+    if (flags & HC_BVH_QBVH) {
+        int ret = hc_bvh_build_qbvh(bvh);
+        if (ret != HC_BVH_SUCCESS) {
+            hc_bvh_destroy(bvh);
+            return ret;
+        }
+    } else {
+        // Give back the room reserved for the worst case
+        void *nodes = HC_REALLOC(bvh->nodes, bvh->node_count * sizeof(hc_bvh_node_t));
+        if (nodes) bvh->nodes = nodes;
+    }
+
+    return HC_BVH_SUCCESS;
+}
+
+void hc_bvh_destroy(hc_bvh_t* bvh)
+{
+    if (!bvh) return;
+    HC_FREE(bvh->nodes);
+    HC_FREE(bvh->qnodes);
+    HC_FREE(bvh->triangles);
+    HC_FREE(bvh->indices);
+    memset(bvh, 0, sizeof(hc_bvh_t));
+}
+
+/* Closest hit before 'tmax' (HUGE_VALF for no limit), 'hit' is only written on success */
+bool hc_bvh_intersect(const hc_bvh_t* bvh, const float origin[3], const float direction[3], float tmax, hc_bvh_hit_t* hit)
+{
+    if (!bvh || bvh->triangle_count == 0) return false;
+
+    hc_bvh_hit_t h = { tmax, 0.0f, 0.0f, 0 };
+    bool found = bvh->qnodes ? hc_bvh_traverse_qbvh(bvh, origin, direction, false, &h)
+                             : hc_bvh_traverse_binary(bvh, origin, direction, false, &h);
+
+    if (found && hit) *hit = h;
+    return found;
+}
+
+/* Any hit before 'tmax', for shadow and visibility rays */
+bool hc_bvh_occluded(const hc_bvh_t* bvh, const float origin[3], const float direction[3], float tmax)
+{
+    if (!bvh || bvh->triangle_count == 0) return false;
+
+    hc_bvh_hit_t h = { tmax, 0.0f, 0.0f, 0 };
+    return bvh->qnodes ? hc_bvh_traverse_qbvh(bvh, origin, direction, true, &h)
+                       : hc_bvh_traverse_binary(bvh, origin, direction, true, &h);
+}
+
+#endif // HC_BVH_IMPL
@@ -0,0 +1,350 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024-2025 Le Juez Victor
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+ * CSV / TSV parser yielding zero-copy field views.
+ *
+ * The input is indexed 64 bytes at a time: bitmasks of the quotes, delimiters
+ * and newlines are built with SIMD compares, the quoted regions are obtained
+ * with a prefix XOR of the quote mask (a carry-less multiplication when
+ * PCLMUL is available), and the unquoted delimiters and newlines left are
+ * the field boundaries. Records are then cut from this index without
+ * looking at the bytes again.
+ *
+ * Fields are views into the input: the surrounding quotes of a quoted field
+ * are removed, and the fields containing doubled quotes are flagged so that
+ * only those need hc_csv_field_unescape. Records end with "\n" or "\r\n".
+ */
+
+#ifndef HC_CSV_H
+#define HC_CSV_H
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Macros and defintions */
+
+#ifndef HC_MALLOC
+#   define HC_MALLOC(sz) malloc(sz)
+#endif
+
+#ifndef HC_REALLOC
+#   define HC_REALLOC(ptr, new_sz) realloc(ptr, new_sz)
+#endif
+
+#ifndef HC_FREE
+#   define HC_FREE(ptr) free(ptr)
+#endif
+
+#ifndef HC_CSV_BATCH_SIZE
+#   define HC_CSV_BATCH_SIZE (64 * 1024)   // Bytes indexed at once (multiple of 64)
+#endif
+
+/* SIMD support (define HC_CSV_NO_SIMD to only use the scalar paths) */
+
+#ifndef HC_CSV_NO_SIMD
+#   if defined(__AVX2__)
+#       define HC_CSV_AVX2
+#   endif
+#   if defined(__PCLMUL__)
+#       define HC_CSV_PCLMUL
+#   endif
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define HC_CSV_SSE2
+#       include <immintrin.h>
+#   endif
+#endif // HC_CSV_NO_SIMD
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#   include <intrin.h>
+static inline int hc_csv_ctz64(uint64_t x) { unsigned long i; _BitScanForward64(&i, x); return (int)i; }
+#else
+#   define hc_csv_ctz64(x) __builtin_ctzll(x)
+#endif
+
+/* Types definitions */
+
+enum hc_retcode_csv {
+    HC_CSV_ERROR_UNTERMINATED_QUOTE = -2,
+    HC_CSV_ERROR_OUT_OF_MEMORY      = -1,
+    HC_CSV_END                      = 0,
+    HC_CSV_RECORD                   = 1
+};
+
+typedef struct {
+    const char *data;
+    size_t length;
+    bool escaped;           // Contains doubled quotes, see hc_csv_field_unescape
+} hc_csv_field_t;
+
+typedef struct {
+    const char *data;
+    size_t length;
+    char delimiter;
+    char quote;
+    /* Structural index */
+    size_t *index;          // Positions of the unquoted delimiters and newlines
+    size_t index_count;
+    size_t index_pos;
+    size_t scanned;         // Input bytes already indexed
+    uint64_t inside;        // All ones if the last indexed byte is inside quotes
+    /* Current record */
+    hc_csv_field_t *fields;
+    size_t field_count;
+    size_t field_capacity;
+    size_t cursor;          // Start of the next record
+} hc_csv_t;
+
+/* Function declarations */
+
+void hc_csv_init(hc_csv_t* csv, const char* data, size_t length, char delimiter, char quote);
+void hc_csv_destroy(hc_csv_t* csv);
+int hc_csv_next(hc_csv_t* csv, const hc_csv_field_t** fields, size_t* count);
+size_t hc_csv_field_unescape(const hc_csv_t* csv, const hc_csv_field_t* field, char* dst);
+
+#endif // HC_CSV_H
+
+#ifdef HC_CSV_IMPL
+
+/* Structural indexing */
+
+static inline uint64_t hc_csv_prefix_xor(uint64_t x)
+{
+#if defined(HC_CSV_PCLMUL)
+    __m128i r = _mm_clmulepi64_si128(_mm_set_epi64x(0, (long long)x), _mm_set1_epi8((char)0xFF), 0);
+    return (uint64_t)_mm_cvtsi128_si64(r);
+#else
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+#endif
+}
+
+/* Builds the quote and separator (delimiter or newline) masks of 64 bytes */
+static inline void hc_csv_masks(const hc_csv_t* csv, const uint8_t* src, uint64_t* quotes, uint64_t* separators)
+{
+#if defined(HC_CSV_AVX2)
+    const __m256i q = _mm256_set1_epi8(csv->quote);
+    const __m256i d = _mm256_set1_epi8(csv->delimiter);
+    const __m256i n = _mm256_set1_epi8('\n');
+    __m256i lo = _mm256_loadu_si256((const __m256i*)src);
+    __m256i hi = _mm256_loadu_si256((const __m256i*)(src + 32));
+    *quotes = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, q))
+            | ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, q)) << 32);
+    *separators = (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(lo, d), _mm256_cmpeq_epi8(lo, n)))
+                | ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(hi, d), _mm256_cmpeq_epi8(hi, n))) << 32);
+#elif defined(HC_CSV_SSE2)
+    const __m128i q = _mm_set1_epi8(csv->quote);
+    const __m128i d = _mm_set1_epi8(csv->delimiter);
+    const __m128i n = _mm_set1_epi8('\n');
+    uint64_t qm = 0, sm = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + 16 * i));
+        qm |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, q)) << (16 * i);
+        sm |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, d), _mm_cmpeq_epi8(v, n))) << (16 * i);
+    }
+    *quotes = qm;
+    *separators = sm;
+#else
+    uint64_t qm = 0, sm = 0;
+    for (int i = 0; i < 64; i++) {
+        qm |= (uint64_t)(src[i] == (uint8_t)csv->quote) << i;
+        sm |= (uint64_t)(src[i] == (uint8_t)csv->delimiter || src[i] == '\n') << i;
+    }
+    *quotes = qm;
+    *separators = sm;
+#endif
+}
+
+/* Indexes the next batch of input, returns false on allocation failure */
+static bool hc_csv_refill(hc_csv_t* csv)
+{
+    if (!csv->index) {
+        csv->index = HC_MALLOC(HC_CSV_BATCH_SIZE * sizeof(size_t));
+        if (!csv->index) return false;
+    }
+
+    size_t end = csv->scanned + HC_CSV_BATCH_SIZE;
+    if (end > csv->length) end = csv->length;
+
+    size_t count = 0;
+
+    for (size_t base = csv->scanned; base < end; base += 64) {
+        uint64_t quotes, separators;
+
+        if (base + 64 <= csv->length) {
+            hc_csv_masks(csv, (const uint8_t*)csv->data + base, &quotes, &separators);
+        }
+        else {
+            // Last partial block, padded with quote-free non-separator bytes
+            uint8_t tail[64];
+            size_t rest = csv->length - base;
+            uint8_t pad = (uint8_t)(csv->delimiter == ' ' || csv->quote == ' ' ? 'x' : ' ');
+            memset(tail, pad, sizeof(tail));
+            memcpy(tail, csv->data + base, rest);
+            hc_csv_masks(csv, tail, &quotes, &separators);
+        }
+
+        uint64_t inside = hc_csv_prefix_xor(quotes) ^ csv->inside;
+        csv->inside = (uint64_t)((int64_t)inside >> 63);
+
+        uint64_t structural = separators & ~inside;
+        while (structural) {
+            csv->index[count++] = base + hc_csv_ctz64(structural);
+            structural &= structural - 1;
+        }
+    }
+
+    csv->scanned = end;
+    csv->index_count = count;
+    csv->index_pos = 0;
+
+    return true;
+}
+
+static bool hc_csv_push_field(hc_csv_t* csv, size_t begin, size_t end, bool newline)
+{
+    if (csv->field_count >= csv->field_capacity) {
+        size_t new_capacity = csv->field_capacity ? csv->field_capacity * 2 : 16;
+        hc_csv_field_t *new_fields = HC_REALLOC(csv->fields, new_capacity * sizeof(hc_csv_field_t));
+        if (!new_fields) return false;
+        csv->fields = new_fields;
+        csv->field_capacity = new_capacity;
+    }
+
+    const char *data = csv->data;
+    if (newline && end > begin && data[end - 1] == '\r') {
+        end--;
+    }
+
+    hc_csv_field_t *field = &csv->fields[csv->field_count++];
+
+    if (end - begin >= 2 && data[begin] == csv->quote && data[end - 1] == csv->quote) {
+        field->data = data + begin + 1;
+        field->length = end - begin - 2;
+        field->escaped = (memchr(field->data, csv->quote, field->length) != NULL);
+    }
+    else {
+        field->data = data + begin;
+        field->length = end - begin;
+        field->escaped = false;
+    }
+
+    return true;
+}
+
+/* Public API */
+
+void hc_csv_init(hc_csv_t* csv, const char* data, size_t length, char delimiter, char quote)
+{
+    memset(csv, 0, sizeof(*csv));
+
+    csv->data = data;
+    csv->length = length;
+    csv->delimiter = delimiter;
+    csv->quote = quote;
+}
+
+void hc_csv_destroy(hc_csv_t* csv)
+{
+    HC_FREE(csv->index);
+    HC_FREE(csv->fields);
+    memset(csv, 0, sizeof(*csv));
+}
+
+int hc_csv_next(hc_csv_t* csv, const hc_csv_field_t** fields, size_t* count)
+{
+    if (csv->cursor >= csv->length) {
+        return HC_CSV_END;
+    }
+
+    csv->field_count = 0;
+    size_t start = csv->cursor;
+
+    for (;;) {
+        if (csv->index_pos == csv->index_count) {
+            if (csv->scanned < csv->length) {
+                if (!hc_csv_refill(csv)) return HC_CSV_ERROR_OUT_OF_MEMORY;
+                continue;
+            }
+
+            // Last record without final newline
+            if (csv->inside) {
+                return HC_CSV_ERROR_UNTERMINATED_QUOTE;
+            }
+            if (!hc_csv_push_field(csv, start, csv->length, false)) {
+                return HC_CSV_ERROR_OUT_OF_MEMORY;
+            }
+            csv->cursor = csv->length;
+            break;
+        }
+
+        size_t pos = csv->index[csv->index_pos++];
+        bool newline = (csv->data[pos] == '\n');
+
+        if (!hc_csv_push_field(csv, start, pos, newline)) {
+            return HC_CSV_ERROR_OUT_OF_MEMORY;
+        }
+
+        start = pos + 1;
+
+        if (newline) {
+            csv->cursor = start;
+            break;
+        }
+    }
+
+    if (fields) *fields = csv->fields;
+    if (count) *count = csv->field_count;
+
+    return HC_CSV_RECORD;
+}
+
+size_t hc_csv_field_unescape(const hc_csv_t* csv, const hc_csv_field_t* field, char* dst)
+{
+    if (!field->escaped) {
+        memcpy(dst, field->data, field->length);
+        return field->length;
+    }
+
+    // Doubled quotes become single ones, 'dst' needs at most 'field->length' bytes
+    size_t n = 0;
+    for (size_t i = 0; i < field->length; i++) {
+        dst[n++] = field->data[i];
+        if (field->data[i] == csv->quote && i + 1 < field->length && field->data[i + 1] == csv->quote) {
+            i++;
+        }
+    }
+
+    return n;
+}
+
+#endif // HC_CSV_IMPL
@@ -0,0 +1,751 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2024-2025 Le Juez Victor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Suffix array and FM-index for repeated substring queries on an immutable text.
+ *
+ * The suffix array is built in linear time with SA-IS. The FM-index keeps the
+ * Burrows-Wheeler transform of the text, occurrence counts sampled every
+ * HC_FMINDEX_OCC_RATE rows and the text positions multiple of HC_FMINDEX_SA_RATE,
+ * so that counting a pattern costs O(pattern length) and locating each of its
+ * occurrences at most HC_FMINDEX_SA_RATE extra steps, whatever the text size.
+ *
+ * The text itself is not needed once the index is built. Texts are limited
+ * to 4 GiB - 2 bytes (32-bit positions).
+ *
+ * The index is stored in a single block which is also its serialized form,
+ * an index saved to a file can thus be memory mapped and used through
+ * hc_fmindex_load without any copy. The format uses the native byte order.
+ */
+
+#ifndef HC_FMINDEX_H
+#define HC_FMINDEX_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/* Macros and defintions */
+
+#ifndef HC_MALLOC
+#   define HC_MALLOC(sz) malloc(sz)
+#endif
+
+#ifndef HC_CALLOC
+#   define HC_CALLOC(nb, sz) calloc(nb, sz)
+#endif
+
+#ifndef HC_REALLOC
+#   define HC_REALLOC(ptr, new_sz) realloc(ptr, new_sz)
+#endif
+
+#ifndef HC_FREE
+#   define HC_FREE(ptr) free(ptr)
+#endif
+
+#ifndef HC_FMINDEX_OCC_RATE
+#   define HC_FMINDEX_OCC_RATE 256     // BWT rows between two occurrence count samples
+#endif
+
+#ifndef HC_FMINDEX_SA_RATE
+#   define HC_FMINDEX_SA_RATE 32       // Distance between two sampled text positions
+#endif
+
+/* SIMD support (define HC_FMINDEX_NO_SIMD to only use the scalar paths) */
+
+#ifndef HC_FMINDEX_NO_SIMD
+#   if defined(__AVX2__)
+#       define HC_FMINDEX_AVX2
+#   endif
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define HC_FMINDEX_SSE2
+#       include <immintrin.h>
+#   endif
+#endif // HC_FMINDEX_NO_SIMD
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#   include <intrin.h>
+#   define hc_fmindex_popcount32(x) ((int)__popcnt(x))
+#   define hc_fmindex_popcount64(x) ((int)__popcnt64(x))
+#else
+#   define hc_fmindex_popcount32(x) __builtin_popcount(x)
+#   define hc_fmindex_popcount64(x) __builtin_popcountll(x)
+#endif
+
+/* Types definitions */
+
+enum hc_retcode_fmindex {
+    HC_FMINDEX_ERROR_IO             = -4,
+    HC_FMINDEX_ERROR_INVALID_DATA   = -3,
+    HC_FMINDEX_ERROR_TOO_LARGE      = -2,
+    HC_FMINDEX_ERROR_OUT_OF_MEMORY  = -1,
+    HC_FMINDEX_SUCCESS              = 0
+};
+
+typedef struct {
+    char magic[8];
+    uint32_t byte_order;    // Used to reject data saved with another byte order
+    uint32_t sigma;         // Number of distinct bytes in the text
+    uint32_t occ_rate;
+    uint32_t sa_rate;
+    uint64_t rows;          // Text length + 1 (the empty suffix)
+    uint64_t primary;       // Row of the whole text, whose BWT byte is the virtual sentinel
+    uint64_t sample_count;  // Number of sampled text positions
+    uint64_t size;          // Total size of the block in bytes
+    uint64_t C[257];        // Rows sorted before the suffixes starting with each byte
+    uint8_t symbols[256];   // Rank of each byte among the bytes present in the text
+} hc_fmindex_header_t;
+
+typedef struct {
+    const hc_fmindex_header_t *header;
+    const uint32_t *occ;            // Counts of each symbol before every sampled row
+    const uint64_t *sampled;        // Bit set for the rows whose text position is sampled
+    const uint32_t *sampled_rank;   // Set bits before every 512 rows
+    const uint32_t *positions;      // Text positions of the sampled rows, in row order
+    const uint8_t *bwt;             // Burrows-Wheeler transform of the text
+    void *memory;                   // Block owned by the index (NULL if loaded from user data)
+} hc_fmindex_t;
+
+/* Function declarations */
+
+int hc_fmindex_suffix_array(const char* text, size_t length, uint32_t* sa);
+int hc_fmindex_build(hc_fmindex_t* index, const char* text, size_t length);
+void hc_fmindex_destroy(hc_fmindex_t* index);
+size_t hc_fmindex_count(const hc_fmindex_t* index, const char* pattern, size_t length);
+size_t hc_fmindex_locate(const hc_fmindex_t* index, const char* pattern, size_t length, size_t* positions, size_t max_positions);
+size_t hc_fmindex_size(const hc_fmindex_t* index);
+const void* hc_fmindex_data(const hc_fmindex_t* index);
+int hc_fmindex_save(const hc_fmindex_t* index, const char* path);
+int hc_fmindex_load(hc_fmindex_t* index, const void* data, size_t size);
+int hc_fmindex_load_file(hc_fmindex_t* index, const char* path);
+
+#endif // HC_FMINDEX_H
+
+#ifdef HC_FMINDEX_IMPL
+
+/* Private definitions */
+
+#define HC_FMINDEX_EMPTY UINT32_MAX
+#define HC_FMINDEX_BYTE_ORDER 0x01020304u
+
+static const char hc_fmindex_magic[8] = { 'H', 'C', 'F', 'M', 'I', 'D', 'X', '1' };
+
+/* SA-IS construction */
+
+/*
+ * Level 0 reads the text bytes shifted by one and followed by a virtual
+ * sentinel 0, so that the text may contain any byte without being copied.
+ * Deeper levels read the reduced strings, stored as 32-bit names whose last
+ * one (the sentinel LMS substring) is the unique smallest.
+ */
+static inline uint32_t hc_fmindex_chr(const void* s, uint32_t n, int level, uint32_t i)
+{
+    if (level == 0) {
+        return (i + 1 == n) ? 0 : ((const uint8_t*)s)[i] + 1u;
+    }
+    return ((const uint32_t*)s)[i];
+}
+
+#define HC_FMINDEX_TGET(i) ((t[(i) >> 3] >> ((i) & 7)) & 1)
+#define HC_FMINDEX_TSET(i, b) (t[(i) >> 3] = (uint8_t)((b) ? t[(i) >> 3] | (1 << ((i) & 7)) : t[(i) >> 3] & ~(1 << ((i) & 7))))
+#define HC_FMINDEX_ISLMS(i) ((i) > 0 && HC_FMINDEX_TGET(i) && !HC_FMINDEX_TGET((i) - 1))
+
+static void hc_fmindex_buckets(const void* s, uint32_t n, int level, uint32_t* bkt, uint32_t k, bool end)
+{
+    memset(bkt, 0, k * sizeof(uint32_t));
+    for (uint32_t i = 0; i < n; i++) {
+        bkt[hc_fmindex_chr(s, n, level, i)]++;
+    }
+
+    uint32_t sum = 0;
+    for (uint32_t c = 0; c < k; c++) {
+        sum += bkt[c];
+        bkt[c] = end ? sum : sum - bkt[c];
+    }
+}
+
+static void hc_fmindex_induce(const uint8_t* t, uint32_t* sa, const void* s, uint32_t n, int level, uint32_t* bkt, uint32_t k)
+{
+    // L-type suffixes, from the bucket starts
+    hc_fmindex_buckets(s, n, level, bkt, k, false);
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t j = sa[i];
+        if (j != HC_FMINDEX_EMPTY && j > 0 && !HC_FMINDEX_TGET(j - 1)) {
+            sa[bkt[hc_fmindex_chr(s, n, level, j - 1)]++] = j - 1;
+        }
+    }
+
+    // S-type suffixes, from the bucket ends
+    hc_fmindex_buckets(s, n, level, bkt, k, true);
+    for (uint32_t i = n; i-- > 0;) {
+        uint32_t j = sa[i];
+        if (j != HC_FMINDEX_EMPTY && j > 0 && HC_FMINDEX_TGET(j - 1)) {
+            sa[--bkt[hc_fmindex_chr(s, n, level, j - 1)]] = j - 1;
+        }
+    }
+}
+
+static bool hc_fmindex_sais(const void* s, uint32_t* sa, uint32_t n, uint32_t k, int level)
+{
+    if (n == 1) {
+        sa[0] = 0;
+        return true;
+    }
+
+    uint8_t *t = HC_CALLOC(n / 8 + 1, 1);
+    uint32_t *bkt = HC_MALLOC(k * sizeof(uint32_t));
+
+    if (!t || !bkt) {
+        HC_FREE(t);
+        HC_FREE(bkt);
+        return false;
+    }
+
+    // Classify the suffixes as S-type (1) or L-type (0)
+    HC_FMINDEX_TSET(n - 1, 1);
+    HC_FMINDEX_TSET(n - 2, 0);
+    for (uint32_t i = n - 2; i-- > 0;) {
+        uint32_t a = hc_fmindex_chr(s, n, level, i);
+        uint32_t b = hc_fmindex_chr(s, n, level, i + 1);
+        HC_FMINDEX_TSET(i, a < b || (a == b && HC_FMINDEX_TGET(i + 1)));
+    }
+
+    // Stage 1: sort the LMS substrings
+    hc_fmindex_buckets(s, n, level, bkt, k, true);
+    for (uint32_t i = 0; i < n; i++) sa[i] = HC_FMINDEX_EMPTY;
+    for (uint32_t i = 1; i < n; i++) {
+        if (HC_FMINDEX_ISLMS(i)) sa[--bkt[hc_fmindex_chr(s, n, level, i)]] = i;
+    }
+    hc_fmindex_induce(t, sa, s, n, level, bkt, k);
+
+    uint32_t n1 = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (HC_FMINDEX_ISLMS(sa[i])) sa[n1++] = sa[i];
+    }
+
+    // Name the LMS substrings, equal substrings get the same name
+    for (uint32_t i = n1; i < n; i++) sa[i] = HC_FMINDEX_EMPTY;
+
+    uint32_t name = 0;
+    uint32_t prev = HC_FMINDEX_EMPTY;
+
+    for (uint32_t i = 0; i < n1; i++) {
+        uint32_t pos = sa[i];
+        bool diff = false;
+        for (uint32_t d = 0; d < n; d++) {
+            if (prev == HC_FMINDEX_EMPTY
+                || hc_fmindex_chr(s, n, level, pos + d) != hc_fmindex_chr(s, n, level, prev + d)
+                || HC_FMINDEX_TGET(pos + d) != HC_FMINDEX_TGET(prev + d)) {
+                diff = true;
+                break;
+            }
+            if (d > 0 && (HC_FMINDEX_ISLMS(pos + d) || HC_FMINDEX_ISLMS(prev + d))) {
+                break;
+            }
+        }
+        if (diff) {
+            name++;
+            prev = pos;
+        }
+        sa[n1 + pos / 2] = name - 1;
+    }
+
+    for (uint32_t i = n, j = n; i-- > n1;) {
+        if (sa[i] != HC_FMINDEX_EMPTY) sa[--j] = sa[i];
+    }
+
+    // Stage 2: sort the reduced string, recursively if names are not unique
+    uint32_t *sa1 = sa;
+    uint32_t *s1 = sa + n - n1;
+
+    if (name < n1) {
+        if (!hc_fmindex_sais(s1, sa1, n1, name, level + 1)) {
+            HC_FREE(t);
+            HC_FREE(bkt);
+            return false;
+        }
+    }
+    else {
+        for (uint32_t i = 0; i < n1; i++) sa1[s1[i]] = i;
+    }
+
+    // Stage 3: induce the whole suffix array from the sorted LMS suffixes
+    for (uint32_t i = 1, j = 0; i < n; i++) {
+        if (HC_FMINDEX_ISLMS(i)) s1[j++] = i;
+    }
+    for (uint32_t i = 0; i < n1; i++) {
+        sa1[i] = s1[sa1[i]];
+    }
+    for (uint32_t i = n1; i < n; i++) sa[i] = HC_FMINDEX_EMPTY;
+
+    hc_fmindex_buckets(s, n, level, bkt, k, true);
+    for (uint32_t i = n1; i-- > 0;) {
+        uint32_t j = sa[i];
+        sa[i] = HC_FMINDEX_EMPTY;
+        sa[--bkt[hc_fmindex_chr(s, n, level, j)]] = j;
+    }
+    hc_fmindex_induce(t, sa, s, n, level, bkt, k);
+
+    HC_FREE(t);
+    HC_FREE(bkt);
+
+    return true;
+}
+
+#undef HC_FMINDEX_TGET
+#undef HC_FMINDEX_TSET
+#undef HC_FMINDEX_ISLMS
+
+/* Index layout */
+
+static size_t hc_fmindex_align8(size_t x)
+{
+    return (x + 7) & ~(size_t)7;
+}
+
+/* Computes the offsets of the arrays following the header, returns the block size */
+static size_t hc_fmindex_layout(const hc_fmindex_header_t* h, size_t offsets[5])
+{
+    size_t occ_blocks = (size_t)(h->rows / h->occ_rate) + 1;
+    size_t words = (size_t)(h->rows / 64) + 1;
+    size_t size = sizeof(hc_fmindex_header_t);
+
+    offsets[0] = size; size = hc_fmindex_align8(size + occ_blocks * h->sigma * sizeof(uint32_t));
+    offsets[1] = size; size = hc_fmindex_align8(size + words * sizeof(uint64_t));
+    offsets[2] = size; size = hc_fmindex_align8(size + (words / 8 + 1) * sizeof(uint32_t));
+    offsets[3] = size; size = hc_fmindex_align8(size + (size_t)h->sample_count * sizeof(uint32_t));
+    offsets[4] = size; size = hc_fmindex_align8(size + (size_t)h->rows);
+
+    return size;
+}
+
+static void hc_fmindex_attach(hc_fmindex_t* index, const void* data)
+{
+    const hc_fmindex_header_t *h = (const hc_fmindex_header_t*)data;
+    const uint8_t *base = (const uint8_t*)data;
+    size_t offsets[5];
+
+    hc_fmindex_layout(h, offsets);
+
+    index->header = h;
+    index->occ = (const uint32_t*)(base + offsets[0]);
+    index->sampled = (const uint64_t*)(base + offsets[1]);
+    index->sampled_rank = (const uint32_t*)(base + offsets[2]);
+    index->positions = (const uint32_t*)(base + offsets[3]);
+    index->bwt = base + offsets[4];
+}
+
+/* Queries */
+
+/* Counts the bytes 'c' in 'src[0..length)' */
+static size_t hc_fmindex_count_byte(const uint8_t* src, size_t length, uint8_t c)
+{
+    size_t count = 0;
+    size_t i = 0;
+
+#if defined(HC_FMINDEX_AVX2)
+    const __m256i c32 = _mm256_set1_epi8((char)c);
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        count += hc_fmindex_popcount32((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, c32)));
+    }
+#endif
+
+#if defined(HC_FMINDEX_SSE2)
+    const __m128i c16 = _mm_set1_epi8((char)c);
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        count += hc_fmindex_popcount32((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, c16)));
+    }
+#endif
+
+    for (; i < length; i++) {
+        count += (src[i] == c);
+    }
+
+    return count;
+}
+
+/* Occurrences of byte 'c' in the BWT rows [lo, hi), excluding the sentinel */
+static size_t hc_fmindex_count_range(const hc_fmindex_t* index, uint8_t c, size_t lo, size_t hi)
+{
+    size_t count = hc_fmindex_count_byte(index->bwt + lo, hi - lo, c);
+    size_t primary = (size_t)index->header->primary;
+
+    if (primary >= lo && primary < hi && index->bwt[primary] == c) {
+        count--;
+    }
+
+    return count;
+}
+
+/* Occurrences of byte 'c' (present in the text) in the BWT rows [0, row) */
+static size_t hc_fmindex_occ(const hc_fmindex_t* index, uint8_t c, size_t row)
+{
+    const hc_fmindex_header_t *h = index->header;
+    const uint32_t *occ = index->occ + h->symbols[c];
+
+    size_t rate = h->occ_rate;
+    size_t block = row / rate;
+    size_t base = block * rate;
+
+    // Scan from the closest sample, backward from the next one if needed
+    if (row - base > rate / 2 && base + rate <= h->rows) {
+        return occ[(block + 1) * h->sigma] - hc_fmindex_count_range(index, c, row, base + rate);
+    }
+
+    return occ[block * h->sigma] + hc_fmindex_count_range(index, c, base, row);
+}
+
+/* Rows of the suffixes prefixed by 'pattern', as [*sp, *ep) */
+static bool hc_fmindex_range(const hc_fmindex_t* index, const uint8_t* pattern, size_t length, size_t* sp, size_t* ep)
+{
+    const hc_fmindex_header_t *h = index->header;
+
+    size_t lo = 0;
+    size_t hi = (size_t)h->rows;
+
+    for (size_t i = length; i-- > 0;) {
+        uint8_t c = pattern[i];
+        if (h->C[c] == h->C[c + 1]) {
+            return false;
+        }
+        lo = (size_t)h->C[c] + hc_fmindex_occ(index, c, lo);
+        hi = (size_t)h->C[c] + hc_fmindex_occ(index, c, hi);
+        if (lo >= hi) {
+            return false;
+        }
+    }
+
+    *sp = lo;
+    *ep = hi;
+
+    return true;
+}
+
+static bool hc_fmindex_is_sampled(const hc_fmindex_t* index, size_t row)
+{
+    return (index->sampled[row / 64] >> (row % 64)) & 1;
+}
+
+static size_t hc_fmindex_rank(const hc_fmindex_t* index, size_t row)
+{
+    size_t word = row / 64;
+    size_t rank = index->sampled_rank[row / 512];
+
+    for (size_t w = (row / 512) * 8; w < word; w++) {
+        rank += hc_fmindex_popcount64(index->sampled[w]);
+    }
+
+    uint64_t mask = ((uint64_t)1 << (row % 64)) - 1;
+    return rank + hc_fmindex_popcount64(index->sampled[word] & mask);
+}
+
+/* Text position of the suffix at 'row', walking the LF mapping up to a sampled row */
+static size_t hc_fmindex_position(const hc_fmindex_t* index, size_t row)
+{
+    const hc_fmindex_header_t *h = index->header;
+    size_t steps = 0;
+
+    // The primary row is position 0, always sampled, so the walk never crosses the sentinel
+    while (!hc_fmindex_is_sampled(index, row)) {
+        uint8_t c = index->bwt[row];
+        row = (size_t)h->C[c] + hc_fmindex_occ(index, c, row);
+        steps++;
+    }
+
+    return index->positions[hc_fmindex_rank(index, row)] + steps;
+}
+
+/* Public API */
+
+int hc_fmindex_suffix_array(const char* text, size_t length, uint32_t* sa)
+{
+    if (length >= (size_t)UINT32_MAX - 1) {
+        return HC_FMINDEX_ERROR_TOO_LARGE;
+    }
+
+    if (!hc_fmindex_sais(text, sa, (uint32_t)length + 1, 257, 0)) {
+        return HC_FMINDEX_ERROR_OUT_OF_MEMORY;
+    }
+
+    return HC_FMINDEX_SUCCESS;
+}
+
+int hc_fmindex_build(hc_fmindex_t* index, const char* text, size_t length)
+{
+    memset(index, 0, sizeof(*index));
+
+    if (length >= (size_t)UINT32_MAX - 1) {
+        return HC_FMINDEX_ERROR_TOO_LARGE;
+    }
+
+    size_t rows = length + 1;
+    uint32_t *sa = HC_MALLOC(rows * sizeof(uint32_t));
+    if (!sa) {
+        return HC_FMINDEX_ERROR_OUT_OF_MEMORY;
+    }
+
+    int ret = hc_fmindex_suffix_array(text, length, sa);
+    if (ret != HC_FMINDEX_SUCCESS) {
+        HC_FREE(sa);
+        return ret;
+    }
+
+    hc_fmindex_header_t h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, hc_fmindex_magic, sizeof(h.magic));
+    h.byte_order = HC_FMINDEX_BYTE_ORDER;
+    h.occ_rate = HC_FMINDEX_OCC_RATE;
+    h.sa_rate = HC_FMINDEX_SA_RATE;
+    h.rows = rows;
+    h.sample_count = length / HC_FMINDEX_SA_RATE + 1;
+
+    // Byte frequencies give the symbols and the C array (row 0 is the empty suffix)
+    uint64_t freq[256] = { 0 };
+    for (size_t i = 0; i < length; i++) {
+        freq[(uint8_t)text[i]]++;
+    }
+
+    h.C[0] = 1;
+    for (int c = 0; c < 256; c++) {
+        h.C[c + 1] = h.C[c] + freq[c];
+        h.symbols[c] = (uint8_t)h.sigma;
+        if (freq[c] > 0) h.sigma++;
+    }
+
+    size_t offsets[5];
+    h.size = hc_fmindex_layout(&h, offsets);
+
+    uint8_t *block = HC_CALLOC(1, (size_t)h.size);
+    if (!block) {
+        HC_FREE(sa);
+        return HC_FMINDEX_ERROR_OUT_OF_MEMORY;
+    }
+
+    uint32_t *occ = (uint32_t*)(block + offsets[0]);
+    uint64_t *sampled = (uint64_t*)(block + offsets[1]);
+    uint32_t *sampled_rank = (uint32_t*)(block + offsets[2]);
+    uint32_t *positions = (uint32_t*)(block + offsets[3]);
+    uint8_t *bwt = block + offsets[4];
+
+    uint32_t running[256] = { 0 };
+    size_t sample = 0;
+
+    for (size_t row = 0; row < rows; row++) {
+        if (row % h.occ_rate == 0) {
+            memcpy(occ + (row / h.occ_rate) * h.sigma, running, h.sigma * sizeof(uint32_t));
+        }
+
+        uint32_t pos = sa[row];
+        if (pos == 0) {
+            h.primary = row;
+            bwt[row] = 0;
+        }
+        else {
+            uint8_t c = (uint8_t)text[pos - 1];
+            running[h.symbols[c]]++;
+            bwt[row] = c;
+        }
+
+        if (pos % h.sa_rate == 0) {
+            sampled[row / 64] |= (uint64_t)1 << (row % 64);
+            positions[sample++] = pos;
+        }
+    }
+
+    if (rows % h.occ_rate == 0) {
+        memcpy(occ + (rows / h.occ_rate) * h.sigma, running, h.sigma * sizeof(uint32_t));
+    }
+
+    size_t words = rows / 64 + 1;
+    uint32_t rank = 0;
+    for (size_t w = 0; w < words; w++) {
+        if (w % 8 == 0) sampled_rank[w / 8] = rank;
+        rank += hc_fmindex_popcount64(sampled[w]);
+    }
+
+    memcpy(block, &h, sizeof(h));
+    HC_FREE(sa);
+
+    hc_fmindex_attach(index, block);
+    index->memory = block;
+
+    return HC_FMINDEX_SUCCESS;
+}
+
+void hc_fmindex_destroy(hc_fmindex_t* index)
+{
+    HC_FREE(index->memory);
+    memset(index, 0, sizeof(*index));
+}
+
+size_t hc_fmindex_count(const hc_fmindex_t* index, const char* pattern, size_t length)
+{
+    size_t sp, ep;
+
+    if (!index->header || length == 0) {
+        return 0;
+    }
+
+    if (!hc_fmindex_range(index, (const uint8_t*)pattern, length, &sp, &ep)) {
+        return 0;
+    }
+
+    return ep - sp;
+}
+
+size_t hc_fmindex_locate(const hc_fmindex_t* index, const char* pattern, size_t length, size_t* positions, size_t max_positions)
+{
+    size_t sp, ep;
+
+    if (!index->header || length == 0) {
+        return 0;
+    }
+
+    if (!hc_fmindex_range(index, (const uint8_t*)pattern, length, &sp, &ep)) {
+        return 0;
+    }
+
+    // Positions are written in suffix order, not in text order
+    for (size_t row = sp; row < ep && row - sp < max_positions; row++) {
+        positions[row - sp] = hc_fmindex_position(index, row);
+    }
+
+    return ep - sp;
+}
+
+size_t hc_fmindex_size(const hc_fmindex_t* index)
+{
+    return index->header ? (size_t)index->header->size : 0;
+}
+
+const void* hc_fmindex_data(const hc_fmindex_t* index)
+{
+    return index->header;
+}
+
+int hc_fmindex_save(const hc_fmindex_t* index, const char* path)
+{
+    if (!index->header) {
+        return HC_FMINDEX_ERROR_INVALID_DATA;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        return HC_FMINDEX_ERROR_IO;
+    }
+
+    size_t size = (size_t)index->header->size;
+    size_t written = fwrite(index->header, 1, size, file);
+
+    if (fclose(file) != 0 || written != size) {
+        return HC_FMINDEX_ERROR_IO;
+    }
+
+    return HC_FMINDEX_SUCCESS;
+}
+
+int hc_fmindex_load(hc_fmindex_t* index, const void* data, size_t size)
+{
+    memset(index, 0, sizeof(*index));
+
+    // The data must stay valid (and 8-byte aligned) while the index is used
+    if (!data || ((uintptr_t)data & 7) || size < sizeof(hc_fmindex_header_t)) {
+        return HC_FMINDEX_ERROR_INVALID_DATA;
+    }
+
+    const hc_fmindex_header_t *h = (const hc_fmindex_header_t*)data;
+
+    if (memcmp(h->magic, hc_fmindex_magic, sizeof(h->magic)) != 0
+        || h->byte_order != HC_FMINDEX_BYTE_ORDER
+        || h->occ_rate == 0 || h->sa_rate == 0 || h->sigma > 256
+        || h->rows == 0 || h->rows >= UINT32_MAX
+        || h->primary >= h->rows || h->sample_count > h->rows
+        || h->C[256] != h->rows) {
+        return HC_FMINDEX_ERROR_INVALID_DATA;
+    }
+
+    for (int c = 0; c < 256; c++) {
+        if (h->C[c + 1] < h->C[c] || (h->C[c + 1] > h->C[c] && h->symbols[c] >= h->sigma)) {
+            return HC_FMINDEX_ERROR_INVALID_DATA;
+        }
+    }
+
+    size_t offsets[5];
+    if (h->size != size || hc_fmindex_layout(h, offsets) != size) {
+        return HC_FMINDEX_ERROR_INVALID_DATA;
+    }
+
+    hc_fmindex_attach(index, data);
+
+    return HC_FMINDEX_SUCCESS;
+}
+
+int hc_fmindex_load_file(hc_fmindex_t* index, const char* path)
+{
+    memset(index, 0, sizeof(*index));
+
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return HC_FMINDEX_ERROR_IO;
+    }
+
+    hc_fmindex_header_t h;
+    if (fread(&h, sizeof(h), 1, file) != 1 || h.size < sizeof(h) || h.size > (uint64_t)SIZE_MAX) {
+        fclose(file);
+        return HC_FMINDEX_ERROR_INVALID_DATA;
+    }
+
+    uint8_t *block = HC_MALLOC((size_t)h.size);
+    if (!block) {
+        fclose(file);
+        return HC_FMINDEX_ERROR_OUT_OF_MEMORY;
+    }
+
+    memcpy(block, &h, sizeof(h));
+    size_t rest = (size_t)h.size - sizeof(h);
+
+    if (fread(block + sizeof(h), 1, rest, file) != rest) {
+        fclose(file);
+        HC_FREE(block);
+        return HC_FMINDEX_ERROR_IO;
+    }
+
+    fclose(file);
+
+    int ret = hc_fmindex_load(index, block, (size_t)h.size);
+    if (ret != HC_FMINDEX_SUCCESS) {
+        HC_FREE(block);
+        return ret;
+    }
+
+    index->memory = block;
+
+    return HC_FMINDEX_SUCCESS;
+}
+
+#endif // HC_FMINDEX_IMPL
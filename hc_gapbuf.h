@@ -0,0 +1,309 @@
+/**
+ * MIT License
+ * 
+ * Copyright (c) 2024-2025 Le Juez Victor
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+ * Gap buffer for cursor-local text editing.
+ *
+ * The text is stored in a single allocation split in two by a gap located
+ * at the cursor. Inserting or deleting at the cursor only touches the gap
+ * (amortized O(1)), and moving the cursor only moves the bytes between the
+ * old and new positions. The two halves can be read in place through
+ * hc_gapbuf_halves, without building a contiguous copy.
+ */
+
+#ifndef HC_GAPBUF_H
+#define HC_GAPBUF_H
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Macros and defintions */
+
+#ifndef HC_MALLOC
+#   define HC_MALLOC(sz) malloc(sz)
+#endif
+
+#ifndef HC_REALLOC
+#   define HC_REALLOC(ptr, new_sz) realloc(ptr, new_sz)
+#endif
+
+#ifndef HC_FREE
+#   define HC_FREE(ptr) free(ptr)
+#endif
+
+#ifndef HC_GAPBUF_MIN_GAP
+#   define HC_GAPBUF_MIN_GAP 64        // Minimal gap left after the buffer grows
+#endif
+
+/* Types definitions */
+
+enum hc_retcode_gapbuf {
+    HC_GAPBUF_ERROR_OUT_OF_MEMORY   = -1,
+    HC_GAPBUF_SUCCESS               = 0
+};
+
+typedef struct {
+    char *data;             // Text before the gap, gap, then text after the gap
+    size_t gap_start;       // Cursor position, length of the text before the gap
+    size_t gap_end;         // Offset of the text after the gap
+    size_t capacity;        // Total size of 'data' (in bytes)
+} hc_gapbuf_t;
+
+typedef struct {
+    const char *data;
+    size_t length;
+} hc_gapbuf_span_t;
+
+/* Function declarations */
+
+hc_gapbuf_t hc_gapbuf_create(size_t capacity);
+hc_gapbuf_t hc_gapbuf_create_from(const char* text, size_t length);
+void hc_gapbuf_destroy(hc_gapbuf_t* buf);
+size_t hc_gapbuf_length(const hc_gapbuf_t* buf);
+size_t hc_gapbuf_cursor(const hc_gapbuf_t* buf);
+int hc_gapbuf_reserve(hc_gapbuf_t* buf, size_t gap_size);
+void hc_gapbuf_move_to(hc_gapbuf_t* buf, size_t position);
+void hc_gapbuf_move_by(hc_gapbuf_t* buf, long long offset);
+int hc_gapbuf_insert(hc_gapbuf_t* buf, const char* text, size_t length);
+int hc_gapbuf_insert_char(hc_gapbuf_t* buf, char c);
+size_t hc_gapbuf_delete_backward(hc_gapbuf_t* buf, size_t count);
+size_t hc_gapbuf_delete_forward(hc_gapbuf_t* buf, size_t count);
+char hc_gapbuf_at(const hc_gapbuf_t* buf, size_t index);
+void hc_gapbuf_halves(const hc_gapbuf_t* buf, hc_gapbuf_span_t* before, hc_gapbuf_span_t* after);
+size_t hc_gapbuf_copy(const hc_gapbuf_t* buf, size_t start, size_t length, char* dst);
+const char* hc_gapbuf_flatten(hc_gapbuf_t* buf);
+
+#endif // HC_GAPBUF_H
+
+#ifdef HC_GAPBUF_IMPL
+
+hc_gapbuf_t hc_gapbuf_create(size_t capacity)
+{
+    hc_gapbuf_t buf = { 0 };
+
+    if (capacity == 0) {
+        capacity = HC_GAPBUF_MIN_GAP;
+    }
+
+    char *data = HC_MALLOC(capacity);
+    if (!data) return buf;
+
+    buf.data = data;
+    buf.gap_end = capacity;
+    buf.capacity = capacity;
+
+    return buf;
+}
+
+hc_gapbuf_t hc_gapbuf_create_from(const char* text, size_t length)
+{
+    hc_gapbuf_t buf = hc_gapbuf_create(length + HC_GAPBUF_MIN_GAP);
+    if (!buf.data) return buf;
+
+    // The cursor starts at the end of the text
+    if (length > 0) memcpy(buf.data, text, length);
+    buf.gap_start = length;
+
+    return buf;
+}
+
+void hc_gapbuf_destroy(hc_gapbuf_t* buf)
+{
+    if (buf->data) {
+        HC_FREE(buf->data);
+        buf->data = NULL;
+    }
+    buf->gap_start = 0;
+    buf->gap_end = 0;
+    buf->capacity = 0;
+}
+
+size_t hc_gapbuf_length(const hc_gapbuf_t* buf)
+{
+    return buf->capacity - (buf->gap_end - buf->gap_start);
+}
+
+size_t hc_gapbuf_cursor(const hc_gapbuf_t* buf)
+{
+    return buf->gap_start;
+}
+
+int hc_gapbuf_reserve(hc_gapbuf_t* buf, size_t gap_size)
+{
+    size_t gap = buf->gap_end - buf->gap_start;
+    if (gap >= gap_size) {
+        return HC_GAPBUF_SUCCESS;
+    }
+
+    // Geometric growth keeps a sequence of insertions amortized O(1)
+    size_t after = buf->capacity - buf->gap_end;
+    size_t needed = buf->capacity - gap + gap_size;
+    size_t new_capacity = buf->capacity * 2;
+    if (new_capacity < needed + HC_GAPBUF_MIN_GAP) {
+        new_capacity = needed + HC_GAPBUF_MIN_GAP;
+    }
+
+    char *new_data = HC_REALLOC(buf->data, new_capacity);
+    if (!new_data) {
+        return HC_GAPBUF_ERROR_OUT_OF_MEMORY;
+    }
+
+    // Only the text after the gap moves, to the end of the new allocation
+    memmove(new_data + new_capacity - after, new_data + buf->gap_end, after);
+
+    buf->data = new_data;
+    buf->gap_end = new_capacity - after;
+    buf->capacity = new_capacity;
+
+    return HC_GAPBUF_SUCCESS;
+}
+
+void hc_gapbuf_move_to(hc_gapbuf_t* buf, size_t position)
+{
+    size_t length = hc_gapbuf_length(buf);
+    if (position > length) position = length;
+
+    if (position < buf->gap_start) {
+        size_t count = buf->gap_start - position;
+        memmove(buf->data + buf->gap_end - count, buf->data + position, count);
+        buf->gap_start -= count;
+        buf->gap_end -= count;
+    }
+    else if (position > buf->gap_start) {
+        size_t count = position - buf->gap_start;
+        memmove(buf->data + buf->gap_start, buf->data + buf->gap_end, count);
+        buf->gap_start += count;
+        buf->gap_end += count;
+    }
+}
+
+void hc_gapbuf_move_by(hc_gapbuf_t* buf, long long offset)
+{
+    if (offset < 0) {
+        size_t back = (size_t)(-(offset + 1)) + 1;
+        hc_gapbuf_move_to(buf, back > buf->gap_start ? 0 : buf->gap_start - back);
+    }
+    else {
+        hc_gapbuf_move_to(buf, buf->gap_start + (size_t)offset);
+    }
+}
+
+int hc_gapbuf_insert(hc_gapbuf_t* buf, const char* text, size_t length)
+{
+    int ret = hc_gapbuf_reserve(buf, length);
+    if (ret < 0) return ret;
+
+    memcpy(buf->data + buf->gap_start, text, length);
+    buf->gap_start += length;
+
+    return HC_GAPBUF_SUCCESS;
+}
+
+int hc_gapbuf_insert_char(hc_gapbuf_t* buf, char c)
+{
+    if (buf->gap_start == buf->gap_end) {
+        int ret = hc_gapbuf_reserve(buf, 1);
+        if (ret < 0) return ret;
+    }
+
+    buf->data[buf->gap_start++] = c;
+
+    return HC_GAPBUF_SUCCESS;
+}
+
+size_t hc_gapbuf_delete_backward(hc_gapbuf_t* buf, size_t count)
+{
+    if (count > buf->gap_start) count = buf->gap_start;
+    buf->gap_start -= count;
+    return count;
+}
+
+size_t hc_gapbuf_delete_forward(hc_gapbuf_t* buf, size_t count)
+{
+    size_t after = buf->capacity - buf->gap_end;
+    if (count > after) count = after;
+    buf->gap_end += count;
+    return count;
+}
+
+char hc_gapbuf_at(const hc_gapbuf_t* buf, size_t index)
+{
+    if (index < buf->gap_start) {
+        return buf->data[index];
+    }
+    return buf->data[index + (buf->gap_end - buf->gap_start)];
+}
+
+void hc_gapbuf_halves(const hc_gapbuf_t* buf, hc_gapbuf_span_t* before, hc_gapbuf_span_t* after)
+{
+    if (before) {
+        before->data = buf->data;
+        before->length = buf->gap_start;
+    }
+    if (after) {
+        after->data = buf->data + buf->gap_end;
+        after->length = buf->capacity - buf->gap_end;
+    }
+}
+
+size_t hc_gapbuf_copy(const hc_gapbuf_t* buf, size_t start, size_t length, char* dst)
+{
+    size_t total = hc_gapbuf_length(buf);
+    if (start >= total) return 0;
+    if (length > total - start) length = total - start;
+
+    size_t copied = 0;
+
+    if (start < buf->gap_start) {
+        size_t n = buf->gap_start - start;
+        if (n > length) n = length;
+        memcpy(dst, buf->data + start, n);
+        copied = n;
+    }
+
+    if (copied < length) {
+        size_t offset = start + copied - buf->gap_start;
+        memcpy(dst + copied, buf->data + buf->gap_end + offset, length - copied);
+    }
+
+    return length;
+}
+
+const char* hc_gapbuf_flatten(hc_gapbuf_t* buf)
+{
+    // Moves the gap to the end, then uses its first byte for the null terminator
+    if (hc_gapbuf_reserve(buf, 1) < 0) {
+        return NULL;
+    }
+
+    hc_gapbuf_move_to(buf, hc_gapbuf_length(buf));
+    buf->data[buf->gap_start] = '\0';
+
+    return buf->data;
+}
+
+#endif // HC_GAPBUF_IMPL
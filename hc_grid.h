@@ -0,0 +1,547 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2024-2025 Le Juez Victor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Uniform spatial hash grid over 3D points, for neighbor queries.
+ *
+ * Points are binned into cubic cells whose coordinates are hashed into a
+ * table with as many buckets as points (rounded up to a power of two). The
+ * build is a counting sort: the points are stored bucket by bucket, so the
+ * queries read contiguous memory, and a grid can be rebuilt every frame
+ * without reallocating as long as the point count doesn't grow.
+ *
+ * The points are arrays of hc_vec3_t (x, y, z packed). The queries return
+ * indices into that array, in a deterministic order.
+ *
+ * NOTE: The cell size should be close to the usual query radius: a radius
+ * query then reads 27 cells at most, making a neighbor search over all the
+ * points linear in their number (for a bounded density).
+ */
+
+#ifndef HC_GRID_H
+#define HC_GRID_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+/* Macros and defintions */
+
+#ifndef HC_MALLOC
+#   define HC_MALLOC(sz) malloc(sz)
+#endif
+
+#ifndef HC_CALLOC
+#   define HC_CALLOC(nb, sz) calloc(nb, sz)
+#endif
+
+#ifndef HC_REALLOC
+#   define HC_REALLOC(ptr, new_sz) realloc(ptr, new_sz)
+#endif
+
+#ifndef HC_FREE
+#   define HC_FREE(ptr) free(ptr)
+#endif
+
+/* Multi-threading (used by the build and hc_grid_neighbors when compiled with OpenMP) */
+
+#ifdef _OPENMP
+#   include <omp.h>
+#endif
+
+/* Types definitions */
+
+enum hc_retcode_grid {
+    HC_GRID_ERROR_OUT_OF_MEMORY     = -2,
+    HC_GRID_ERROR_INVALID           = -1,
+    HC_GRID_SUCCESS                 = 0
+};
+
+typedef struct {
+    float cell_size;
+    float inv_cell_size;
+    uint32_t count;         // Points of the last build
+    uint32_t capacity;      // Points the buffers can hold without reallocating
+    uint32_t table_mask;    // Bucket count minus one
+    uint32_t *cell_start;   // First sorted point of each bucket, plus the point count at the end
+    uint32_t *indices;      // Index of each sorted point in the input array
+    float *points;          // Positions of the sorted points (x, y, z)
+    uint32_t *keys;         // Bucket of each input point (build scratch)
+    int32_t cell_min[3];    // Range of the occupied cells
+    int32_t cell_max[3];
+} hc_grid_t;
+
+/* Function declarations */
+
+hc_grid_t hc_grid_create(float cell_size);
+void hc_grid_destroy(hc_grid_t* grid);
+int hc_grid_build(hc_grid_t* grid, const float* points, uint32_t count, int num_threads);
+size_t hc_grid_query_radius(const hc_grid_t* grid, const float center[3], float radius, uint32_t* indices, size_t max_indices);
+size_t hc_grid_query_knn(const hc_grid_t* grid, const float center[3], float max_radius, uint32_t* indices, float* distances, size_t k);
+int hc_grid_neighbors(const hc_grid_t* grid, float radius, uint32_t** offsets, uint32_t** neighbors, int num_threads);
+
+#endif // HC_GRID_H
+
+#ifdef HC_GRID_IMPL
+
+/* Private definitions */
+
+#define HC_GRID_CELL_LIMIT (1 << 30)    // Cell coordinates are clamped to stay far from overflows
+
+static inline int32_t hc_grid_coord(const hc_grid_t* grid, float x)
+{
+    float c = x * grid->inv_cell_size;
+    if (!(c > -HC_GRID_CELL_LIMIT)) return -HC_GRID_CELL_LIMIT;    // NaN lands here too
+    if (c > HC_GRID_CELL_LIMIT) return HC_GRID_CELL_LIMIT;
+
+    // Floor without the libm call (floorf isn't inlined without SSE4.1)
+    int32_t i = (int32_t)c;
+    return i - (c < (float)i);
+}
+
+/* Only y and z are hashed: cells following each other on x get consecutive buckets, read in one run */
+static inline uint32_t hc_grid_hash(const hc_grid_t* grid, int32_t x, int32_t y, int32_t z)
+{
+    uint32_t h = ((uint32_t)y * 73856093u) ^ ((uint32_t)z * 19349663u);
+    return ((h ^ (h >> 16)) + (uint32_t)x) & grid->table_mask;
+}
+
+#ifdef _OPENMP
+static int hc_grid_compare_u32(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+#endif
+
+static int hc_grid_reserve(hc_grid_t* grid, uint32_t count)
+{
+    uint32_t table_size = 1;
+    while (table_size < count) table_size <<= 1;
+
+    // The table is sized along with the capacity, so it's large enough for fewer points
+    if (count > grid->capacity || !grid->cell_start) {
+        uint32_t *cell_start = HC_REALLOC(grid->cell_start, ((size_t)table_size + 1) * sizeof(uint32_t));
+        if (!cell_start) return HC_GRID_ERROR_OUT_OF_MEMORY;
+        grid->cell_start = cell_start;
+    }
+
+    if (count > grid->capacity) {
+        uint32_t *indices = HC_REALLOC(grid->indices, (size_t)count * sizeof(uint32_t));
+        if (!indices) return HC_GRID_ERROR_OUT_OF_MEMORY;
+        grid->indices = indices;
+
+        uint32_t *keys = HC_REALLOC(grid->keys, (size_t)count * sizeof(uint32_t));
+        if (!keys) return HC_GRID_ERROR_OUT_OF_MEMORY;
+        grid->keys = keys;
+
+        float *points = HC_REALLOC(grid->points, 3 * (size_t)count * sizeof(float));
+        if (!points) return HC_GRID_ERROR_OUT_OF_MEMORY;
+        grid->points = points;
+
+        grid->capacity = count;
+    }
+
+    grid->table_mask = table_size - 1;
+    return HC_GRID_SUCCESS;
+}
+
+/*
+ * Visits the cell (x, y, z): the points of its bucket within 'radius2' of
+ * 'center' that really belong to that cell (buckets are shared by colliding
+ * cells) are written up to 'max_indices', all of them are counted.
+ */
+static inline size_t hc_grid_visit_cell(const hc_grid_t* grid, int32_t x, int32_t y, int32_t z,
+                                        const float* center, float radius2, uint32_t skip,
+                                        uint32_t* indices, size_t found, size_t max_indices)
+{
+    uint32_t bucket = hc_grid_hash(grid, x, y, z);
+    for (uint32_t j = grid->cell_start[bucket]; j < grid->cell_start[bucket + 1]; j++) {
+        const float *p = grid->points + 3 * (size_t)j;
+        float dx = p[0] - center[0], dy = p[1] - center[1], dz = p[2] - center[2];
+        if (dx * dx + dy * dy + dz * dz > radius2 || grid->indices[j] == skip) continue;
+        if (hc_grid_coord(grid, p[0]) != x || hc_grid_coord(grid, p[1]) != y || hc_grid_coord(grid, p[2]) != z) continue;
+
+        if (found < max_indices) indices[found] = grid->indices[j];
+        found++;
+    }
+    return found;
+}
+
+/* Radius query skipping the point 'skip' (UINT32_MAX for none) */
+static size_t hc_grid_gather(const hc_grid_t* grid, const float* center, float radius, uint32_t skip,
+                             uint32_t* indices, size_t max_indices)
+{
+    if (grid->count == 0 || !(radius >= 0.0f)) return 0;
+
+    float radius2 = radius * radius;
+    int32_t lo[3], hi[3];
+    uint64_t cells = 1;
+    for (int a = 0; a < 3; a++) {
+        lo[a] = hc_grid_coord(grid, center[a] - radius);
+        hi[a] = hc_grid_coord(grid, center[a] + radius);
+        if (lo[a] < grid->cell_min[a]) lo[a] = grid->cell_min[a];
+        if (hi[a] > grid->cell_max[a]) hi[a] = grid->cell_max[a];
+        if (lo[a] > hi[a]) return 0;
+        cells *= (uint64_t)((int64_t)hi[a] - lo[a] + 1);
+    }
+
+    size_t found = 0;
+
+    // Radius much larger than the cells: reading every point is cheaper
+    if (cells > grid->count) {
+        for (uint32_t j = 0; j < grid->count; j++) {
+            const float *p = grid->points + 3 * (size_t)j;
+            float dx = p[0] - center[0], dy = p[1] - center[1], dz = p[2] - center[2];
+            if (dx * dx + dy * dy + dz * dz > radius2 || grid->indices[j] == skip) continue;
+            if (found < max_indices) indices[found] = grid->indices[j];
+            found++;
+        }
+        return found;
+    }
+
+    for (int32_t z = lo[2]; z <= hi[2]; z++) {
+        for (int32_t y = lo[1]; y <= hi[1]; y++) {
+            for (int32_t x = lo[0]; x <= hi[0]; x++) {
+                found = hc_grid_visit_cell(grid, x, y, z, center, radius2, skip, indices, found, max_indices);
+            }
+        }
+    }
+    return found;
+}
+
+/* Inserts a candidate into the k nearest found so far, sorted by squared distance */
+static inline void hc_grid_knn_insert(uint32_t* indices, float* dist2, size_t* found, size_t k, uint32_t index, float d2)
+{
+    if (*found == k && d2 >= dist2[k - 1]) return;
+
+    size_t i = (*found < k) ? (*found)++ : k - 1;
+    while (i > 0 && dist2[i - 1] > d2) {
+        indices[i] = indices[i - 1];
+        dist2[i] = dist2[i - 1];
+        i--;
+    }
+    indices[i] = index;
+    dist2[i] = d2;
+}
+
+static inline void hc_grid_knn_cell(const hc_grid_t* grid, int32_t x, int32_t y, int32_t z, const float* center,
+                                    float max2, uint32_t* indices, float* dist2, size_t* found, size_t k)
+{
+    uint32_t bucket = hc_grid_hash(grid, x, y, z);
+    for (uint32_t j = grid->cell_start[bucket]; j < grid->cell_start[bucket + 1]; j++) {
+        const float *p = grid->points + 3 * (size_t)j;
+        float dx = p[0] - center[0], dy = p[1] - center[1], dz = p[2] - center[2];
+        float d2 = dx * dx + dy * dy + dz * dz;
+        if (d2 > max2) continue;
+        if (hc_grid_coord(grid, p[0]) != x || hc_grid_coord(grid, p[1]) != y || hc_grid_coord(grid, p[2]) != z) continue;
+        hc_grid_knn_insert(indices, dist2, found, k, grid->indices[j], d2);
+    }
+}
+
+/* Public functions */
+
+hc_grid_t hc_grid_create(float cell_size)
+{
+    hc_grid_t grid;
+    memset(&grid, 0, sizeof(hc_grid_t));
+    if (!(cell_size > 0.0f)) return grid;
+
+    grid.cell_size = cell_size;
+    grid.inv_cell_size = 1.0f / cell_size;
+    return grid;
+}
+
+void hc_grid_destroy(hc_grid_t* grid)
+{
+    if (!grid) return;
+    HC_FREE(grid->cell_start);
+    HC_FREE(grid->indices);
+    HC_FREE(grid->points);
+    HC_FREE(grid->keys);
+    memset(grid, 0, sizeof(hc_grid_t));
+}
+
+int hc_grid_build(hc_grid_t* grid, const float* points, uint32_t count, int num_threads)
+{
+    if (!grid || !(grid->cell_size > 0.0f) || (!points && count > 0)) {
+        return HC_GRID_ERROR_INVALID;
+    }
+
+    int ret = hc_grid_reserve(grid, count);
+    if (ret != HC_GRID_SUCCESS) return ret;
+
+#ifdef _OPENMP
+    int threads = num_threads > 0 ? num_threads : omp_get_max_threads();
+#else
+    (void)num_threads;
+#endif
+
+    uint32_t table_size = grid->table_mask + 1;
+    uint32_t *cell_start = grid->cell_start;
+    grid->count = count;
+
+    // Range of the occupied cells, which bounds the query loops
+    float min[3] = { HUGE_VALF, HUGE_VALF, HUGE_VALF }, max[3] = { -HUGE_VALF, -HUGE_VALF, -HUGE_VALF };
+    for (uint32_t i = 0; i < count; i++) {
+        for (int a = 0; a < 3; a++) {
+            float v = points[3 * (size_t)i + a];
+            min[a] = (v < min[a]) ? v : min[a];
+            max[a] = (v > max[a]) ? v : max[a];
+        }
+    }
+    for (int a = 0; a < 3; a++) {
+        grid->cell_min[a] = count ? hc_grid_coord(grid, min[a]) : 0;
+        grid->cell_max[a] = count ? hc_grid_coord(grid, max[a]) : -1;
+    }
+
+    // Counting sort of the points by bucket: histogram (shifted by one), then prefix sums
+    memset(cell_start, 0, ((size_t)table_size + 1) * sizeof(uint32_t));
+
+#ifdef _OPENMP
+#   pragma omp parallel for num_threads(threads)
+#endif
+    for (long long k = 0; k < (long long)count; k++) {
+        const float *p = points + 3 * (size_t)k;
+        uint32_t key = hc_grid_hash(grid, hc_grid_coord(grid, p[0]), hc_grid_coord(grid, p[1]), hc_grid_coord(grid, p[2]));
+        grid->keys[k] = key;
+#ifdef _OPENMP
+#       pragma omp atomic
+#endif
+        cell_start[key + 1]++;
+    }
+
+    for (uint32_t b = 0; b < table_size; b++) {
+        cell_start[b + 1] += cell_start[b];
+    }
+
+    // Scatter, moving each bucket start to its end (restored below)
+#ifdef _OPENMP
+    if (threads > 1) {
+#       pragma omp parallel for num_threads(threads)
+        for (long long k = 0; k < (long long)count; k++) {
+            uint32_t slot;
+#           pragma omp atomic capture
+            slot = cell_start[grid->keys[k]]++;
+            grid->indices[slot] = (uint32_t)k;
+        }
+    } else
+#endif
+    {
+        for (uint32_t i = 0; i < count; i++) {
+            grid->indices[cell_start[grid->keys[i]]++] = i;
+        }
+    }
+
+    memmove(cell_start + 1, cell_start, (size_t)table_size * sizeof(uint32_t));
+    cell_start[0] = 0;
+
+#ifdef _OPENMP
+    // The parallel scatter doesn't keep the input order within buckets, sort them back
+    if (threads > 1) {
+#       pragma omp parallel for schedule(dynamic, 1024) num_threads(threads)
+        for (long long b = 0; b < (long long)table_size; b++) {
+            uint32_t *begin = grid->indices + cell_start[b];
+            uint32_t n = cell_start[b + 1] - cell_start[b];
+            if (n > 16) {
+                qsort(begin, n, sizeof(uint32_t), hc_grid_compare_u32);
+                continue;
+            }
+            for (uint32_t i = 1; i < n; i++) {
+                uint32_t v = begin[i], j = i;
+                while (j > 0 && begin[j - 1] > v) {
+                    begin[j] = begin[j - 1];
+                    j--;
+                }
+                begin[j] = v;
+            }
+        }
+    }
+#endif
+
+    // Positions in sorted order, so that queries read each bucket contiguously
+#ifdef _OPENMP
+#   pragma omp parallel for num_threads(threads)
+#endif
+    for (long long k = 0; k < (long long)count; k++) {
+        memcpy(grid->points + 3 * (size_t)k, points + 3 * (size_t)grid->indices[k], 3 * sizeof(float));
+    }
+
+    return HC_GRID_SUCCESS;
+}
+
+/*
+ * Writes the indices of the points within 'radius' of 'center' (up to 'max_indices')
+ * and returns how many there are, which may be more than 'max_indices'.
+ */
+size_t hc_grid_query_radius(const hc_grid_t* grid, const float center[3], float radius, uint32_t* indices, size_t max_indices)
+{
+    if (!grid || !center) return 0;
+    return hc_grid_gather(grid, center, radius, UINT32_MAX, indices, indices ? max_indices : 0);
+}
+
+/*
+ * Writes the indices of the 'k' points nearest to 'center' within 'max_radius'
+ * (HUGE_VALF for no limit), nearest first, and returns how many were found.
+ * 'distances' receives their distances to 'center' if not NULL.
+ *
+ * Cells are read in rings of growing size around the cell of 'center', until
+ * the k-th nearest point found is closer than any cell left to read.
+ */
+size_t hc_grid_query_knn(const hc_grid_t* grid, const float center[3], float max_radius, uint32_t* indices, float* distances, size_t k)
+{
+    if (!grid || !center || !indices || k == 0 || grid->count == 0 || !(max_radius >= 0.0f)) return 0;
+
+    float stack_dist2[64];
+    float *dist2 = (k <= 64) ? stack_dist2 : HC_MALLOC(k * sizeof(float));
+    if (!dist2) return 0;
+
+    float max2 = (max_radius < HUGE_VALF) ? max_radius * max_radius : HUGE_VALF;
+    size_t found = 0;
+
+    int32_t c[3];
+    int32_t ring_max = 0;   // Rings past this one contain no occupied cell
+    for (int a = 0; a < 3; a++) {
+        c[a] = hc_grid_coord(grid, center[a]);
+        int32_t below = c[a] - grid->cell_min[a], above = grid->cell_max[a] - c[a];
+        int32_t reach = (below > above) ? below : above;
+        ring_max = (reach > ring_max) ? reach : ring_max;
+    }
+
+    uint64_t cells_read = 0;
+    for (int32_t r = 0; r <= ring_max; r++) {
+        // Wide empty regions: reading every point is cheaper than the next ring
+        uint64_t ring_cells = (r == 0) ? 1 : (uint64_t)24 * r * r + 2;
+        if (cells_read + ring_cells > 2 * (uint64_t)grid->count) {
+            found = 0;
+            for (uint32_t j = 0; j < grid->count; j++) {
+                const float *p = grid->points + 3 * (size_t)j;
+                float dx = p[0] - center[0], dy = p[1] - center[1], dz = p[2] - center[2];
+                float d2 = dx * dx + dy * dy + dz * dz;
+                if (d2 <= max2) hc_grid_knn_insert(indices, dist2, &found, k, grid->indices[j], d2);
+            }
+            break;
+        }
+        cells_read += ring_cells;
+
+        for (int32_t z = c[2] - r; z <= c[2] + r; z++) {
+            if (z < grid->cell_min[2] || z > grid->cell_max[2]) continue;
+            for (int32_t y = c[1] - r; y <= c[1] + r; y++) {
+                if (y < grid->cell_min[1] || y > grid->cell_max[1]) continue;
+
+                // Inside the faces of the ring, only its two end cells on x
+                bool face = (z == c[2] - r || z == c[2] + r || y == c[1] - r || y == c[1] + r);
+                int32_t step = (face || r == 0) ? 1 : 2 * r;
+                for (int32_t x = c[0] - r; x <= c[0] + r; x += step) {
+                    if (x < grid->cell_min[0] || x > grid->cell_max[0]) continue;
+                    hc_grid_knn_cell(grid, x, y, z, center, max2, indices, dist2, &found, k);
+                }
+            }
+        }
+
+        // Distance from 'center' to the closest cell outside the rings read so far
+        float gap = HUGE_VALF;
+        for (int a = 0; a < 3; a++) {
+            float below = center[a] - (float)(c[a] - r) * grid->cell_size;
+            float above = (float)(c[a] + r + 1) * grid->cell_size - center[a];
+            gap = (below < gap) ? below : gap;
+            gap = (above < gap) ? above : gap;
+        }
+        if (gap < 0.0f) gap = 0.0f;
+
+        float gap2 = gap * gap;
+        if (gap2 > max2 || (found == k && dist2[k - 1] <= gap2)) break;
+    }
+
+    if (distances) {
+        for (size_t i = 0; i < found; i++) distances[i] = sqrtf(dist2[i]);
+    }
+    if (dist2 != stack_dist2) HC_FREE(dist2);
+    return found;
+}
+
+/*
+ * Neighbors within 'radius' of every point (itself excluded), as lists indexed
+ * by the input order: the neighbors of point i are neighbors[offsets[i]] up to
+ * neighbors[offsets[i + 1]]. Both arrays are allocated, free them with HC_FREE.
+ */
+int hc_grid_neighbors(const hc_grid_t* grid, float radius, uint32_t** offsets, uint32_t** neighbors, int num_threads)
+{
+    if (!grid || !offsets || !neighbors || !(radius >= 0.0f)) return HC_GRID_ERROR_INVALID;
+    *offsets = NULL;
+    *neighbors = NULL;
+
+#ifdef _OPENMP
+    int threads = num_threads > 0 ? num_threads : omp_get_max_threads();
+#else
+    (void)num_threads;
+#endif
+
+    uint32_t count = grid->count;
+
+    uint32_t *off = HC_MALLOC(((size_t)count + 1) * sizeof(uint32_t));
+    if (!off) return HC_GRID_ERROR_OUT_OF_MEMORY;
+
+    // Two passes over the points in sorted order (for locality): count, then fill
+    off[0] = 0;
+#ifdef _OPENMP
+#   pragma omp parallel for schedule(dynamic, 256) num_threads(threads)
+#endif
+    for (long long k = 0; k < (long long)count; k++) {
+        uint32_t i = grid->indices[k];
+        off[i + 1] = (uint32_t)hc_grid_gather(grid, grid->points + 3 * (size_t)k, radius, i, NULL, 0);
+    }
+
+    size_t total = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        total += off[i + 1];
+        if (total > UINT32_MAX) {
+            HC_FREE(off);
+            return HC_GRID_ERROR_OUT_OF_MEMORY;
+        }
+        off[i + 1] = (uint32_t)total;
+    }
+
+    uint32_t *list = HC_MALLOC((total ? total : 1) * sizeof(uint32_t));
+    if (!list) {
+        HC_FREE(off);
+        return HC_GRID_ERROR_OUT_OF_MEMORY;
+    }
+
+#ifdef _OPENMP
+#   pragma omp parallel for schedule(dynamic, 256) num_threads(threads)
+#endif
+    for (long long k = 0; k < (long long)count; k++) {
+        uint32_t i = grid->indices[k];
+        hc_grid_gather(grid, grid->points + 3 * (size_t)k, radius, i, list + off[i], off[i + 1] - off[i]);
+    }
+
+    *offsets = off;
+    *neighbors = list;
+    return HC_GRID_SUCCESS;
+}
+
+#endif // HC_GRID_IMPL
@@ -0,0 +1,1018 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2024-2025 Le Juez Victor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Glob and regular expression matching without backtracking.
+ *
+ * Patterns are compiled into a Thompson NFA, and the DFA is built lazily while
+ * matching: each (state, byte class) transition is computed once then cached,
+ * so matching is linear in the length of the text whatever the pattern.
+ * The cache starts small and doubles on demand up to HC_MATCH_MAX_DFA_STATES.
+ *
+ * Supported regex subset:
+ *   - literals, '.', escapes (\d \w \s \D \W \S \n \t \r and escaped punctuation such as \. or \\,
+ *     other escapes like \b or \1 being syntax errors)
+ *   - bracket classes: [abc] [a-z] [^0-9] (escapes allowed inside)
+ *   - grouping '(...)' and alternation '|'
+ *   - quantifiers '*', '+', '?', '{n}', '{n,}', '{n,m}'
+ *   - anchors '^' and '$', only at the very start / end of the pattern and applying
+ *     to all of it: an anchored top-level alternation must be grouped, "^(a|b)$"
+ *
+ * Globs match the whole text and support '*', '?', [abc], [a-z] and [!abc].
+ *
+ * NOTE: The DFA cache is filled during matching, a compiled pattern
+ *       must therefore not be used by several threads at the same time.
+ */
+
+#ifndef HC_MATCH_H
+#define HC_MATCH_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <ctype.h>
+
+/* Macros and defintions */
+
+#ifndef HC_MALLOC
+#   define HC_MALLOC(sz) malloc(sz)
+#endif
+
+#ifndef HC_CALLOC
+#   define HC_CALLOC(nb, sz) calloc(nb, sz)
+#endif
+
+#ifndef HC_REALLOC
+#   define HC_REALLOC(ptr, new_sz) realloc(ptr, new_sz)
+#endif
+
+#ifndef HC_FREE
+#   define HC_FREE(ptr) free(ptr)
+#endif
+
+#ifndef HC_MATCH_MAX_DFA_STATES
+#   define HC_MATCH_MAX_DFA_STATES 2048    // Cached DFA states before the cache is flushed
+#endif
+
+#ifndef HC_MATCH_MAX_NFA_STATES
+#   define HC_MATCH_MAX_NFA_STATES 65536   // Guard against patterns like "(a{1000}){1000}"
+#endif
+
+/* Types definitions */
+
+enum hc_retcode_match {
+    HC_MATCH_ERROR_TOO_COMPLEX      = -3,
+    HC_MATCH_ERROR_OUT_OF_MEMORY    = -2,
+    HC_MATCH_ERROR_SYNTAX           = -1,
+    HC_MATCH_SUCCESS                = 0
+};
+
+enum hc_flags_match {
+    HC_MATCH_ICASE                  = 1 << 0    // Case insensitive (ASCII) matching
+};
+
+typedef struct {
+    uint8_t type;           // Set, split, epsilon or match
+    int out, out1;          // Next states (out1 is only used by splits)
+    uint32_t set[8];        // Accepted bytes (256 bits), only used by sets
+} hc_match_nfa_state_t;
+
+typedef struct {
+    size_t set_offset;      // Offset of the NFA state list in 'dfa_sets'
+    int set_count;          // Number of NFA states in the list
+    bool match;             // Contains the final NFA state
+} hc_match_dfa_state_t;
+
+typedef struct {
+    /* Compiled NFA */
+    hc_match_nfa_state_t *nfa;
+    int nfa_count;
+    int nfa_capacity;
+    int start;
+    bool anchor_start;
+    bool anchor_end;
+    /* Byte equivalence classes */
+    uint8_t classes[256];
+    int class_count;
+    /* Lazily built DFA */
+    hc_match_dfa_state_t *dfa;
+    int32_t *dfa_next;      // dfa_count * class_count transitions, -1 if not computed
+    int *dfa_sets;          // Concatenated sorted NFA state lists
+    size_t dfa_sets_count;
+    size_t dfa_sets_capacity;
+    int *dfa_hash;          // Open addressing table of DFA state indices, twice the capacity
+    int dfa_count;
+    int dfa_capacity;
+    int dfa_start;
+    /* Scratch buffers */
+    int *stack;
+    int *list;
+    uint32_t *marks;
+    uint32_t mark_gen;
+} hc_match_t;
+
+/* Function declarations */
+
+int hc_match_compile_regex(hc_match_t* m, const char* pattern, int flags);
+int hc_match_compile_glob(hc_match_t* m, const char* pattern, int flags);
+void hc_match_destroy(hc_match_t* m);
+bool hc_match_exec(hc_match_t* m, const char* text, size_t length);
+bool hc_match_exec_cstr(hc_match_t* m, const char* text);
+
+#endif // HC_MATCH_H
+
+#ifdef HC_MATCH_IMPL
+
+/* Private definitions */
+
+enum {
+    HC_MATCH_NFA_SET,
+    HC_MATCH_NFA_SPLIT,
+    HC_MATCH_NFA_EPSILON,
+    HC_MATCH_NFA_FINAL
+};
+
+#define HC_MATCH_DFA_MIN_STATES 16     // Initial capacity of the DFA cache
+
+typedef struct {
+    int start;
+    int end;                // Epsilon state whose 'out' is left dangling
+} hc_match_frag_t;
+
+typedef struct {
+    hc_match_t *m;
+    const char *pattern;
+    const char *ptr;
+    int flags;
+    int error;
+    bool top_alt;           // A '|' was found outside of any group
+} hc_match_parser_t;
+
+static int hc_match_nfa_add(hc_match_parser_t* p, uint8_t type, int out, int out1)
+{
+    hc_match_t *m = p->m;
+
+    if (m->nfa_count >= HC_MATCH_MAX_NFA_STATES) {
+        p->error = HC_MATCH_ERROR_TOO_COMPLEX;
+        return -1;
+    }
+
+    if (m->nfa_count >= m->nfa_capacity) {
+        int new_capacity = m->nfa_capacity ? m->nfa_capacity * 2 : 64;
+        void *new_nfa = HC_REALLOC(m->nfa, new_capacity * sizeof(hc_match_nfa_state_t));
+        if (!new_nfa) {
+            p->error = HC_MATCH_ERROR_OUT_OF_MEMORY;
+            return -1;
+        }
+        m->nfa = new_nfa;
+        m->nfa_capacity = new_capacity;
+    }
+
+    hc_match_nfa_state_t *state = &m->nfa[m->nfa_count];
+    memset(state, 0, sizeof(*state));
+    state->type = type;
+    state->out = out;
+    state->out1 = out1;
+
+    return m->nfa_count++;
+}
+
+static void hc_match_set_add(uint32_t* set, int c)
+{
+    set[(uint8_t)c >> 5] |= 1u << ((uint8_t)c & 31);
+}
+
+static bool hc_match_set_has(const uint32_t* set, int c)
+{
+    return (set[(uint8_t)c >> 5] >> ((uint8_t)c & 31)) & 1;
+}
+
+static void hc_match_set_add_range(uint32_t* set, int lo, int hi, int flags)
+{
+    for (int c = lo; c <= hi; c++) {
+        hc_match_set_add(set, c);
+        if (flags & HC_MATCH_ICASE) {
+            hc_match_set_add(set, tolower(c));
+            hc_match_set_add(set, toupper(c));
+        }
+    }
+}
+
+/* Byte of a single-character escape, -1 if not supported */
+static int hc_match_escape_char(int esc)
+{
+    switch (esc) {
+        case 'n': return '\n';
+        case 't': return '\t';
+        case 'r': return '\r';
+    }
+    return ispunct(esc) ? esc : -1;
+}
+
+/* Adds the bytes of an escape to the set, returns false if the escape isn't supported */
+static bool hc_match_set_add_escape(uint32_t* set, int esc, int flags)
+{
+    uint32_t tmp[8] = { 0 };
+    bool negate = false;
+
+    switch (esc) {
+        case 'D': negate = true; /* fallthrough */
+        case 'd': hc_match_set_add_range(tmp, '0', '9', 0); break;
+        case 'W': negate = true; /* fallthrough */
+        case 'w':
+            hc_match_set_add_range(tmp, 'a', 'z', 0);
+            hc_match_set_add_range(tmp, 'A', 'Z', 0);
+            hc_match_set_add_range(tmp, '0', '9', 0);
+            hc_match_set_add(tmp, '_');
+            break;
+        case 'S': negate = true; /* fallthrough */
+        case 's':
+            hc_match_set_add(tmp, ' ');
+            hc_match_set_add_range(tmp, '\t', '\r', 0);
+            break;
+        default: {
+            int c = hc_match_escape_char(esc);
+            if (c < 0) return false;
+            hc_match_set_add_range(tmp, c, c, flags);
+        } break;
+    }
+
+    for (int i = 0; i < 8; i++) {
+        set[i] |= negate ? ~tmp[i] : tmp[i];
+    }
+    return true;
+}
+
+static hc_match_frag_t hc_match_frag_set(hc_match_parser_t* p, const uint32_t* set)
+{
+    hc_match_frag_t frag = { -1, -1 };
+
+    frag.end = hc_match_nfa_add(p, HC_MATCH_NFA_EPSILON, -1, -1);
+    if (frag.end < 0) return frag;
+
+    frag.start = hc_match_nfa_add(p, HC_MATCH_NFA_SET, frag.end, -1);
+    if (frag.start < 0) return frag;
+
+    memcpy(p->m->nfa[frag.start].set, set, sizeof(uint32_t[8]));
+
+    return frag;
+}
+
+static hc_match_frag_t hc_match_frag_empty(hc_match_parser_t* p)
+{
+    hc_match_frag_t frag;
+    frag.start = frag.end = hc_match_nfa_add(p, HC_MATCH_NFA_EPSILON, -1, -1);
+    return frag;
+}
+
+static hc_match_frag_t hc_match_frag_concat(hc_match_parser_t* p, hc_match_frag_t a, hc_match_frag_t b)
+{
+    p->m->nfa[a.end].out = b.start;
+    a.end = b.end;
+    return a;
+}
+
+static hc_match_frag_t hc_match_frag_alt(hc_match_parser_t* p, hc_match_frag_t a, hc_match_frag_t b)
+{
+    hc_match_frag_t frag = { -1, -1 };
+
+    frag.end = hc_match_nfa_add(p, HC_MATCH_NFA_EPSILON, -1, -1);
+    if (frag.end < 0) return frag;
+
+    frag.start = hc_match_nfa_add(p, HC_MATCH_NFA_SPLIT, a.start, b.start);
+    if (frag.start < 0) return frag;
+
+    p->m->nfa[a.end].out = frag.end;
+    p->m->nfa[b.end].out = frag.end;
+
+    return frag;
+}
+
+static hc_match_frag_t hc_match_frag_star(hc_match_parser_t* p, hc_match_frag_t a)
+{
+    hc_match_frag_t frag = { -1, -1 };
+
+    frag.end = hc_match_nfa_add(p, HC_MATCH_NFA_EPSILON, -1, -1);
+    if (frag.end < 0) return frag;
+
+    frag.start = hc_match_nfa_add(p, HC_MATCH_NFA_SPLIT, a.start, frag.end);
+    if (frag.start < 0) return frag;
+
+    p->m->nfa[a.end].out = frag.start;
+
+    return frag;
+}
+
+static hc_match_frag_t hc_match_frag_optional(hc_match_parser_t* p, hc_match_frag_t a)
+{
+    hc_match_frag_t frag = { -1, -1 };
+
+    frag.start = hc_match_nfa_add(p, HC_MATCH_NFA_SPLIT, a.start, a.end);
+    if (frag.start < 0) return frag;
+
+    frag.end = a.end;
+
+    return frag;
+}
+
+static hc_match_frag_t hc_match_parse_alt(hc_match_parser_t* p, int depth);
+
+static hc_match_frag_t hc_match_parse_class(hc_match_parser_t* p, bool glob)
+{
+    uint32_t set[8] = { 0 };
+    bool negate = false;
+
+    if (*p->ptr == '^' || (glob && *p->ptr == '!')) {
+        negate = true;
+        p->ptr++;
+    }
+
+    // A leading ']' is taken as a literal
+    bool first = true;
+
+    while (*p->ptr && (*p->ptr != ']' || first)) {
+        first = false;
+
+        int lo = (uint8_t)*p->ptr++;
+        if (lo == '\\' && !glob) {
+            if (!*p->ptr) break;
+            int esc = (uint8_t)*p->ptr++;
+            if (strchr("dDwWsS", esc)) {
+                hc_match_set_add_escape(set, esc, p->flags);
+                continue;
+            }
+            lo = hc_match_escape_char(esc);
+            if (lo < 0) {
+                p->error = HC_MATCH_ERROR_SYNTAX;
+                break;
+            }
+        }
+
+        int hi = lo;
+        if (p->ptr[0] == '-' && p->ptr[1] && p->ptr[1] != ']') {
+            p->ptr++;
+            hi = (uint8_t)*p->ptr++;
+            if (hi == '\\' && !glob && *p->ptr) {
+                hi = hc_match_escape_char((uint8_t)*p->ptr++);
+            }
+            if (hi < lo) {
+                p->error = HC_MATCH_ERROR_SYNTAX;
+                break;
+            }
+        }
+
+        hc_match_set_add_range(set, lo, hi, p->flags);
+    }
+
+    if (*p->ptr != ']') {
+        p->error = HC_MATCH_ERROR_SYNTAX;
+        hc_match_frag_t frag = { -1, -1 };
+        return frag;
+    }
+    p->ptr++;
+
+    if (negate) {
+        for (int i = 0; i < 8; i++) set[i] = ~set[i];
+    }
+
+    return hc_match_frag_set(p, set);
+}
+
+static hc_match_frag_t hc_match_parse_atom(hc_match_parser_t* p, int depth)
+{
+    hc_match_frag_t frag = { -1, -1 };
+    uint32_t set[8] = { 0 };
+
+    int c = (uint8_t)*p->ptr++;
+
+    switch (c) {
+        case '(':
+            frag = hc_match_parse_alt(p, depth + 1);
+            if (p->error) return frag;
+            if (*p->ptr != ')') {
+                p->error = HC_MATCH_ERROR_SYNTAX;
+                return frag;
+            }
+            p->ptr++;
+            return frag;
+
+        case '[':
+            return hc_match_parse_class(p, false);
+
+        case '.':
+            memset(set, 0xFF, sizeof(set));
+            return hc_match_frag_set(p, set);
+
+        case '\\':
+            if (!*p->ptr) {
+                p->error = HC_MATCH_ERROR_SYNTAX;
+                return frag;
+            }
+            if (!hc_match_set_add_escape(set, (uint8_t)*p->ptr++, p->flags)) {
+                p->error = HC_MATCH_ERROR_SYNTAX;
+                return frag;
+            }
+            return hc_match_frag_set(p, set);
+
+        // Anchors are only accepted at the ends of the pattern, see hc_match_compile_regex
+        case '*': case '+': case '?': case '{': case ')': case '|': case '^': case '$':
+            p->error = HC_MATCH_ERROR_SYNTAX;
+            return frag;
+
+        default:
+            hc_match_set_add_range(set, c, c, p->flags);
+            return hc_match_frag_set(p, set);
+    }
+}
+
+static bool hc_match_parse_count(hc_match_parser_t* p, int* value)
+{
+    if (!isdigit((unsigned char)*p->ptr)) return false;
+
+    int n = 0;
+    while (isdigit((unsigned char)*p->ptr)) {
+        n = n * 10 + (*p->ptr++ - '0');
+        if (n > 1000) {
+            p->error = HC_MATCH_ERROR_TOO_COMPLEX;
+            return false;
+        }
+    }
+
+    *value = n;
+    return true;
+}
+
+static hc_match_frag_t hc_match_parse_repeat(hc_match_parser_t* p, int depth)
+{
+    const char *atom_start = p->ptr;
+
+    hc_match_frag_t frag = hc_match_parse_atom(p, depth);
+    if (p->error) return frag;
+
+    for (bool quantified = false; ; quantified = true) {
+        char q = *p->ptr;
+
+        if (q == '*') {
+            p->ptr++;
+            frag = hc_match_frag_star(p, frag);
+        } else if (q == '+') {
+            p->ptr++;
+            // a+ = a a*, the loop goes back to the first copy
+            hc_match_frag_t star = hc_match_frag_star(p, frag);
+            if (p->error) return frag;
+            frag.end = star.end;
+        } else if (q == '?') {
+            p->ptr++;
+            frag = hc_match_frag_optional(p, frag);
+        } else if (q == '{') {
+            // Bounded repetitions are expanded by parsing the atom again for each copy,
+            // which only makes sense if no other quantifier was applied to it before
+            if (quantified) {
+                p->error = HC_MATCH_ERROR_SYNTAX;
+                return frag;
+            }
+
+            int min = 0, max = 0;
+
+            p->ptr++;
+            if (!hc_match_parse_count(p, &min)) {
+                if (!p->error) p->error = HC_MATCH_ERROR_SYNTAX;
+                return frag;
+            }
+            if (*p->ptr == ',') {
+                p->ptr++;
+                max = -1;
+                if (*p->ptr != '}' && (!hc_match_parse_count(p, &max) || max < min)) {
+                    if (!p->error) p->error = HC_MATCH_ERROR_SYNTAX;
+                    return frag;
+                }
+            } else {
+                max = min;
+            }
+            if (*p->ptr != '}') {
+                p->error = HC_MATCH_ERROR_SYNTAX;
+                return frag;
+            }
+            const char *resume = ++p->ptr;
+
+            // a{2,4} = a a a? a?, a{2,} = a a a*
+            int total = (max < 0) ? min + 1 : max;
+            hc_match_frag_t result = (min > 0) ? frag : hc_match_frag_empty(p);
+
+            for (int i = (min > 0) ? 1 : 0; i < total && !p->error; i++) {
+                hc_match_frag_t copy = frag;
+                if (i > 0) {
+                    p->ptr = atom_start;
+                    copy = hc_match_parse_atom(p, depth);
+                    if (p->error) break;
+                }
+                if (i >= min) {
+                    copy = (max < 0) ? hc_match_frag_star(p, copy)
+                                     : hc_match_frag_optional(p, copy);
+                    if (p->error) break;
+                }
+                result = hc_match_frag_concat(p, result, copy);
+            }
+
+            if (p->error) return frag;
+
+            frag = result;
+            p->ptr = resume;
+        } else {
+            break;
+        }
+
+        if (p->error) break;
+    }
+
+    return frag;
+}
+
+static hc_match_frag_t hc_match_parse_concat(hc_match_parser_t* p, int depth)
+{
+    hc_match_frag_t frag = hc_match_frag_empty(p);
+
+    while (!p->error && *p->ptr && *p->ptr != '|' && *p->ptr != ')') {
+        // An unescaped '$' is only allowed at the end of the pattern
+        if (*p->ptr == '$' && p->ptr[1] == '\0' && depth == 0) break;
+
+        hc_match_frag_t next = hc_match_parse_repeat(p, depth);
+        if (p->error) break;
+
+        frag = hc_match_frag_concat(p, frag, next);
+    }
+
+    return frag;
+}
+
+static hc_match_frag_t hc_match_parse_alt(hc_match_parser_t* p, int depth)
+{
+    hc_match_frag_t frag = hc_match_parse_concat(p, depth);
+
+    while (!p->error && *p->ptr == '|') {
+        if (depth == 0) p->top_alt = true;
+        p->ptr++;
+        hc_match_frag_t next = hc_match_parse_concat(p, depth);
+        if (p->error) break;
+        frag = hc_match_frag_alt(p, frag, next);
+    }
+
+    return frag;
+}
+
+static hc_match_frag_t hc_match_parse_glob(hc_match_parser_t* p)
+{
+    hc_match_frag_t frag = hc_match_frag_empty(p);
+    uint32_t set[8];
+
+    while (!p->error && *p->ptr) {
+        hc_match_frag_t next;
+        int c = (uint8_t)*p->ptr++;
+
+        memset(set, 0, sizeof(set));
+
+        switch (c) {
+            case '*':
+                while (*p->ptr == '*') p->ptr++;
+                memset(set, 0xFF, sizeof(set));
+                next = hc_match_frag_set(p, set);
+                if (!p->error) next = hc_match_frag_star(p, next);
+                break;
+            case '?':
+                memset(set, 0xFF, sizeof(set));
+                next = hc_match_frag_set(p, set);
+                break;
+            case '[':
+                next = hc_match_parse_class(p, true);
+                break;
+            case '\\':
+                if (*p->ptr) c = (uint8_t)*p->ptr++;
+                /* fallthrough */
+            default:
+                hc_match_set_add_range(set, c, c, p->flags);
+                next = hc_match_frag_set(p, set);
+                break;
+        }
+
+        if (p->error) break;
+        frag = hc_match_frag_concat(p, frag, next);
+    }
+
+    return frag;
+}
+
+static void hc_match_compute_classes(hc_match_t* m)
+{
+    // Bytes accepted by exactly the same NFA sets share a class,
+    // this keeps the DFA transition table small
+    uint8_t map[512];
+
+    memset(m->classes, 0, sizeof(m->classes));
+    m->class_count = 1;
+
+    for (int i = 0; i < m->nfa_count; i++) {
+        if (m->nfa[i].type != HC_MATCH_NFA_SET) continue;
+
+        memset(map, 0xFF, sizeof(map));
+        int count = 0;
+
+        for (int c = 0; c < 256; c++) {
+            int key = m->classes[c] * 2 + hc_match_set_has(m->nfa[i].set, c);
+            if (map[key] == 0xFF) map[key] = (uint8_t)count++;
+            m->classes[c] = map[key];
+        }
+
+        m->class_count = count;
+        if (count == 256) break;
+    }
+}
+
+static int hc_match_int_cmp(const void* a, const void* b)
+{
+    return *(const int*)a - *(const int*)b;
+}
+
+static void hc_match_dfa_reset(hc_match_t* m)
+{
+    m->dfa_count = 0;
+    m->dfa_sets_count = 0;
+    m->dfa_start = -1;
+
+    for (int i = 0; i < m->dfa_capacity * 2; i++) {
+        m->dfa_hash[i] = -1;
+    }
+}
+
+static uint32_t hc_match_dfa_hash(const int* list, int count)
+{
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < count; i++) {
+        hash = (hash ^ (uint32_t)list[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/* Resizes the DFA cache to 'capacity' states, the cached states and transitions are kept */
+static bool hc_match_dfa_resize(hc_match_t* m, int capacity)
+{
+    uint32_t hash_size = (uint32_t)capacity * 2;
+
+    hc_match_dfa_state_t *dfa = HC_REALLOC(m->dfa, capacity * sizeof(hc_match_dfa_state_t));
+    if (!dfa) return false;
+    m->dfa = dfa;
+
+    int32_t *next = HC_REALLOC(m->dfa_next, (size_t)capacity * m->class_count * sizeof(int32_t));
+    if (!next) return false;
+    m->dfa_next = next;
+
+    int *hash = HC_REALLOC(m->dfa_hash, hash_size * sizeof(int));
+    if (!hash) return false;
+    m->dfa_hash = hash;
+
+    for (uint32_t i = 0; i < hash_size; i++) {
+        hash[i] = -1;
+    }
+
+    for (int id = 0; id < m->dfa_count; id++) {
+        const hc_match_dfa_state_t *d = &m->dfa[id];
+        uint32_t slot = hc_match_dfa_hash(m->dfa_sets + d->set_offset, d->set_count) % hash_size;
+        while (hash[slot] >= 0) slot = (slot + 1) % hash_size;
+        hash[slot] = id;
+    }
+
+    m->dfa_capacity = capacity;
+
+    return true;
+}
+
+/* Adds the epsilon closure of 'state' to 'm->list' (only sets and final states are kept) */
+static int hc_match_closure(hc_match_t* m, int state, int count)
+{
+    int sp = 0;
+    m->stack[sp++] = state;
+
+    while (sp > 0) {
+        int s = m->stack[--sp];
+        if (s < 0 || m->marks[s] == m->mark_gen) continue;
+        m->marks[s] = m->mark_gen;
+
+        const hc_match_nfa_state_t *st = &m->nfa[s];
+        switch (st->type) {
+            case HC_MATCH_NFA_SET:
+            case HC_MATCH_NFA_FINAL:
+                m->list[count++] = s;
+                break;
+            case HC_MATCH_NFA_SPLIT:
+                m->stack[sp++] = st->out1;
+                m->stack[sp++] = st->out;
+                break;
+            case HC_MATCH_NFA_EPSILON:
+                m->stack[sp++] = st->out;
+                break;
+        }
+    }
+
+    return count;
+}
+
+static void hc_match_next_gen(hc_match_t* m)
+{
+    if (++m->mark_gen == 0) {
+        memset(m->marks, 0, m->nfa_count * sizeof(uint32_t));
+        m->mark_gen = 1;
+    }
+}
+
+/* Returns the DFA state for the NFA list 'm->list[0..count)', creating it if needed */
+static int hc_match_dfa_lookup(hc_match_t* m, int count)
+{
+    qsort(m->list, count, sizeof(int), hc_match_int_cmp);
+
+    uint32_t hash = hc_match_dfa_hash(m->list, count);
+    uint32_t hash_size = (uint32_t)m->dfa_capacity * 2;
+
+    uint32_t slot = hash % hash_size;
+    while (m->dfa_hash[slot] >= 0) {
+        const hc_match_dfa_state_t *d = &m->dfa[m->dfa_hash[slot]];
+        if (d->set_count == count && !memcmp(m->dfa_sets + d->set_offset, m->list, count * sizeof(int))) {
+            return m->dfa_hash[slot];
+        }
+        slot = (slot + 1) % hash_size;
+    }
+
+    // Grow the cache before flushing it, most patterns never get close to the limit
+    if (m->dfa_count >= m->dfa_capacity) {
+        if (m->dfa_capacity >= HC_MATCH_MAX_DFA_STATES) {
+            return -1;
+        }
+
+        int capacity = m->dfa_capacity * 2;
+        if (capacity > HC_MATCH_MAX_DFA_STATES) capacity = HC_MATCH_MAX_DFA_STATES;
+        if (!hc_match_dfa_resize(m, capacity)) return -2;
+
+        hash_size = (uint32_t)capacity * 2;
+        slot = hash % hash_size;
+        while (m->dfa_hash[slot] >= 0) slot = (slot + 1) % hash_size;
+    }
+
+    if (m->dfa_sets_count + count > m->dfa_sets_capacity) {
+        size_t new_capacity = (m->dfa_sets_count + count) * 2;
+        int *new_sets = HC_REALLOC(m->dfa_sets, new_capacity * sizeof(int));
+        if (!new_sets) return -2;
+        m->dfa_sets = new_sets;
+        m->dfa_sets_capacity = new_capacity;
+    }
+
+    int id = m->dfa_count++;
+    hc_match_dfa_state_t *d = &m->dfa[id];
+
+    d->set_offset = m->dfa_sets_count;
+    d->set_count = count;
+    d->match = false;
+
+    for (int i = 0; i < count; i++) {
+        if (m->nfa[m->list[i]].type == HC_MATCH_NFA_FINAL) d->match = true;
+    }
+
+    memcpy(m->dfa_sets + m->dfa_sets_count, m->list, count * sizeof(int));
+    m->dfa_sets_count += count;
+
+    for (int c = 0; c < m->class_count; c++) {
+        m->dfa_next[id * m->class_count + c] = -1;
+    }
+
+    m->dfa_hash[slot] = id;
+
+    return id;
+}
+
+static int hc_match_dfa_start(hc_match_t* m)
+{
+    if (m->dfa_start < 0) {
+        hc_match_next_gen(m);
+        int count = hc_match_closure(m, m->start, 0);
+        int id = hc_match_dfa_lookup(m, count);
+        if (id == -1) {
+            hc_match_dfa_reset(m);
+            id = hc_match_dfa_lookup(m, count);
+        }
+        m->dfa_start = id;
+    }
+    return m->dfa_start;
+}
+
+/* Computes the transition of DFA state 'id' on byte 'c', flushing the cache when it is full */
+static int hc_match_dfa_step(hc_match_t* m, int* id, uint8_t c)
+{
+    for (int attempt = 0; attempt < 2; attempt++) {
+        const hc_match_dfa_state_t *d = &m->dfa[*id];
+        int count = 0;
+
+        hc_match_next_gen(m);
+
+        for (int i = 0; i < d->set_count; i++) {
+            const hc_match_nfa_state_t *st = &m->nfa[m->dfa_sets[d->set_offset + i]];
+            if (st->type == HC_MATCH_NFA_SET && hc_match_set_has(st->set, c)) {
+                count = hc_match_closure(m, st->out, count);
+            }
+        }
+
+        // Unanchored search, a new match attempt can begin at every position
+        if (!m->anchor_start) {
+            count = hc_match_closure(m, m->start, count);
+        }
+
+        int next = hc_match_dfa_lookup(m, count);
+        if (next >= 0) {
+            m->dfa_next[*id * m->class_count + m->classes[c]] = next;
+            return next;
+        }
+        if (next == -2) {
+            return -1;
+        }
+
+        // Cache full, restart it with only the current state
+        memcpy(m->list, m->dfa_sets + d->set_offset, d->set_count * sizeof(int));
+        count = d->set_count;
+        hc_match_dfa_reset(m);
+        *id = hc_match_dfa_lookup(m, count);
+    }
+
+    return -1;
+}
+
+static int hc_match_finish(hc_match_t* m, hc_match_parser_t* p, hc_match_frag_t frag)
+{
+    if (!p->error) {
+        int final = hc_match_nfa_add(p, HC_MATCH_NFA_FINAL, -1, -1);
+        if (!p->error) {
+            m->nfa[frag.end].out = final;
+            m->start = frag.start;
+        }
+    }
+
+    if (!p->error) {
+        m->stack = HC_MALLOC((m->nfa_count * 2 + 1) * sizeof(int));
+        m->list = HC_MALLOC(m->nfa_count * sizeof(int));
+        m->marks = HC_CALLOC(m->nfa_count, sizeof(uint32_t));
+
+        if (!m->stack || !m->list || !m->marks) {
+            p->error = HC_MATCH_ERROR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (!p->error) {
+        hc_match_compute_classes(m);
+        int capacity = HC_MATCH_DFA_MIN_STATES;
+        if (capacity > HC_MATCH_MAX_DFA_STATES) capacity = HC_MATCH_MAX_DFA_STATES;
+        if (!hc_match_dfa_resize(m, capacity)) p->error = HC_MATCH_ERROR_OUT_OF_MEMORY;
+    }
+
+    if (p->error) {
+        hc_match_destroy(m);
+        return p->error;
+    }
+
+    m->mark_gen = 0;
+    hc_match_dfa_reset(m);
+
+    return HC_MATCH_SUCCESS;
+}
+
+/* Public API */
+
+int hc_match_compile_regex(hc_match_t* m, const char* pattern, int flags)
+{
+    if (!m || !pattern) {
+        return HC_MATCH_ERROR_SYNTAX;
+    }
+
+    memset(m, 0, sizeof(*m));
+
+    hc_match_parser_t p = { 0 };
+    p.m = m;
+    p.pattern = pattern;
+    p.ptr = pattern;
+    p.flags = flags;
+
+    if (*p.ptr == '^') {
+        m->anchor_start = true;
+        p.ptr++;
+    }
+
+    hc_match_frag_t frag = hc_match_parse_alt(&p, 0);
+
+    if (!p.error) {
+        if (*p.ptr == '$' && p.ptr[1] == '\0') {
+            m->anchor_end = true;
+            p.ptr++;
+        }
+        if (*p.ptr != '\0') {
+            p.error = HC_MATCH_ERROR_SYNTAX;
+        }
+        // "a|b$" would silently mean "(a|b)$", the alternation must be grouped explicitly
+        if ((m->anchor_start || m->anchor_end) && p.top_alt) {
+            p.error = HC_MATCH_ERROR_SYNTAX;
+        }
+    }
+
+    return hc_match_finish(m, &p, frag);
+}
+
+int hc_match_compile_glob(hc_match_t* m, const char* pattern, int flags)
+{
+    if (!m || !pattern) {
+        return HC_MATCH_ERROR_SYNTAX;
+    }
+
+    memset(m, 0, sizeof(*m));
+
+    hc_match_parser_t p = { 0 };
+    p.m = m;
+    p.pattern = pattern;
+    p.ptr = pattern;
+    p.flags = flags;
+
+    m->anchor_start = true;
+    m->anchor_end = true;
+
+    hc_match_frag_t frag = hc_match_parse_glob(&p);
+
+    return hc_match_finish(m, &p, frag);
+}
+
+void hc_match_destroy(hc_match_t* m)
+{
+    if (!m) return;
+
+    HC_FREE(m->nfa);
+    HC_FREE(m->dfa);
+    HC_FREE(m->dfa_next);
+    HC_FREE(m->dfa_sets);
+    HC_FREE(m->dfa_hash);
+    HC_FREE(m->stack);
+    HC_FREE(m->list);
+    HC_FREE(m->marks);
+
+    memset(m, 0, sizeof(*m));
+}
+
+bool hc_match_exec(hc_match_t* m, const char* text, size_t length)
+{
+    if (!m || !m->nfa || (!text && length > 0)) {
+        return false;
+    }
+
+    int state = hc_match_dfa_start(m);
+    if (state < 0) return false;
+
+    const uint8_t *ptr = (const uint8_t*)text;
+    const uint8_t *end = ptr + length;
+
+    while (ptr < end) {
+        const hc_match_dfa_state_t *d = &m->dfa[state];
+
+        if (d->match && !m->anchor_end) return true;
+        if (d->set_count == 0) return false;    // Dead state
+
+        int next = m->dfa_next[state * m->class_count + m->classes[*ptr]];
+        if (next < 0) {
+            next = hc_match_dfa_step(m, &state, *ptr);
+            if (next < 0) return false;
+        }
+
+        state = next;
+        ptr++;
+    }
+
+    return m->dfa[state].match;
+}
+
+bool hc_match_exec_cstr(hc_match_t* m, const char* text)
+{
+    return hc_match_exec(m, text, text ? strlen(text) : 0);
+}
+
+#endif // HC_MATCH_IMPL
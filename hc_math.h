@@ -25,6 +25,7 @@
 #ifndef HC_MATH_H
 #define HC_MATH_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <math.h>
 
@@ -34,21 +35,19 @@
 #   define HCSAPI static inline
 #endif // HCSAPI
 
-#ifndef HC_FISR
-#   define hc_rsqrtf(x) (1.0f / sqrtf(x))
-#else
-// NOTE: More useful on older platforms.
-// SEE: http://www.lomont.org/papers/2003/InvSqrt.pdf
-HCSAPI float hc_rsqrtf(float x)
-{
-    float xhalf = 0.5f*x;
-    int i = *(int*)&x;              // get bits for floating value
-    i = 0x5f375a86 - (i >> 1);      // gives initial guess y0
-    x = *(float*)&i;                // convert bits back to float
-    x = x*(1.5f - xhalf*x*x);       // Newton step, repeating increases accuracy
-    return x;
-}
-#endif // HC_FISR
+/* Precision of the reciprocal square roots (define HC_RSQRT_PRECISION to one of these) */
+
+#define HC_RSQRT_EXACT      0   // 1 / sqrt(x)
+#define HC_RSQRT_NEWTON     1   // Hardware estimate refined by one Newton step (about 22 bits)
+#define HC_RSQRT_ESTIMATE   2   // Hardware estimate alone (12 bits, 14 with AVX-512)
+
+#ifndef HC_RSQRT_PRECISION
+#   ifdef HC_FISR
+#       define HC_RSQRT_PRECISION HC_RSQRT_ESTIMATE     // Former option, kept for compatibility
+#   else
+#       define HC_RSQRT_PRECISION HC_RSQRT_EXACT
+#   endif
+#endif // HC_RSQRT_PRECISION
 
 #define HC_PI 3.14159265358979323846
 #define HC_TAU (2.0 * HC_PI)
@@ -59,13 +58,148 @@ HCSAPI float hc_rsqrtf(float x)
 /* Platform Specific */
 
 #ifndef HC_RESTRICT
-#   ifdef _MSC_VER
+#   if defined(_MSC_VER) || defined(__cplusplus)
 #       define HC_RESTRICT __restrict
 #   else // ANY_PLATFORM
 #       define HC_RESTRICT restrict
 #   endif // PLATFORM
 #endif // HC_RESTRICT
 
+/* Name under which this header includes itself to instantiate its templates (define it for a renamed copy) */
+
+#ifndef HC_MATH_SELF
+#   if defined(__FILE_NAME__)
+#       define HC_MATH_SELF __FILE_NAME__   // Base name, looked up next to this file first
+#   else
+#       define HC_MATH_SELF "hc_math.h"
+#   endif
+#endif // HC_MATH_SELF
+
+/* SIMD level (define HC_SIMD to one of these levels to override the detection) */
+
+#define HC_SIMD_NONE    0
+#define HC_SIMD_SSE2    1
+#define HC_SIMD_SSE41   2
+#define HC_SIMD_AVX     3
+#define HC_SIMD_AVX2    4       // AVX2 + FMA
+#define HC_SIMD_AVX512  5       // AVX-512F
+#define HC_SIMD_NEON    16
+
+#ifndef HC_SIMD
+#   if defined(__AVX512F__)
+#       define HC_SIMD HC_SIMD_AVX512
+#   elif defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#       define HC_SIMD HC_SIMD_AVX2
+#   elif defined(__AVX__)
+#       define HC_SIMD HC_SIMD_AVX
+#   elif defined(__SSE4_1__)
+#       define HC_SIMD HC_SIMD_SSE41
+#   elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define HC_SIMD HC_SIMD_SSE2
+#   elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#       define HC_SIMD HC_SIMD_NEON
+#   else
+#       define HC_SIMD HC_SIMD_NONE
+#   endif
+#endif // HC_SIMD
+
+#if HC_SIMD == HC_SIMD_NEON
+#   define HC_MATH_NEON
+#   include <arm_neon.h>
+#elif HC_SIMD >= HC_SIMD_SSE2
+#   define HC_MATH_SSE2
+#   if HC_SIMD >= HC_SIMD_SSE41
+#       define HC_MATH_SSE41
+#   endif
+#   if HC_SIMD >= HC_SIMD_AVX
+#       define HC_MATH_AVX
+#   endif
+#   if HC_SIMD >= HC_SIMD_AVX2
+#       define HC_MATH_AVX2
+#   endif
+#   if HC_SIMD >= HC_SIMD_AVX512
+#       define HC_MATH_AVX512
+#   endif
+#   include <immintrin.h>
+#endif
+
+#if defined(HC_MATH_AVX2)
+#   define hc_madd_ps(a, b, c) _mm_fmadd_ps(a, b, c)
+#   define hc_madd256_ps(a, b, c) _mm256_fmadd_ps(a, b, c)
+#   define hc_madd_pd(a, b, c) _mm_fmadd_pd(a, b, c)
+#   define hc_madd256_pd(a, b, c) _mm256_fmadd_pd(a, b, c)
+#elif defined(HC_MATH_SSE2)
+#   define hc_madd_ps(a, b, c) _mm_add_ps(_mm_mul_ps(a, b), c)
+#   define hc_madd256_ps(a, b, c) _mm256_add_ps(_mm256_mul_ps(a, b), c)
+#   define hc_madd_pd(a, b, c) _mm_add_pd(_mm_mul_pd(a, b), c)
+#   define hc_madd256_pd(a, b, c) _mm256_add_pd(_mm256_mul_pd(a, b), c)
+#elif defined(HC_MATH_NEON) && defined(__aarch64__)
+#   define hc_madd_f32(acc, v, s) vfmaq_n_f32(acc, v, s)
+#elif defined(HC_MATH_NEON)
+#   define hc_madd_f32(acc, v, s) vmlaq_n_f32(acc, v, s)
+#endif
+
+/*
+ * Runtime dispatch (optional): define HC_MATH_DISPATCH in every file including
+ * this header and HC_MATH_DISPATCH_IMPL in exactly one of them. The batch
+ * kernels are then called through a function table, filled on first use with
+ * the variants best suited to the running CPU (AVX2/FMA and AVX-512 on x86,
+ * with GCC or Clang), so that a baseline build still uses them when available.
+ * The table entries are read and written atomically, and the first calls select
+ * the kernels only once, so threads may make their first calls concurrently.
+ */
+
+#if defined(HC_MATH_DISPATCH_IMPL) && !defined(HC_MATH_DISPATCH)
+#   define HC_MATH_DISPATCH
+#endif
+
+#if defined(HC_MATH_DISPATCH) && defined(_MSC_VER) && !defined(__clang__)
+#   include <intrin.h>
+#   define HC_MATH_ATOMIC_LOAD(ptr) (*(ptr))                // Aligned pointer loads, ordered on x86/x64
+#   define HC_MATH_ATOMIC_STORE(ptr, val) (*(ptr) = (val))
+#   define HC_MATH_ATOMIC_CAS(ptr, expected, desired) \
+        (_InterlockedCompareExchange(ptr, desired, expected) == (expected))
+#elif defined(HC_MATH_DISPATCH)
+#   define HC_MATH_ATOMIC_LOAD(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#   define HC_MATH_ATOMIC_STORE(ptr, val) __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+#   define HC_MATH_ATOMIC_CAS(ptr, expected, desired) __sync_bool_compare_and_swap(ptr, expected, desired)
+#endif
+
+#if defined(HC_MATH_DISPATCH)
+#   define HC_MATH_KERNEL(name) HC_MATH_ATOMIC_LOAD(&hc_math_kernels.name)
+#endif
+
+#if defined(HC_MATH_DISPATCH_IMPL) && defined(HC_MATH_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#   define HC_MATH_DISPATCH_X86
+#   define HC_MATH_TARGET_AVX __attribute__((target("avx")))
+#   define HC_MATH_TARGET_AVX2 __attribute__((target("avx,avx2,fma")))
+#   define hc_madd256_kernel_ps(a, b, c) _mm256_fmadd_ps(a, b, c)
+#elif defined(HC_MATH_AVX)
+#   define HC_MATH_TARGET_AVX
+#   define HC_MATH_TARGET_AVX2
+#   define hc_madd256_kernel_ps(a, b, c) hc_madd256_ps(a, b, c)
+#endif
+
+#if defined(HC_MATH_AVX) || defined(HC_MATH_DISPATCH_X86)
+#   define HC_MATH_AVX_KERNELS     // The AVX batch kernels are defined
+#endif
+
+#if defined(HC_MATH_AVX) && (!defined(HC_MATH_DISPATCH_X86) || defined(HC_MATH_AVX2))
+#   define HC_MATH_AVX_BATCH       // The generic batch functions call the AVX kernels
+#endif
+
+#if defined(HC_MATH_AVX2) || defined(HC_MATH_DISPATCH_X86)
+#   define HC_MATH_AVX2_KERNELS    // The AVX2 stream kernels are defined (they need the gathers)
+#endif
+
+#if defined(HC_MATH_DISPATCH_X86)
+#   define HC_MATH_TARGET_AVX512 __attribute__((target("avx,avx2,fma,avx512f")))
+#   define HC_MATH_AVX512_KERNELS  // The AVX-512 stream kernels are defined
+#elif defined(HC_MATH_AVX512)
+#   define HC_MATH_TARGET_AVX512
+#   define HC_MATH_AVX512_KERNELS
+#endif
+
 /* Types definitions */
 
 typedef float hc_vec2_t[2];
@@ -84,6 +218,633 @@ typedef float hc_mat4_t[16];
 typedef float* hc_mat4_ptr_t;
 typedef float const* hc_mat4_cptr_t;
 
+typedef double hc_dvec2_t[2];
+typedef double* hc_dvec2_ptr_t;
+typedef double const* hc_dvec2_cptr_t;
+
+typedef double hc_dvec3_t[3];
+typedef double* hc_dvec3_ptr_t;
+typedef double const* hc_dvec3_cptr_t;
+
+typedef double hc_dvec4_t[4];
+typedef double* hc_dvec4_ptr_t;
+typedef double const* hc_dvec4_cptr_t;
+
+typedef double hc_dmat4_t[16];
+typedef double* hc_dmat4_ptr_t;
+typedef double const* hc_dmat4_cptr_t;
+
+typedef float hc_mat3x4_t[12];
+typedef float* hc_mat3x4_ptr_t;
+typedef float const* hc_mat3x4_cptr_t;
+
+typedef float hc_quat_t[4];         // x, y, z, w
+typedef float* hc_quat_ptr_t;
+typedef float const* hc_quat_cptr_t;
+
+typedef float hc_frustum_t[24];     // Planes (a, b, c, d): left, right, bottom, top, near, far
+typedef float* hc_frustum_ptr_t;
+typedef float const* hc_frustum_cptr_t;
+
+typedef struct {
+    float *x, *y, *z;       // First element of each component
+    size_t stride;          // Bytes between two consecutive elements of a component
+} hc_vec3_stream_t;         // See hc_vec3_stream_soa() and hc_vec3_stream_aos()
+
+typedef struct {
+    const float *x, *y, *z;
+    size_t stride;
+} hc_vec3_cstream_t;        // Read-only stream, for the sources of the stream operations
+
+#ifdef HC_MATH_DISPATCH
+typedef struct {
+    void (*vec2_transform_wt_batch)(hc_vec2_ptr_t, hc_vec2_cptr_t, size_t, size_t, float, hc_mat4_cptr_t);
+    void (*vec3_transform_wt_batch)(hc_vec3_ptr_t, hc_vec3_cptr_t, size_t, size_t, float, hc_mat4_cptr_t);
+    void (*vec3_transform_wt_soa)(float*, float*, float*, const float*, const float*, const float*, size_t, float, hc_mat4_cptr_t);
+    void (*vec4_transform_batch)(hc_vec4_ptr_t, hc_vec4_cptr_t, size_t, size_t, hc_mat4_cptr_t);
+    void (*vec3_stream)(int, const hc_vec3_stream_t*, const hc_vec3_cstream_t*, const hc_vec3_cstream_t*, float, float*, size_t);
+    int level;              // HC_SIMD level of the selected kernels (-1 before selection)
+} hc_math_kernels_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern hc_math_kernels_t hc_math_kernels;
+
+// Selects the kernels for the running CPU, up to 'max_level', and returns the level used.
+// Called automatically (once) on first use, calling it again replaces the kernels.
+int hc_math_dispatch_init(int max_level);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // HC_MATH_DISPATCH
+
+/* Reciprocal square root */
+
+/*
+ * 1 / sqrt(x) at the precision selected by HC_RSQRT_PRECISION, for one float
+ * (hc_rsqrtf) and for 4 (hc_rsqrt_ps, hc_rsqrt_f32 with NEON), 8 (hc_rsqrt256_ps)
+ * or 16 (hc_rsqrt512_ps) floats. The approximate tiers use rsqrtps/rsqrt14ps on
+ * x86 and vrsqrte on NEON, whose estimate having 8 bits gets one more Newton step
+ * than on x86. Without SIMD the estimate comes from the bits of 'x' followed by
+ * one step, as with the former HC_FISR option (9 bits, SEE:
+ * http://www.lomont.org/papers/2003/InvSqrt.pdf), and HC_RSQRT_NEWTON adds two
+ * steps to it. The hc_sqrt*_ps forms compute sqrt(x) as x * rsqrt(x).
+ *
+ * The float functions of this header normalize with hc_rsqrtf, and the batch
+ * forms (hc_vec*_normalize_batch, hc_vec*_distance_batch, the streams and the
+ * quaternion blends) with the vector forms. The approximations expect positive
+ * normal numbers: 0 gives NaN (0 for the square roots), as do denormals on x86.
+ */
+
+// One Newton step refining 'y' (the relative error e becomes about 1.5*e^2)
+HCSAPI float
+hc_rsqrt_newtonf(float x, float y)
+{
+    return y * (1.5f - 0.5f * x * y * y);
+}
+
+HCSAPI float
+hc_rsqrtf(float x)
+{
+#if HC_RSQRT_PRECISION == HC_RSQRT_EXACT
+    return 1.0f / sqrtf(x);
+#else
+#   if defined(HC_MATH_SSE2)
+    float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+#   elif defined(HC_MATH_NEON) && defined(__aarch64__)
+    float y = vrsqrtes_f32(x);
+    y *= vrsqrtss_f32(x * y, y);
+#   else
+    union { float f; uint32_t u; } v = { x };
+    v.u = 0x5f375a86u - (v.u >> 1);
+    float y = hc_rsqrt_newtonf(x, v.f);
+#       if HC_RSQRT_PRECISION == HC_RSQRT_NEWTON
+    y = hc_rsqrt_newtonf(x, y);
+#       endif
+#   endif
+#   if HC_RSQRT_PRECISION == HC_RSQRT_NEWTON
+    y = hc_rsqrt_newtonf(x, y);
+#   endif
+    return y;
+#endif
+}
+
+#if defined(HC_MATH_SSE2)
+
+HCSAPI __m128
+hc_rsqrt_ps(__m128 x)
+{
+#if HC_RSQRT_PRECISION == HC_RSQRT_EXACT
+    return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(x));
+#else
+    __m128 y = _mm_rsqrt_ps(x);
+#   if HC_RSQRT_PRECISION == HC_RSQRT_NEWTON
+    __m128 e = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_mul_ps(x, y), y));
+    y = hc_madd_ps(_mm_mul_ps(_mm_set1_ps(0.5f), y), e, y);
+#   endif
+    return y;
+#endif
+}
+
+HCSAPI __m128
+hc_sqrt_ps(__m128 x)
+{
+#if HC_RSQRT_PRECISION == HC_RSQRT_EXACT
+    return _mm_sqrt_ps(x);
+#else
+    return _mm_and_ps(_mm_mul_ps(x, hc_rsqrt_ps(x)), _mm_cmpgt_ps(x, _mm_setzero_ps()));
+#endif
+}
+
+#elif defined(HC_MATH_NEON)
+
+HCSAPI float32x4_t
+hc_rsqrt_f32(float32x4_t x)
+{
+#if HC_RSQRT_PRECISION == HC_RSQRT_EXACT && defined(__aarch64__)
+    return vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(x));
+#else
+    float32x4_t y = vrsqrteq_f32(x);
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(x, y), y));
+#   if HC_RSQRT_PRECISION != HC_RSQRT_ESTIMATE
+    // Also the exact tier without division on 32-bit ARM
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(x, y), y));
+#   endif
+    return y;
+#endif
+}
+
+HCSAPI float32x4_t
+hc_sqrt_f32(float32x4_t x)
+{
+#if HC_RSQRT_PRECISION == HC_RSQRT_EXACT && defined(__aarch64__)
+    return vsqrtq_f32(x);
+#else
+    uint32x4_t positive = vcgtq_f32(x, vdupq_n_f32(0.0f));
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vmulq_f32(x, hc_rsqrt_f32(x))), positive));
+#endif
+}
+
+#endif // HC_MATH_SSE2
+
+#if defined(HC_MATH_AVX_KERNELS)
+
+// No FMA here, so that the AVX code outside of the kernels can call them
+HC_MATH_TARGET_AVX HCSAPI __m256
+hc_rsqrt256_ps(__m256 x)
+{
+#if HC_RSQRT_PRECISION == HC_RSQRT_EXACT
+    return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(x));
+#else
+    __m256 y = _mm256_rsqrt_ps(x);
+#   if HC_RSQRT_PRECISION == HC_RSQRT_NEWTON
+    __m256 e = _mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(_mm256_mul_ps(x, y), y));
+    y = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), y), e), y);
+#   endif
+    return y;
+#endif
+}
+
+HC_MATH_TARGET_AVX HCSAPI __m256
+hc_sqrt256_ps(__m256 x)
+{
+#if HC_RSQRT_PRECISION == HC_RSQRT_EXACT
+    return _mm256_sqrt_ps(x);
+#else
+    return _mm256_and_ps(_mm256_mul_ps(x, hc_rsqrt256_ps(x)), _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GT_OQ));
+#endif
+}
+
+#endif // HC_MATH_AVX_KERNELS
+
+#if defined(HC_MATH_AVX512_KERNELS)
+
+// The zero-masked forms avoid the undefined source of the plain ones, which g++ warns about in C++
+HC_MATH_TARGET_AVX512 HCSAPI __m512
+hc_rsqrt512_ps(__m512 x)
+{
+#if HC_RSQRT_PRECISION == HC_RSQRT_EXACT
+    return _mm512_div_ps(_mm512_set1_ps(1.0f), _mm512_maskz_sqrt_ps((__mmask16)-1, x));
+#else
+    __m512 y = _mm512_maskz_rsqrt14_ps((__mmask16)-1, x);
+#   if HC_RSQRT_PRECISION == HC_RSQRT_NEWTON
+    __m512 e = _mm512_fnmadd_ps(_mm512_mul_ps(x, y), y, _mm512_set1_ps(1.0f));
+    y = _mm512_fmadd_ps(_mm512_mul_ps(_mm512_set1_ps(0.5f), y), e, y);
+#   endif
+    return y;
+#endif
+}
+
+HC_MATH_TARGET_AVX512 HCSAPI __m512
+hc_sqrt512_ps(__m512 x)
+{
+#if HC_RSQRT_PRECISION == HC_RSQRT_EXACT
+    return _mm512_maskz_sqrt_ps((__mmask16)-1, x);
+#else
+    __mmask16 positive = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_GT_OQ);
+    return _mm512_maskz_mul_ps(positive, x, hc_rsqrt512_ps(x));
+#endif
+}
+
+#endif // HC_MATH_AVX512_KERNELS
+
+/* Fast approximations */
+
+/*
+ * Fast approximations of the libm functions, with minimax polynomials (the
+ * Cephes coefficients) after a range reduction. They don't set errno and are
+ * branch-free, so that the compilers vectorize the loops calling them, and have
+ * 4-wide (SSE2) and 8-wide (AVX2) register forms, hc_fast_<name>_ps and
+ * hc_fast_<name>256_ps, computing the same formulas (up to the last bit with
+ * FMA). Defining HC_MATH_FAST routes the float functions of this header through
+ * them.
+ *
+ * Maximum errors measured against double precision libm:
+ *   sin, cos, sincos   2.5 ulp for |x| <= 8192, the reduction degrades beyond
+ *   tan                3.5 ulp for |x| <= 8192
+ *   atan2              3.5 ulp
+ *   exp                1 ulp for the normal results (1.01 with FMA), the subnormal
+ *                      ones (x < -87.33) are within 0.75 * 2^-149 of exp(x), which
+ *                      is 1.5 ulp of a 24-bit result just below FLT_MIN and a
+ *                      growing relative error further down, as bits are lost
+ *   log                1 ulp, including the subnormal inputs
+ *   pow                exp(y * log(x)): 2 ulp when |y * log(x)| <= 1 and about
+ *                      2.5 * |y * log(x)| ulp beyond, NaN for negative 'x'
+ * sin, cos and tan give meaningless values for |x| >= 2^30 and for non-finite 'x'.
+ */
+
+#define HC_FAST_PIO2_1 1.5703125f                   // pi/2 split in four parts, the first
+#define HC_FAST_PIO2_2 4.837512969970703125e-4f     // ones having 11 significant bits or less
+#define HC_FAST_PIO2_3 7.549533620476722717e-8f     // so that their products by the quadrant
+#define HC_FAST_PIO2_4 2.563344068257089604e-12f    // are exact for |x| <= 8192
+
+HCSAPI uint32_t
+hc_fast_as_u32(float x)
+{
+    union { float f; uint32_t u; } v = { x };
+    return v.u;
+}
+
+HCSAPI float
+hc_fast_as_f32(uint32_t x)
+{
+    union { uint32_t u; float f; } v = { x };
+    return v.f;
+}
+
+// Bitwise 'm ? a : b' for a mask of all ones or zero: no branch, so loops of these functions vectorize
+HCSAPI float
+hc_fast_select(uint32_t m, float a, float b)
+{
+    return hc_fast_as_f32((hc_fast_as_u32(a) & m) | (hc_fast_as_u32(b) & ~m));
+}
+
+HCSAPI uint32_t
+hc_fast_mask(int cond)
+{
+    return 0u - (uint32_t)(cond != 0);
+}
+
+// Reduces 'x' to 'r' in [-pi/4, pi/4] such as x = r + q*pi/2, returns q
+HCSAPI int32_t
+hc_fast_reduce_pio2(float x, float* r)
+{
+    float t = x * 0.636619772f;
+    t = hc_fast_select(hc_fast_mask(fabsf(t) < 1073741824.0f), t, 0.0f);   // Keeps the conversion defined
+    float q = (float)(int32_t)(t + (t < 0.0f ? -0.5f : 0.5f));
+    *r = (((x - q * HC_FAST_PIO2_1) - q * HC_FAST_PIO2_2) - q * HC_FAST_PIO2_3) - q * HC_FAST_PIO2_4;
+    return (int32_t)q;
+}
+
+HCSAPI float
+hc_fast_sin_poly(float r, float z)
+{
+    return r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+}
+
+HCSAPI float
+hc_fast_cos_poly(float z)
+{
+    return 1.0f - 0.5f * z + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+}
+
+HCSAPI void
+hc_fast_sincosf(float x, float* s, float* c)
+{
+    float r;
+    int32_t q = hc_fast_reduce_pio2(x, &r);
+    float z = r * r;
+    float ps = hc_fast_sin_poly(r, z);
+    float pc = hc_fast_cos_poly(z);
+
+    uint32_t swap = hc_fast_mask(q & 1);
+    *s = hc_fast_as_f32(hc_fast_as_u32(hc_fast_select(swap, pc, ps)) ^ ((uint32_t)(q & 2) << 30));
+    *c = hc_fast_as_f32(hc_fast_as_u32(hc_fast_select(swap, ps, pc)) ^ ((uint32_t)((q + 1) & 2) << 30));
+}
+
+HCSAPI float
+hc_fast_sinf(float x)
+{
+    float s, c;
+    hc_fast_sincosf(x, &s, &c);
+    return s;
+}
+
+HCSAPI float
+hc_fast_cosf(float x)
+{
+    float s, c;
+    hc_fast_sincosf(x, &s, &c);
+    return c;
+}
+
+HCSAPI float
+hc_fast_tanf(float x)
+{
+    float r;
+    int32_t q = hc_fast_reduce_pio2(x, &r);
+    float z = r * r;
+
+    float y = 9.38540185543e-3f;
+    y = y * z + 3.11992232697e-3f;
+    y = y * z + 2.44301354525e-2f;
+    y = y * z + 5.34112807005e-2f;
+    y = y * z + 1.33387994085e-1f;
+    y = y * z + 3.33331568548e-1f;
+    y = y * z * r + r;
+
+    // tan(r + pi/2) = -1/tan(r)
+    return hc_fast_select(hc_fast_mask(q & 1), -1.0f / y, y);
+}
+
+HCSAPI float
+hc_fast_atan2f(float y, float x)
+{
+    float ax = fabsf(x), ay = fabsf(y);
+    uint32_t steep = hc_fast_mask(ay > ax);
+    float mx = hc_fast_select(steep, ay, ax);
+    float mn = hc_fast_select(steep, ax, ay);
+    float a = mn / hc_fast_select(hc_fast_mask(mx > 0.0f), mx, 1.0f);
+
+    // atan(a) for a in [0, 1], reduced to [-tan(pi/8), tan(pi/8)]
+    uint32_t big = hc_fast_mask(a > 0.414213562f);
+    a = hc_fast_select(big, (a - 1.0f) / (a + 1.0f), a);
+
+    float z = a * a;
+    float p = 8.05374449538e-2f;
+    p = p * z - 1.38776856032e-1f;
+    p = p * z + 1.99777106478e-1f;
+    p = p * z - 3.33329491539e-1f;
+    p = p * z * a + a + hc_fast_as_f32(big & hc_fast_as_u32(0.785398163f));
+
+    // Back to the octant, then the quadrant
+    p = hc_fast_select(steep, 1.57079633f - p, p);
+    p = hc_fast_select(0u - (hc_fast_as_u32(x) >> 31), 3.14159265f - p, p);
+    p = hc_fast_as_f32(hc_fast_as_u32(p) | (hc_fast_as_u32(y) & 0x80000000u));
+    return hc_fast_select(hc_fast_mask(x != x || y != y), x + y, p);
+}
+
+HCSAPI float
+hc_fast_expf(float x)
+{
+    uint32_t over = hc_fast_mask(x > 88.7228394f);
+    uint32_t under = hc_fast_mask(x < -103.972084f);
+    float xc = hc_fast_select(over, 88.7228394f, hc_fast_select(under, -103.972084f, x));
+    xc = hc_fast_select(hc_fast_mask(x != x), 0.0f, xc);
+
+    // exp(x) = 2^n * exp(r) with |r| <= ln(2)/2
+    float n = (float)(int32_t)(xc * 1.44269504f + (xc < 0.0f ? -0.5f : 0.5f));
+    float r = (xc - n * 0.693359375f) + n * 2.12194440e-4f;
+
+    float p = 1.9875691500e-4f;
+    p = p * r + 1.3981999507e-3f;
+    p = p * r + 8.3334519073e-3f;
+    p = p * r + 4.1665795894e-2f;
+    p = p * r + 1.6666665459e-1f;
+    p = p * r + 5.0000001201e-1f;
+    p = p * r * r + r + 1.0f;
+
+    // 2^n in two factors, so that both stay normal down to the subnormal results
+    int32_t n1 = (int32_t)n >> 1, n2 = (int32_t)n - n1;
+    p = p * hc_fast_as_f32((uint32_t)(n1 + 127) << 23) * hc_fast_as_f32((uint32_t)(n2 + 127) << 23);
+
+    p = hc_fast_select(over, HUGE_VALF, hc_fast_as_f32(hc_fast_as_u32(p) & ~under));
+    return hc_fast_select(hc_fast_mask(x != x), x, p);
+}
+
+HCSAPI float
+hc_fast_logf(float x)
+{
+    // Subnormals scaled by 2^23
+    uint32_t sub = hc_fast_mask(x < 1.17549435e-38f);
+    uint32_t bits = hc_fast_as_u32(hc_fast_select(sub, x * 8388608.0f, x));
+    int32_t e = (int32_t)(bits >> 23 & 0xff) - 126 - (int32_t)(sub & 23);
+
+    // x = m * 2^e with m in [sqrt(1/2), sqrt(2)), f = m - 1
+    float m = hc_fast_as_f32((bits & 0x007fffff) | 0x3f000000);
+    uint32_t small = hc_fast_mask(m < 0.707106781f);
+    e -= (int32_t)(small & 1);
+    m += hc_fast_as_f32(hc_fast_as_u32(m) & small);
+    float f = m - 1.0f;
+    float z = f * f;
+
+    float y = 7.0376836292e-2f;
+    y = y * f - 1.1514610310e-1f;
+    y = y * f + 1.1676998740e-1f;
+    y = y * f - 1.2420140846e-1f;
+    y = y * f + 1.4249322787e-1f;
+    y = y * f - 1.6668057665e-1f;
+    y = y * f + 2.0000714765e-1f;
+    y = y * f - 2.4999993993e-1f;
+    y = y * f + 3.3333331174e-1f;
+    y = y * f * z;
+
+    float ef = (float)e;
+    y += -2.12194440e-4f * ef;
+    y += -0.5f * z;
+    float res = (f + y) + 0.693359375f * ef;
+
+    res = hc_fast_select(hc_fast_mask(x == HUGE_VALF), x, res);
+    res = hc_fast_select(hc_fast_mask(x == 0.0f), -HUGE_VALF, res);
+    return hc_fast_select(hc_fast_mask(!(x >= 0.0f)), NAN, res);
+}
+
+HCSAPI float
+hc_fast_powf(float x, float y)
+{
+    // Negative 'x' gives NaN through the logarithm
+    float res = hc_fast_expf(y * hc_fast_logf(x));
+    return hc_fast_select(hc_fast_mask(y == 0.0f || x == 1.0f), 1.0f, res);
+}
+
+// The register forms are written once, in the HC_MATH_FAST_TEMPLATE section at the
+// end of this file, in terms of the macros below, and instantiated per width
+
+#if defined(HC_MATH_SSE2)
+#define HC_MATH_FAST_TEMPLATE
+
+#define HC_VF __m128
+#define HC_VI __m128i
+#define HC_VFN(name) hc_fast_ ## name ## _ps
+#define HC_VSET1(x) _mm_set1_ps(x)
+#define HC_VADD(a, b) _mm_add_ps(a, b)
+#define HC_VSUB(a, b) _mm_sub_ps(a, b)
+#define HC_VMUL(a, b) _mm_mul_ps(a, b)
+#define HC_VDIV(a, b) _mm_div_ps(a, b)
+#define HC_VMADD(a, b, c) hc_madd_ps(a, b, c)
+#define HC_VMIN(a, b) _mm_min_ps(a, b)
+#define HC_VMAX(a, b) _mm_max_ps(a, b)
+#define HC_VAND(a, b) _mm_and_ps(a, b)
+#define HC_VOR(a, b) _mm_or_ps(a, b)
+#define HC_VXOR(a, b) _mm_xor_ps(a, b)
+#define HC_VANDNOT(a, b) _mm_andnot_ps(a, b)        // ~a & b
+#define HC_VCMPLT(a, b) _mm_cmplt_ps(a, b)
+#define HC_VCMPGT(a, b) _mm_cmpgt_ps(a, b)
+#define HC_VCMPEQ(a, b) _mm_cmpeq_ps(a, b)
+#define HC_VCMPNGE(a, b) _mm_cmpnge_ps(a, b)        // !(a >= b), true for NaN
+#define HC_VCMPUNORD(a, b) _mm_cmpunord_ps(a, b)
+#if defined(HC_MATH_SSE41)
+#   define HC_VSEL(m, a, b) _mm_blendv_ps(b, a, m)  // m ? a : b
+#else
+#   define HC_VSEL(m, a, b) _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b))
+#endif
+#define HC_VCVTI(x) _mm_cvtps_epi32(x)              // Rounded to nearest
+#define HC_VCVTF(x) _mm_cvtepi32_ps(x)
+#define HC_VASI(x) _mm_castps_si128(x)
+#define HC_VASF(x) _mm_castsi128_ps(x)
+#define HC_VISET1(x) _mm_set1_epi32(x)
+#define HC_VIADD(a, b) _mm_add_epi32(a, b)
+#define HC_VISUB(a, b) _mm_sub_epi32(a, b)
+#define HC_VIAND(a, b) _mm_and_si128(a, b)
+#define HC_VICMPEQ(a, b) _mm_cmpeq_epi32(a, b)
+#define HC_VISLLI(a, n) _mm_slli_epi32(a, n)
+#define HC_VISRLI(a, n) _mm_srli_epi32(a, n)
+#define HC_VISRAI(a, n) _mm_srai_epi32(a, n)
+#include HC_MATH_SELF
+#undef HC_VF
+#undef HC_VI
+#undef HC_VFN
+#undef HC_VSET1
+#undef HC_VADD
+#undef HC_VSUB
+#undef HC_VMUL
+#undef HC_VDIV
+#undef HC_VMADD
+#undef HC_VMIN
+#undef HC_VMAX
+#undef HC_VAND
+#undef HC_VOR
+#undef HC_VXOR
+#undef HC_VANDNOT
+#undef HC_VCMPLT
+#undef HC_VCMPGT
+#undef HC_VCMPEQ
+#undef HC_VCMPNGE
+#undef HC_VCMPUNORD
+#undef HC_VSEL
+#undef HC_VCVTI
+#undef HC_VCVTF
+#undef HC_VASI
+#undef HC_VASF
+#undef HC_VISET1
+#undef HC_VIADD
+#undef HC_VISUB
+#undef HC_VIAND
+#undef HC_VICMPEQ
+#undef HC_VISLLI
+#undef HC_VISRLI
+#undef HC_VISRAI
+
+#if defined(HC_MATH_AVX2)       // The 8-wide forms need the AVX2 integer instructions
+#define HC_VF __m256
+#define HC_VI __m256i
+#define HC_VFN(name) hc_fast_ ## name ## 256_ps
+#define HC_VSET1(x) _mm256_set1_ps(x)
+#define HC_VADD(a, b) _mm256_add_ps(a, b)
+#define HC_VSUB(a, b) _mm256_sub_ps(a, b)
+#define HC_VMUL(a, b) _mm256_mul_ps(a, b)
+#define HC_VDIV(a, b) _mm256_div_ps(a, b)
+#define HC_VMADD(a, b, c) hc_madd256_ps(a, b, c)
+#define HC_VMIN(a, b) _mm256_min_ps(a, b)
+#define HC_VMAX(a, b) _mm256_max_ps(a, b)
+#define HC_VAND(a, b) _mm256_and_ps(a, b)
+#define HC_VOR(a, b) _mm256_or_ps(a, b)
+#define HC_VXOR(a, b) _mm256_xor_ps(a, b)
+#define HC_VANDNOT(a, b) _mm256_andnot_ps(a, b)
+#define HC_VCMPLT(a, b) _mm256_cmp_ps(a, b, _CMP_LT_OQ)
+#define HC_VCMPGT(a, b) _mm256_cmp_ps(a, b, _CMP_GT_OQ)
+#define HC_VCMPEQ(a, b) _mm256_cmp_ps(a, b, _CMP_EQ_OQ)
+#define HC_VCMPNGE(a, b) _mm256_cmp_ps(a, b, _CMP_NGE_UQ)
+#define HC_VCMPUNORD(a, b) _mm256_cmp_ps(a, b, _CMP_UNORD_Q)
+#define HC_VSEL(m, a, b) _mm256_blendv_ps(b, a, m)
+#define HC_VCVTI(x) _mm256_cvtps_epi32(x)
+#define HC_VCVTF(x) _mm256_cvtepi32_ps(x)
+#define HC_VASI(x) _mm256_castps_si256(x)
+#define HC_VASF(x) _mm256_castsi256_ps(x)
+#define HC_VISET1(x) _mm256_set1_epi32(x)
+#define HC_VIADD(a, b) _mm256_add_epi32(a, b)
+#define HC_VISUB(a, b) _mm256_sub_epi32(a, b)
+#define HC_VIAND(a, b) _mm256_and_si256(a, b)
+#define HC_VICMPEQ(a, b) _mm256_cmpeq_epi32(a, b)
+#define HC_VISLLI(a, n) _mm256_slli_epi32(a, n)
+#define HC_VISRLI(a, n) _mm256_srli_epi32(a, n)
+#define HC_VISRAI(a, n) _mm256_srai_epi32(a, n)
+#include HC_MATH_SELF
+#undef HC_VF
+#undef HC_VI
+#undef HC_VFN
+#undef HC_VSET1
+#undef HC_VADD
+#undef HC_VSUB
+#undef HC_VMUL
+#undef HC_VDIV
+#undef HC_VMADD
+#undef HC_VMIN
+#undef HC_VMAX
+#undef HC_VAND
+#undef HC_VOR
+#undef HC_VXOR
+#undef HC_VANDNOT
+#undef HC_VCMPLT
+#undef HC_VCMPGT
+#undef HC_VCMPEQ
+#undef HC_VCMPNGE
+#undef HC_VCMPUNORD
+#undef HC_VSEL
+#undef HC_VCVTI
+#undef HC_VCVTF
+#undef HC_VASI
+#undef HC_VASF
+#undef HC_VISET1
+#undef HC_VIADD
+#undef HC_VISUB
+#undef HC_VIAND
+#undef HC_VICMPEQ
+#undef HC_VISLLI
+#undef HC_VISRLI
+#undef HC_VISRAI
+#endif // HC_MATH_AVX2
+
+#undef HC_MATH_FAST_TEMPLATE
+#endif // HC_MATH_SSE2
+
+// Functions used by this header, define HC_MATH_FAST to route them through the approximations
+#ifdef HC_MATH_FAST
+#   define hc_math_sinf(x) hc_fast_sinf(x)
+#   define hc_math_cosf(x) hc_fast_cosf(x)
+#   define hc_math_tanf(x) hc_fast_tanf(x)
+#   define hc_math_expf(x) hc_fast_expf(x)
+#else
+#   define hc_math_sinf(x) sinf(x)
+#   define hc_math_cosf(x) cosf(x)
+#   define hc_math_tanf(x) tanf(x)
+#   define hc_math_expf(x) expf(x)
+#endif // HC_MATH_FAST
+
+
 /* Scalar functions */
 
 HCSAPI int
@@ -166,126 +927,2808 @@ hc_approx(float a, float b, float epsilon)
     return fabsf(a - b) < epsilon;
 }
 
-HCSAPI float
-hc_lerp(float a, float b, float t)
+HCSAPI float
+hc_lerp(float a, float b, float t)
+{
+    return a + t * (b - a);
+}
+
+HCSAPI float
+hc_lerp_angle(float a, float b, float t)
+{
+    float diff = hc_wrap_angle(b - a);
+    return a + diff * t;
+}
+
+HCSAPI float
+hc_inverse_lerp(float a, float b, float value)
+{
+    return (value - a) / (b - a);
+}
+
+HCSAPI float
+hc_smoothstep(float edge0, float edge1, float x)
+{
+    float t = (x - edge0) / (edge1 - edge0);
+    t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+    return t * t * t * (t * (t * 6 - 15) + 10);
+}
+
+HCSAPI float
+hc_exp_decay(float initial, float decay_rate, float time)
+{
+    return initial * hc_math_expf(-decay_rate * time);
+}
+
+HCSAPI float
+hc_move_towards(float current, float target, float max_delta)
+{
+    float delta = target - current;
+    float distance = fabsf(delta);
+    if (distance <= max_delta) return target;
+    else return current + (delta / distance) * max_delta;
+}
+
+HCSAPI uint32_t
+hc_next_po2(uint32_t x)
+{
+    if (x == 0) return 1;
+    if ((x & (x - 1)) == 0) return x << 1; // (x * 2)
+    x--;
+    x |= x >> 1;
+    x |= x >> 2;
+    x |= x >> 4;
+    x |= x >> 8;
+    x |= x >> 16;
+    x++;
+    return x;
+}
+
+HCSAPI uint32_t
+hc_previous_po2(uint32_t x)
+{
+    if (x == 0) return 0;
+    if ((x & (x - 1)) == 0) return x >> 1; // (x / 2)
+    x |= x >> 1;
+    x |= x >> 2;
+    x |= x >> 4;
+    x |= x >> 8;
+    x |= x >> 16;
+    return x - (x >> 1);
+}
+
+HCSAPI uint32_t
+hc_nearest_po2(uint32_t x)
+{
+    uint32_t next = hc_next_po2(x);
+    uint32_t prev = hc_previous_po2(x);
+    return (x - prev < next - x) ? prev : next;
+}
+
+HCSAPI uint64_t
+hc_next_po2_u64(uint64_t x)
+{
+    if (x == 0) return 1;
+    if ((x & (x - 1)) == 0) return x << 1; // (x * 2)
+    x--;
+    x |= x >> 1;
+    x |= x >> 2;
+    x |= x >> 4;
+    x |= x >> 8;
+    x |= x >> 16;
+    x |= x >> 32; //< Only for 64 bits
+    x++;
+    return x;
+}
+
+HCSAPI uint64_t
+hc_previous_po2_u64(uint64_t x)
+{
+    if (x == 0) return 0;
+    if ((x & (x - 1)) == 0) return x >> 1; // (x / 2)
+    x |= x >> 1;
+    x |= x >> 2;
+    x |= x >> 4;
+    x |= x >> 8;
+    x |= x >> 16;
+    x |= x >> 32; //< Only for 64 bits
+    return x - (x >> 1);
+}
+
+HCSAPI uint64_t
+hc_nearest_po2_u64(uint64_t x)
+{
+    uint64_t next = hc_next_po2_u64(x);
+    uint64_t prev = hc_previous_po2_u64(x);
+    return (x - prev < next - x) ? prev : next;
+}
+
+/*
+ * Vector and matrix functions: they are written once, in the HC_MATH_TEMPLATE
+ * section at the end of this file, in terms of the macros below, and this header
+ * includes itself to instantiate them for float (hc_vec3_t, hc_mat4_t, ...)
+ * and for double (hc_dvec3_t, hc_dmat4_t, ...). The double functions have a
+ * 'd' before the type in their name: hc_dvec3_add, hc_length_sq_dvec3, ...
+ * The functions with SIMD paths are written per type after the instantiations.
+ */
+
+#define HC_MATH_CAT_(a, b, c) a ## b ## c
+#define HC_MATH_CAT(a, b, c) HC_MATH_CAT_(a, b, c)
+
+#define HC_FN(prefix, name) HC_MATH_CAT(prefix, HC_TP, name)    // Name for the current type
+#define HC_VEC2_T HC_FN(hc_, vec2_t)
+#define HC_VEC2_PTR_T HC_FN(hc_, vec2_ptr_t)
+#define HC_VEC3_T HC_FN(hc_, vec3_t)
+#define HC_VEC3_PTR_T HC_FN(hc_, vec3_ptr_t)
+#define HC_VEC4_T HC_FN(hc_, vec4_t)
+#define HC_VEC4_PTR_T HC_FN(hc_, vec4_ptr_t)
+#define HC_MAT4_T HC_FN(hc_, mat4_t)
+#define HC_MAT4_PTR_T HC_FN(hc_, mat4_ptr_t)
+#define HC_MAT4_CPTR_T HC_FN(hc_, mat4_cptr_t)
+
+#define HC_MATH_TEMPLATE
+
+#define HC_T float
+#define HC_TP
+#define HC_R(x) x ## f                  // Literal of the current type
+#define HC_SQRT sqrtf
+#define HC_SIN hc_math_sinf
+#define HC_COS hc_math_cosf
+#define HC_TAN hc_math_tanf
+#define HC_RSQRT hc_rsqrtf
+#include HC_MATH_SELF
+#undef HC_T
+#undef HC_TP
+#undef HC_R
+#undef HC_SQRT
+#undef HC_SIN
+#undef HC_COS
+#undef HC_TAN
+#undef HC_RSQRT
+
+#define HC_T double
+#define HC_TP d
+#define HC_R(x) x
+#define HC_SQRT sqrt
+#define HC_SIN sin
+#define HC_COS cos
+#define HC_TAN tan
+#define HC_RSQRT(x) (1.0 / sqrt(x))
+#include HC_MATH_SELF
+#undef HC_T
+#undef HC_TP
+#undef HC_R
+#undef HC_SQRT
+#undef HC_SIN
+#undef HC_COS
+#undef HC_TAN
+#undef HC_RSQRT
+
+#undef HC_MATH_TEMPLATE
+#undef HC_VEC2_T
+#undef HC_VEC2_PTR_T
+#undef HC_VEC3_T
+#undef HC_VEC3_PTR_T
+#undef HC_VEC4_T
+#undef HC_VEC4_PTR_T
+#undef HC_MAT4_T
+#undef HC_MAT4_PTR_T
+#undef HC_MAT4_CPTR_T
+#undef HC_FN
+#undef HC_MATH_CAT
+#undef HC_MATH_CAT_
+
+/* 2D Vector batch transforms */
+
+#if defined(HC_MATH_AVX_KERNELS)
+// AVX part of the batch transform (packed vectors), returns the number of vectors done
+HC_MATH_TARGET_AVX2 HCSAPI size_t
+hc_vec2_transform_wt_batch_avx(hc_vec2_ptr_t dst, hc_vec2_cptr_t src, size_t count, float w_translation, const hc_mat4_t mat)
+{
+    size_t i = 0;
+
+    const __m256 m0 = _mm256_set1_ps(mat[0]), m1 = _mm256_set1_ps(mat[1]);
+    const __m256 m4 = _mm256_set1_ps(mat[4]), m5 = _mm256_set1_ps(mat[5]);
+    const __m256 t0 = _mm256_set1_ps(w_translation * mat[12]);
+    const __m256 t1 = _mm256_set1_ps(w_translation * mat[13]);
+    for (; i < (count & ~(size_t)7); i += 8) {
+        __m256 a = _mm256_loadu_ps(src + 2 * i);
+        __m256 b = _mm256_loadu_ps(src + 2 * i + 8);
+        __m256 x = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 y = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        __m256 rx = hc_madd256_kernel_ps(m4, y, hc_madd256_kernel_ps(m0, x, t0));
+        __m256 ry = hc_madd256_kernel_ps(m5, y, hc_madd256_kernel_ps(m1, x, t1));
+        _mm256_storeu_ps(dst + 2 * i, _mm256_unpacklo_ps(rx, ry));
+        _mm256_storeu_ps(dst + 2 * i + 8, _mm256_unpackhi_ps(rx, ry));
+    }
+
+    return i;
+}
+#endif
+
+/*
+ * Batch transforms: 'stride' is the distance in bytes between two consecutive
+ * vectors of 'src' and 'dst' (0 if they are packed), and 'dst' may be 'src'.
+ */
+
+HCSAPI void
+hc_vec2_transform_wt_batch_generic(hc_vec2_ptr_t dst, hc_vec2_cptr_t src, size_t count, size_t stride, float w_translation, const hc_mat4_t mat)
+{
+    if (stride == 0) stride = sizeof(hc_vec2_t);
+
+    size_t i = 0;
+
+#if defined(HC_MATH_AVX_BATCH)
+    if (stride == sizeof(hc_vec2_t)) {
+        i = hc_vec2_transform_wt_batch_avx(dst, src, count, w_translation, mat);
+    }
+#endif
+
+    // Matrix copied into locals, it could otherwise be reloaded for each vector
+    const float m0 = mat[0], m1 = mat[1], m4 = mat[4], m5 = mat[5];
+    const float t0 = w_translation * mat[12], t1 = w_translation * mat[13];
+
+    for (; i < count; i++) {
+        const float *v = (const float*)((const char*)src + i * stride);
+        float *d = (float*)((char*)dst + i * stride);
+        float x = v[0], y = v[1];
+        d[0] = m0 * x + m4 * y + t0;
+        d[1] = m1 * x + m5 * y + t1;
+    }
+}
+
+HCSAPI void
+hc_vec2_transform_wt_batch(hc_vec2_ptr_t dst, hc_vec2_cptr_t src, size_t count, size_t stride, float w_translation, const hc_mat4_t mat)
+{
+#if defined(HC_MATH_DISPATCH)
+    HC_MATH_KERNEL(vec2_transform_wt_batch)(dst, src, count, stride, w_translation, mat);
+#else
+    hc_vec2_transform_wt_batch_generic(dst, src, count, stride, w_translation, mat);
+#endif
+}
+
+HCSAPI void
+hc_vec2_transform_batch(hc_vec2_ptr_t dst, hc_vec2_cptr_t src, size_t count, size_t stride, const hc_mat4_t mat)
+{
+    hc_vec2_transform_wt_batch(dst, src, count, stride, 1.0f, mat);
+}
+
+/*
+ * Batch normalization and distances, 'stride' being the same as above. Zero
+ * vectors are copied as they are, and the precision is HC_RSQRT_PRECISION.
+ */
+
+HCSAPI void
+hc_vec2_normalize_batch(hc_vec2_ptr_t dst, hc_vec2_cptr_t src, size_t count, size_t stride)
+{
+    if (stride == 0) stride = sizeof(hc_vec2_t);
+
+    size_t i = 0;
+
+#if defined(HC_MATH_SSE2)
+    if (stride == sizeof(hc_vec2_t)) {
+        const __m128 one = _mm_set1_ps(1.0f);
+        for (; i < (count & ~(size_t)3); i += 4) {
+            __m128 a = _mm_loadu_ps(src + 2 * i), b = _mm_loadu_ps(src + 2 * i + 4);
+            __m128 x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            __m128 sq = hc_madd_ps(y, y, _mm_mul_ps(x, x));
+            __m128 nonzero = _mm_cmpgt_ps(sq, _mm_setzero_ps());
+            __m128 inv = _mm_or_ps(_mm_and_ps(nonzero, hc_rsqrt_ps(sq)), _mm_andnot_ps(nonzero, one));
+            x = _mm_mul_ps(x, inv), y = _mm_mul_ps(y, inv);
+            _mm_storeu_ps(dst + 2 * i, _mm_unpacklo_ps(x, y));
+            _mm_storeu_ps(dst + 2 * i + 4, _mm_unpackhi_ps(x, y));
+        }
+    }
+#elif defined(HC_MATH_NEON)
+    if (stride == sizeof(hc_vec2_t)) {
+        for (; i < (count & ~(size_t)3); i += 4) {
+            float32x4x2_t v = vld2q_f32(src + 2 * i);
+            float32x4_t sq = vmlaq_f32(vmulq_f32(v.val[0], v.val[0]), v.val[1], v.val[1]);
+            float32x4_t inv = vbslq_f32(vcgtq_f32(sq, vdupq_n_f32(0.0f)), hc_rsqrt_f32(sq), vdupq_n_f32(1.0f));
+            v.val[0] = vmulq_f32(v.val[0], inv), v.val[1] = vmulq_f32(v.val[1], inv);
+            vst2q_f32(dst + 2 * i, v);
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        const float *v = (const float*)((const char*)src + i * stride);
+        float *d = (float*)((char*)dst + i * stride);
+        float x = v[0], y = v[1], sq = x * x + y * y;
+        float inv = (sq > 0.0f) ? hc_rsqrtf(sq) : 1.0f;
+        d[0] = x * inv, d[1] = y * inv;
+    }
+}
+
+/* dst[i] = distance(v1[i], v2[i]), both arrays having the same 'stride' */
+HCSAPI void
+hc_vec2_distance_batch(float* dst, hc_vec2_cptr_t v1, hc_vec2_cptr_t v2, size_t count, size_t stride)
+{
+    if (stride == 0) stride = sizeof(hc_vec2_t);
+
+    size_t i = 0;
+
+#if defined(HC_MATH_SSE2)
+    if (stride == sizeof(hc_vec2_t)) {
+        for (; i < (count & ~(size_t)3); i += 4) {
+            __m128 a = _mm_sub_ps(_mm_loadu_ps(v2 + 2 * i), _mm_loadu_ps(v1 + 2 * i));
+            __m128 b = _mm_sub_ps(_mm_loadu_ps(v2 + 2 * i + 4), _mm_loadu_ps(v1 + 2 * i + 4));
+            __m128 dx = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 dy = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            _mm_storeu_ps(dst + i, hc_sqrt_ps(hc_madd_ps(dy, dy, _mm_mul_ps(dx, dx))));
+        }
+    }
+#elif defined(HC_MATH_NEON)
+    if (stride == sizeof(hc_vec2_t)) {
+        for (; i < (count & ~(size_t)3); i += 4) {
+            float32x4x2_t a = vld2q_f32(v1 + 2 * i), b = vld2q_f32(v2 + 2 * i);
+            float32x4_t dx = vsubq_f32(b.val[0], a.val[0]), dy = vsubq_f32(b.val[1], a.val[1]);
+            vst1q_f32(dst + i, hc_sqrt_f32(vmlaq_f32(vmulq_f32(dx, dx), dy, dy)));
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        const float *a = (const float*)((const char*)v1 + i * stride);
+        const float *b = (const float*)((const char*)v2 + i * stride);
+        float dx = b[0] - a[0], dy = b[1] - a[1];
+        dst[i] = sqrtf(dx * dx + dy * dy);
+    }
+}
+
+/* 3D Vector batch transforms */
+
+#if defined(HC_MATH_AVX_KERNELS)
+// AVX part of the batch transform (packed vectors), returns the number of vectors done
+HC_MATH_TARGET_AVX2 HCSAPI size_t
+hc_vec3_transform_wt_batch_avx(hc_vec3_ptr_t dst, hc_vec3_cptr_t src, size_t count, float w_translation, const hc_mat4_t mat)
+{
+    size_t i = 0;
+
+    __m256 m[9], t[3];
+    for (int_fast8_t k = 0; k < 3; k++) {
+        m[k] = _mm256_set1_ps(mat[k]);
+        m[k + 3] = _mm256_set1_ps(mat[k + 4]);
+        m[k + 6] = _mm256_set1_ps(mat[k + 8]);
+        t[k] = _mm256_set1_ps(w_translation * mat[k + 12]);
+    }
+    for (; i < (count & ~(size_t)7); i += 8) {
+        const float *p = src + 3 * i;
+        __m256 m03 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+        __m256 m14 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+        __m256 m25 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+        __m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+        __m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+        __m256 x = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+        __m256 y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        __m256 z = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+
+        __m256 rx = hc_madd256_kernel_ps(m[6], z, hc_madd256_kernel_ps(m[3], y, hc_madd256_kernel_ps(m[0], x, t[0])));
+        __m256 ry = hc_madd256_kernel_ps(m[7], z, hc_madd256_kernel_ps(m[4], y, hc_madd256_kernel_ps(m[1], x, t[1])));
+        __m256 rz = hc_madd256_kernel_ps(m[8], z, hc_madd256_kernel_ps(m[5], y, hc_madd256_kernel_ps(m[2], x, t[2])));
+
+        __m256 rxy = _mm256_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 ryz = _mm256_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 1, 3, 1));
+        __m256 rzx = _mm256_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 1, 2, 0));
+        __m256 r03 = _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 r14 = _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0));
+        __m256 r25 = _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1));
+
+        float *d = dst + 3 * i;
+        _mm_storeu_ps(d, _mm256_castps256_ps128(r03));
+        _mm_storeu_ps(d + 4, _mm256_castps256_ps128(r14));
+        _mm_storeu_ps(d + 8, _mm256_castps256_ps128(r25));
+        _mm_storeu_ps(d + 12, _mm256_extractf128_ps(r03, 1));
+        _mm_storeu_ps(d + 16, _mm256_extractf128_ps(r14, 1));
+        _mm_storeu_ps(d + 20, _mm256_extractf128_ps(r25, 1));
+    }
+
+    return i;
+}
+#endif
+
+/*
+ * Batch transforms: 'stride' is the distance in bytes between two consecutive
+ * vectors of 'src' and 'dst' (0 if they are packed), and 'dst' may be 'src'.
+ * Packed vectors are transposed to SoA form in registers, 8 (AVX) or 4 (SSE)
+ * at a time. Use 'w_translation' 1 for positions and 0 for directions.
+ */
+
+HCSAPI void
+hc_vec3_transform_wt_batch_generic(hc_vec3_ptr_t dst, hc_vec3_cptr_t src, size_t count, size_t stride, float w_translation, const hc_mat4_t mat)
+{
+    if (stride == 0) stride = sizeof(hc_vec3_t);
+
+    size_t i = 0;
+
+#if defined(HC_MATH_AVX_BATCH)
+    if (stride == sizeof(hc_vec3_t)) {
+        i = hc_vec3_transform_wt_batch_avx(dst, src, count, w_translation, mat);
+    }
+#endif
+
+#if defined(HC_MATH_SSE2)
+    if (stride == sizeof(hc_vec3_t)) {
+        __m128 m[9], t[3];
+        for (int_fast8_t k = 0; k < 3; k++) {
+            m[k] = _mm_set1_ps(mat[k]);
+            m[k + 3] = _mm_set1_ps(mat[k + 4]);
+            m[k + 6] = _mm_set1_ps(mat[k + 8]);
+            t[k] = _mm_set1_ps(w_translation * mat[k + 12]);
+        }
+        for (; i < (count & ~(size_t)3); i += 4) {
+            const float *p = src + 3 * i;
+            __m128 m03 = _mm_loadu_ps(p), m14 = _mm_loadu_ps(p + 4), m25 = _mm_loadu_ps(p + 8);
+            __m128 xy = _mm_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+            __m128 yz = _mm_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+            __m128 x = _mm_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+            __m128 y = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+            __m128 z = _mm_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+
+            __m128 rx = hc_madd_ps(m[6], z, hc_madd_ps(m[3], y, hc_madd_ps(m[0], x, t[0])));
+            __m128 ry = hc_madd_ps(m[7], z, hc_madd_ps(m[4], y, hc_madd_ps(m[1], x, t[1])));
+            __m128 rz = hc_madd_ps(m[8], z, hc_madd_ps(m[5], y, hc_madd_ps(m[2], x, t[2])));
+
+            __m128 rxy = _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 ryz = _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 1, 3, 1));
+            __m128 rzx = _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 1, 2, 0));
+
+            float *d = dst + 3 * i;
+            _mm_storeu_ps(d, _mm_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(d + 4, _mm_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0)));
+            _mm_storeu_ps(d + 8, _mm_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+    }
+#endif
+
+    // Matrix copied into locals, it could otherwise be reloaded for each vector
+    const float m0 = mat[0], m1 = mat[1], m2 = mat[2];
+    const float m4 = mat[4], m5 = mat[5], m6 = mat[6];
+    const float m8 = mat[8], m9 = mat[9], m10 = mat[10];
+    const float t0 = w_translation * mat[12], t1 = w_translation * mat[13], t2 = w_translation * mat[14];
+
+    for (; i < count; i++) {
+        const float *v = (const float*)((const char*)src + i * stride);
+        float *d = (float*)((char*)dst + i * stride);
+        float x = v[0], y = v[1], z = v[2];
+        d[0] = m0 * x + m4 * y + m8 * z + t0;
+        d[1] = m1 * x + m5 * y + m9 * z + t1;
+        d[2] = m2 * x + m6 * y + m10 * z + t2;
+    }
+}
+
+HCSAPI void
+hc_vec3_transform_wt_batch(hc_vec3_ptr_t dst, hc_vec3_cptr_t src, size_t count, size_t stride, float w_translation, const hc_mat4_t mat)
+{
+#if defined(HC_MATH_DISPATCH)
+    HC_MATH_KERNEL(vec3_transform_wt_batch)(dst, src, count, stride, w_translation, mat);
+#else
+    hc_vec3_transform_wt_batch_generic(dst, src, count, stride, w_translation, mat);
+#endif
+}
+
+HCSAPI void
+hc_vec3_transform_batch(hc_vec3_ptr_t dst, hc_vec3_cptr_t src, size_t count, size_t stride, const hc_mat4_t mat)
+{
+    hc_vec3_transform_wt_batch(dst, src, count, stride, 1.0f, mat);
+}
+
+#if defined(HC_MATH_AVX_KERNELS)
+// AVX part of the batch transform (packed vectors), returns the number of vectors done
+HC_MATH_TARGET_AVX2 HCSAPI size_t
+hc_vec3_transform_wt_soa_avx(float* dst_x, float* dst_y, float* dst_z,
+                             const float* x, const float* y, const float* z,
+                             size_t count, float w_translation, const hc_mat4_t mat)
+{
+    size_t i = 0;
+
+    __m256 m[9], t[3];
+    for (int_fast8_t k = 0; k < 3; k++) {
+        m[k] = _mm256_set1_ps(mat[k]);
+        m[k + 3] = _mm256_set1_ps(mat[k + 4]);
+        m[k + 6] = _mm256_set1_ps(mat[k + 8]);
+        t[k] = _mm256_set1_ps(w_translation * mat[k + 12]);
+    }
+    for (; i < (count & ~(size_t)7); i += 8) {
+        __m256 vx = _mm256_loadu_ps(x + i), vy = _mm256_loadu_ps(y + i), vz = _mm256_loadu_ps(z + i);
+        __m256 rx = hc_madd256_kernel_ps(m[6], vz, hc_madd256_kernel_ps(m[3], vy, hc_madd256_kernel_ps(m[0], vx, t[0])));
+        __m256 ry = hc_madd256_kernel_ps(m[7], vz, hc_madd256_kernel_ps(m[4], vy, hc_madd256_kernel_ps(m[1], vx, t[1])));
+        __m256 rz = hc_madd256_kernel_ps(m[8], vz, hc_madd256_kernel_ps(m[5], vy, hc_madd256_kernel_ps(m[2], vx, t[2])));
+        _mm256_storeu_ps(dst_x + i, rx);
+        _mm256_storeu_ps(dst_y + i, ry);
+        _mm256_storeu_ps(dst_z + i, rz);
+    }
+
+    return i;
+}
+#endif
+
+/* Same as hc_vec3_transform_wt_batch with the components in separate arrays (outputs may be the inputs) */
+HCSAPI void
+hc_vec3_transform_wt_soa_generic(float* dst_x, float* dst_y, float* dst_z,
+                                 const float* x, const float* y, const float* z,
+                                 size_t count, float w_translation, const hc_mat4_t mat)
+{
+    size_t i = 0;
+
+#if defined(HC_MATH_AVX_BATCH)
+    i = hc_vec3_transform_wt_soa_avx(dst_x, dst_y, dst_z, x, y, z, count, w_translation, mat);
+#elif defined(HC_MATH_SSE2)
+    {
+        __m128 m[9], t[3];
+        for (int_fast8_t k = 0; k < 3; k++) {
+            m[k] = _mm_set1_ps(mat[k]);
+            m[k + 3] = _mm_set1_ps(mat[k + 4]);
+            m[k + 6] = _mm_set1_ps(mat[k + 8]);
+            t[k] = _mm_set1_ps(w_translation * mat[k + 12]);
+        }
+        for (; i < (count & ~(size_t)3); i += 4) {
+            __m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(y + i), vz = _mm_loadu_ps(z + i);
+            __m128 rx = hc_madd_ps(m[6], vz, hc_madd_ps(m[3], vy, hc_madd_ps(m[0], vx, t[0])));
+            __m128 ry = hc_madd_ps(m[7], vz, hc_madd_ps(m[4], vy, hc_madd_ps(m[1], vx, t[1])));
+            __m128 rz = hc_madd_ps(m[8], vz, hc_madd_ps(m[5], vy, hc_madd_ps(m[2], vx, t[2])));
+            _mm_storeu_ps(dst_x + i, rx);
+            _mm_storeu_ps(dst_y + i, ry);
+            _mm_storeu_ps(dst_z + i, rz);
+        }
+    }
+#endif
+
+    const float m0 = mat[0], m1 = mat[1], m2 = mat[2];
+    const float m4 = mat[4], m5 = mat[5], m6 = mat[6];
+    const float m8 = mat[8], m9 = mat[9], m10 = mat[10];
+    const float t0 = w_translation * mat[12], t1 = w_translation * mat[13], t2 = w_translation * mat[14];
+
+    for (; i < count; i++) {
+        float vx = x[i], vy = y[i], vz = z[i];
+        dst_x[i] = m0 * vx + m4 * vy + m8 * vz + t0;
+        dst_y[i] = m1 * vx + m5 * vy + m9 * vz + t1;
+        dst_z[i] = m2 * vx + m6 * vy + m10 * vz + t2;
+    }
+}
+
+HCSAPI void
+hc_vec3_transform_wt_soa(float* dst_x, float* dst_y, float* dst_z,
+                         const float* x, const float* y, const float* z,
+                         size_t count, float w_translation, const hc_mat4_t mat)
+{
+#if defined(HC_MATH_DISPATCH)
+    HC_MATH_KERNEL(vec3_transform_wt_soa)(dst_x, dst_y, dst_z, x, y, z, count, w_translation, mat);
+#else
+    hc_vec3_transform_wt_soa_generic(dst_x, dst_y, dst_z, x, y, z, count, w_translation, mat);
+#endif
+}
+
+HCSAPI void
+hc_vec3_transform_soa(float* dst_x, float* dst_y, float* dst_z,
+                      const float* x, const float* y, const float* z,
+                      size_t count, const hc_mat4_t mat)
+{
+    hc_vec3_transform_wt_soa(dst_x, dst_y, dst_z, x, y, z, count, 1.0f, mat);
+}
+
+/* 3D Vector streams */
+
+/*
+ * Operations over arrays of vectors described by streams: the components are
+ * either in separate arrays (SoA, see hc_vec3_stream_soa()), or interleaved
+ * with any distance between the vectors (AoS, see hc_vec3_stream_aos()). The
+ * layout of each stream is checked once per call: SoA streams are loaded as
+ * they are, packed hc_vec3_t arrays are transposed in registers, and other
+ * strides are gathered. The vectors are processed 8 (AVX2) or 16 (AVX-512,
+ * SoA and strided streams only) at a time, the remainder with scalar code,
+ * except for the square roots which SSE2 does 4 at a time.
+ *
+ * The sources are read-only hc_vec3_cstream_t, so const arrays can be passed
+ * as they are (see hc_vec3_stream_const() for a stream being updated in place).
+ * The destination may be one of the sources, but must not partially overlap
+ * them.
+ */
+
+enum {
+    HC_VEC3_STREAM_ADD,
+    HC_VEC3_STREAM_SUB,
+    HC_VEC3_STREAM_SCALE,
+    HC_VEC3_STREAM_MADD,
+    HC_VEC3_STREAM_DOT,
+    HC_VEC3_STREAM_CROSS,
+    HC_VEC3_STREAM_LENGTH,
+    HC_VEC3_STREAM_NORMALIZE,
+    HC_VEC3_STREAM_LERP,
+    HC_VEC3_STREAM_DISTANCE
+};
+
+enum {
+    HC_VEC3_STREAM_SOA_LAYOUT,      // Components in separate arrays
+    HC_VEC3_STREAM_PACKED_LAYOUT,   // Packed hc_vec3_t
+    HC_VEC3_STREAM_STRIDED_LAYOUT
+};
+
+/* Stream over components stored in separate arrays */
+HCSAPI hc_vec3_stream_t
+hc_vec3_stream_soa(float* x, float* y, float* z)
+{
+    hc_vec3_stream_t s = { x, y, z, sizeof(float) };
+    return s;
+}
+
+/* Stream over vectors 'stride' bytes apart (0 for packed hc_vec3_t), each with its x, y, z components next to each other */
+HCSAPI hc_vec3_stream_t
+hc_vec3_stream_aos(float* v, size_t stride)
+{
+    hc_vec3_stream_t s = { v, v + 1, v + 2, stride ? stride : sizeof(hc_vec3_t) };
+    return s;
+}
+
+/* Read-only version of hc_vec3_stream_soa() */
+HCSAPI hc_vec3_cstream_t
+hc_vec3_cstream_soa(const float* x, const float* y, const float* z)
+{
+    hc_vec3_cstream_t s = { x, y, z, sizeof(float) };
+    return s;
+}
+
+/* Read-only version of hc_vec3_stream_aos() */
+HCSAPI hc_vec3_cstream_t
+hc_vec3_cstream_aos(const float* v, size_t stride)
+{
+    hc_vec3_cstream_t s = { v, v + 1, v + 2, stride ? stride : sizeof(hc_vec3_t) };
+    return s;
+}
+
+/* Same vectors as a read-only stream, to use a destination as a source */
+HCSAPI hc_vec3_cstream_t
+hc_vec3_stream_const(hc_vec3_stream_t s)
+{
+    hc_vec3_cstream_t r = { s.x, s.y, s.z, s.stride };
+    return r;
+}
+
+HCSAPI int
+hc_vec3_stream_layout(const hc_vec3_cstream_t* s)
+{
+    if (s->stride == sizeof(float)) return HC_VEC3_STREAM_SOA_LAYOUT;
+    if (s->stride == sizeof(hc_vec3_t) && s->y == s->x + 1 && s->z == s->x + 2) return HC_VEC3_STREAM_PACKED_LAYOUT;
+    return HC_VEC3_STREAM_STRIDED_LAYOUT;
+}
+
+/* Same stream, starting 'count' vectors further (unused streams are NULL) */
+HCSAPI hc_vec3_stream_t
+hc_vec3_stream_advance(const hc_vec3_stream_t* s, size_t count)
+{
+    hc_vec3_stream_t r = { NULL, NULL, NULL, 0 };
+    if (s) {
+        size_t offset = count * s->stride;
+        r.x = (float*)((char*)s->x + offset);
+        r.y = (float*)((char*)s->y + offset);
+        r.z = (float*)((char*)s->z + offset);
+        r.stride = s->stride;
+    }
+    return r;
+}
+
+HCSAPI hc_vec3_cstream_t
+hc_vec3_cstream_advance(const hc_vec3_cstream_t* s, size_t count)
+{
+    hc_vec3_cstream_t r = { NULL, NULL, NULL, 0 };
+    if (s) {
+        size_t offset = count * s->stride;
+        r.x = (const float*)((const char*)s->x + offset);
+        r.y = (const float*)((const char*)s->y + offset);
+        r.z = (const float*)((const char*)s->z + offset);
+        r.stride = s->stride;
+    }
+    return r;
+}
+
+#if defined(HC_MATH_AVX2_KERNELS)
+
+HC_MATH_TARGET_AVX2 HCSAPI void
+hc_vec3_stream_load_avx2(const hc_vec3_cstream_t* s, int layout, size_t i, __m256* x, __m256* y, __m256* z)
+{
+    if (layout == HC_VEC3_STREAM_SOA_LAYOUT) {
+        *x = _mm256_loadu_ps(s->x + i);
+        *y = _mm256_loadu_ps(s->y + i);
+        *z = _mm256_loadu_ps(s->z + i);
+    } else if (layout == HC_VEC3_STREAM_PACKED_LAYOUT) {
+        const float *p = s->x + 3 * i;
+        __m256 m03 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+        __m256 m14 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+        __m256 m25 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+        __m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+        __m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+        *x = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+        *y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        *z = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+    } else {
+        __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32((int)s->stride));
+        size_t base = i * s->stride;
+        *x = _mm256_i32gather_ps((const float*)((const char*)s->x + base), offsets, 1);
+        *y = _mm256_i32gather_ps((const float*)((const char*)s->y + base), offsets, 1);
+        *z = _mm256_i32gather_ps((const float*)((const char*)s->z + base), offsets, 1);
+    }
+}
+
+HC_MATH_TARGET_AVX2 HCSAPI void
+hc_vec3_stream_store_avx2(const hc_vec3_stream_t* s, int layout, size_t i, __m256 x, __m256 y, __m256 z)
+{
+    if (layout == HC_VEC3_STREAM_SOA_LAYOUT) {
+        _mm256_storeu_ps(s->x + i, x);
+        _mm256_storeu_ps(s->y + i, y);
+        _mm256_storeu_ps(s->z + i, z);
+    } else if (layout == HC_VEC3_STREAM_PACKED_LAYOUT) {
+        __m256 xy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 yz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+        __m256 zx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+        __m256 r03 = _mm256_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 r14 = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        __m256 r25 = _mm256_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1));
+        float *d = s->x + 3 * i;
+        _mm_storeu_ps(d, _mm256_castps256_ps128(r03));
+        _mm_storeu_ps(d + 4, _mm256_castps256_ps128(r14));
+        _mm_storeu_ps(d + 8, _mm256_castps256_ps128(r25));
+        _mm_storeu_ps(d + 12, _mm256_extractf128_ps(r03, 1));
+        _mm_storeu_ps(d + 16, _mm256_extractf128_ps(r14, 1));
+        _mm_storeu_ps(d + 20, _mm256_extractf128_ps(r25, 1));
+    } else {
+        // No scatter before AVX-512
+        float tmp[3][8];
+        _mm256_storeu_ps(tmp[0], x);
+        _mm256_storeu_ps(tmp[1], y);
+        _mm256_storeu_ps(tmp[2], z);
+        for (int_fast8_t k = 0; k < 8; k++) {
+            size_t offset = (i + k) * s->stride;
+            *(float*)((char*)s->x + offset) = tmp[0][k];
+            *(float*)((char*)s->y + offset) = tmp[1][k];
+            *(float*)((char*)s->z + offset) = tmp[2][k];
+        }
+    }
+}
+
+// AVX2 part of a stream operation, returns the number of vectors done
+HC_MATH_TARGET_AVX2 HCSAPI size_t
+hc_vec3_stream_avx2_kernel(int op, const hc_vec3_stream_t* dst, const hc_vec3_cstream_t* a, const hc_vec3_cstream_t* b,
+                           float scalar, float* out, size_t count)
+{
+    hc_vec3_cstream_t d = dst ? hc_vec3_stream_const(*dst) : *a;
+    const hc_vec3_cstream_t* streams[3] = { dst ? &d : NULL, a, b };
+    int layouts[3] = { 0 };
+    for (int_fast8_t k = 0; k < 3; k++) {
+        if (!streams[k]) continue;
+        layouts[k] = hc_vec3_stream_layout(streams[k]);
+        // The gathers take 32-bit offsets
+        if (layouts[k] == HC_VEC3_STREAM_STRIDED_LAYOUT && streams[k]->stride > INT32_MAX / 8) return 0;
+    }
+    const int ld = layouts[0], la = layouts[1], lb = layouts[2];
+
+    const __m256 s = _mm256_set1_ps(scalar);
+    __m256 ax, ay, az, bx, by, bz;
+    size_t i = 0, n = count & ~(size_t)7;
+
+    switch (op) {
+        case HC_VEC3_STREAM_ADD:
+            for (; i < n; i += 8) {
+                hc_vec3_stream_load_avx2(a, la, i, &ax, &ay, &az);
+                hc_vec3_stream_load_avx2(b, lb, i, &bx, &by, &bz);
+                hc_vec3_stream_store_avx2(dst, ld, i, _mm256_add_ps(ax, bx), _mm256_add_ps(ay, by), _mm256_add_ps(az, bz));
+            }
+            break;
+        case HC_VEC3_STREAM_SUB:
+            for (; i < n; i += 8) {
+                hc_vec3_stream_load_avx2(a, la, i, &ax, &ay, &az);
+                hc_vec3_stream_load_avx2(b, lb, i, &bx, &by, &bz);
+                hc_vec3_stream_store_avx2(dst, ld, i, _mm256_sub_ps(ax, bx), _mm256_sub_ps(ay, by), _mm256_sub_ps(az, bz));
+            }
+            break;
+        case HC_VEC3_STREAM_SCALE:
+            for (; i < n; i += 8) {
+                hc_vec3_stream_load_avx2(a, la, i, &ax, &ay, &az);
+                hc_vec3_stream_store_avx2(dst, ld, i, _mm256_mul_ps(ax, s), _mm256_mul_ps(ay, s), _mm256_mul_ps(az, s));
+            }
+            break;
+        case HC_VEC3_STREAM_MADD:
+            for (; i < n; i += 8) {
+                hc_vec3_stream_load_avx2(a, la, i, &ax, &ay, &az);
+                hc_vec3_stream_load_avx2(b, lb, i, &bx, &by, &bz);
+                hc_vec3_stream_store_avx2(dst, ld, i, _mm256_fmadd_ps(bx, s, ax), _mm256_fmadd_ps(by, s, ay), _mm256_fmadd_ps(bz, s, az));
+            }
+            break;
+        case HC_VEC3_STREAM_DOT:
+            for (; i < n; i += 8) {
+                hc_vec3_stream_load_avx2(a, la, i, &ax, &ay, &az);
+                hc_vec3_stream_load_avx2(b, lb, i, &bx, &by, &bz);
+                _mm256_storeu_ps(out + i, _mm256_fmadd_ps(az, bz, _mm256_fmadd_ps(ay, by, _mm256_mul_ps(ax, bx))));
+            }
+            break;
+        case HC_VEC3_STREAM_CROSS:
+            for (; i < n; i += 8) {
+                hc_vec3_stream_load_avx2(a, la, i, &ax, &ay, &az);
+                hc_vec3_stream_load_avx2(b, lb, i, &bx, &by, &bz);
+                hc_vec3_stream_store_avx2(dst, ld, i,
+                    _mm256_fmsub_ps(ay, bz, _mm256_mul_ps(az, by)),
+                    _mm256_fmsub_ps(az, bx, _mm256_mul_ps(ax, bz)),
+                    _mm256_fmsub_ps(ax, by, _mm256_mul_ps(ay, bx)));
+            }
+            break;
+        case HC_VEC3_STREAM_LENGTH:
+            for (; i < n; i += 8) {
+                hc_vec3_stream_load_avx2(a, la, i, &ax, &ay, &az);
+                __m256 sq = _mm256_fmadd_ps(az, az, _mm256_fmadd_ps(ay, ay, _mm256_mul_ps(ax, ax)));
+                _mm256_storeu_ps(out + i, hc_sqrt256_ps(sq));
+            }
+            break;
+        case HC_VEC3_STREAM_NORMALIZE:
+            for (; i < n; i += 8) {
+                hc_vec3_stream_load_avx2(a, la, i, &ax, &ay, &az);
+                __m256 sq = _mm256_fmadd_ps(az, az, _mm256_fmadd_ps(ay, ay, _mm256_mul_ps(ax, ax)));
+                __m256 inv = hc_rsqrt256_ps(sq);
+                inv = _mm256_blendv_ps(_mm256_set1_ps(1.0f), inv, _mm256_cmp_ps(sq, _mm256_setzero_ps(), _CMP_GT_OQ));
+                hc_vec3_stream_store_avx2(dst, ld, i, _mm256_mul_ps(ax, inv), _mm256_mul_ps(ay, inv), _mm256_mul_ps(az, inv));
+            }
+            break;
+        case HC_VEC3_STREAM_LERP:
+            for (; i < n; i += 8) {
+                hc_vec3_stream_load_avx2(a, la, i, &ax, &ay, &az);
+                hc_vec3_stream_load_avx2(b, lb, i, &bx, &by, &bz);
+                hc_vec3_stream_store_avx2(dst, ld, i,
+                    _mm256_fmadd_ps(_mm256_sub_ps(bx, ax), s, ax),
+                    _mm256_fmadd_ps(_mm256_sub_ps(by, ay), s, ay),
+                    _mm256_fmadd_ps(_mm256_sub_ps(bz, az), s, az));
+            }
+            break;
+        case HC_VEC3_STREAM_DISTANCE:
+            for (; i < n; i += 8) {
+                hc_vec3_stream_load_avx2(a, la, i, &ax, &ay, &az);
+                hc_vec3_stream_load_avx2(b, lb, i, &bx, &by, &bz);
+                __m256 dx = _mm256_sub_ps(bx, ax), dy = _mm256_sub_ps(by, ay), dz = _mm256_sub_ps(bz, az);
+                __m256 sq = _mm256_fmadd_ps(dz, dz, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dx, dx)));
+                _mm256_storeu_ps(out + i, hc_sqrt256_ps(sq));
+            }
+            break;
+    }
+
+    return i;
+}
+
+#endif // HC_MATH_AVX2_KERNELS
+
+#if defined(HC_MATH_AVX512_KERNELS)
+
+HC_MATH_TARGET_AVX512 HCSAPI void
+hc_vec3_stream_load_avx512(const hc_vec3_cstream_t* s, __m512i offsets, size_t i, __m512* x, __m512* y, __m512* z)
+{
+    if (s->stride == sizeof(float)) {
+        *x = _mm512_loadu_ps(s->x + i);
+        *y = _mm512_loadu_ps(s->y + i);
+        *z = _mm512_loadu_ps(s->z + i);
+    } else {
+        // Masked gathers with a zero source, g++ warns about the undefined one of the plain gathers in C++
+        const __m512 zero = _mm512_setzero_ps();
+        size_t base = i * s->stride;
+        *x = _mm512_mask_i32gather_ps(zero, (__mmask16)-1, offsets, (const char*)s->x + base, 1);
+        *y = _mm512_mask_i32gather_ps(zero, (__mmask16)-1, offsets, (const char*)s->y + base, 1);
+        *z = _mm512_mask_i32gather_ps(zero, (__mmask16)-1, offsets, (const char*)s->z + base, 1);
+    }
+}
+
+HC_MATH_TARGET_AVX512 HCSAPI void
+hc_vec3_stream_store_avx512(const hc_vec3_stream_t* s, __m512i offsets, size_t i, __m512 x, __m512 y, __m512 z)
+{
+    if (s->stride == sizeof(float)) {
+        _mm512_storeu_ps(s->x + i, x);
+        _mm512_storeu_ps(s->y + i, y);
+        _mm512_storeu_ps(s->z + i, z);
+    } else {
+        size_t base = i * s->stride;
+        _mm512_i32scatter_ps((char*)s->x + base, offsets, x, 1);
+        _mm512_i32scatter_ps((char*)s->y + base, offsets, y, 1);
+        _mm512_i32scatter_ps((char*)s->z + base, offsets, z, 1);
+    }
+}
+
+// AVX-512 part of a stream operation, returns the number of vectors done (the AVX2 kernel does the rest)
+HC_MATH_TARGET_AVX512 HCSAPI size_t
+hc_vec3_stream_avx512_kernel(int op, const hc_vec3_stream_t* dst, const hc_vec3_cstream_t* a, const hc_vec3_cstream_t* b,
+                             float scalar, float* out, size_t count)
+{
+    // Packed vectors would need three-register permutes, the AVX2 transposition is used instead
+    hc_vec3_cstream_t d = dst ? hc_vec3_stream_const(*dst) : *a;
+    const hc_vec3_cstream_t* streams[3] = { dst ? &d : NULL, a, b };
+    __m512i offsets[3];
+    for (int_fast8_t k = 0; k < 3; k++) {
+        offsets[k] = _mm512_setzero_si512();
+        if (!streams[k]) continue;
+        int layout = hc_vec3_stream_layout(streams[k]);
+        if (layout == HC_VEC3_STREAM_PACKED_LAYOUT || streams[k]->stride > INT32_MAX / 16) {
+            return hc_vec3_stream_avx2_kernel(op, dst, a, b, scalar, out, count);
+        }
+        offsets[k] = _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+                                        _mm512_set1_epi32((int)streams[k]->stride));
+    }
+    const __m512i od = offsets[0], oa = offsets[1], ob = offsets[2];
+
+    const __m512 s = _mm512_set1_ps(scalar);
+    __m512 ax, ay, az, bx, by, bz;
+    size_t i = 0, n = count & ~(size_t)15;
+
+    switch (op) {
+        case HC_VEC3_STREAM_ADD:
+            for (; i < n; i += 16) {
+                hc_vec3_stream_load_avx512(a, oa, i, &ax, &ay, &az);
+                hc_vec3_stream_load_avx512(b, ob, i, &bx, &by, &bz);
+                hc_vec3_stream_store_avx512(dst, od, i, _mm512_add_ps(ax, bx), _mm512_add_ps(ay, by), _mm512_add_ps(az, bz));
+            }
+            break;
+        case HC_VEC3_STREAM_SUB:
+            for (; i < n; i += 16) {
+                hc_vec3_stream_load_avx512(a, oa, i, &ax, &ay, &az);
+                hc_vec3_stream_load_avx512(b, ob, i, &bx, &by, &bz);
+                hc_vec3_stream_store_avx512(dst, od, i, _mm512_sub_ps(ax, bx), _mm512_sub_ps(ay, by), _mm512_sub_ps(az, bz));
+            }
+            break;
+        case HC_VEC3_STREAM_SCALE:
+            for (; i < n; i += 16) {
+                hc_vec3_stream_load_avx512(a, oa, i, &ax, &ay, &az);
+                hc_vec3_stream_store_avx512(dst, od, i, _mm512_mul_ps(ax, s), _mm512_mul_ps(ay, s), _mm512_mul_ps(az, s));
+            }
+            break;
+        case HC_VEC3_STREAM_MADD:
+            for (; i < n; i += 16) {
+                hc_vec3_stream_load_avx512(a, oa, i, &ax, &ay, &az);
+                hc_vec3_stream_load_avx512(b, ob, i, &bx, &by, &bz);
+                hc_vec3_stream_store_avx512(dst, od, i, _mm512_fmadd_ps(bx, s, ax), _mm512_fmadd_ps(by, s, ay), _mm512_fmadd_ps(bz, s, az));
+            }
+            break;
+        case HC_VEC3_STREAM_DOT:
+            for (; i < n; i += 16) {
+                hc_vec3_stream_load_avx512(a, oa, i, &ax, &ay, &az);
+                hc_vec3_stream_load_avx512(b, ob, i, &bx, &by, &bz);
+                _mm512_storeu_ps(out + i, _mm512_fmadd_ps(az, bz, _mm512_fmadd_ps(ay, by, _mm512_mul_ps(ax, bx))));
+            }
+            break;
+        case HC_VEC3_STREAM_CROSS:
+            for (; i < n; i += 16) {
+                hc_vec3_stream_load_avx512(a, oa, i, &ax, &ay, &az);
+                hc_vec3_stream_load_avx512(b, ob, i, &bx, &by, &bz);
+                hc_vec3_stream_store_avx512(dst, od, i,
+                    _mm512_fmsub_ps(ay, bz, _mm512_mul_ps(az, by)),
+                    _mm512_fmsub_ps(az, bx, _mm512_mul_ps(ax, bz)),
+                    _mm512_fmsub_ps(ax, by, _mm512_mul_ps(ay, bx)));
+            }
+            break;
+        case HC_VEC3_STREAM_LENGTH:
+            for (; i < n; i += 16) {
+                hc_vec3_stream_load_avx512(a, oa, i, &ax, &ay, &az);
+                __m512 sq = _mm512_fmadd_ps(az, az, _mm512_fmadd_ps(ay, ay, _mm512_mul_ps(ax, ax)));
+                _mm512_storeu_ps(out + i, hc_sqrt512_ps(sq));
+            }
+            break;
+        case HC_VEC3_STREAM_NORMALIZE:
+            for (; i < n; i += 16) {
+                hc_vec3_stream_load_avx512(a, oa, i, &ax, &ay, &az);
+                __m512 sq = _mm512_fmadd_ps(az, az, _mm512_fmadd_ps(ay, ay, _mm512_mul_ps(ax, ax)));
+                __mmask16 nonzero = _mm512_cmp_ps_mask(sq, _mm512_setzero_ps(), _CMP_GT_OQ);
+                __m512 inv = _mm512_mask_mov_ps(_mm512_set1_ps(1.0f), nonzero, hc_rsqrt512_ps(sq));
+                hc_vec3_stream_store_avx512(dst, od, i, _mm512_mul_ps(ax, inv), _mm512_mul_ps(ay, inv), _mm512_mul_ps(az, inv));
+            }
+            break;
+        case HC_VEC3_STREAM_LERP:
+            for (; i < n; i += 16) {
+                hc_vec3_stream_load_avx512(a, oa, i, &ax, &ay, &az);
+                hc_vec3_stream_load_avx512(b, ob, i, &bx, &by, &bz);
+                hc_vec3_stream_store_avx512(dst, od, i,
+                    _mm512_fmadd_ps(_mm512_sub_ps(bx, ax), s, ax),
+                    _mm512_fmadd_ps(_mm512_sub_ps(by, ay), s, ay),
+                    _mm512_fmadd_ps(_mm512_sub_ps(bz, az), s, az));
+            }
+            break;
+        case HC_VEC3_STREAM_DISTANCE:
+            for (; i < n; i += 16) {
+                hc_vec3_stream_load_avx512(a, oa, i, &ax, &ay, &az);
+                hc_vec3_stream_load_avx512(b, ob, i, &bx, &by, &bz);
+                __m512 dx = _mm512_sub_ps(bx, ax), dy = _mm512_sub_ps(by, ay), dz = _mm512_sub_ps(bz, az);
+                __m512 sq = _mm512_fmadd_ps(dz, dz, _mm512_fmadd_ps(dy, dy, _mm512_mul_ps(dx, dx)));
+                _mm512_storeu_ps(out + i, hc_sqrt512_ps(sq));
+            }
+            break;
+    }
+
+    if (i < count) {
+        hc_vec3_stream_t rd = hc_vec3_stream_advance(dst, i);
+        hc_vec3_cstream_t ra = hc_vec3_cstream_advance(a, i), rb = hc_vec3_cstream_advance(b, i);
+        i += hc_vec3_stream_avx2_kernel(op, dst ? &rd : NULL, &ra, b ? &rb : NULL, scalar, out ? out + i : NULL, count - i);
+    }
+
+    return i;
+}
+
+#endif // HC_MATH_AVX512_KERNELS
+
+#if defined(HC_MATH_SSE2)
+
+HCSAPI void
+hc_vec3_stream_load_sse2(const hc_vec3_cstream_t* s, int layout, size_t i, __m128* x, __m128* y, __m128* z)
+{
+    if (layout == HC_VEC3_STREAM_SOA_LAYOUT) {
+        *x = _mm_loadu_ps(s->x + i);
+        *y = _mm_loadu_ps(s->y + i);
+        *z = _mm_loadu_ps(s->z + i);
+    } else if (layout == HC_VEC3_STREAM_PACKED_LAYOUT) {
+        const float *p = s->x + 3 * i;
+        __m128 m03 = _mm_loadu_ps(p), m14 = _mm_loadu_ps(p + 4), m25 = _mm_loadu_ps(p + 8);
+        __m128 xy = _mm_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+        __m128 yz = _mm_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+        *x = _mm_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+        *y = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        *z = _mm_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+    } else {
+        float tmp[3][4];
+        for (int_fast8_t k = 0; k < 4; k++) {
+            size_t offset = (i + k) * s->stride;
+            tmp[0][k] = *(const float*)((const char*)s->x + offset);
+            tmp[1][k] = *(const float*)((const char*)s->y + offset);
+            tmp[2][k] = *(const float*)((const char*)s->z + offset);
+        }
+        *x = _mm_loadu_ps(tmp[0]);
+        *y = _mm_loadu_ps(tmp[1]);
+        *z = _mm_loadu_ps(tmp[2]);
+    }
+}
+
+HCSAPI void
+hc_vec3_stream_store_sse2(const hc_vec3_stream_t* s, int layout, size_t i, __m128 x, __m128 y, __m128 z)
+{
+    if (layout == HC_VEC3_STREAM_SOA_LAYOUT) {
+        _mm_storeu_ps(s->x + i, x);
+        _mm_storeu_ps(s->y + i, y);
+        _mm_storeu_ps(s->z + i, z);
+    } else if (layout == HC_VEC3_STREAM_PACKED_LAYOUT) {
+        __m128 xy = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 yz = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+        __m128 zx = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+        float *d = s->x + 3 * i;
+        _mm_storeu_ps(d, _mm_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(d + 4, _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0)));
+        _mm_storeu_ps(d + 8, _mm_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1)));
+    } else {
+        float tmp[3][4];
+        _mm_storeu_ps(tmp[0], x);
+        _mm_storeu_ps(tmp[1], y);
+        _mm_storeu_ps(tmp[2], z);
+        for (int_fast8_t k = 0; k < 4; k++) {
+            size_t offset = (i + k) * s->stride;
+            *(float*)((char*)s->x + offset) = tmp[0][k];
+            *(float*)((char*)s->y + offset) = tmp[1][k];
+            *(float*)((char*)s->z + offset) = tmp[2][k];
+        }
+    }
+}
+
+// SSE2 part of the square root operations, which the compilers can't vectorize
+// through hc_rsqrtf, returns the number of vectors done
+HCSAPI size_t
+hc_vec3_stream_sse2_kernel(int op, const hc_vec3_stream_t* dst, const hc_vec3_cstream_t* a, const hc_vec3_cstream_t* b,
+                           float* out, size_t count)
+{
+    if (op != HC_VEC3_STREAM_LENGTH && op != HC_VEC3_STREAM_NORMALIZE && op != HC_VEC3_STREAM_DISTANCE) return 0;
+
+    hc_vec3_cstream_t d = dst ? hc_vec3_stream_const(*dst) : *a;
+    const int ld = dst ? hc_vec3_stream_layout(&d) : 0;
+    const int la = hc_vec3_stream_layout(a);
+    const int lb = b ? hc_vec3_stream_layout(b) : 0;
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    __m128 ax, ay, az, bx, by, bz;
+    size_t i = 0, n = count & ~(size_t)3;
+
+    for (; i < n; i += 4) {
+        hc_vec3_stream_load_sse2(a, la, i, &ax, &ay, &az);
+        if (op == HC_VEC3_STREAM_DISTANCE) {
+            hc_vec3_stream_load_sse2(b, lb, i, &bx, &by, &bz);
+            ax = _mm_sub_ps(bx, ax), ay = _mm_sub_ps(by, ay), az = _mm_sub_ps(bz, az);
+        }
+        __m128 sq = hc_madd_ps(az, az, hc_madd_ps(ay, ay, _mm_mul_ps(ax, ax)));
+        if (op != HC_VEC3_STREAM_NORMALIZE) {
+            _mm_storeu_ps(out + i, hc_sqrt_ps(sq));
+            continue;
+        }
+        __m128 nonzero = _mm_cmpgt_ps(sq, _mm_setzero_ps());
+        __m128 inv = _mm_or_ps(_mm_and_ps(nonzero, hc_rsqrt_ps(sq)), _mm_andnot_ps(nonzero, one));
+        hc_vec3_stream_store_sse2(dst, ld, i, _mm_mul_ps(ax, inv), _mm_mul_ps(ay, inv), _mm_mul_ps(az, inv));
+    }
+
+    return i;
+}
+
+#endif // HC_MATH_SSE2
+
+/* Applies a stream operation with the vectors left by the SIMD kernels, if any; 'out' receives the scalar results */
+HCSAPI void
+hc_vec3_stream_generic(int op, const hc_vec3_stream_t* dst, const hc_vec3_cstream_t* a, const hc_vec3_cstream_t* b,
+                       float scalar, float* out, size_t count)
+{
+    size_t i = 0;
+
+#if defined(HC_MATH_AVX512)
+    i = hc_vec3_stream_avx512_kernel(op, dst, a, b, scalar, out, count);
+#elif defined(HC_MATH_AVX2)
+    i = hc_vec3_stream_avx2_kernel(op, dst, a, b, scalar, out, count);
+#endif
+
+#if defined(HC_MATH_SSE2)
+    if (i < count) {
+        hc_vec3_stream_t rd = hc_vec3_stream_advance(dst, i);
+        hc_vec3_cstream_t ra = hc_vec3_cstream_advance(a, i), rb = hc_vec3_cstream_advance(b, i);
+        i += hc_vec3_stream_sse2_kernel(op, dst ? &rd : NULL, &ra, b ? &rb : NULL, out ? out + i : NULL, count - i);
+    }
+#endif
+
+    for (; i < count; i++) {
+        size_t offset_a = i * a->stride;
+        float ax = *(const float*)((const char*)a->x + offset_a);
+        float ay = *(const float*)((const char*)a->y + offset_a);
+        float az = *(const float*)((const char*)a->z + offset_a);
+
+        float bx = 0.0f, by = 0.0f, bz = 0.0f;
+        if (b) {
+            size_t offset_b = i * b->stride;
+            bx = *(const float*)((const char*)b->x + offset_b);
+            by = *(const float*)((const char*)b->y + offset_b);
+            bz = *(const float*)((const char*)b->z + offset_b);
+        }
+
+        float rx = 0.0f, ry = 0.0f, rz = 0.0f;
+        switch (op) {
+            case HC_VEC3_STREAM_ADD: rx = ax + bx, ry = ay + by, rz = az + bz; break;
+            case HC_VEC3_STREAM_SUB: rx = ax - bx, ry = ay - by, rz = az - bz; break;
+            case HC_VEC3_STREAM_SCALE: rx = ax * scalar, ry = ay * scalar, rz = az * scalar; break;
+            case HC_VEC3_STREAM_MADD: rx = ax + bx * scalar, ry = ay + by * scalar, rz = az + bz * scalar; break;
+            case HC_VEC3_STREAM_DOT: out[i] = ax * bx + ay * by + az * bz; continue;
+            case HC_VEC3_STREAM_CROSS: rx = ay * bz - az * by, ry = az * bx - ax * bz, rz = ax * by - ay * bx; break;
+            case HC_VEC3_STREAM_LENGTH: out[i] = sqrtf(ax * ax + ay * ay + az * az); continue;
+            case HC_VEC3_STREAM_NORMALIZE: {
+                float sq = ax * ax + ay * ay + az * az;
+                float inv = (sq > 0.0f) ? hc_rsqrtf(sq) : 1.0f;
+                rx = ax * inv, ry = ay * inv, rz = az * inv;
+            } break;
+            case HC_VEC3_STREAM_LERP: rx = ax + (bx - ax) * scalar, ry = ay + (by - ay) * scalar, rz = az + (bz - az) * scalar; break;
+            case HC_VEC3_STREAM_DISTANCE: {
+                float dx = bx - ax, dy = by - ay, dz = bz - az;
+                out[i] = sqrtf(dx * dx + dy * dy + dz * dz);
+            } continue;
+        }
+
+        size_t offset_d = i * dst->stride;
+        *(float*)((char*)dst->x + offset_d) = rx;
+        *(float*)((char*)dst->y + offset_d) = ry;
+        *(float*)((char*)dst->z + offset_d) = rz;
+    }
+}
+
+HCSAPI void
+hc_vec3_stream(int op, const hc_vec3_stream_t* dst, const hc_vec3_cstream_t* a, const hc_vec3_cstream_t* b,
+               float scalar, float* out, size_t count)
+{
+#if defined(HC_MATH_DISPATCH)
+    HC_MATH_KERNEL(vec3_stream)(op, dst, a, b, scalar, out, count);
+#else
+    hc_vec3_stream_generic(op, dst, a, b, scalar, out, count);
+#endif
+}
+
+/* dst = a + b */
+HCSAPI void
+hc_vec3_stream_add(hc_vec3_stream_t dst, hc_vec3_cstream_t a, hc_vec3_cstream_t b, size_t count)
+{
+    hc_vec3_stream(HC_VEC3_STREAM_ADD, &dst, &a, &b, 0.0f, NULL, count);
+}
+
+/* dst = a - b */
+HCSAPI void
+hc_vec3_stream_sub(hc_vec3_stream_t dst, hc_vec3_cstream_t a, hc_vec3_cstream_t b, size_t count)
+{
+    hc_vec3_stream(HC_VEC3_STREAM_SUB, &dst, &a, &b, 0.0f, NULL, count);
+}
+
+/* dst = a * scalar */
+HCSAPI void
+hc_vec3_stream_scale(hc_vec3_stream_t dst, hc_vec3_cstream_t a, float scalar, size_t count)
+{
+    hc_vec3_stream(HC_VEC3_STREAM_SCALE, &dst, &a, NULL, scalar, NULL, count);
+}
+
+/* dst = a + b * scalar (fused with FMA), as in 'position += velocity * dt' */
+HCSAPI void
+hc_vec3_stream_madd(hc_vec3_stream_t dst, hc_vec3_cstream_t a, hc_vec3_cstream_t b, float scalar, size_t count)
+{
+    hc_vec3_stream(HC_VEC3_STREAM_MADD, &dst, &a, &b, scalar, NULL, count);
+}
+
+/* dst[i] = dot(a, b) */
+HCSAPI void
+hc_vec3_stream_dot(float* dst, hc_vec3_cstream_t a, hc_vec3_cstream_t b, size_t count)
+{
+    hc_vec3_stream(HC_VEC3_STREAM_DOT, NULL, &a, &b, 0.0f, dst, count);
+}
+
+/* dst = cross(a, b) */
+HCSAPI void
+hc_vec3_stream_cross(hc_vec3_stream_t dst, hc_vec3_cstream_t a, hc_vec3_cstream_t b, size_t count)
+{
+    hc_vec3_stream(HC_VEC3_STREAM_CROSS, &dst, &a, &b, 0.0f, NULL, count);
+}
+
+/* dst[i] = length(a) */
+HCSAPI void
+hc_vec3_stream_length(float* dst, hc_vec3_cstream_t a, size_t count)
+{
+    hc_vec3_stream(HC_VEC3_STREAM_LENGTH, NULL, &a, NULL, 0.0f, dst, count);
+}
+
+/* dst = normalize(a), zero vectors being copied as they are */
+HCSAPI void
+hc_vec3_stream_normalize(hc_vec3_stream_t dst, hc_vec3_cstream_t a, size_t count)
+{
+    hc_vec3_stream(HC_VEC3_STREAM_NORMALIZE, &dst, &a, NULL, 0.0f, NULL, count);
+}
+
+/* dst = a + (b - a) * t */
+HCSAPI void
+hc_vec3_stream_lerp(hc_vec3_stream_t dst, hc_vec3_cstream_t a, hc_vec3_cstream_t b, float t, size_t count)
+{
+    hc_vec3_stream(HC_VEC3_STREAM_LERP, &dst, &a, &b, t, NULL, count);
+}
+
+/* dst[i] = distance(a, b) */
+HCSAPI void
+hc_vec3_stream_distance(float* dst, hc_vec3_cstream_t a, hc_vec3_cstream_t b, size_t count)
+{
+    hc_vec3_stream(HC_VEC3_STREAM_DISTANCE, NULL, &a, &b, 0.0f, dst, count);
+}
+
+/* Same as hc_vec2_normalize_batch(), through the streams */
+HCSAPI void
+hc_vec3_normalize_batch(hc_vec3_ptr_t dst, hc_vec3_cptr_t src, size_t count, size_t stride)
+{
+    hc_vec3_stream_normalize(hc_vec3_stream_aos(dst, stride), hc_vec3_cstream_aos(src, stride), count);
+}
+
+/* Same as hc_vec2_distance_batch(), through the streams */
+HCSAPI void
+hc_vec3_distance_batch(float* dst, hc_vec3_cptr_t v1, hc_vec3_cptr_t v2, size_t count, size_t stride)
+{
+    hc_vec3_stream_distance(dst, hc_vec3_cstream_aos(v1, stride), hc_vec3_cstream_aos(v2, stride), count);
+}
+
+/* 4D Vector transforms */
+
+HCSAPI void
+hc_vec4_transform(hc_vec4_t dst, const hc_vec4_t v, const hc_mat4_t mat)
+{
+#if defined(HC_MATH_SSE2)
+    // Sum of the matrix columns scaled by the vector components
+    __m128 x = _mm_set1_ps(v[0]), y = _mm_set1_ps(v[1]);
+    __m128 z = _mm_set1_ps(v[2]), w = _mm_set1_ps(v[3]);
+    __m128 r = _mm_mul_ps(_mm_loadu_ps(mat), x);
+    r = hc_madd_ps(_mm_loadu_ps(mat + 4), y, r);
+    r = hc_madd_ps(_mm_loadu_ps(mat + 8), z, r);
+    r = hc_madd_ps(_mm_loadu_ps(mat + 12), w, r);
+    _mm_storeu_ps(dst, r);
+#elif defined(HC_MATH_NEON)
+    float32x4_t r = vmulq_n_f32(vld1q_f32(mat), v[0]);
+    float y = v[1], z = v[2], w = v[3];
+    r = hc_madd_f32(r, vld1q_f32(mat + 4), y);
+    r = hc_madd_f32(r, vld1q_f32(mat + 8), z);
+    r = hc_madd_f32(r, vld1q_f32(mat + 12), w);
+    vst1q_f32(dst, r);
+#else
+    hc_vec4_t tmp = {
+        mat[0] * v[0] + mat[4] * v[1] + mat[8] * v[2] + mat[12] * v[3],
+        mat[1] * v[0] + mat[5] * v[1] + mat[9] * v[2] + mat[13] * v[3],
+        mat[2] * v[0] + mat[6] * v[1] + mat[10] * v[2] + mat[14] * v[3],
+        mat[3] * v[0] + mat[7] * v[1] + mat[11] * v[2] + mat[15] * v[3]
+    };
+
+    for (int_fast8_t i = 0; i < 4; i++) {
+        dst[i] = tmp[i];
+    }
+#endif
+}
+
+HCSAPI void
+hc_vec4_transform_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v, const hc_mat4_t mat)
+{
+#if defined(HC_MATH_SSE2) || defined(HC_MATH_NEON)
+    hc_vec4_transform(dst, v, mat);
+#else
+    dst[0] = mat[0] * v[0] + mat[4] * v[1] + mat[8] * v[2] + mat[12] * v[3];
+    dst[1] = mat[1] * v[0] + mat[5] * v[1] + mat[9] * v[2] + mat[13] * v[3];
+    dst[2] = mat[2] * v[0] + mat[6] * v[1] + mat[10] * v[2] + mat[14] * v[3];
+    dst[3] = mat[3] * v[0] + mat[7] * v[1] + mat[11] * v[2] + mat[15] * v[3];
+#endif
+}
+
+#if defined(HC_MATH_AVX_KERNELS)
+// AVX part of the batch transform (packed vectors), returns the number of vectors done
+HC_MATH_TARGET_AVX2 HCSAPI size_t
+hc_vec4_transform_batch_avx(hc_vec4_ptr_t dst, hc_vec4_cptr_t src, size_t count, const hc_mat4_t mat)
+{
+    size_t i = 0;
+
+    // Two vectors per register, the columns being duplicated in both halves
+    const __m256 c0 = _mm256_broadcast_ps((const __m128*)mat);
+    const __m256 c1 = _mm256_broadcast_ps((const __m128*)(mat + 4));
+    const __m256 c2 = _mm256_broadcast_ps((const __m128*)(mat + 8));
+    const __m256 c3 = _mm256_broadcast_ps((const __m128*)(mat + 12));
+    for (; i < (count & ~(size_t)3); i += 4) {
+        __m256 a = _mm256_loadu_ps(src + 4 * i);
+        __m256 b = _mm256_loadu_ps(src + 4 * i + 8);
+        __m256 ra = _mm256_mul_ps(c0, _mm256_shuffle_ps(a, a, 0x00));
+        __m256 rb = _mm256_mul_ps(c0, _mm256_shuffle_ps(b, b, 0x00));
+        ra = hc_madd256_kernel_ps(c1, _mm256_shuffle_ps(a, a, 0x55), ra);
+        rb = hc_madd256_kernel_ps(c1, _mm256_shuffle_ps(b, b, 0x55), rb);
+        ra = hc_madd256_kernel_ps(c2, _mm256_shuffle_ps(a, a, 0xAA), ra);
+        rb = hc_madd256_kernel_ps(c2, _mm256_shuffle_ps(b, b, 0xAA), rb);
+        ra = hc_madd256_kernel_ps(c3, _mm256_shuffle_ps(a, a, 0xFF), ra);
+        rb = hc_madd256_kernel_ps(c3, _mm256_shuffle_ps(b, b, 0xFF), rb);
+        _mm256_storeu_ps(dst + 4 * i, ra);
+        _mm256_storeu_ps(dst + 4 * i + 8, rb);
+    }
+
+    return i;
+}
+#endif
+
+/* Batch transform, 'stride' is the distance in bytes between two vectors (0 if packed), 'dst' may be 'src' */
+HCSAPI void
+hc_vec4_transform_batch_generic(hc_vec4_ptr_t dst, hc_vec4_cptr_t src, size_t count, size_t stride, const hc_mat4_t mat)
+{
+    if (stride == 0) stride = sizeof(hc_vec4_t);
+
+    size_t i = 0;
+
+#if defined(HC_MATH_AVX_BATCH)
+    if (stride == sizeof(hc_vec4_t)) {
+        i = hc_vec4_transform_batch_avx(dst, src, count, mat);
+    }
+#endif
+
+#if defined(HC_MATH_SSE2)
+    const __m128 c0 = _mm_loadu_ps(mat), c1 = _mm_loadu_ps(mat + 4);
+    const __m128 c2 = _mm_loadu_ps(mat + 8), c3 = _mm_loadu_ps(mat + 12);
+    for (; i < count; i++) {
+        const float *v = (const float*)((const char*)src + i * stride);
+        __m128 a = _mm_loadu_ps(v);
+        __m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(a, a, 0x00));
+        r = hc_madd_ps(c1, _mm_shuffle_ps(a, a, 0x55), r);
+        r = hc_madd_ps(c2, _mm_shuffle_ps(a, a, 0xAA), r);
+        r = hc_madd_ps(c3, _mm_shuffle_ps(a, a, 0xFF), r);
+        _mm_storeu_ps((float*)((char*)dst + i * stride), r);
+    }
+#else
+    hc_mat4_t m;
+    for (int_fast8_t k = 0; k < 16; k++) {
+        m[k] = mat[k];
+    }
+    for (; i < count; i++) {
+        const float *v = (const float*)((const char*)src + i * stride);
+        float *d = (float*)((char*)dst + i * stride);
+        float x = v[0], y = v[1], z = v[2], w = v[3];
+        d[0] = m[0] * x + m[4] * y + m[8] * z + m[12] * w;
+        d[1] = m[1] * x + m[5] * y + m[9] * z + m[13] * w;
+        d[2] = m[2] * x + m[6] * y + m[10] * z + m[14] * w;
+        d[3] = m[3] * x + m[7] * y + m[11] * z + m[15] * w;
+    }
+#endif
+}
+
+HCSAPI void
+hc_vec4_transform_batch(hc_vec4_ptr_t dst, hc_vec4_cptr_t src, size_t count, size_t stride, const hc_mat4_t mat)
+{
+#if defined(HC_MATH_DISPATCH)
+    HC_MATH_KERNEL(vec4_transform_batch)(dst, src, count, stride, mat);
+#else
+    hc_vec4_transform_batch_generic(dst, src, count, stride, mat);
+#endif
+}
+
+/* Same as hc_vec2_normalize_batch() */
+HCSAPI void
+hc_vec4_normalize_batch(hc_vec4_ptr_t dst, hc_vec4_cptr_t src, size_t count, size_t stride)
+{
+    if (stride == 0) stride = sizeof(hc_vec4_t);
+
+    size_t i = 0;
+
+#if defined(HC_MATH_SSE2)
+    if (stride == sizeof(hc_vec4_t)) {
+        const __m128 one = _mm_set1_ps(1.0f);
+        for (; i < (count & ~(size_t)3); i += 4) {
+            __m128 x = _mm_loadu_ps(src + 4 * i), y = _mm_loadu_ps(src + 4 * i + 4);
+            __m128 z = _mm_loadu_ps(src + 4 * i + 8), w = _mm_loadu_ps(src + 4 * i + 12);
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            __m128 sq = _mm_mul_ps(x, x);
+            sq = hc_madd_ps(y, y, sq);
+            sq = hc_madd_ps(z, z, sq);
+            sq = hc_madd_ps(w, w, sq);
+            __m128 nonzero = _mm_cmpgt_ps(sq, _mm_setzero_ps());
+            __m128 inv = _mm_or_ps(_mm_and_ps(nonzero, hc_rsqrt_ps(sq)), _mm_andnot_ps(nonzero, one));
+            x = _mm_mul_ps(x, inv), y = _mm_mul_ps(y, inv);
+            z = _mm_mul_ps(z, inv), w = _mm_mul_ps(w, inv);
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            _mm_storeu_ps(dst + 4 * i, x), _mm_storeu_ps(dst + 4 * i + 4, y);
+            _mm_storeu_ps(dst + 4 * i + 8, z), _mm_storeu_ps(dst + 4 * i + 12, w);
+        }
+    }
+#elif defined(HC_MATH_NEON)
+    if (stride == sizeof(hc_vec4_t)) {
+        for (; i < (count & ~(size_t)3); i += 4) {
+            float32x4x4_t v = vld4q_f32(src + 4 * i);
+            float32x4_t sq = vmulq_f32(v.val[0], v.val[0]);
+            for (int_fast8_t c = 1; c < 4; c++) {
+                sq = vmlaq_f32(sq, v.val[c], v.val[c]);
+            }
+            float32x4_t inv = vbslq_f32(vcgtq_f32(sq, vdupq_n_f32(0.0f)), hc_rsqrt_f32(sq), vdupq_n_f32(1.0f));
+            for (int_fast8_t c = 0; c < 4; c++) {
+                v.val[c] = vmulq_f32(v.val[c], inv);
+            }
+            vst4q_f32(dst + 4 * i, v);
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        const float *v = (const float*)((const char*)src + i * stride);
+        float *d = (float*)((char*)dst + i * stride);
+        float sq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3];
+        float inv = (sq > 0.0f) ? hc_rsqrtf(sq) : 1.0f;
+        for (int_fast8_t c = 0; c < 4; c++) {
+            d[c] = v[c] * inv;
+        }
+    }
+}
+
+/* Matrix 4x4 product */
+
+HCSAPI void
+hc_mat4_mul(hc_mat4_t dst, const hc_mat4_t left, const hc_mat4_t right)
+{
+    // Each row of the result is the sum of the rows of 'right' scaled by the
+    // elements of the same row of 'left'. The SIMD paths load both operands
+    // before storing, so 'dst' may alias 'left' or 'right'.
+#if defined(HC_MATH_AVX512)
+    __m512 l = _mm512_loadu_ps(left);
+    __m512 r0 = _mm512_broadcast_f32x4(_mm_loadu_ps(right));
+    __m512 r1 = _mm512_broadcast_f32x4(_mm_loadu_ps(right + 4));
+    __m512 r2 = _mm512_broadcast_f32x4(_mm_loadu_ps(right + 8));
+    __m512 r3 = _mm512_broadcast_f32x4(_mm_loadu_ps(right + 12));
+    __m512 acc = _mm512_mul_ps(_mm512_permute_ps(l, 0x00), r0);
+    acc = _mm512_fmadd_ps(_mm512_permute_ps(l, 0x55), r1, acc);
+    acc = _mm512_fmadd_ps(_mm512_permute_ps(l, 0xAA), r2, acc);
+    acc = _mm512_fmadd_ps(_mm512_permute_ps(l, 0xFF), r3, acc);
+    _mm512_storeu_ps(dst, acc);
+#elif defined(HC_MATH_AVX)
+    // Two rows per 256-bit register
+    __m256 l01 = _mm256_loadu_ps(left);
+    __m256 l23 = _mm256_loadu_ps(left + 8);
+    __m256 r0 = _mm256_broadcast_ps((const __m128*)right);
+    __m256 r1 = _mm256_broadcast_ps((const __m128*)(right + 4));
+    __m256 r2 = _mm256_broadcast_ps((const __m128*)(right + 8));
+    __m256 r3 = _mm256_broadcast_ps((const __m128*)(right + 12));
+    __m256 a01 = _mm256_mul_ps(_mm256_shuffle_ps(l01, l01, 0x00), r0);
+    __m256 a23 = _mm256_mul_ps(_mm256_shuffle_ps(l23, l23, 0x00), r0);
+    a01 = hc_madd256_ps(_mm256_shuffle_ps(l01, l01, 0x55), r1, a01);
+    a23 = hc_madd256_ps(_mm256_shuffle_ps(l23, l23, 0x55), r1, a23);
+    a01 = hc_madd256_ps(_mm256_shuffle_ps(l01, l01, 0xAA), r2, a01);
+    a23 = hc_madd256_ps(_mm256_shuffle_ps(l23, l23, 0xAA), r2, a23);
+    a01 = hc_madd256_ps(_mm256_shuffle_ps(l01, l01, 0xFF), r3, a01);
+    a23 = hc_madd256_ps(_mm256_shuffle_ps(l23, l23, 0xFF), r3, a23);
+    _mm256_storeu_ps(dst, a01);
+    _mm256_storeu_ps(dst + 8, a23);
+#elif defined(HC_MATH_SSE2)
+    __m128 r0 = _mm_loadu_ps(right), r1 = _mm_loadu_ps(right + 4);
+    __m128 r2 = _mm_loadu_ps(right + 8), r3 = _mm_loadu_ps(right + 12);
+    __m128 l[4] = {
+        _mm_loadu_ps(left), _mm_loadu_ps(left + 4),
+        _mm_loadu_ps(left + 8), _mm_loadu_ps(left + 12)
+    };
+    for (int_fast8_t i = 0; i < 4; i++) {
+        __m128 acc = _mm_mul_ps(_mm_shuffle_ps(l[i], l[i], 0x00), r0);
+        acc = hc_madd_ps(_mm_shuffle_ps(l[i], l[i], 0x55), r1, acc);
+        acc = hc_madd_ps(_mm_shuffle_ps(l[i], l[i], 0xAA), r2, acc);
+        acc = hc_madd_ps(_mm_shuffle_ps(l[i], l[i], 0xFF), r3, acc);
+        _mm_storeu_ps(dst + 4 * i, acc);
+    }
+#elif defined(HC_MATH_NEON)
+    float32x4_t r0 = vld1q_f32(right), r1 = vld1q_f32(right + 4);
+    float32x4_t r2 = vld1q_f32(right + 8), r3 = vld1q_f32(right + 12);
+    hc_mat4_t l;
+    for (int_fast8_t i = 0; i < 16; i++) {
+        l[i] = left[i];
+    }
+    for (int_fast8_t i = 0; i < 4; i++) {
+        float32x4_t acc = vmulq_n_f32(r0, l[i * 4 + 0]);
+        acc = hc_madd_f32(acc, r1, l[i * 4 + 1]);
+        acc = hc_madd_f32(acc, r2, l[i * 4 + 2]);
+        acc = hc_madd_f32(acc, r3, l[i * 4 + 3]);
+        vst1q_f32(dst + 4 * i, acc);
+    }
+#else
+    hc_mat4_t result;
+#   ifdef _OPENMP
+#       pragma omp simd
+#   endif
+    for (int_fast8_t i = 0; i < 4; i++) {
+        for (int_fast8_t j = 0; j < 4; j++) {
+            float sum = 0.0;
+            for (int_fast8_t k = 0; k < 4; k++) {
+                sum += left[i * 4 + k] * right[k * 4 + j];
+            }
+            result[i * 4 + j] = sum;
+        }
+    }
+    for (int_fast8_t i = 0; i < 16; i++) {
+        dst[i] = result[i];
+    }
+#endif
+}
+
+HCSAPI void
+hc_mat4_mul_r(hc_mat4_ptr_t HC_RESTRICT dst, const hc_mat4_t left, const hc_mat4_t right)
+{
+#if defined(HC_MATH_SSE2) || defined(HC_MATH_NEON)
+    hc_mat4_mul(dst, left, right);
+#else
+#   ifdef _OPENMP
+#       pragma omp simd
+#   endif
+    for (int_fast8_t i = 0; i < 4; i++) {
+        for (int_fast8_t j = 0; j < 4; j++) {
+            float sum = 0.0;
+            for (int_fast8_t k = 0; k < 4; k++) {
+                sum += left[i * 4 + k] * right[k * 4 + j];
+            }
+            dst[i * 4 + j] = sum;
+        }
+    }
+#endif
+}
+
+/* Double precision transform and product */
+
+HCSAPI void
+hc_dvec4_transform(hc_dvec4_t dst, const hc_dvec4_t v, const hc_dmat4_t mat)
+{
+#if defined(HC_MATH_AVX)
+    // Sum of the matrix columns scaled by the vector components, a column per register
+    __m256d r = _mm256_mul_pd(_mm256_loadu_pd(mat), _mm256_set1_pd(v[0]));
+    r = hc_madd256_pd(_mm256_loadu_pd(mat + 4), _mm256_set1_pd(v[1]), r);
+    r = hc_madd256_pd(_mm256_loadu_pd(mat + 8), _mm256_set1_pd(v[2]), r);
+    r = hc_madd256_pd(_mm256_loadu_pd(mat + 12), _mm256_set1_pd(v[3]), r);
+    _mm256_storeu_pd(dst, r);
+#elif defined(HC_MATH_SSE2)
+    // Same with the columns split in two halves
+    __m128d x = _mm_set1_pd(v[0]), y = _mm_set1_pd(v[1]);
+    __m128d z = _mm_set1_pd(v[2]), w = _mm_set1_pd(v[3]);
+    __m128d lo = _mm_mul_pd(_mm_loadu_pd(mat), x);
+    __m128d hi = _mm_mul_pd(_mm_loadu_pd(mat + 2), x);
+    lo = hc_madd_pd(_mm_loadu_pd(mat + 4), y, lo);
+    hi = hc_madd_pd(_mm_loadu_pd(mat + 6), y, hi);
+    lo = hc_madd_pd(_mm_loadu_pd(mat + 8), z, lo);
+    hi = hc_madd_pd(_mm_loadu_pd(mat + 10), z, hi);
+    lo = hc_madd_pd(_mm_loadu_pd(mat + 12), w, lo);
+    hi = hc_madd_pd(_mm_loadu_pd(mat + 14), w, hi);
+    _mm_storeu_pd(dst, lo);
+    _mm_storeu_pd(dst + 2, hi);
+#else
+    hc_dvec4_t tmp = {
+        mat[0] * v[0] + mat[4] * v[1] + mat[8] * v[2] + mat[12] * v[3],
+        mat[1] * v[0] + mat[5] * v[1] + mat[9] * v[2] + mat[13] * v[3],
+        mat[2] * v[0] + mat[6] * v[1] + mat[10] * v[2] + mat[14] * v[3],
+        mat[3] * v[0] + mat[7] * v[1] + mat[11] * v[2] + mat[15] * v[3]
+    };
+
+    for (int_fast8_t i = 0; i < 4; i++) {
+        dst[i] = tmp[i];
+    }
+#endif
+}
+
+HCSAPI void
+hc_dvec4_transform_r(hc_dvec4_ptr_t HC_RESTRICT dst, const hc_dvec4_t v, const hc_dmat4_t mat)
+{
+#if defined(HC_MATH_SSE2)
+    hc_dvec4_transform(dst, v, mat);
+#else
+    dst[0] = mat[0] * v[0] + mat[4] * v[1] + mat[8] * v[2] + mat[12] * v[3];
+    dst[1] = mat[1] * v[0] + mat[5] * v[1] + mat[9] * v[2] + mat[13] * v[3];
+    dst[2] = mat[2] * v[0] + mat[6] * v[1] + mat[10] * v[2] + mat[14] * v[3];
+    dst[3] = mat[3] * v[0] + mat[7] * v[1] + mat[11] * v[2] + mat[15] * v[3];
+#endif
+}
+
+HCSAPI void
+hc_dmat4_mul(hc_dmat4_t dst, const hc_dmat4_t left, const hc_dmat4_t right)
+{
+    // Same as hc_mat4_mul(), the rows of the result are sums of the rows of 'right'
+#if defined(HC_MATH_AVX512)
+    // Two rows per 512-bit register
+    __m512d l01 = _mm512_loadu_pd(left);
+    __m512d l23 = _mm512_loadu_pd(left + 8);
+    __m512d r0 = _mm512_broadcast_f64x4(_mm256_loadu_pd(right));
+    __m512d r1 = _mm512_broadcast_f64x4(_mm256_loadu_pd(right + 4));
+    __m512d r2 = _mm512_broadcast_f64x4(_mm256_loadu_pd(right + 8));
+    __m512d r3 = _mm512_broadcast_f64x4(_mm256_loadu_pd(right + 12));
+    __m512d a01 = _mm512_mul_pd(_mm512_permutex_pd(l01, 0x00), r0);
+    __m512d a23 = _mm512_mul_pd(_mm512_permutex_pd(l23, 0x00), r0);
+    a01 = _mm512_fmadd_pd(_mm512_permutex_pd(l01, 0x55), r1, a01);
+    a23 = _mm512_fmadd_pd(_mm512_permutex_pd(l23, 0x55), r1, a23);
+    a01 = _mm512_fmadd_pd(_mm512_permutex_pd(l01, 0xAA), r2, a01);
+    a23 = _mm512_fmadd_pd(_mm512_permutex_pd(l23, 0xAA), r2, a23);
+    a01 = _mm512_fmadd_pd(_mm512_permutex_pd(l01, 0xFF), r3, a01);
+    a23 = _mm512_fmadd_pd(_mm512_permutex_pd(l23, 0xFF), r3, a23);
+    _mm512_storeu_pd(dst, a01);
+    _mm512_storeu_pd(dst + 8, a23);
+#elif defined(HC_MATH_AVX)
+    // One row per 256-bit register
+    __m256d r0 = _mm256_loadu_pd(right), r1 = _mm256_loadu_pd(right + 4);
+    __m256d r2 = _mm256_loadu_pd(right + 8), r3 = _mm256_loadu_pd(right + 12);
+    __m256d a[4];
+    for (int_fast8_t i = 0; i < 4; i++) {
+        const double *l = left + 4 * i;
+        __m256d acc = _mm256_mul_pd(_mm256_set1_pd(l[0]), r0);
+        acc = hc_madd256_pd(_mm256_set1_pd(l[1]), r1, acc);
+        acc = hc_madd256_pd(_mm256_set1_pd(l[2]), r2, acc);
+        a[i] = hc_madd256_pd(_mm256_set1_pd(l[3]), r3, acc);
+    }
+    for (int_fast8_t i = 0; i < 4; i++) {
+        _mm256_storeu_pd(dst + 4 * i, a[i]);
+    }
+#else
+    hc_dmat4_t result;
+    for (int_fast8_t i = 0; i < 4; i++) {
+        for (int_fast8_t j = 0; j < 4; j++) {
+            double sum = 0.0;
+            for (int_fast8_t k = 0; k < 4; k++) {
+                sum += left[i * 4 + k] * right[k * 4 + j];
+            }
+            result[i * 4 + j] = sum;
+        }
+    }
+    for (int_fast8_t i = 0; i < 16; i++) {
+        dst[i] = result[i];
+    }
+#endif
+}
+
+HCSAPI void
+hc_dmat4_mul_r(hc_dmat4_ptr_t HC_RESTRICT dst, const hc_dmat4_t left, const hc_dmat4_t right)
+{
+#if defined(HC_MATH_AVX)
+    hc_dmat4_mul(dst, left, right);
+#else
+    for (int_fast8_t i = 0; i < 4; i++) {
+        for (int_fast8_t j = 0; j < 4; j++) {
+            double sum = 0.0;
+            for (int_fast8_t k = 0; k < 4; k++) {
+                sum += left[i * 4 + k] * right[k * 4 + j];
+            }
+            dst[i * 4 + j] = sum;
+        }
+    }
+#endif
+}
+
+/* Conversions between precisions */
+
+HCSAPI void
+hc_vec3_from_dvec3(hc_vec3_t dst, const hc_dvec3_t v)
+{
+    dst[0] = (float)v[0];
+    dst[1] = (float)v[1];
+    dst[2] = (float)v[2];
+}
+
+HCSAPI void
+hc_dvec3_from_vec3(hc_dvec3_t dst, const hc_vec3_t v)
+{
+    dst[0] = v[0];
+    dst[1] = v[1];
+    dst[2] = v[2];
+}
+
+HCSAPI void
+hc_mat4_from_dmat4(hc_mat4_t dst, const hc_dmat4_t mat)
+{
+    for (int_fast8_t i = 0; i < 16; i++) {
+        dst[i] = (float)mat[i];
+    }
+}
+
+HCSAPI void
+hc_dmat4_from_mat4(hc_dmat4_t dst, const hc_mat4_t mat)
+{
+    for (int_fast8_t i = 0; i < 16; i++) {
+        dst[i] = mat[i];
+    }
+}
+
+/*
+ * Same as hc_mat4_from_dmat4() with 'origin' subtracted from the translation
+ * before the conversion, to render far from the world origin relative to the
+ * camera position without losing the precision of the translation.
+ */
+HCSAPI void
+hc_mat4_from_dmat4_relative(hc_mat4_t dst, const hc_dmat4_t mat, const hc_dvec3_t origin)
+{
+    for (int_fast8_t i = 0; i < 4; i++) {
+        const double *c = mat + 4 * i;
+        dst[4 * i + 0] = (float)(c[0] - origin[0] * c[3]);
+        dst[4 * i + 1] = (float)(c[1] - origin[1] * c[3]);
+        dst[4 * i + 2] = (float)(c[2] - origin[2] * c[3]);
+        dst[4 * i + 3] = (float)c[3];
+    }
+}
+
+/* Matrix 3x4 (affine) function definitions */
+
+// NOTE: hc_mat3x4_t is a hc_mat4_t without its last row, (0, 0, 0, 1) being implied.
+//       It is stored as 4 columns of 3 floats: the 3 axes then the translation.
+
+HCSAPI void
+hc_mat3x4_identity(hc_mat3x4_t dst)
+{
+    for (int_fast8_t i = 0; i < 12; i++) {
+        dst[i] = (float)(!(i % 4));
+    }
+}
+
+HCSAPI void
+hc_mat3x4_from_mat4(hc_mat3x4_t dst, const hc_mat4_t mat)
+{
+    for (int_fast8_t i = 0; i < 4; i++) {
+        dst[i * 3 + 0] = mat[i * 4 + 0];
+        dst[i * 3 + 1] = mat[i * 4 + 1];
+        dst[i * 3 + 2] = mat[i * 4 + 2];
+    }
+}
+
+HCSAPI void
+hc_mat3x4_to_mat4(hc_mat4_t dst, const hc_mat3x4_t mat)
+{
+    for (int_fast8_t i = 0; i < 4; i++) {
+        dst[i * 4 + 0] = mat[i * 3 + 0];
+        dst[i * 4 + 1] = mat[i * 3 + 1];
+        dst[i * 4 + 2] = mat[i * 3 + 2];
+        dst[i * 4 + 3] = 0.0f;
+    }
+    dst[15] = 1.0f;
+}
+
+/* Same order as hc_mat4_mul(): the result applies 'left' then 'right' */
+HCSAPI void
+hc_mat3x4_mul(hc_mat3x4_t dst, const hc_mat3x4_t left, const hc_mat3x4_t right)
+{
+    float l[12], r[12];
+    for (int_fast8_t i = 0; i < 12; i++) {
+        l[i] = left[i];
+        r[i] = right[i];
+    }
+
+    // Each column of 'left' is transformed by 'right', the translation as a point
+    for (int_fast8_t i = 0; i < 4; i++) {
+        float x = l[i * 3 + 0], y = l[i * 3 + 1], z = l[i * 3 + 2];
+        float w = (float)(i == 3);
+        dst[i * 3 + 0] = r[0] * x + r[3] * y + r[6] * z + r[9] * w;
+        dst[i * 3 + 1] = r[1] * x + r[4] * y + r[7] * z + r[10] * w;
+        dst[i * 3 + 2] = r[2] * x + r[5] * y + r[8] * z + r[11] * w;
+    }
+}
+
+HCSAPI void
+hc_mat3x4_invert(hc_mat3x4_t dst, const hc_mat3x4_t src)
+{
+    hc_affine_invert_columns(dst, src, 3);
+}
+
+HCSAPI void
+hc_mat3x4_invert_rigid(hc_mat3x4_t dst, const hc_mat3x4_t src)
+{
+    hc_rigid_invert_columns(dst, src, 3);
+}
+
+HCSAPI void
+hc_mat3x4_transform(hc_vec3_t dst, const hc_vec3_t v, const hc_mat3x4_t mat)
+{
+    float x = v[0], y = v[1], z = v[2];
+    dst[0] = mat[0] * x + mat[3] * y + mat[6] * z + mat[9];
+    dst[1] = mat[1] * x + mat[4] * y + mat[7] * z + mat[10];
+    dst[2] = mat[2] * x + mat[5] * y + mat[8] * z + mat[11];
+}
+
+/* Same as hc_mat3x4_transform() without the translation, for directions */
+HCSAPI void
+hc_mat3x4_transform_dir(hc_vec3_t dst, const hc_vec3_t v, const hc_mat3x4_t mat)
+{
+    float x = v[0], y = v[1], z = v[2];
+    dst[0] = mat[0] * x + mat[3] * y + mat[6] * z;
+    dst[1] = mat[1] * x + mat[4] * y + mat[7] * z;
+    dst[2] = mat[2] * x + mat[5] * y + mat[8] * z;
+}
+
+/* Batch functions, the arrays are packed and 'dst' may be one of the sources */
+
+HCSAPI void
+hc_mat3x4_mul_batch(hc_mat3x4_ptr_t dst, hc_mat3x4_cptr_t left, hc_mat3x4_cptr_t right, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        hc_mat3x4_mul(dst + 12 * i, left + 12 * i, right + 12 * i);
+    }
+}
+
+HCSAPI void
+hc_mat3x4_invert_batch(hc_mat3x4_ptr_t dst, hc_mat3x4_cptr_t src, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        hc_mat3x4_invert(dst + 12 * i, src + 12 * i);
+    }
+}
+
+HCSAPI void
+hc_mat3x4_invert_rigid_batch(hc_mat3x4_ptr_t dst, hc_mat3x4_cptr_t src, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        hc_mat3x4_invert_rigid(dst + 12 * i, src + 12 * i);
+    }
+}
+
+/* Transforms points by one matrix, 'stride' is the same as for hc_vec3_transform_batch() */
+HCSAPI void
+hc_mat3x4_transform_batch(hc_vec3_ptr_t dst, hc_vec3_cptr_t src, size_t count, size_t stride, const hc_mat3x4_t mat)
+{
+    hc_mat4_t m;
+    hc_mat3x4_to_mat4(m, mat);
+    hc_vec3_transform_batch(dst, src, count, stride, m);
+}
+
+/* Quaternion function definitions */
+
+// NOTE: Quaternions are stored as (x, y, z, w) and are expected to be normalized
+//       unless stated otherwise. Outputs may alias the inputs.
+
+HCSAPI void
+hc_quat_identity(hc_quat_t dst)
+{
+    dst[0] = dst[1] = dst[2] = 0.0f;
+    dst[3] = 1.0f;
+}
+
+HCSAPI void
+hc_quat_set(hc_quat_t dst, float x, float y, float z, float w)
+{
+    dst[0] = x, dst[1] = y;
+    dst[2] = z, dst[3] = w;
+}
+
+HCSAPI float
+hc_quat_dot(const hc_quat_t q1, const hc_quat_t q2)
+{
+    return q1[0]*q2[0] + q1[1]*q2[1] + q1[2]*q2[2] + q1[3]*q2[3];
+}
+
+HCSAPI void
+hc_quat_normalize(hc_quat_t dst, const hc_quat_t q)
+{
+    float lengthSq = q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3];
+    float invLength = (lengthSq > 0.0f) ? hc_rsqrtf(lengthSq) : 0.0f;
+
+    for (int_fast8_t i = 0; i < 4; i++) {
+        dst[i] = q[i] * invLength;
+    }
+}
+
+HCSAPI void
+hc_quat_conjugate(hc_quat_t dst, const hc_quat_t q)
+{
+    dst[0] = -q[0];
+    dst[1] = -q[1];
+    dst[2] = -q[2];
+    dst[3] = q[3];
+}
+
+/* Inverse of a quaternion of any length (the conjugate is enough for unit quaternions) */
+HCSAPI void
+hc_quat_invert(hc_quat_t dst, const hc_quat_t q)
+{
+    float lengthSq = q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3];
+    float invLengthSq = (lengthSq > 0.0f) ? 1.0f / lengthSq : 0.0f;
+
+    dst[0] = -q[0] * invLengthSq;
+    dst[1] = -q[1] * invLengthSq;
+    dst[2] = -q[2] * invLengthSq;
+    dst[3] = q[3] * invLengthSq;
+}
+
+/* Hamilton product q1*q2, the rotation by 'q2' followed by the rotation by 'q1' */
+HCSAPI void
+hc_quat_mul(hc_quat_t dst, const hc_quat_t q1, const hc_quat_t q2)
+{
+    float ax = q1[0], ay = q1[1], az = q1[2], aw = q1[3];
+    float bx = q2[0], by = q2[1], bz = q2[2], bw = q2[3];
+
+    dst[0] = aw*bx + ax*bw + ay*bz - az*by;
+    dst[1] = aw*by - ax*bz + ay*bw + az*bx;
+    dst[2] = aw*bz + ax*by - ay*bx + az*bw;
+    dst[3] = aw*bw - ax*bx - ay*by - az*bz;
+}
+
+HCSAPI void
+hc_quat_from_axis_angle(hc_quat_t dst, const hc_vec3_t axis, float radians)
+{
+    float x = axis[0], y = axis[1], z = axis[2];
+    float lengthSq = x*x + y*y + z*z;
+
+    if (lengthSq == 0.0f) {
+        hc_quat_identity(dst);
+        return;
+    }
+
+    float s = hc_math_sinf(0.5f * radians) * hc_rsqrtf(lengthSq);
+
+    dst[0] = x * s;
+    dst[1] = y * s;
+    dst[2] = z * s;
+    dst[3] = hc_math_cosf(0.5f * radians);
+}
+
+/* Same rotation as h_rotate_zyx_mat4(): around X, then Y, then Z */
+HCSAPI void
+hc_quat_from_euler(hc_quat_t dst, const hc_vec3_t radians)
+{
+    float cx = hc_math_cosf(0.5f * radians[0]), sx = hc_math_sinf(0.5f * radians[0]);
+    float cy = hc_math_cosf(0.5f * radians[1]), sy = hc_math_sinf(0.5f * radians[1]);
+    float cz = hc_math_cosf(0.5f * radians[2]), sz = hc_math_sinf(0.5f * radians[2]);
+
+    dst[0] = sx*cy*cz - cx*sy*sz;
+    dst[1] = cx*sy*cz + sx*cy*sz;
+    dst[2] = cx*cy*sz - sx*sy*cz;
+    dst[3] = cx*cy*cz + sx*sy*sz;
+}
+
+/* Writes the rotation in the same layout as hc_mat4_rotate() */
+HCSAPI void
+hc_quat_to_mat4(hc_mat4_t dst, const hc_quat_t q)
+{
+    float x = q[0], y = q[1], z = q[2], w = q[3];
+    float x2 = x + x, y2 = y + y, z2 = z + z;
+    float xx = x*x2, yy = y*y2, zz = z*z2;
+    float xy = x*y2, xz = x*z2, yz = y*z2;
+    float wx = w*x2, wy = w*y2, wz = w*z2;
+
+    dst[0]  = 1.0f - (yy + zz);
+    dst[1]  = xy + wz;
+    dst[2]  = xz - wy;
+    dst[3]  = 0.0f;
+
+    dst[4]  = xy - wz;
+    dst[5]  = 1.0f - (xx + zz);
+    dst[6]  = yz + wx;
+    dst[7]  = 0.0f;
+
+    dst[8]  = xz + wy;
+    dst[9]  = yz - wx;
+    dst[10] = 1.0f - (xx + yy);
+    dst[11] = 0.0f;
+
+    dst[12] = dst[13] = dst[14] = 0.0f;
+    dst[15] = 1.0f;
+}
+
+/* Rotation part of a matrix without scaling */
+HCSAPI void
+hc_quat_from_mat4(hc_quat_t dst, const hc_mat4_t mat)
+{
+    float m00 = mat[0], m01 = mat[4], m02 = mat[8];
+    float m10 = mat[1], m11 = mat[5], m12 = mat[9];
+    float m20 = mat[2], m21 = mat[6], m22 = mat[10];
+    float trace = m00 + m11 + m22;
+
+    // Divides by the largest component to stay accurate
+    if (trace > 0.0f) {
+        float s = 0.5f * hc_rsqrtf(trace + 1.0f);
+        dst[0] = (m21 - m12) * s;
+        dst[1] = (m02 - m20) * s;
+        dst[2] = (m10 - m01) * s;
+        dst[3] = 0.25f / s;
+    } else if (m00 > m11 && m00 > m22) {
+        float s = 2.0f * sqrtf(1.0f + m00 - m11 - m22), is = 1.0f / s;
+        dst[0] = 0.25f * s;
+        dst[1] = (m01 + m10) * is;
+        dst[2] = (m02 + m20) * is;
+        dst[3] = (m21 - m12) * is;
+    } else if (m11 > m22) {
+        float s = 2.0f * sqrtf(1.0f + m11 - m00 - m22), is = 1.0f / s;
+        dst[0] = (m01 + m10) * is;
+        dst[1] = 0.25f * s;
+        dst[2] = (m12 + m21) * is;
+        dst[3] = (m02 - m20) * is;
+    } else {
+        float s = 2.0f * sqrtf(1.0f + m22 - m00 - m11), is = 1.0f / s;
+        dst[0] = (m02 + m20) * is;
+        dst[1] = (m12 + m21) * is;
+        dst[2] = 0.25f * s;
+        dst[3] = (m10 - m01) * is;
+    }
+}
+
+/* Rotates 'v' by 'q' with v + 2w(u x v) + 2u x (u x v), u being the vector part (15 mul, 15 add) */
+HCSAPI void
+hc_vec3_rotate(hc_vec3_t dst, const hc_vec3_t v, const hc_quat_t q)
+{
+    float ux = q[0], uy = q[1], uz = q[2], w = q[3];
+    float vx = v[0], vy = v[1], vz = v[2];
+
+    // t = 2 (u x v)
+    float tx = 2.0f * (uy*vz - uz*vy);
+    float ty = 2.0f * (uz*vx - ux*vz);
+    float tz = 2.0f * (ux*vy - uy*vx);
+
+    // v + w t + u x t
+    dst[0] = vx + w*tx + (uy*tz - uz*ty);
+    dst[1] = vy + w*ty + (uz*tx - ux*tz);
+    dst[2] = vz + w*tz + (ux*ty - uy*tx);
+}
+
+/* Normalized linear interpolation along the shortest arc, constant speed is not preserved */
+HCSAPI void
+hc_quat_nlerp(hc_quat_t dst, const hc_quat_t q1, const hc_quat_t q2, float t)
+{
+    float w1 = 1.0f - t;
+    float w2 = (hc_quat_dot(q1, q2) < 0.0f) ? -t : t;
+
+    hc_quat_t tmp;
+    for (int_fast8_t i = 0; i < 4; i++) {
+        tmp[i] = w1 * q1[i] + w2 * q2[i];
+    }
+
+    hc_quat_normalize(dst, tmp);
+}
+
+/* Spherical interpolation along the shortest arc */
+HCSAPI void
+hc_quat_slerp(hc_quat_t dst, const hc_quat_t q1, const hc_quat_t q2, float t)
+{
+    float cosTheta = hc_quat_dot(q1, q2);
+    float sign = 1.0f;
+
+    if (cosTheta < 0.0f) {
+        cosTheta = -cosTheta;
+        sign = -1.0f;
+    }
+
+    // Nearly the same orientation, sin(theta) vanishes
+    if (cosTheta > 0.9995f) {
+        hc_quat_nlerp(dst, q1, q2, t);
+        return;
+    }
+
+    float theta = acosf(cosTheta);
+    float invSinTheta = 1.0f / hc_math_sinf(theta);
+    float w1 = hc_math_sinf((1.0f - t) * theta) * invSinTheta;
+    float w2 = hc_math_sinf(t * theta) * invSinTheta * sign;
+
+    for (int_fast8_t i = 0; i < 4; i++) {
+        dst[i] = w1 * q1[i] + w2 * q2[i];
+    }
+}
+
+/*
+ * Approximated slerp: nlerp with 't' corrected by a polynomial fitted on the
+ * angle between the quaternions, no trigonometric function is evaluated.
+ * The angular error stays below about 1e-3 radians.
+ * SEE: https://zeux.io/2015/07/23/approximating-slerp/
+ */
+
+HCSAPI float
+hc_quat_slerp_fast_t(float cosTheta, float t)
+{
+    float d = fabsf(cosTheta);
+    float a = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+    float b = 0.848013f + d * (-1.06021f + d * 0.215638f);
+    float k = a * (t - 0.5f) * (t - 0.5f) + b;
+    return t + t * (t - 0.5f) * (t - 1.0f) * k;
+}
+
+HCSAPI void
+hc_quat_slerp_fast(hc_quat_t dst, const hc_quat_t q1, const hc_quat_t q2, float t)
+{
+    hc_quat_nlerp(dst, q1, q2, hc_quat_slerp_fast_t(hc_quat_dot(q1, q2), t));
+}
+
+/* Batch functions, the arrays are packed and 'dst' may be one of the sources */
+
+HCSAPI void
+hc_quat_mul_batch(hc_quat_ptr_t dst, hc_quat_cptr_t q1, hc_quat_cptr_t q2, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        hc_quat_mul(dst + 4 * i, q1 + 4 * i, q2 + 4 * i);
+    }
+}
+
+HCSAPI void
+hc_quat_to_mat4_batch(hc_mat4_ptr_t dst, hc_quat_cptr_t q, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        hc_quat_to_mat4(dst + 16 * i, q + 4 * i);
+    }
+}
+
+/* Rotates vectors by one quaternion, 'stride' is the same as for hc_vec3_transform_batch() */
+HCSAPI void
+hc_vec3_rotate_batch(hc_vec3_ptr_t dst, hc_vec3_cptr_t src, size_t count, size_t stride, const hc_quat_t q)
+{
+    hc_mat4_t mat;
+    hc_quat_to_mat4(mat, q);
+    hc_vec3_transform_wt_batch(dst, src, count, stride, 0.0f, mat);
+}
+
+/*
+ * Interpolation of whole poses with the same factor, as for blending two
+ * animations. The SIMD paths transpose groups of quaternions so that each
+ * register holds one component. If 'fast_slerp' is set, 't' is corrected
+ * as in hc_quat_slerp_fast(), otherwise this is a plain nlerp.
+ */
+
+HCSAPI void
+hc_quat_blend_batch(hc_quat_ptr_t dst, hc_quat_cptr_t q1, hc_quat_cptr_t q2, size_t count, float t, int fast_slerp)
+{
+    size_t i = 0;
+
+#if defined(HC_MATH_SSE2) || defined(HC_MATH_NEON)
+    // Factors of the correction of 't' that don't depend on the angle
+    const float tt = (t - 0.5f) * (t - 0.5f);
+    const float tk = t * (t - 0.5f) * (t - 1.0f);
+#endif
+
+#if defined(HC_MATH_AVX)
+    // In-lane transpose: the lanes hold the quaternions 0,2,4,6 and 1,3,5,7
+#   define HC_MATH_TRANSPOSE4_256(r0, r1, r2, r3) do {                 \
+        __m256 t0 = _mm256_unpacklo_ps(r0, r1);                         \
+        __m256 t1 = _mm256_unpacklo_ps(r2, r3);                         \
+        __m256 t2 = _mm256_unpackhi_ps(r0, r1);                         \
+        __m256 t3 = _mm256_unpackhi_ps(r2, r3);                         \
+        r0 = _mm256_shuffle_ps(t0, t1, 0x44);                           \
+        r1 = _mm256_shuffle_ps(t0, t1, 0xEE);                           \
+        r2 = _mm256_shuffle_ps(t2, t3, 0x44);                           \
+        r3 = _mm256_shuffle_ps(t2, t3, 0xEE);                           \
+    } while (0)
+
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    for (; i < (count & ~(size_t)7); i += 8) {
+        __m256 ax = _mm256_loadu_ps(q1 + 4 * i), ay = _mm256_loadu_ps(q1 + 4 * i + 8);
+        __m256 az = _mm256_loadu_ps(q1 + 4 * i + 16), aw = _mm256_loadu_ps(q1 + 4 * i + 24);
+        __m256 bx = _mm256_loadu_ps(q2 + 4 * i), by = _mm256_loadu_ps(q2 + 4 * i + 8);
+        __m256 bz = _mm256_loadu_ps(q2 + 4 * i + 16), bw = _mm256_loadu_ps(q2 + 4 * i + 24);
+        HC_MATH_TRANSPOSE4_256(ax, ay, az, aw);
+        HC_MATH_TRANSPOSE4_256(bx, by, bz, bw);
+
+        __m256 d = _mm256_mul_ps(ax, bx);
+        d = hc_madd256_ps(ay, by, d);
+        d = hc_madd256_ps(az, bz, d);
+        d = hc_madd256_ps(aw, bw, d);
+        __m256 sign = _mm256_and_ps(d, sign_mask);
+
+        __m256 w2 = _mm256_set1_ps(t);
+        if (fast_slerp) {
+            d = _mm256_andnot_ps(sign_mask, d);
+            __m256 a = hc_madd256_ps(d, _mm256_set1_ps(-1.43519f), _mm256_set1_ps(3.55645f));
+            a = hc_madd256_ps(d, a, _mm256_set1_ps(-3.2452f));
+            a = hc_madd256_ps(d, a, _mm256_set1_ps(1.0904f));
+            __m256 b = hc_madd256_ps(d, _mm256_set1_ps(0.215638f), _mm256_set1_ps(-1.06021f));
+            b = hc_madd256_ps(d, b, _mm256_set1_ps(0.848013f));
+            __m256 k = hc_madd256_ps(a, _mm256_set1_ps(tt), b);
+            w2 = hc_madd256_ps(k, _mm256_set1_ps(tk), w2);
+        }
+        __m256 w1 = _mm256_sub_ps(one, w2);
+        w2 = _mm256_xor_ps(w2, sign);
+
+        __m256 rx = hc_madd256_ps(w2, bx, _mm256_mul_ps(w1, ax));
+        __m256 ry = hc_madd256_ps(w2, by, _mm256_mul_ps(w1, ay));
+        __m256 rz = hc_madd256_ps(w2, bz, _mm256_mul_ps(w1, az));
+        __m256 rw = hc_madd256_ps(w2, bw, _mm256_mul_ps(w1, aw));
+
+        __m256 len = _mm256_mul_ps(rx, rx);
+        len = hc_madd256_ps(ry, ry, len);
+        len = hc_madd256_ps(rz, rz, len);
+        len = hc_madd256_ps(rw, rw, len);
+        __m256 inv = hc_rsqrt256_ps(len);
+        rx = _mm256_mul_ps(rx, inv), ry = _mm256_mul_ps(ry, inv);
+        rz = _mm256_mul_ps(rz, inv), rw = _mm256_mul_ps(rw, inv);
+
+        HC_MATH_TRANSPOSE4_256(rx, ry, rz, rw);
+        _mm256_storeu_ps(dst + 4 * i, rx), _mm256_storeu_ps(dst + 4 * i + 8, ry);
+        _mm256_storeu_ps(dst + 4 * i + 16, rz), _mm256_storeu_ps(dst + 4 * i + 24, rw);
+    }
+
+#   undef HC_MATH_TRANSPOSE4_256
+#endif
+
+#if defined(HC_MATH_SSE2)
+    const __m128 one4 = _mm_set1_ps(1.0f);
+    const __m128 sign_mask4 = _mm_set1_ps(-0.0f);
+    for (; i < (count & ~(size_t)3); i += 4) {
+        __m128 ax = _mm_loadu_ps(q1 + 4 * i), ay = _mm_loadu_ps(q1 + 4 * i + 4);
+        __m128 az = _mm_loadu_ps(q1 + 4 * i + 8), aw = _mm_loadu_ps(q1 + 4 * i + 12);
+        __m128 bx = _mm_loadu_ps(q2 + 4 * i), by = _mm_loadu_ps(q2 + 4 * i + 4);
+        __m128 bz = _mm_loadu_ps(q2 + 4 * i + 8), bw = _mm_loadu_ps(q2 + 4 * i + 12);
+        _MM_TRANSPOSE4_PS(ax, ay, az, aw);
+        _MM_TRANSPOSE4_PS(bx, by, bz, bw);
+
+        __m128 d = _mm_mul_ps(ax, bx);
+        d = hc_madd_ps(ay, by, d);
+        d = hc_madd_ps(az, bz, d);
+        d = hc_madd_ps(aw, bw, d);
+        __m128 sign = _mm_and_ps(d, sign_mask4);
+
+        __m128 w2 = _mm_set1_ps(t);
+        if (fast_slerp) {
+            d = _mm_andnot_ps(sign_mask4, d);
+            __m128 a = hc_madd_ps(d, _mm_set1_ps(-1.43519f), _mm_set1_ps(3.55645f));
+            a = hc_madd_ps(d, a, _mm_set1_ps(-3.2452f));
+            a = hc_madd_ps(d, a, _mm_set1_ps(1.0904f));
+            __m128 b = hc_madd_ps(d, _mm_set1_ps(0.215638f), _mm_set1_ps(-1.06021f));
+            b = hc_madd_ps(d, b, _mm_set1_ps(0.848013f));
+            __m128 k = hc_madd_ps(a, _mm_set1_ps(tt), b);
+            w2 = hc_madd_ps(k, _mm_set1_ps(tk), w2);
+        }
+        __m128 w1 = _mm_sub_ps(one4, w2);
+        w2 = _mm_xor_ps(w2, sign);
+
+        __m128 rx = hc_madd_ps(w2, bx, _mm_mul_ps(w1, ax));
+        __m128 ry = hc_madd_ps(w2, by, _mm_mul_ps(w1, ay));
+        __m128 rz = hc_madd_ps(w2, bz, _mm_mul_ps(w1, az));
+        __m128 rw = hc_madd_ps(w2, bw, _mm_mul_ps(w1, aw));
+
+        __m128 len = _mm_mul_ps(rx, rx);
+        len = hc_madd_ps(ry, ry, len);
+        len = hc_madd_ps(rz, rz, len);
+        len = hc_madd_ps(rw, rw, len);
+        __m128 inv = hc_rsqrt_ps(len);
+        rx = _mm_mul_ps(rx, inv), ry = _mm_mul_ps(ry, inv);
+        rz = _mm_mul_ps(rz, inv), rw = _mm_mul_ps(rw, inv);
+
+        _MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+        _mm_storeu_ps(dst + 4 * i, rx), _mm_storeu_ps(dst + 4 * i + 4, ry);
+        _mm_storeu_ps(dst + 4 * i + 8, rz), _mm_storeu_ps(dst + 4 * i + 12, rw);
+    }
+#elif defined(HC_MATH_NEON)
+    // vld4q deinterleaves the components of 4 quaternions
+    for (; i < (count & ~(size_t)3); i += 4) {
+        float32x4x4_t a = vld4q_f32(q1 + 4 * i);
+        float32x4x4_t b = vld4q_f32(q2 + 4 * i);
+
+        float32x4_t d = vmulq_f32(a.val[0], b.val[0]);
+        d = vmlaq_f32(d, a.val[1], b.val[1]);
+        d = vmlaq_f32(d, a.val[2], b.val[2]);
+        d = vmlaq_f32(d, a.val[3], b.val[3]);
+        uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(d), vdupq_n_u32(0x80000000u));
+
+        float32x4_t w2 = vdupq_n_f32(t);
+        if (fast_slerp) {
+            d = vabsq_f32(d);
+            float32x4_t a3 = hc_madd_f32(vdupq_n_f32(3.55645f), d, -1.43519f);
+            float32x4_t a2 = vmlaq_f32(vdupq_n_f32(-3.2452f), d, a3);
+            float32x4_t ka = vmlaq_f32(vdupq_n_f32(1.0904f), d, a2);
+            float32x4_t b1 = hc_madd_f32(vdupq_n_f32(-1.06021f), d, 0.215638f);
+            float32x4_t kb = vmlaq_f32(vdupq_n_f32(0.848013f), d, b1);
+            float32x4_t k = hc_madd_f32(kb, ka, tt);
+            w2 = hc_madd_f32(w2, k, tk);
+        }
+        float32x4_t w1 = vsubq_f32(vdupq_n_f32(1.0f), w2);
+        w2 = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(w2), sign));
+
+        float32x4x4_t r;
+        float32x4_t len = vdupq_n_f32(0.0f);
+        for (int_fast8_t c = 0; c < 4; c++) {
+            r.val[c] = vmlaq_f32(vmulq_f32(w1, a.val[c]), w2, b.val[c]);
+            len = vmlaq_f32(len, r.val[c], r.val[c]);
+        }
+
+        float32x4_t inv = hc_rsqrt_f32(len);
+        for (int_fast8_t c = 0; c < 4; c++) {
+            r.val[c] = vmulq_f32(r.val[c], inv);
+        }
+
+        vst4q_f32(dst + 4 * i, r);
+    }
+#endif
+
+    for (; i < count; i++) {
+        const float *a = q1 + 4 * i, *b = q2 + 4 * i;
+        float d = hc_quat_dot(a, b);
+        float w2 = fast_slerp ? hc_quat_slerp_fast_t(d, t) : t;
+        float w1 = 1.0f - w2;
+        if (d < 0.0f) w2 = -w2;
+
+        hc_quat_t tmp;
+        for (int_fast8_t c = 0; c < 4; c++) {
+            tmp[c] = w1 * a[c] + w2 * b[c];
+        }
+        hc_quat_normalize(dst + 4 * i, tmp);
+    }
+}
+
+HCSAPI void
+hc_quat_nlerp_batch(hc_quat_ptr_t dst, hc_quat_cptr_t q1, hc_quat_cptr_t q2, size_t count, float t)
+{
+    hc_quat_blend_batch(dst, q1, q2, count, t, 0);
+}
+
+HCSAPI void
+hc_quat_slerp_fast_batch(hc_quat_ptr_t dst, hc_quat_cptr_t q1, hc_quat_cptr_t q2, size_t count, float t)
+{
+    hc_quat_blend_batch(dst, q1, q2, count, t, 1);
+}
+
+/* Frustum culling */
+
+// NOTE: Planes are stored as (a, b, c, d) with (a, b, c) of unit length, so that
+//       a*x + b*y + c*z + d is the distance of a point, positive on the inner side.
+//       Boxes are given by their center and their half sizes ('extents').
+
+/* Planes of the clip volume of 'mat' (-w <= x, y, z <= w), in the space it transforms from */
+HCSAPI void
+hc_frustum_from_mat4(hc_frustum_t dst, const hc_mat4_t mat)
+{
+    // Row r of the matrix is (mat[r], mat[4 + r], mat[8 + r], mat[12 + r]), the planes are row 3 +/- row r
+    for (int_fast8_t i = 0; i < 6; i++) {
+        int_fast8_t row = i >> 1;
+        float sign = (i & 1) ? -1.0f : 1.0f;
+        float* plane = dst + 4 * i;
+
+        for (int_fast8_t j = 0; j < 4; j++) {
+            plane[j] = mat[4 * j + 3] + sign * mat[4 * j + row];
+        }
+
+        // The far plane of an infinite projection is left as is
+        float lengthSq = plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2];
+        if (lengthSq > 0.0f) {
+            float invLength = 1.0f / sqrtf(lengthSq);
+            for (int_fast8_t j = 0; j < 4; j++) plane[j] *= invLength;
+        }
+    }
+}
+
+/* Returns 1 if the sphere is inside or crosses the frustum, 0 otherwise */
+HCSAPI int
+hc_frustum_test_sphere(const hc_frustum_t frustum, const hc_vec3_t center, float radius)
+{
+    for (int_fast8_t i = 0; i < 6; i++) {
+        const float* p = frustum + 4 * i;
+        if (p[0] * center[0] + p[1] * center[1] + p[2] * center[2] + p[3] + radius < 0.0f) return 0;
+    }
+    return 1;
+}
+
+/* Returns 1 if the box is inside or crosses the frustum, 0 otherwise */
+HCSAPI int
+hc_frustum_test_aabb(const hc_frustum_t frustum, const hc_vec3_t center, const hc_vec3_t extents)
+{
+    for (int_fast8_t i = 0; i < 6; i++) {
+        const float* p = frustum + 4 * i;
+        float dist = p[0] * center[0] + p[1] * center[1] + p[2] * center[2] + p[3];
+        float radius = fabsf(p[0]) * extents[0] + fabsf(p[1]) * extents[1] + fabsf(p[2]) * extents[2];
+        if (dist + radius < 0.0f) return 0;
+    }
+    return 1;
+}
+
+/*
+ * Batch tests over separate arrays (SoA), 8 objects at a time with AVX. They
+ * write the indices of the visible objects to 'indices' (room for 'count' of
+ * them is needed) and/or set their bits in 'mask' (bit i % 32 of word i / 32,
+ * the words are overwritten), any of these may be NULL, and return the number
+ * of visible objects. Like the tests above, they are conservative: an object
+ * outside the frustum but crossing two planes near an edge is reported visible.
+ */
+
+/* Appends the visibility 'bits' of the objects [i, i + n), returns the new visible count */
+HCSAPI size_t
+hc_frustum_emit(uint32_t bits, size_t i, int n, size_t visible, uint32_t* indices, uint32_t* mask)
+{
+    if (indices && bits) {
+        // Every index is written, the visible ones are kept
+        for (int k = 0; k < n; k++) {
+            indices[visible] = (uint32_t)(i + k);
+            visible += (bits >> k) & 1;
+        }
+    } else {
+        uint32_t c = bits - ((bits >> 1) & 0x55555555u);
+        c = (c & 0x33333333u) + ((c >> 2) & 0x33333333u);
+        visible += (((c + (c >> 4)) & 0x0f0f0f0fu) * 0x01010101u) >> 24;
+    }
+
+    if (mask) {
+        if ((i & 31) == 0) mask[i >> 5] = 0;
+        mask[i >> 5] |= bits << (i & 31);
+    }
+    return visible;
+}
+
+HCSAPI size_t
+hc_frustum_cull_spheres(const hc_frustum_t frustum, const float* x, const float* y, const float* z, const float* radius,
+                        size_t count, uint32_t* indices, uint32_t* mask)
+{
+    size_t i = 0, visible = 0;
+
+#if defined(HC_MATH_AVX)
+    __m256 planes[24];
+    for (int_fast8_t j = 0; j < 24; j++) planes[j] = _mm256_set1_ps(frustum[j]);
+
+    for (; i < (count & ~(size_t)7); i += 8) {
+        __m256 vx = _mm256_loadu_ps(x + i), vy = _mm256_loadu_ps(y + i);
+        __m256 vz = _mm256_loadu_ps(z + i), vr = _mm256_loadu_ps(radius + i);
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        for (int_fast8_t j = 0; j < 24; j += 4) {
+            __m256 dist = hc_madd256_ps(planes[j], vx, _mm256_add_ps(planes[j + 3], vr));
+            dist = hc_madd256_ps(planes[j + 1], vy, dist);
+            dist = hc_madd256_ps(planes[j + 2], vz, dist);
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+        visible = hc_frustum_emit((uint32_t)_mm256_movemask_ps(inside), i, 8, visible, indices, mask);
+    }
+#elif defined(HC_MATH_SSE2)
+    __m128 planes[24];
+    for (int_fast8_t j = 0; j < 24; j++) planes[j] = _mm_set1_ps(frustum[j]);
+
+    for (; i < (count & ~(size_t)3); i += 4) {
+        __m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(y + i);
+        __m128 vz = _mm_loadu_ps(z + i), vr = _mm_loadu_ps(radius + i);
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (int_fast8_t j = 0; j < 24; j += 4) {
+            __m128 dist = hc_madd_ps(planes[j], vx, _mm_add_ps(planes[j + 3], vr));
+            dist = hc_madd_ps(planes[j + 1], vy, dist);
+            dist = hc_madd_ps(planes[j + 2], vz, dist);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, _mm_setzero_ps()));
+        }
+        visible = hc_frustum_emit((uint32_t)_mm_movemask_ps(inside), i, 4, visible, indices, mask);
+    }
+#elif defined(HC_MATH_NEON)
+    static const uint32_t lanes[4] = { 1, 2, 4, 8 };
+    const uint32x4_t lane_bits = vld1q_u32(lanes);
+
+    for (; i < (count & ~(size_t)3); i += 4) {
+        float32x4_t vx = vld1q_f32(x + i), vy = vld1q_f32(y + i);
+        float32x4_t vz = vld1q_f32(z + i), vr = vld1q_f32(radius + i);
+        uint32x4_t inside = vdupq_n_u32(0xffffffffu);
+
+        for (int_fast8_t j = 0; j < 24; j += 4) {
+            float32x4_t dist = hc_madd_f32(vaddq_f32(vr, vdupq_n_f32(frustum[j + 3])), vx, frustum[j]);
+            dist = hc_madd_f32(dist, vy, frustum[j + 1]);
+            dist = hc_madd_f32(dist, vz, frustum[j + 2]);
+            inside = vandq_u32(inside, vcgeq_f32(dist, vdupq_n_f32(0.0f)));
+        }
+
+        uint32x4_t b = vandq_u32(inside, lane_bits);
+        uint32x2_t b2 = vadd_u32(vget_low_u32(b), vget_high_u32(b));
+        visible = hc_frustum_emit(vget_lane_u32(vpadd_u32(b2, b2), 0), i, 4, visible, indices, mask);
+    }
+#endif
+
+    for (; i < count; i++) {
+        const hc_vec3_t center = { x[i], y[i], z[i] };
+        visible = hc_frustum_emit((uint32_t)hc_frustum_test_sphere(frustum, center, radius[i]), i, 1, visible, indices, mask);
+    }
+    return visible;
+}
+
+HCSAPI size_t
+hc_frustum_cull_aabbs(const hc_frustum_t frustum, const float* cx, const float* cy, const float* cz,
+                      const float* ex, const float* ey, const float* ez, size_t count, uint32_t* indices, uint32_t* mask)
+{
+    size_t i = 0, visible = 0;
+
+#if defined(HC_MATH_SSE2) || defined(HC_MATH_NEON)
+    // Planes with the absolute values of their normals, which project the extents
+    float abs_planes[24];
+    for (int_fast8_t j = 0; j < 24; j++) abs_planes[j] = (j & 3) == 3 ? frustum[j] : fabsf(frustum[j]);
+#endif
+
+#if defined(HC_MATH_AVX)
+    __m256 planes[24], abs_normals[24];
+    for (int_fast8_t j = 0; j < 24; j++) {
+        planes[j] = _mm256_set1_ps(frustum[j]);
+        abs_normals[j] = _mm256_set1_ps(abs_planes[j]);
+    }
+
+    for (; i < (count & ~(size_t)7); i += 8) {
+        __m256 vx = _mm256_loadu_ps(cx + i), vy = _mm256_loadu_ps(cy + i), vz = _mm256_loadu_ps(cz + i);
+        __m256 wx = _mm256_loadu_ps(ex + i), wy = _mm256_loadu_ps(ey + i), wz = _mm256_loadu_ps(ez + i);
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        for (int_fast8_t j = 0; j < 24; j += 4) {
+            __m256 dist = hc_madd256_ps(planes[j], vx, planes[j + 3]);
+            dist = hc_madd256_ps(planes[j + 1], vy, dist);
+            dist = hc_madd256_ps(planes[j + 2], vz, dist);
+            dist = hc_madd256_ps(abs_normals[j], wx, dist);
+            dist = hc_madd256_ps(abs_normals[j + 1], wy, dist);
+            dist = hc_madd256_ps(abs_normals[j + 2], wz, dist);
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+        visible = hc_frustum_emit((uint32_t)_mm256_movemask_ps(inside), i, 8, visible, indices, mask);
+    }
+#elif defined(HC_MATH_SSE2)
+    __m128 planes[24], abs_normals[24];
+    for (int_fast8_t j = 0; j < 24; j++) {
+        planes[j] = _mm_set1_ps(frustum[j]);
+        abs_normals[j] = _mm_set1_ps(abs_planes[j]);
+    }
+
+    for (; i < (count & ~(size_t)3); i += 4) {
+        __m128 vx = _mm_loadu_ps(cx + i), vy = _mm_loadu_ps(cy + i), vz = _mm_loadu_ps(cz + i);
+        __m128 wx = _mm_loadu_ps(ex + i), wy = _mm_loadu_ps(ey + i), wz = _mm_loadu_ps(ez + i);
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (int_fast8_t j = 0; j < 24; j += 4) {
+            __m128 dist = hc_madd_ps(planes[j], vx, planes[j + 3]);
+            dist = hc_madd_ps(planes[j + 1], vy, dist);
+            dist = hc_madd_ps(planes[j + 2], vz, dist);
+            dist = hc_madd_ps(abs_normals[j], wx, dist);
+            dist = hc_madd_ps(abs_normals[j + 1], wy, dist);
+            dist = hc_madd_ps(abs_normals[j + 2], wz, dist);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, _mm_setzero_ps()));
+        }
+        visible = hc_frustum_emit((uint32_t)_mm_movemask_ps(inside), i, 4, visible, indices, mask);
+    }
+#elif defined(HC_MATH_NEON)
+    static const uint32_t lanes[4] = { 1, 2, 4, 8 };
+    const uint32x4_t lane_bits = vld1q_u32(lanes);
+
+    for (; i < (count & ~(size_t)3); i += 4) {
+        float32x4_t vx = vld1q_f32(cx + i), vy = vld1q_f32(cy + i), vz = vld1q_f32(cz + i);
+        float32x4_t wx = vld1q_f32(ex + i), wy = vld1q_f32(ey + i), wz = vld1q_f32(ez + i);
+        uint32x4_t inside = vdupq_n_u32(0xffffffffu);
+
+        for (int_fast8_t j = 0; j < 24; j += 4) {
+            float32x4_t dist = hc_madd_f32(vdupq_n_f32(frustum[j + 3]), vx, frustum[j]);
+            dist = hc_madd_f32(dist, vy, frustum[j + 1]);
+            dist = hc_madd_f32(dist, vz, frustum[j + 2]);
+            dist = hc_madd_f32(dist, wx, abs_planes[j]);
+            dist = hc_madd_f32(dist, wy, abs_planes[j + 1]);
+            dist = hc_madd_f32(dist, wz, abs_planes[j + 2]);
+            inside = vandq_u32(inside, vcgeq_f32(dist, vdupq_n_f32(0.0f)));
+        }
+
+        uint32x4_t b = vandq_u32(inside, lane_bits);
+        uint32x2_t b2 = vadd_u32(vget_low_u32(b), vget_high_u32(b));
+        visible = hc_frustum_emit(vget_lane_u32(vpadd_u32(b2, b2), 0), i, 4, visible, indices, mask);
+    }
+#endif
+
+    for (; i < count; i++) {
+        const hc_vec3_t center = { cx[i], cy[i], cz[i] };
+        const hc_vec3_t extents = { ex[i], ey[i], ez[i] };
+        visible = hc_frustum_emit((uint32_t)hc_frustum_test_aabb(frustum, center, extents), i, 1, visible, indices, mask);
+    }
+    return visible;
+}
+
+/* Runtime dispatch implementation */
+
+#ifdef HC_MATH_DISPATCH_IMPL
+
+#if defined(HC_MATH_DISPATCH_X86)
+
+HC_MATH_TARGET_AVX2 static void
+hc_vec2_transform_wt_batch_avx2(hc_vec2_ptr_t dst, hc_vec2_cptr_t src, size_t count, size_t stride, float w_translation, hc_mat4_cptr_t mat)
+{
+    size_t i = (stride == 0 || stride == sizeof(hc_vec2_t)) ? hc_vec2_transform_wt_batch_avx(dst, src, count, w_translation, mat) : 0;
+    hc_vec2_transform_wt_batch_generic(dst + 2 * i, src + 2 * i, count - i, stride, w_translation, mat);
+}
+
+HC_MATH_TARGET_AVX2 static void
+hc_vec3_transform_wt_batch_avx2(hc_vec3_ptr_t dst, hc_vec3_cptr_t src, size_t count, size_t stride, float w_translation, hc_mat4_cptr_t mat)
+{
+    size_t i = (stride == 0 || stride == sizeof(hc_vec3_t)) ? hc_vec3_transform_wt_batch_avx(dst, src, count, w_translation, mat) : 0;
+    hc_vec3_transform_wt_batch_generic(dst + 3 * i, src + 3 * i, count - i, stride, w_translation, mat);
+}
+
+HC_MATH_TARGET_AVX2 static void
+hc_vec3_transform_wt_soa_avx2(float* dst_x, float* dst_y, float* dst_z,
+                              const float* x, const float* y, const float* z,
+                              size_t count, float w_translation, hc_mat4_cptr_t mat)
 {
-    return a + t * (b - a);
+    size_t i = hc_vec3_transform_wt_soa_avx(dst_x, dst_y, dst_z, x, y, z, count, w_translation, mat);
+    hc_vec3_transform_wt_soa_generic(dst_x + i, dst_y + i, dst_z + i, x + i, y + i, z + i, count - i, w_translation, mat);
 }
 
-HCSAPI float
-hc_lerp_angle(float a, float b, float t)
+HC_MATH_TARGET_AVX2 static void
+hc_vec4_transform_batch_avx2(hc_vec4_ptr_t dst, hc_vec4_cptr_t src, size_t count, size_t stride, hc_mat4_cptr_t mat)
 {
-    float diff = hc_wrap_angle(b - a);
-    return a + diff * t;
+    size_t i = (stride == 0 || stride == sizeof(hc_vec4_t)) ? hc_vec4_transform_batch_avx(dst, src, count, mat) : 0;
+    hc_vec4_transform_batch_generic(dst + 4 * i, src + 4 * i, count - i, stride, mat);
 }
 
-HCSAPI float
-hc_inverse_lerp(float a, float b, float value)
+HC_MATH_TARGET_AVX2 static void
+hc_vec3_stream_avx2(int op, const hc_vec3_stream_t* dst, const hc_vec3_cstream_t* a, const hc_vec3_cstream_t* b,
+                    float scalar, float* out, size_t count)
 {
-    return (value - a) / (b - a);
+    size_t i = hc_vec3_stream_avx2_kernel(op, dst, a, b, scalar, out, count);
+    hc_vec3_stream_t rd = hc_vec3_stream_advance(dst, i);
+    hc_vec3_cstream_t ra = hc_vec3_cstream_advance(a, i), rb = hc_vec3_cstream_advance(b, i);
+    hc_vec3_stream_generic(op, dst ? &rd : NULL, &ra, b ? &rb : NULL, scalar, out ? out + i : NULL, count - i);
 }
 
-HCSAPI float
-hc_smoothstep(float edge0, float edge1, float x)
+HC_MATH_TARGET_AVX512 static void
+hc_vec3_stream_avx512(int op, const hc_vec3_stream_t* dst, const hc_vec3_cstream_t* a, const hc_vec3_cstream_t* b,
+                      float scalar, float* out, size_t count)
 {
-    float t = (x - edge0) / (edge1 - edge0);
-    t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
-    return t * t * t * (t * (t * 6 - 15) + 10);
+    size_t i = hc_vec3_stream_avx512_kernel(op, dst, a, b, scalar, out, count);
+    hc_vec3_stream_t rd = hc_vec3_stream_advance(dst, i);
+    hc_vec3_cstream_t ra = hc_vec3_cstream_advance(a, i), rb = hc_vec3_cstream_advance(b, i);
+    hc_vec3_stream_generic(op, dst ? &rd : NULL, &ra, b ? &rb : NULL, scalar, out ? out + i : NULL, count - i);
 }
 
-HCSAPI float
-hc_exp_decay(float initial, float decay_rate, float time)
+HC_MATH_TARGET_AVX512 static void
+hc_vec3_transform_wt_soa_avx512(float* dst_x, float* dst_y, float* dst_z,
+                                const float* x, const float* y, const float* z,
+                                size_t count, float w_translation, hc_mat4_cptr_t mat)
 {
-    return initial * expf(-decay_rate * time);
+    size_t i = 0;
+
+    __m512 m[9], t[3];
+    for (int_fast8_t k = 0; k < 3; k++) {
+        m[k] = _mm512_set1_ps(mat[k]);
+        m[k + 3] = _mm512_set1_ps(mat[k + 4]);
+        m[k + 6] = _mm512_set1_ps(mat[k + 8]);
+        t[k] = _mm512_set1_ps(w_translation * mat[k + 12]);
+    }
+    for (; i < (count & ~(size_t)15); i += 16) {
+        __m512 vx = _mm512_loadu_ps(x + i), vy = _mm512_loadu_ps(y + i), vz = _mm512_loadu_ps(z + i);
+        __m512 rx = _mm512_fmadd_ps(m[6], vz, _mm512_fmadd_ps(m[3], vy, _mm512_fmadd_ps(m[0], vx, t[0])));
+        __m512 ry = _mm512_fmadd_ps(m[7], vz, _mm512_fmadd_ps(m[4], vy, _mm512_fmadd_ps(m[1], vx, t[1])));
+        __m512 rz = _mm512_fmadd_ps(m[8], vz, _mm512_fmadd_ps(m[5], vy, _mm512_fmadd_ps(m[2], vx, t[2])));
+        _mm512_storeu_ps(dst_x + i, rx);
+        _mm512_storeu_ps(dst_y + i, ry);
+        _mm512_storeu_ps(dst_z + i, rz);
+    }
+
+    hc_vec3_transform_wt_soa_avx2(dst_x + i, dst_y + i, dst_z + i, x + i, y + i, z + i, count - i, w_translation, mat);
 }
 
-HCSAPI float
-hc_move_towards(float current, float target, float max_delta)
+#endif // HC_MATH_DISPATCH_X86
+
+int hc_math_dispatch_init(int max_level)
 {
-    float delta = target - current;
-    float distance = fabsf(delta);
-    if (distance <= max_delta) return target;
-    else return current + (delta / distance) * max_delta;
+    hc_math_kernels_t k = {
+        hc_vec2_transform_wt_batch_generic,
+        hc_vec3_transform_wt_batch_generic,
+        hc_vec3_transform_wt_soa_generic,
+        hc_vec4_transform_batch_generic,
+        hc_vec3_stream_generic,
+        HC_SIMD
+    };
+
+#if defined(HC_MATH_DISPATCH_X86)
+    __builtin_cpu_init();
+    if (max_level >= HC_SIMD_AVX2 && k.level < HC_SIMD_AVX2
+        && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        k.vec2_transform_wt_batch = hc_vec2_transform_wt_batch_avx2;
+        k.vec3_transform_wt_batch = hc_vec3_transform_wt_batch_avx2;
+        k.vec3_transform_wt_soa = hc_vec3_transform_wt_soa_avx2;
+        k.vec4_transform_batch = hc_vec4_transform_batch_avx2;
+        k.vec3_stream = hc_vec3_stream_avx2;
+        k.level = HC_SIMD_AVX2;
+    }
+    if (max_level >= HC_SIMD_AVX512 && k.level >= HC_SIMD_AVX2
+        && __builtin_cpu_supports("avx512f")) {
+        k.vec3_transform_wt_soa = hc_vec3_transform_wt_soa_avx512;
+        k.vec3_stream = hc_vec3_stream_avx512;
+        k.level = HC_SIMD_AVX512;
+    }
+#else
+    (void)max_level;
+#endif
+
+    // Entry by entry, each one is valid on its own for concurrent callers
+    HC_MATH_ATOMIC_STORE(&hc_math_kernels.vec2_transform_wt_batch, k.vec2_transform_wt_batch);
+    HC_MATH_ATOMIC_STORE(&hc_math_kernels.vec3_transform_wt_batch, k.vec3_transform_wt_batch);
+    HC_MATH_ATOMIC_STORE(&hc_math_kernels.vec3_transform_wt_soa, k.vec3_transform_wt_soa);
+    HC_MATH_ATOMIC_STORE(&hc_math_kernels.vec4_transform_batch, k.vec4_transform_batch);
+    HC_MATH_ATOMIC_STORE(&hc_math_kernels.vec3_stream, k.vec3_stream);
+    HC_MATH_ATOMIC_STORE(&hc_math_kernels.level, k.level);
+
+    return k.level;
 }
 
-HCSAPI uint32_t
-hc_next_po2(uint32_t x)
+/* Selects the kernels once, concurrent first callers wait until the table is published */
+static void hc_math_dispatch_once(void)
 {
-    if (x == 0) return 1;
-    if ((x & (x - 1)) == 0) return x << 1; // (x * 2)
-    x--;
-    x |= x >> 1;
-    x |= x >> 2;
-    x |= x >> 4;
-    x |= x >> 8;
-    x |= x >> 16;
-    x++;
-    return x;
+    static volatile long state = 0;     // 0: not selected, 1: selecting, 2: published
+
+    if (HC_MATH_ATOMIC_LOAD(&state) == 2) {
+        return;
+    }
+
+    if (HC_MATH_ATOMIC_CAS(&state, 0, 1)) {
+        hc_math_dispatch_init(HC_SIMD_AVX512);
+        HC_MATH_ATOMIC_STORE(&state, 2);
+        return;
+    }
+
+    while (HC_MATH_ATOMIC_LOAD(&state) != 2) {
+        // The selection only takes a few CPUID queries
+    }
 }
 
-HCSAPI uint32_t
-hc_previous_po2(uint32_t x)
+/* First calls go through these, which select the kernels then forward the call */
+
+static void
+hc_vec2_transform_wt_batch_resolve(hc_vec2_ptr_t dst, hc_vec2_cptr_t src, size_t count, size_t stride, float w_translation, hc_mat4_cptr_t mat)
 {
-    if (x == 0) return 0;
-    if ((x & (x - 1)) == 0) return x >> 1; // (x / 2)
-    x |= x >> 1;
-    x |= x >> 2;
-    x |= x >> 4;
-    x |= x >> 8;
-    x |= x >> 16;
-    return x - (x >> 1);
+    hc_math_dispatch_once();
+    HC_MATH_KERNEL(vec2_transform_wt_batch)(dst, src, count, stride, w_translation, mat);
 }
 
-HCSAPI uint32_t
-hc_nearest_po2(uint32_t x)
+static void
+hc_vec3_transform_wt_batch_resolve(hc_vec3_ptr_t dst, hc_vec3_cptr_t src, size_t count, size_t stride, float w_translation, hc_mat4_cptr_t mat)
 {
-    uint32_t next = hc_next_po2(x);
-    uint32_t prev = hc_previous_po2(x);
-    return (x - prev < next - x) ? prev : next;
+    hc_math_dispatch_once();
+    HC_MATH_KERNEL(vec3_transform_wt_batch)(dst, src, count, stride, w_translation, mat);
 }
 
-HCSAPI uint64_t
-hc_next_po2_u64(uint64_t x)
+static void
+hc_vec3_transform_wt_soa_resolve(float* dst_x, float* dst_y, float* dst_z,
+                                 const float* x, const float* y, const float* z,
+                                 size_t count, float w_translation, hc_mat4_cptr_t mat)
 {
-    if (x == 0) return 1;
-    if ((x & (x - 1)) == 0) return x << 1; // (x * 2)
-    x--;
-    x |= x >> 1;
-    x |= x >> 2;
-    x |= x >> 4;
-    x |= x >> 8;
-    x |= x >> 16;
-    x |= x >> 32; //< Only for 64 bits
-    x++;
-    return x;
+    hc_math_dispatch_once();
+    HC_MATH_KERNEL(vec3_transform_wt_soa)(dst_x, dst_y, dst_z, x, y, z, count, w_translation, mat);
 }
 
-HCSAPI uint64_t
-hc_previous_po2_u64(uint64_t x)
+static void
+hc_vec4_transform_batch_resolve(hc_vec4_ptr_t dst, hc_vec4_cptr_t src, size_t count, size_t stride, hc_mat4_cptr_t mat)
 {
-    if (x == 0) return 0;
-    if ((x & (x - 1)) == 0) return x >> 1; // (x / 2)
-    x |= x >> 1;
-    x |= x >> 2;
-    x |= x >> 4;
-    x |= x >> 8;
-    x |= x >> 16;
-    x |= x >> 32; //< Only for 64 bits
-    return x - (x >> 1);
+    hc_math_dispatch_once();
+    HC_MATH_KERNEL(vec4_transform_batch)(dst, src, count, stride, mat);
 }
 
-HCSAPI uint64_t
-hc_nearest_po2_u64(uint64_t x)
+static void
+hc_vec3_stream_resolve(int op, const hc_vec3_stream_t* dst, const hc_vec3_cstream_t* a, const hc_vec3_cstream_t* b,
+                       float scalar, float* out, size_t count)
 {
-    uint64_t next = hc_next_po2_u64(x);
-    uint64_t prev = hc_previous_po2_u64(x);
-    return (x - prev < next - x) ? prev : next;
+    hc_math_dispatch_once();
+    HC_MATH_KERNEL(vec3_stream)(op, dst, a, b, scalar, out, count);
 }
 
+hc_math_kernels_t hc_math_kernels = {
+    hc_vec2_transform_wt_batch_resolve,
+    hc_vec3_transform_wt_batch_resolve,
+    hc_vec3_transform_wt_soa_resolve,
+    hc_vec4_transform_batch_resolve,
+    hc_vec3_stream_resolve,
+    -1
+};
+
+#endif // HC_MATH_DISPATCH_IMPL
+
+#endif //HC_MATH_H
+
+/*
+ * Generic vector and matrix functions, instantiated for each scalar type
+ * (see "Vector and matrix functions" above) when this header includes itself.
+ */
+
+#ifdef HC_MATH_TEMPLATE
+
 /* 2D Vector function definitions */
 
 HCSAPI void
-hc_vec2_zero(hc_vec2_t dst)
+HC_FN(hc_, vec2_zero)(HC_VEC2_T dst)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = 0;
@@ -293,19 +3736,19 @@ hc_vec2_zero(hc_vec2_t dst)
 }
 
 HCSAPI void
-hc_vec2_one(hc_vec2_t dst, float v)
+HC_FN(hc_, vec2_one)(HC_VEC2_T dst, HC_T v)
 {
     dst[0] = dst[1] = v;
 }
 
 HCSAPI void
-hc_vec2_set(hc_vec2_t dst, float x, float y)
+HC_FN(hc_, vec2_set)(HC_VEC2_T dst, HC_T x, HC_T y)
 {
     dst[0] = x, dst[1] = y;
 }
 
 HCSAPI void
-hc_vec2_copy(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_ptr_t HC_RESTRICT src)
+HC_FN(hc_, vec2_copy)(HC_VEC2_PTR_T HC_RESTRICT dst, const HC_VEC2_PTR_T HC_RESTRICT src)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = src[i];
@@ -313,17 +3756,17 @@ hc_vec2_copy(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_ptr_t HC_RESTRICT src)
 }
 
 HCSAPI void
-hc_vec2_swap(hc_vec2_ptr_t HC_RESTRICT a, hc_vec2_ptr_t HC_RESTRICT b)
+HC_FN(hc_, vec2_swap)(HC_VEC2_PTR_T HC_RESTRICT a, HC_VEC2_PTR_T HC_RESTRICT b)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
-        float tmp = a[i];
+        HC_T tmp = a[i];
         a[i] = b[i];
         b[i] = tmp;
     }
 }
 
 HCSAPI void
-hc_vec2_neg(hc_vec2_t dst, const hc_vec2_t v)
+HC_FN(hc_, vec2_neg)(HC_VEC2_T dst, const HC_VEC2_T v)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = -v[i];
@@ -331,7 +3774,7 @@ hc_vec2_neg(hc_vec2_t dst, const hc_vec2_t v)
 }
 
 HCSAPI void
-hc_vec2_neg_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v)
+HC_FN(hc_, vec2_neg_r)(HC_VEC2_PTR_T HC_RESTRICT dst, const HC_VEC2_T v)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = -v[i];
@@ -339,7 +3782,7 @@ hc_vec2_neg_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v)
 }
 
 HCSAPI void
-hc_vec2_add(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2)
+HC_FN(hc_, vec2_add)(HC_VEC2_T dst, const HC_VEC2_T v1, const HC_VEC2_T v2)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v1[i] + v2[i];
@@ -347,7 +3790,7 @@ hc_vec2_add(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2)
 }
 
 HCSAPI void
-hc_vec2_add_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc_vec2_t v2)
+HC_FN(hc_, vec2_add_r)(HC_VEC2_PTR_T HC_RESTRICT dst, const HC_VEC2_T v1, const HC_VEC2_T v2)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v1[i] + v2[i];
@@ -355,7 +3798,7 @@ hc_vec2_add_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc_vec2_t
 }
 
 HCSAPI void
-hc_vec2_sub(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2)
+HC_FN(hc_, vec2_sub)(HC_VEC2_T dst, const HC_VEC2_T v1, const HC_VEC2_T v2)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v1[i] - v2[i];
@@ -363,7 +3806,7 @@ hc_vec2_sub(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2)
 }
 
 HCSAPI void
-hc_vec2_sub_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc_vec2_t v2)
+HC_FN(hc_, vec2_sub_r)(HC_VEC2_PTR_T HC_RESTRICT dst, const HC_VEC2_T v1, const HC_VEC2_T v2)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v1[i] - v2[i];
@@ -371,7 +3814,7 @@ hc_vec2_sub_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc_vec2_t
 }
 
 HCSAPI void
-hc_vec2_mul(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2)
+HC_FN(hc_, vec2_mul)(HC_VEC2_T dst, const HC_VEC2_T v1, const HC_VEC2_T v2)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v1[i] * v2[i];
@@ -379,7 +3822,7 @@ hc_vec2_mul(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2)
 }
 
 HCSAPI void
-hc_vec2_mul_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc_vec2_t v2)
+HC_FN(hc_, vec2_mul_r)(HC_VEC2_PTR_T HC_RESTRICT dst, const HC_VEC2_T v1, const HC_VEC2_T v2)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v1[i] * v2[i];
@@ -387,7 +3830,7 @@ hc_vec2_mul_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc_vec2_t
 }
 
 HCSAPI void
-hc_vec2_div(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2)
+HC_FN(hc_, vec2_div)(HC_VEC2_T dst, const HC_VEC2_T v1, const HC_VEC2_T v2)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v1[i]/v2[i];
@@ -395,7 +3838,7 @@ hc_vec2_div(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2)
 }
 
 HCSAPI void
-hc_vec2_div_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc_vec2_t v2)
+HC_FN(hc_, vec2_div_r)(HC_VEC2_PTR_T HC_RESTRICT dst, const HC_VEC2_T v1, const HC_VEC2_T v2)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v1[i]/v2[i];
@@ -403,7 +3846,7 @@ hc_vec2_div_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc_vec2_t
 }
 
 HCSAPI void
-hc_vec2_offset(hc_vec2_t dst, const hc_vec2_t v, float scalar)
+HC_FN(hc_, vec2_offset)(HC_VEC2_T dst, const HC_VEC2_T v, HC_T scalar)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v[i] + scalar;
@@ -411,7 +3854,7 @@ hc_vec2_offset(hc_vec2_t dst, const hc_vec2_t v, float scalar)
 }
 
 HCSAPI void
-hc_vec2_offset_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v, float scalar)
+HC_FN(hc_, vec2_offset_r)(HC_VEC2_PTR_T HC_RESTRICT dst, const HC_VEC2_T v, HC_T scalar)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v[i] + scalar;
@@ -419,7 +3862,7 @@ hc_vec2_offset_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v, float scalar)
 }
 
 HCSAPI void
-hc_vec2_scale(hc_vec2_t dst, const hc_vec2_t v, float scalar)
+HC_FN(hc_, vec2_scale)(HC_VEC2_T dst, const HC_VEC2_T v, HC_T scalar)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v[i]*scalar;
@@ -427,7 +3870,7 @@ hc_vec2_scale(hc_vec2_t dst, const hc_vec2_t v, float scalar)
 }
 
 HCSAPI void
-hc_vec2_scale_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v, float scalar)
+HC_FN(hc_, vec2_scale_r)(HC_VEC2_PTR_T HC_RESTRICT dst, const HC_VEC2_T v, HC_T scalar)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v[i]*scalar;
@@ -435,77 +3878,73 @@ hc_vec2_scale_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v, float scalar)
 }
 
 HCSAPI void
-hc_vec2_normalize(hc_vec2_t dst, const hc_vec2_t v)
+HC_FN(hc_, vec2_normalize)(HC_VEC2_T dst, const HC_VEC2_T v)
 {
-    float length_sq = v[0] * v[0] + v[1] * v[1];
-    if (length_sq == 0.0f) return;
+    HC_T length_sq = v[0] * v[0] + v[1] * v[1];
+    if (length_sq == HC_R(0.0)) return;
 
-    float inv_lenght = hc_rsqrtf(length_sq);
+    HC_T inv_lenght = HC_RSQRT(length_sq);
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v[i] * inv_lenght;
     }
 }
 
 HCSAPI void
-hc_vec2_normalize_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v)
+HC_FN(hc_, vec2_normalize_r)(HC_VEC2_PTR_T HC_RESTRICT dst, const HC_VEC2_T v)
 {
-    float length_sq = v[0] * v[0] + v[1] * v[1];
-    if (length_sq == 0.0f) return;
+    HC_T length_sq = v[0] * v[0] + v[1] * v[1];
+    if (length_sq == HC_R(0.0)) return;
 
-    float inv_lenght = hc_rsqrtf(length_sq);
+    HC_T inv_lenght = HC_RSQRT(length_sq);
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v[i] * inv_lenght;
     }
 }
 
-HCSAPI float
-hc_vec2_length(const hc_vec2_t v)
+HCSAPI HC_T
+HC_FN(hc_, vec2_length)(const HC_VEC2_T v)
 {
-    return sqrtf(v[0] * v[0] + v[1] * v[1]);
+    return HC_SQRT(v[0] * v[0] + v[1] * v[1]);
 }
 
-HCSAPI float
-hc_length_sq_vec2(const hc_vec2_t v)
+HCSAPI HC_T
+HC_FN(hc_length_sq_, vec2)(const HC_VEC2_T v)
 {
     return v[0] * v[0] + v[1] * v[1];
 }
 
-HCSAPI float
-hc_vec2_dot(const hc_vec2_t v1, const hc_vec2_t v2)
+HCSAPI HC_T
+HC_FN(hc_, vec2_dot)(const HC_VEC2_T v1, const HC_VEC2_T v2)
 {
     return v1[0] * v2[0] + v1[1] * v2[1];
 }
 
-HCSAPI float
-hc_vec2_distance(const hc_vec2_t v1, const hc_vec2_t v2)
+HCSAPI HC_T
+HC_FN(hc_, vec2_distance)(const HC_VEC2_T v1, const HC_VEC2_T v2)
 {
-    hc_vec2_t dt = {
+    HC_VEC2_T dt = {
         v1[0] - v2[0],
         v1[1] - v2[1]
     };
 
-    float dist_sq = dt[0]*dt[0] +
+    HC_T dist_sq = dt[0]*dt[0] +
                            dt[1]*dt[1];
 
-#ifdef HC_FISR
-    return dist_sq*hc_rsqrtf(dist_sq);
-#else
-    return sqrtf(dist_sq);
-#endif
+    return HC_SQRT(dist_sq);
 }
 
-HCSAPI float
-hc_distance_sq_vec2(const hc_vec2_t v1, const hc_vec2_t v2)
+HCSAPI HC_T
+HC_FN(hc_distance_sq_, vec2)(const HC_VEC2_T v1, const HC_VEC2_T v2)
 {
-    hc_vec2_t dt = { v1[0] - v2[0], v1[1] - v2[1] };
+    HC_VEC2_T dt = { v1[0] - v2[0], v1[1] - v2[1] };
     return dt[0]*dt[0] + dt[1]*dt[1];
 }
 
 HCSAPI void
-hc_vec2_direction(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2)
+HC_FN(hc_, vec2_direction)(HC_VEC2_T dst, const HC_VEC2_T v1, const HC_VEC2_T v2)
 {
-    hc_vec2_t tmp;
-    float lengthSq = 0.0f;
+    HC_VEC2_T tmp;
+    HC_T lengthSq = HC_R(0.0);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -515,7 +3954,7 @@ hc_vec2_direction(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2)
         lengthSq += tmp[i]*tmp[i];
     }
 
-    float inv_lenght = hc_rsqrtf(lengthSq);
+    HC_T inv_lenght = HC_RSQRT(lengthSq);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -526,9 +3965,9 @@ hc_vec2_direction(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2)
 }
 
 HCSAPI void
-hc_vec2_direction_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc_vec2_t v2)
+HC_FN(hc_, vec2_direction_r)(HC_VEC2_PTR_T HC_RESTRICT dst, const HC_VEC2_T v1, const HC_VEC2_T v2)
 {
-    float lengthSq = 0.0f;
+    HC_T lengthSq = HC_R(0.0);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -538,7 +3977,7 @@ hc_vec2_direction_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc_
         lengthSq += dst[i]*dst[i];
     }
 
-    float inv_lenght = hc_rsqrtf(lengthSq);
+    HC_T inv_lenght = HC_RSQRT(lengthSq);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -549,7 +3988,7 @@ hc_vec2_direction_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc_
 }
 
 HCSAPI void
-hc_vec2_lerp(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2, float t)
+HC_FN(hc_, vec2_lerp)(HC_VEC2_T dst, const HC_VEC2_T v1, const HC_VEC2_T v2, HC_T t)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v1[i] + t*(v2[i]-v1[i]);
@@ -557,7 +3996,7 @@ hc_vec2_lerp(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2, float t)
 }
 
 HCSAPI void
-hc_vec2_lerp_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc_vec2_t v2, float t)
+HC_FN(hc_, vec2_lerp_r)(HC_VEC2_PTR_T HC_RESTRICT dst, const HC_VEC2_T v1, const HC_VEC2_T v2, HC_T t)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = v1[i] + t*(v2[i]-v1[i]);
@@ -565,7 +4004,7 @@ hc_vec2_lerp_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc_vec2_
 }
 
 HCSAPI void
-hc_vec2_barysmooth(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2, const hc_vec2_t v3, float w1, float w2, float w3)
+HC_FN(hc_, vec2_barysmooth)(HC_VEC2_T dst, const HC_VEC2_T v1, const HC_VEC2_T v2, const HC_VEC2_T v3, HC_T w1, HC_T w2, HC_T w3)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = w1*v1[i] + w2*v2[i] + w3*v3[i];
@@ -573,7 +4012,7 @@ hc_vec2_barysmooth(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2, const
 }
 
 HCSAPI void
-hc_vec2_barysmooth_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc_vec2_t v2, const hc_vec2_t v3, float w1, float w2, float w3)
+HC_FN(hc_, vec2_barysmooth_r)(HC_VEC2_PTR_T HC_RESTRICT dst, const HC_VEC2_T v1, const HC_VEC2_T v2, const HC_VEC2_T v3, HC_T w1, HC_T w2, HC_T w3)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = w1*v1[i] + w2*v2[i] + w3*v3[i];
@@ -581,7 +4020,7 @@ hc_vec2_barysmooth_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc
 }
 
 HCSAPI void
-hc_vec2_barysmooth_v(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2, const hc_vec2_t v3, const hc_vec3_t w)
+HC_FN(hc_, vec2_barysmooth_v)(HC_VEC2_T dst, const HC_VEC2_T v1, const HC_VEC2_T v2, const HC_VEC2_T v3, const HC_VEC3_T w)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = w[0] * v1[i] + w[1] * v2[i] + w[2] * v3[i];
@@ -589,7 +4028,7 @@ hc_vec2_barysmooth_v(hc_vec2_t dst, const hc_vec2_t v1, const hc_vec2_t v2, cons
 }
 
 HCSAPI void
-hc_vec2_barysmooth_vr(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const hc_vec2_t v2, const hc_vec2_t v3, const hc_vec3_t w)
+HC_FN(hc_, vec2_barysmooth_vr)(HC_VEC2_PTR_T HC_RESTRICT dst, const HC_VEC2_T v1, const HC_VEC2_T v2, const HC_VEC2_T v3, const HC_VEC3_T w)
 {
     for (int_fast8_t i = 0; i < 2; i++) {
         dst[i] = w[0] * v1[i] + w[1] * v2[i] + w[2] * v3[i];
@@ -597,10 +4036,10 @@ hc_vec2_barysmooth_vr(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v1, const h
 }
 
 HCSAPI void
-hc_vec2_baryflat(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, float w1, float w2, float w3)
+HC_FN(hc_, vec2_baryflat)(HC_VEC4_T dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, HC_T w1, HC_T w2, HC_T w3)
 {
     // Find the maximum weight
-    float max_w = w1;
+    HC_T max_w = w1;
     if (w2 > max_w) max_w = w2;
     if (w3 > max_w) max_w = w3;
 
@@ -621,10 +4060,10 @@ hc_vec2_baryflat(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc
 }
 
 HCSAPI void
-hc_vec2_baryflat_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, float w1, float w2, float w3)
+HC_FN(hc_, vec2_baryflat_r)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, HC_T w1, HC_T w2, HC_T w3)
 {
     // Find the maximum weight
-    float max_w = w1;
+    HC_T max_w = w1;
     if (w2 > max_w) max_w = w2;
     if (w3 > max_w) max_w = w3;
 
@@ -645,10 +4084,10 @@ hc_vec2_baryflat_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_v
 }
 
 HCSAPI void
-hc_vec2_baryflat_v(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, const hc_vec3_t w)
+HC_FN(hc_, vec2_baryflat_v)(HC_VEC4_T dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, const HC_VEC3_T w)
 {
     // Find the maximum weight
-    float max_w = w[0];
+    HC_T max_w = w[0];
     if (w[1] > max_w) max_w = w[1];
     if (w[2] > max_w) max_w = w[2];
 
@@ -669,10 +4108,10 @@ hc_vec2_baryflat_v(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, const
 }
 
 HCSAPI void
-hc_vec2_baryflat_vr(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, const hc_vec3_t w)
+HC_FN(hc_, vec2_baryflat_vr)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, const HC_VEC3_T w)
 {
     // Find the maximum weight
-    float max_w = w[0];
+    HC_T max_w = w[0];
     if (w[1] > max_w) max_w = w[1];
     if (w[2] > max_w) max_w = w[2];
 
@@ -693,9 +4132,9 @@ hc_vec2_baryflat_vr(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_
 }
 
 HCSAPI void
-hc_vec2_transform(hc_vec2_t dst, const hc_vec2_t v, const hc_mat4_t mat)
+HC_FN(hc_, vec2_transform)(HC_VEC2_T dst, const HC_VEC2_T v, const HC_MAT4_T mat)
 {
-    hc_vec2_t tmp = {
+    HC_VEC2_T tmp = {
         mat[0] * v[0] + mat[4] * v[1] + mat[12],
         mat[1] * v[0] + mat[5] * v[1] + mat[13]
     };
@@ -706,16 +4145,16 @@ hc_vec2_transform(hc_vec2_t dst, const hc_vec2_t v, const hc_mat4_t mat)
 }
 
 HCSAPI void
-hc_vec2_transform_r(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v, const hc_mat4_t mat)
+HC_FN(hc_, vec2_transform_r)(HC_VEC2_PTR_T HC_RESTRICT dst, const HC_VEC2_T v, const HC_MAT4_T mat)
 {
     dst[0] = mat[0] * v[0] + mat[4] * v[1] + mat[12];
     dst[1] = mat[1] * v[0] + mat[5] * v[1] + mat[13];
 }
 
 HCSAPI void
-hc_vec2_transform_wt(hc_vec2_t dst, const hc_vec2_t v, float w_translation, const hc_mat4_t mat)
+HC_FN(hc_, vec2_transform_wt)(HC_VEC2_T dst, const HC_VEC2_T v, HC_T w_translation, const HC_MAT4_T mat)
 {
-    hc_vec2_t tmp = {
+    HC_VEC2_T tmp = {
         mat[0] * v[0] + mat[4] * v[1] + w_translation * mat[12],
         mat[1] * v[0] + mat[5] * v[1] + w_translation * mat[13]
     };
@@ -726,7 +4165,7 @@ hc_vec2_transform_wt(hc_vec2_t dst, const hc_vec2_t v, float w_translation, cons
 }
 
 HCSAPI void
-hc_vec2_transform_wtr(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v, float w_translation, const hc_mat4_t mat)
+HC_FN(hc_, vec2_transform_wtr)(HC_VEC2_PTR_T HC_RESTRICT dst, const HC_VEC2_T v, HC_T w_translation, const HC_MAT4_T mat)
 {
     dst[0] = mat[0] * v[0] + mat[4] * v[1] + w_translation*mat[12];
     dst[1] = mat[1] * v[0] + mat[5] * v[1] + w_translation*mat[13];
@@ -735,7 +4174,7 @@ hc_vec2_transform_wtr(hc_vec2_ptr_t HC_RESTRICT dst, const hc_vec2_t v, float w_
 /* 3D Vector function definitions */
 
 HCSAPI void
-hc_vec3_zero(hc_vec3_t dst)
+HC_FN(hc_, vec3_zero)(HC_VEC3_T dst)
 {
     for (int_fast8_t i = 0; i < 3; i++) {
         dst[i] = 0;
@@ -743,19 +4182,19 @@ hc_vec3_zero(hc_vec3_t dst)
 }
 
 HCSAPI void
-hc_vec3_one(hc_vec3_t dst, float v)
+HC_FN(hc_, vec3_one)(HC_VEC3_T dst, HC_T v)
 {
     dst[0] = dst[1] = dst[2] = v;
 }
 
 HCSAPI void
-hc_vec3_set(hc_vec3_t dst, float x, float y, float z)
+HC_FN(hc_, vec3_set)(HC_VEC3_T dst, HC_T x, HC_T y, HC_T z)
 {
     dst[0] = x, dst[1] = y, dst[2] = z;
 }
 
 HCSAPI void
-hc_vec3_copy(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_ptr_t HC_RESTRICT src)
+HC_FN(hc_, vec3_copy)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_PTR_T HC_RESTRICT src)
 {
     for (int_fast8_t i = 0; i < 3; i++) {
         dst[i] = src[i];
@@ -763,20 +4202,20 @@ hc_vec3_copy(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_ptr_t HC_RESTRICT src)
 }
 
 HCSAPI void
-hc_vec3_swap(hc_vec3_ptr_t HC_RESTRICT a, hc_vec3_ptr_t HC_RESTRICT b)
+HC_FN(hc_, vec3_swap)(HC_VEC3_PTR_T HC_RESTRICT a, HC_VEC3_PTR_T HC_RESTRICT b)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
 #   endif
     for (int_fast8_t i = 0; i < 3; i++) {
-        float tmp = a[i];
+        HC_T tmp = a[i];
         a[i] = b[i];
         b[i] = tmp;
     }
 }
 
 HCSAPI void
-hc_vec3_neg(hc_vec3_t dst, const hc_vec3_t v)
+HC_FN(hc_, vec3_neg)(HC_VEC3_T dst, const HC_VEC3_T v)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -787,7 +4226,7 @@ hc_vec3_neg(hc_vec3_t dst, const hc_vec3_t v)
 }
 
 HCSAPI void
-hc_vec3_neg_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v)
+HC_FN(hc_, vec3_neg_r)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T v)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -798,7 +4237,7 @@ hc_vec3_neg_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v)
 }
 
 HCSAPI void
-hc_vec3_add(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2)
+HC_FN(hc_, vec3_add)(HC_VEC3_T dst, const HC_VEC3_T v1, const HC_VEC3_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -809,7 +4248,7 @@ hc_vec3_add(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2)
 }
 
 HCSAPI void
-hc_vec3_add_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_vec3_t v2)
+HC_FN(hc_, vec3_add_r)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T v1, const HC_VEC3_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -820,7 +4259,7 @@ hc_vec3_add_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_vec3_t
 }
 
 HCSAPI void
-hc_vec3_sub(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2)
+HC_FN(hc_, vec3_sub)(HC_VEC3_T dst, const HC_VEC3_T v1, const HC_VEC3_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -831,7 +4270,7 @@ hc_vec3_sub(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2)
 }
 
 HCSAPI void
-hc_vec3_sub_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_vec3_t v2)
+HC_FN(hc_, vec3_sub_r)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T v1, const HC_VEC3_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -842,7 +4281,7 @@ hc_vec3_sub_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_vec3_t
 }
 
 HCSAPI void
-hc_vec3_mul(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2)
+HC_FN(hc_, vec3_mul)(HC_VEC3_T dst, const HC_VEC3_T v1, const HC_VEC3_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -853,7 +4292,7 @@ hc_vec3_mul(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2)
 }
 
 HCSAPI void
-hc_vec3_mul_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_vec3_t v2)
+HC_FN(hc_, vec3_mul_r)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T v1, const HC_VEC3_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -864,7 +4303,7 @@ hc_vec3_mul_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_vec3_t
 }
 
 HCSAPI void
-hc_vec3_div(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2)
+HC_FN(hc_, vec3_div)(HC_VEC3_T dst, const HC_VEC3_T v1, const HC_VEC3_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -875,7 +4314,7 @@ hc_vec3_div(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2)
 }
 
 HCSAPI void
-hc_vec3_div_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_vec3_t v2)
+HC_FN(hc_, vec3_div_r)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T v1, const HC_VEC3_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -886,7 +4325,7 @@ hc_vec3_div_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_vec3_t
 }
 
 HCSAPI void
-hc_vec3_offset(hc_vec3_t dst, const hc_vec3_t v, float scalar)
+HC_FN(hc_, vec3_offset)(HC_VEC3_T dst, const HC_VEC3_T v, HC_T scalar)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -897,7 +4336,7 @@ hc_vec3_offset(hc_vec3_t dst, const hc_vec3_t v, float scalar)
 }
 
 HCSAPI void
-hc_vec3_offset_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v, float scalar)
+HC_FN(hc_, vec3_offset_r)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T v, HC_T scalar)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -908,7 +4347,7 @@ hc_vec3_offset_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v, float scalar)
 }
 
 HCSAPI void
-hc_vec3_scale(hc_vec3_t dst, const hc_vec3_t v, float scalar)
+HC_FN(hc_, vec3_scale)(HC_VEC3_T dst, const HC_VEC3_T v, HC_T scalar)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -919,7 +4358,7 @@ hc_vec3_scale(hc_vec3_t dst, const hc_vec3_t v, float scalar)
 }
 
 HCSAPI void
-hc_vec3_scale_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v, float scalar)
+HC_FN(hc_, vec3_scale_r)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T v, HC_T scalar)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -930,12 +4369,12 @@ hc_vec3_scale_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v, float scalar)
 }
 
 HCSAPI void
-hc_vec3_normalize(hc_vec3_t dst, const hc_vec3_t v)
+HC_FN(hc_, vec3_normalize)(HC_VEC3_T dst, const HC_VEC3_T v)
 {
-    float length_sq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
-    if (length_sq == 0.0f) return;
+    HC_T length_sq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+    if (length_sq == HC_R(0.0)) return;
 
-    float inv_lenght = hc_rsqrtf(length_sq);
+    HC_T inv_lenght = HC_RSQRT(length_sq);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -946,12 +4385,12 @@ hc_vec3_normalize(hc_vec3_t dst, const hc_vec3_t v)
 }
 
 HCSAPI void
-hc_vec3_normalize_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v)
+HC_FN(hc_, vec3_normalize_r)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T v)
 {
-    float length_sq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
-    if (length_sq == 0.0f) return;
+    HC_T length_sq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+    if (length_sq == HC_R(0.0)) return;
 
-    float inv_lenght = hc_rsqrtf(length_sq);
+    HC_T inv_lenght = HC_RSQRT(length_sq);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -961,23 +4400,23 @@ hc_vec3_normalize_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v)
     }
 }
 
-HCSAPI float
-hc_vec3_length(const hc_vec3_t v)
+HCSAPI HC_T
+HC_FN(hc_, vec3_length)(const HC_VEC3_T v)
 {
-    return sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    return HC_SQRT(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
 }
 
-HCSAPI float
-hc_length_sq_vec3(const hc_vec3_t v)
+HCSAPI HC_T
+HC_FN(hc_length_sq_, vec3)(const HC_VEC3_T v)
 {
     return v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
 }
 
-HCSAPI float
-hc_vec3_dot(const hc_vec3_t v1, const hc_vec3_t v2)
+HCSAPI HC_T
+HC_FN(hc_, vec3_dot)(const HC_VEC3_T v1, const HC_VEC3_T v2)
 {
 #ifdef _OPENMP
-    float dotProduct = 0.0f;
+    HC_T dotProduct = HC_R(0.0);
 #   pragma omp simd
     for (int_fast8_t i = 0; i < 3; i++) {
         dotProduct += v1[i] * v2[i];
@@ -989,9 +4428,9 @@ hc_vec3_dot(const hc_vec3_t v1, const hc_vec3_t v2)
 }
 
 HCSAPI void
-hc_vec3_cross(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2)
+HC_FN(hc_, vec3_cross)(HC_VEC3_T dst, const HC_VEC3_T v1, const HC_VEC3_T v2)
 {
-    hc_vec3_t tmp = {
+    HC_VEC3_T tmp = {
         v1[1] * v2[2] - v1[2] * v2[1],
         v1[2] * v2[0] - v1[0] * v2[2],
         v1[0] * v2[1] - v1[1] * v2[0]
@@ -1003,54 +4442,50 @@ hc_vec3_cross(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2)
 }
 
 HCSAPI void
-hc_vec3_cross_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_vec3_t v2)
+HC_FN(hc_, vec3_cross_r)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T v1, const HC_VEC3_T v2)
 {
     dst[0] = v1[1] * v2[2] - v1[2] * v2[1];
     dst[1] = v1[2] * v2[0] - v1[0] * v2[2];
     dst[2] = v1[0] * v2[1] - v1[1] * v2[0];
 }
 
-HCSAPI float
-hc_vec3_distance(const hc_vec3_t v1, const hc_vec3_t v2)
+HCSAPI HC_T
+HC_FN(hc_, vec3_distance)(const HC_VEC3_T v1, const HC_VEC3_T v2)
 {
     // NOTE: Here, the loop version adds a conditional branch, in doubt we keep it simple.
 
-    hc_vec3_t dt = {
+    HC_VEC3_T dt = {
         v1[0] - v2[0],
         v1[1] - v2[1],
         v1[2] - v2[2]
     };
 
-    float dist_sq = dt[0]*dt[0] +
+    HC_T dist_sq = dt[0]*dt[0] +
                     dt[1]*dt[1] +
                     dt[2]*dt[2];
 
-#ifdef HC_FISR
-    return dist_sq*hc_rsqrtf(dist_sq);
-#else
-    return sqrtf(dist_sq);
-#endif
+    return HC_SQRT(dist_sq);
 }
 
-HCSAPI float
-hc_distance_sq_vec3(const hc_vec3_t v1, const hc_vec3_t v2)
+HCSAPI HC_T
+HC_FN(hc_distance_sq_, vec3)(const HC_VEC3_T v1, const HC_VEC3_T v2)
 {
     // NOTE 1: The code generated by GCC 11/13 in O3 utilizes SIMD operations more efficiently than the non-loop version
     // NOTE 2: Still with GCC 13 in O3, the code generated with 'omp simd' is the same as without, but on GCC versions lower than 11.1 the code generated with 'omp simd' retains the loop...
 
-    float dist_sq = 0.0f;
+    HC_T dist_sq = HC_R(0.0);
     for (int_fast8_t i = 0; i < 3; i++) {
-        float dt = v1[i] - v2[i];
+        HC_T dt = v1[i] - v2[i];
         dist_sq += dt*dt;
     }
     return dist_sq;
 }
 
 HCSAPI void
-hc_vec3_direction(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2)
+HC_FN(hc_, vec3_direction)(HC_VEC3_T dst, const HC_VEC3_T v1, const HC_VEC3_T v2)
 {
-    hc_vec3_t tmp;
-    float lengthSq = 0.0f;
+    HC_VEC3_T tmp;
+    HC_T lengthSq = HC_R(0.0);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1060,7 +4495,7 @@ hc_vec3_direction(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2)
         lengthSq += tmp[i]*tmp[i];
     }
 
-    float inv_lenght = hc_rsqrtf(lengthSq);
+    HC_T inv_lenght = HC_RSQRT(lengthSq);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1071,9 +4506,9 @@ hc_vec3_direction(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2)
 }
 
 HCSAPI void
-hc_vec3_direction_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_vec3_t v2)
+HC_FN(hc_, vec3_direction_r)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T v1, const HC_VEC3_T v2)
 {
-    float lengthSq = 0.0f;
+    HC_T lengthSq = HC_R(0.0);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1083,7 +4518,7 @@ hc_vec3_direction_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_
         lengthSq += dst[i]*dst[i];
     }
 
-    float inv_lenght = hc_rsqrtf(lengthSq);
+    HC_T inv_lenght = HC_RSQRT(lengthSq);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1094,7 +4529,7 @@ hc_vec3_direction_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_
 }
 
 HCSAPI void
-hc_vec3_lerp(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2, float t)
+HC_FN(hc_, vec3_lerp)(HC_VEC3_T dst, const HC_VEC3_T v1, const HC_VEC3_T v2, HC_T t)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1105,7 +4540,7 @@ hc_vec3_lerp(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2, float t)
 }
 
 HCSAPI void
-hc_vec3_lerp_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_vec3_t v2, float t)
+HC_FN(hc_, vec3_lerp_r)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T v1, const HC_VEC3_T v2, HC_T t)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1116,7 +4551,7 @@ hc_vec3_lerp_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_vec3_
 }
 
 HCSAPI void
-hc_vec3_barysmooth(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2, const hc_vec3_t v3, float w1, float w2, float w3)
+HC_FN(hc_, vec3_barysmooth)(HC_VEC3_T dst, const HC_VEC3_T v1, const HC_VEC3_T v2, const HC_VEC3_T v3, HC_T w1, HC_T w2, HC_T w3)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1127,7 +4562,7 @@ hc_vec3_barysmooth(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2, const
 }
 
 HCSAPI void
-hc_vec3_barysmooth_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_vec3_t v2, const hc_vec3_t v3, float w1, float w2, float w3)
+HC_FN(hc_, vec3_barysmooth_r)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T v1, const HC_VEC3_T v2, const HC_VEC3_T v3, HC_T w1, HC_T w2, HC_T w3)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1138,7 +4573,7 @@ hc_vec3_barysmooth_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc
 }
 
 HCSAPI void
-hc_vec3_barysmooth_v(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2, const hc_vec3_t v3, const hc_vec3_t w)
+HC_FN(hc_, vec3_barysmooth_v)(HC_VEC3_T dst, const HC_VEC3_T v1, const HC_VEC3_T v2, const HC_VEC3_T v3, const HC_VEC3_T w)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1149,7 +4584,7 @@ hc_vec3_barysmooth_v(hc_vec3_t dst, const hc_vec3_t v1, const hc_vec3_t v2, cons
 }
 
 HCSAPI void
-hc_vec3_barysmooth_vr(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const hc_vec3_t v2, const hc_vec3_t v3, const hc_vec3_t w)
+HC_FN(hc_, vec3_barysmooth_vr)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T v1, const HC_VEC3_T v2, const HC_VEC3_T v3, const HC_VEC3_T w)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1160,10 +4595,10 @@ hc_vec3_barysmooth_vr(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v1, const h
 }
 
 HCSAPI void
-hc_vec3_baryflat(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, float w1, float w2, float w3)
+HC_FN(hc_, vec3_baryflat)(HC_VEC4_T dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, HC_T w1, HC_T w2, HC_T w3)
 {
     // Find the maximum weight
-    float max_w = w1;
+    HC_T max_w = w1;
     if (w2 > max_w) max_w = w2;
     if (w3 > max_w) max_w = w3;
 
@@ -1184,10 +4619,10 @@ hc_vec3_baryflat(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc
 }
 
 HCSAPI void
-hc_vec3_baryflat_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, float w1, float w2, float w3)
+HC_FN(hc_, vec3_baryflat_r)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, HC_T w1, HC_T w2, HC_T w3)
 {
     // Find the maximum weight
-    float max_w = w1;
+    HC_T max_w = w1;
     if (w2 > max_w) max_w = w2;
     if (w3 > max_w) max_w = w3;
 
@@ -1208,10 +4643,10 @@ hc_vec3_baryflat_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_v
 }
 
 HCSAPI void
-hc_vec3_baryflat_v(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, const hc_vec3_t w)
+HC_FN(hc_, vec3_baryflat_v)(HC_VEC4_T dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, const HC_VEC3_T w)
 {
     // Find the maximum weight
-    float max_w = w[0];
+    HC_T max_w = w[0];
     if (w[1] > max_w) max_w = w[1];
     if (w[2] > max_w) max_w = w[2];
 
@@ -1232,10 +4667,10 @@ hc_vec3_baryflat_v(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, const
 }
 
 HCSAPI void
-hc_vec3_baryflat_vr(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, const hc_vec3_t w)
+HC_FN(hc_, vec3_baryflat_vr)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, const HC_VEC3_T w)
 {
     // Find the maximum weight
-    float max_w = w[0];
+    HC_T max_w = w[0];
     if (w[1] > max_w) max_w = w[1];
     if (w[2] > max_w) max_w = w[2];
 
@@ -1256,9 +4691,9 @@ hc_vec3_baryflat_vr(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_
 }
 
 HCSAPI void
-hc_vec3_transform(hc_vec3_t dst, const hc_vec3_t v, const hc_mat4_t mat)
+HC_FN(hc_, vec3_transform)(HC_VEC3_T dst, const HC_VEC3_T v, const HC_MAT4_T mat)
 {
-    hc_vec3_t tmp = {
+    HC_VEC3_T tmp = {
         mat[0] * v[0] + mat[4] * v[1] + mat[8] * v[2] + mat[12],
         mat[1] * v[0] + mat[5] * v[1] + mat[9] * v[2] + mat[13],
         mat[2] * v[0] + mat[6] * v[1] + mat[10] * v[2] + mat[14]
@@ -1270,7 +4705,7 @@ hc_vec3_transform(hc_vec3_t dst, const hc_vec3_t v, const hc_mat4_t mat)
 }
 
 HCSAPI void
-hc_vec3_transform_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v, const hc_mat4_t mat)
+HC_FN(hc_, vec3_transform_r)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T v, const HC_MAT4_T mat)
 {
     dst[0] = mat[0] * v[0] + mat[4] * v[1] + mat[8] * v[2] + mat[12];
     dst[1] = mat[1] * v[0] + mat[5] * v[1] + mat[9] * v[2] + mat[13];
@@ -1278,9 +4713,9 @@ hc_vec3_transform_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v, const hc_m
 }
 
 HCSAPI void
-hc_vec3_transform_wt(hc_vec3_t dst, const hc_vec3_t v, float w_translation, const hc_mat4_t mat)
+HC_FN(hc_, vec3_transform_wt)(HC_VEC3_T dst, const HC_VEC3_T v, HC_T w_translation, const HC_MAT4_T mat)
 {
-    hc_vec3_t tmp = {
+    HC_VEC3_T tmp = {
         mat[0] * v[0] + mat[4] * v[1] + mat[8] * v[2] + w_translation*mat[12],
         mat[1] * v[0] + mat[5] * v[1] + mat[9] * v[2] + w_translation*mat[13],
         mat[2] * v[0] + mat[6] * v[1] + mat[10] * v[2] + w_translation*mat[14]
@@ -1292,7 +4727,7 @@ hc_vec3_transform_wt(hc_vec3_t dst, const hc_vec3_t v, float w_translation, cons
 }
 
 HCSAPI void
-hc_vec3_transform_wtr(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v, float w_translation, const hc_mat4_t mat)
+HC_FN(hc_, vec3_transform_wtr)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T v, HC_T w_translation, const HC_MAT4_T mat)
 {
     dst[0] = mat[0] * v[0] + mat[4] * v[1] + mat[8] * v[2] + w_translation*mat[12];
     dst[1] = mat[1] * v[0] + mat[5] * v[1] + mat[9] * v[2] + w_translation*mat[13];
@@ -1300,9 +4735,9 @@ hc_vec3_transform_wtr(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t v, float w_
 }
 
 HCSAPI void
-hc_vec3_reflect(hc_vec3_t dst, const hc_vec3_t incident, const hc_vec3_t normal)
+HC_FN(hc_, vec3_reflect)(HC_VEC3_T dst, const HC_VEC3_T incident, const HC_VEC3_T normal)
 {
-    float dotProduct = 0.0f;
+    HC_T dotProduct = HC_R(0.0);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1311,7 +4746,7 @@ hc_vec3_reflect(hc_vec3_t dst, const hc_vec3_t incident, const hc_vec3_t normal)
         dotProduct += incident[i]*normal[i];
     }
 
-    dotProduct *= 2.0f;
+    dotProduct *= HC_R(2.0);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1322,9 +4757,9 @@ hc_vec3_reflect(hc_vec3_t dst, const hc_vec3_t incident, const hc_vec3_t normal)
 }
 
 HCSAPI void
-hc_vec3_reflect_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t incident, const hc_vec3_t normal)
+HC_FN(hc_, vec3_reflect_r)(HC_VEC3_PTR_T HC_RESTRICT dst, const HC_VEC3_T incident, const HC_VEC3_T normal)
 {
-    float dotProduct = 0.0f;
+    HC_T dotProduct = HC_R(0.0);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1333,7 +4768,7 @@ hc_vec3_reflect_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t incident, const
         dotProduct += incident[i]*normal[i];
     }
 
-    dotProduct *= 2.0f;
+    dotProduct *= HC_R(2.0);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1346,7 +4781,7 @@ hc_vec3_reflect_r(hc_vec3_ptr_t HC_RESTRICT dst, const hc_vec3_t incident, const
 /* 4D Vector function definitions */
 
 HCSAPI void
-hc_vec4_zero(hc_vec4_t dst)
+HC_FN(hc_, vec4_zero)(HC_VEC4_T dst)
 {
     for (int_fast8_t i = 0; i < 4; i++) {
         dst[i] = 0;
@@ -1354,19 +4789,19 @@ hc_vec4_zero(hc_vec4_t dst)
 }
 
 HCSAPI void
-hc_vec4_one(hc_vec4_t dst, float v)
+HC_FN(hc_, vec4_one)(HC_VEC4_T dst, HC_T v)
 {
     dst[0] = dst[1] = dst[2] = dst[3] = v;
 }
 
 HCSAPI void
-hc_vec4_set(hc_vec4_t dst, float x, float y, float z, float w)
+HC_FN(hc_, vec4_set)(HC_VEC4_T dst, HC_T x, HC_T y, HC_T z, HC_T w)
 {
     dst[0] = x, dst[1] = y, dst[2] = z, dst[3] = w;
 }
 
 HCSAPI void
-hc_vec4_copy(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_ptr_t HC_RESTRICT src)
+HC_FN(hc_, vec4_copy)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_PTR_T HC_RESTRICT src)
 {
     for (int_fast8_t i = 0; i < 4; i++) {
         dst[i] = src[i];
@@ -1374,20 +4809,20 @@ hc_vec4_copy(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_ptr_t HC_RESTRICT src)
 }
 
 HCSAPI void
-hc_vec4_swap(hc_vec4_ptr_t HC_RESTRICT a, hc_vec4_ptr_t HC_RESTRICT b)
+HC_FN(hc_, vec4_swap)(HC_VEC4_PTR_T HC_RESTRICT a, HC_VEC4_PTR_T HC_RESTRICT b)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
 #   endif
     for (int_fast8_t i = 0; i < 4; i++) {
-        float tmp = a[i];
+        HC_T tmp = a[i];
         a[i] = b[i];
         b[i] = tmp;
     }
 }
 
 HCSAPI void
-hc_vec4_neg(hc_vec4_t dst, const hc_vec4_t v)
+HC_FN(hc_, vec4_neg)(HC_VEC4_T dst, const HC_VEC4_T v)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1398,7 +4833,7 @@ hc_vec4_neg(hc_vec4_t dst, const hc_vec4_t v)
 }
 
 HCSAPI void
-hc_vec4_neg_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v)
+HC_FN(hc_, vec4_neg_r)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1409,7 +4844,7 @@ hc_vec4_neg_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v)
 }
 
 HCSAPI void
-hc_vec4_add(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2)
+HC_FN(hc_, vec4_add)(HC_VEC4_T dst, const HC_VEC4_T v1, const HC_VEC4_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1420,7 +4855,7 @@ hc_vec4_add(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2)
 }
 
 HCSAPI void
-hc_vec4_add_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t v2)
+HC_FN(hc_, vec4_add_r)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v1, const HC_VEC4_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1431,7 +4866,7 @@ hc_vec4_add_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t
 }
 
 HCSAPI void
-hc_vec4_sub(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2)
+HC_FN(hc_, vec4_sub)(HC_VEC4_T dst, const HC_VEC4_T v1, const HC_VEC4_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1442,7 +4877,7 @@ hc_vec4_sub(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2)
 }
 
 HCSAPI void
-hc_vec4_sub_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t v2)
+HC_FN(hc_, vec4_sub_r)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v1, const HC_VEC4_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1453,7 +4888,7 @@ hc_vec4_sub_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t
 }
 
 HCSAPI void
-hc_vec4_mul(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2)
+HC_FN(hc_, vec4_mul)(HC_VEC4_T dst, const HC_VEC4_T v1, const HC_VEC4_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1464,7 +4899,7 @@ hc_vec4_mul(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2)
 }
 
 HCSAPI void
-hc_vec4_mul_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t v2)
+HC_FN(hc_, vec4_mul_r)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v1, const HC_VEC4_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1475,7 +4910,7 @@ hc_vec4_mul_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t
 }
 
 HCSAPI void
-hc_vec4_div(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2)
+HC_FN(hc_, vec4_div)(HC_VEC4_T dst, const HC_VEC4_T v1, const HC_VEC4_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1486,7 +4921,7 @@ hc_vec4_div(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2)
 }
 
 HCSAPI void
-hc_vec4_div_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t v2)
+HC_FN(hc_, vec4_div_r)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v1, const HC_VEC4_T v2)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1497,7 +4932,7 @@ hc_vec4_div_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t
 }
 
 HCSAPI void
-hc_vec4_offset(hc_vec4_t dst, const hc_vec4_t v, float scalar)
+HC_FN(hc_, vec4_offset)(HC_VEC4_T dst, const HC_VEC4_T v, HC_T scalar)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1508,7 +4943,7 @@ hc_vec4_offset(hc_vec4_t dst, const hc_vec4_t v, float scalar)
 }
 
 HCSAPI void
-hc_vec4_offset_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v, float scalar)
+HC_FN(hc_, vec4_offset_r)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v, HC_T scalar)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1519,7 +4954,7 @@ hc_vec4_offset_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v, float scalar)
 }
 
 HCSAPI void
-hc_vec4_scale(hc_vec4_t dst, const hc_vec4_t v, float scalar)
+HC_FN(hc_, vec4_scale)(HC_VEC4_T dst, const HC_VEC4_T v, HC_T scalar)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1530,7 +4965,7 @@ hc_vec4_scale(hc_vec4_t dst, const hc_vec4_t v, float scalar)
 }
 
 HCSAPI void
-hc_vec4_scale_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v, float scalar)
+HC_FN(hc_, vec4_scale_r)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v, HC_T scalar)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1541,12 +4976,12 @@ hc_vec4_scale_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v, float scalar)
 }
 
 HCSAPI void
-hc_vec4_normalize(hc_vec4_t dst, const hc_vec4_t v)
+HC_FN(hc_, vec4_normalize)(HC_VEC4_T dst, const HC_VEC4_T v)
 {
-    float length_sq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3];
-    if (length_sq == 0.0f) return;
+    HC_T length_sq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3];
+    if (length_sq == HC_R(0.0)) return;
 
-    float inv_lenght = hc_rsqrtf(length_sq);
+    HC_T inv_lenght = HC_RSQRT(length_sq);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1557,12 +4992,12 @@ hc_vec4_normalize(hc_vec4_t dst, const hc_vec4_t v)
 }
 
 HCSAPI void
-hc_vec4_normalize_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v)
+HC_FN(hc_, vec4_normalize_r)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v)
 {
-    float length_sq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3];
-    if (length_sq == 0.0f) return;
+    HC_T length_sq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3];
+    if (length_sq == HC_R(0.0)) return;
 
-    float inv_lenght = hc_rsqrtf(length_sq);
+    HC_T inv_lenght = HC_RSQRT(length_sq);
 
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1572,26 +5007,26 @@ hc_vec4_normalize_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v)
     }
 }
 
-HCSAPI float
-hc_vec4_length(const hc_vec4_t v)
+HCSAPI HC_T
+HC_FN(hc_, vec4_length)(const HC_VEC4_T v)
 {
-    return sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3]);
+    return HC_SQRT(v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3]);
 }
 
-HCSAPI float
-hc_length_sq_vec4(const hc_vec4_t v)
+HCSAPI HC_T
+HC_FN(hc_length_sq_, vec4)(const HC_VEC4_T v)
 {
     return v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3];
 }
 
-HCSAPI float
-hc_vec4_dot(const hc_vec4_t v1, const hc_vec4_t v2)
+HCSAPI HC_T
+HC_FN(hc_, vec4_dot)(const HC_VEC4_T v1, const HC_VEC4_T v2)
 {
     return v1[0] * v2[0] + v1[1] * v2[1] + v1[2] * v2[2] + v1[3] * v2[3];
 }
 
 HCSAPI void
-hc_vec4_lerp(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, float t)
+HC_FN(hc_, vec4_lerp)(HC_VEC4_T dst, const HC_VEC4_T v1, const HC_VEC4_T v2, HC_T t)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1602,7 +5037,7 @@ hc_vec4_lerp(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, float t)
 }
 
 HCSAPI void
-hc_vec4_lerp_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t v2, float t)
+HC_FN(hc_, vec4_lerp_r)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v1, const HC_VEC4_T v2, HC_T t)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1613,7 +5048,7 @@ hc_vec4_lerp_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_
 }
 
 HCSAPI void
-hc_vec4_barysmooth(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, float w1, float w2, float w3)
+HC_FN(hc_, vec4_barysmooth)(HC_VEC4_T dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, HC_T w1, HC_T w2, HC_T w3)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1624,7 +5059,7 @@ hc_vec4_barysmooth(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, const
 }
 
 HCSAPI void
-hc_vec4_barysmooth_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, float w1, float w2, float w3)
+HC_FN(hc_, vec4_barysmooth_r)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, HC_T w1, HC_T w2, HC_T w3)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1635,7 +5070,7 @@ hc_vec4_barysmooth_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc
 }
 
 HCSAPI void
-hc_vec4_barysmooth_v(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, const hc_vec3_t w)
+HC_FN(hc_, vec4_barysmooth_v)(HC_VEC4_T dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, const HC_VEC3_T w)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1646,7 +5081,7 @@ hc_vec4_barysmooth_v(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, cons
 }
 
 HCSAPI void
-hc_vec4_barysmooth_vr(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, const hc_vec3_t w)
+HC_FN(hc_, vec4_barysmooth_vr)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, const HC_VEC3_T w)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -1657,10 +5092,10 @@ hc_vec4_barysmooth_vr(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const h
 }
 
 HCSAPI void
-hc_vec4_baryflat(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, float w1, float w2, float w3)
+HC_FN(hc_, vec4_baryflat)(HC_VEC4_T dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, HC_T w1, HC_T w2, HC_T w3)
 {
     // Find the maximum weight
-    float max_w = w1;
+    HC_T max_w = w1;
     if (w2 > max_w) max_w = w2;
     if (w3 > max_w) max_w = w3;
 
@@ -1681,10 +5116,10 @@ hc_vec4_baryflat(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc
 }
 
 HCSAPI void
-hc_vec4_baryflat_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, float w1, float w2, float w3)
+HC_FN(hc_, vec4_baryflat_r)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, HC_T w1, HC_T w2, HC_T w3)
 {
     // Find the maximum weight
-    float max_w = w1;
+    HC_T max_w = w1;
     if (w2 > max_w) max_w = w2;
     if (w3 > max_w) max_w = w3;
 
@@ -1705,10 +5140,10 @@ hc_vec4_baryflat_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_v
 }
 
 HCSAPI void
-hc_vec4_baryflat_v(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, const hc_vec3_t w)
+HC_FN(hc_, vec4_baryflat_v)(HC_VEC4_T dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, const HC_VEC3_T w)
 {
     // Find the maximum weight
-    float max_w = w[0];
+    HC_T max_w = w[0];
     if (w[1] > max_w) max_w = w[1];
     if (w[2] > max_w) max_w = w[2];
 
@@ -1729,10 +5164,10 @@ hc_vec4_baryflat_v(hc_vec4_t dst, const hc_vec4_t v1, const hc_vec4_t v2, const
 }
 
 HCSAPI void
-hc_vec4_baryflat_vr(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_vec4_t v2, const hc_vec4_t v3, const hc_vec3_t w)
+HC_FN(hc_, vec4_baryflat_vr)(HC_VEC4_PTR_T HC_RESTRICT dst, const HC_VEC4_T v1, const HC_VEC4_T v2, const HC_VEC4_T v3, const HC_VEC3_T w)
 {
     // Find the maximum weight
-    float max_w = w[0];
+    HC_T max_w = w[0];
     if (w[1] > max_w) max_w = w[1];
     if (w[2] > max_w) max_w = w[2];
 
@@ -1752,42 +5187,18 @@ hc_vec4_baryflat_vr(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v1, const hc_
     }
 }
 
-HCSAPI void
-hc_vec4_transform(hc_vec4_t dst, const hc_vec4_t v, const hc_mat4_t mat)
-{
-    hc_vec4_t tmp = {
-        mat[0] * v[0] + mat[4] * v[1] + mat[8] * v[2] + mat[12] * v[3],
-        mat[1] * v[0] + mat[5] * v[1] + mat[9] * v[2] + mat[13] * v[3],
-        mat[2] * v[0] + mat[6] * v[1] + mat[10] * v[2] + mat[14] * v[3],
-        mat[3] * v[0] + mat[7] * v[1] + mat[11] * v[2] + mat[15] * v[3]
-    };
-
-    for (int_fast8_t i = 0; i < 4; i++) {
-        dst[i] = tmp[i];
-    }
-}
-
-HCSAPI void
-hc_vec4_transform_r(hc_vec4_ptr_t HC_RESTRICT dst, const hc_vec4_t v, const hc_mat4_t mat)
-{
-    dst[0] = mat[0] * v[0] + mat[4] * v[1] + mat[8] * v[2] + mat[12] * v[3];
-    dst[1] = mat[1] * v[0] + mat[5] * v[1] + mat[9] * v[2] + mat[13] * v[3];
-    dst[2] = mat[2] * v[0] + mat[6] * v[1] + mat[10] * v[2] + mat[14] * v[3];
-    dst[3] = mat[3] * v[0] + mat[7] * v[1] + mat[11] * v[2] + mat[15] * v[3];
-}
-
 /* Matrix 4x4 function definitions */
 
 HCSAPI void
-hc_mat4_identity(hc_mat4_t dst)
+HC_FN(hc_, mat4_identity)(HC_MAT4_T dst)
 {
     for (int_fast8_t i = 0; i < 16; i++) {
-        dst[i] = (float)(!(i % 5));
+        dst[i] = (HC_T)(!(i % 5));
     }
 }
 
 HCSAPI void
-hc_mat4_copy(hc_mat4_ptr_t HC_RESTRICT dst, const hc_mat4_ptr_t HC_RESTRICT src)
+HC_FN(hc_, mat4_copy)(HC_MAT4_PTR_T HC_RESTRICT dst, const HC_MAT4_PTR_T HC_RESTRICT src)
 {
     for (int_fast8_t i = 0; i < 16; i++) {
         dst[i] = src[i];
@@ -1795,10 +5206,10 @@ hc_mat4_copy(hc_mat4_ptr_t HC_RESTRICT dst, const hc_mat4_ptr_t HC_RESTRICT src)
 }
 
 HCSAPI void
-hc_mat4_translate(hc_mat4_t dst, float x, float y, float z)
+HC_FN(hc_, mat4_translate)(HC_MAT4_T dst, HC_T x, HC_T y, HC_T z)
 {
     for (int_fast8_t i = 0; i < 16; i++) {
-        dst[i] = (float)(!(i % 5));
+        dst[i] = (HC_T)(!(i % 5));
     }
     dst[12] = x;
     dst[13] = y;
@@ -1806,26 +5217,26 @@ hc_mat4_translate(hc_mat4_t dst, float x, float y, float z)
 }
 
 HCSAPI void
-hc_mat4_rotate(hc_mat4_t dst, const hc_vec3_t axis, float radians)
+HC_FN(hc_, mat4_rotate)(HC_MAT4_T dst, const HC_VEC3_T axis, HC_T radians)
 {
     // hc_mat4_identity()
     for (int_fast8_t i = 0; i < 16; i++) {
-        dst[i] = (float)(!(i % 5));
+        dst[i] = (HC_T)(!(i % 5));
     }
 
-    float x = axis[0], y = axis[1], z = axis[2];
-    float lengthSq = x*x + y*y + z*z;
+    HC_T x = axis[0], y = axis[1], z = axis[2];
+    HC_T lengthSq = x*x + y*y + z*z;
 
-    if (lengthSq != 1.0f && lengthSq != 0.0f) {
-        float invLenght = hc_rsqrtf(lengthSq);
+    if (lengthSq != HC_R(1.0) && lengthSq != HC_R(0.0)) {
+        HC_T invLenght = HC_RSQRT(lengthSq);
         x *= invLenght;
         y *= invLenght;
         z *= invLenght;
     }
 
-    float sinres = sinf(radians);
-    float cosres = cosf(radians);
-    float t = 1.0f - cosres;
+    HC_T sinres = HC_SIN(radians);
+    HC_T cosres = HC_COS(radians);
+    HC_T t = HC_R(1.0) - cosres;
 
     dst[0]  = x*x*t + cosres;
     dst[1]  = y*x*t + z*sinres;
@@ -1841,15 +5252,15 @@ hc_mat4_rotate(hc_mat4_t dst, const hc_vec3_t axis, float radians)
 }
 
 HCSAPI void
-hc_rotate_x_mat4(hc_mat4_t dst, float radians)
+HC_FN(hc_rotate_x_, mat4)(HC_MAT4_T dst, HC_T radians)
 {
     // hc_mat4_identity()
     for (int_fast8_t i = 0; i < 16; i++) {
-        dst[i] = (float)(!(i % 5));
+        dst[i] = (HC_T)(!(i % 5));
     }
 
-    float cosres = cosf(radians);
-    float sinres = sinf(radians);
+    HC_T cosres = HC_COS(radians);
+    HC_T sinres = HC_SIN(radians);
 
     dst[5]  = cosres;
     dst[6]  = sinres;
@@ -1859,15 +5270,15 @@ hc_rotate_x_mat4(hc_mat4_t dst, float radians)
 
 
 HCSAPI void
-hc_rotate_y_mat4(hc_mat4_t dst, float radians)
+HC_FN(hc_rotate_y_, mat4)(HC_MAT4_T dst, HC_T radians)
 {
     // hc_mat4_identity()
     for (int_fast8_t i = 0; i < 16; i++) {
-        dst[i] = (float)(!(i % 5));
+        dst[i] = (HC_T)(!(i % 5));
     }
 
-    float cosres = cosf(radians);
-    float sinres = sinf(radians);
+    HC_T cosres = HC_COS(radians);
+    HC_T sinres = HC_SIN(radians);
 
     dst[0]  = cosres;
     dst[2]  = -sinres;
@@ -1876,15 +5287,15 @@ hc_rotate_y_mat4(hc_mat4_t dst, float radians)
 }
 
 HCSAPI void
-hc_rotate_z_mat4(hc_mat4_t dst, float radians)
+HC_FN(hc_rotate_z_, mat4)(HC_MAT4_T dst, HC_T radians)
 {
     // hc_mat4_identity()
     for (int_fast8_t i = 0; i < 16; i++) {
-        dst[i] = (float)(!(i % 5));
+        dst[i] = (HC_T)(!(i % 5));
     }
 
-    float cosres = cosf(radians);
-    float sinres = sinf(radians);
+    HC_T cosres = HC_COS(radians);
+    HC_T sinres = HC_SIN(radians);
 
     dst[0] = cosres;
     dst[1] = sinres;
@@ -1894,19 +5305,19 @@ hc_rotate_z_mat4(hc_mat4_t dst, float radians)
 
 
 HCSAPI void
-hc_rotate_xyz_mat4(hc_mat4_t dst, const hc_vec3_t radians)
+HC_FN(hc_rotate_xyz_, mat4)(HC_MAT4_T dst, const HC_VEC3_T radians)
 {
     // hc_mat4_identity()
     for (int_fast8_t i = 0; i < 16; i++) {
-        dst[i] = (float)(!(i % 5));
+        dst[i] = (HC_T)(!(i % 5));
     }
 
-    float cosz = cosf(-radians[2]);
-    float sinz = sinf(-radians[2]);
-    float cosy = cosf(-radians[1]);
-    float siny = sinf(-radians[1]);
-    float cosx = cosf(-radians[0]);
-    float sinx = sinf(-radians[0]);
+    HC_T cosz = HC_COS(-radians[2]);
+    HC_T sinz = HC_SIN(-radians[2]);
+    HC_T cosy = HC_COS(-radians[1]);
+    HC_T siny = HC_SIN(-radians[1]);
+    HC_T cosx = HC_COS(-radians[0]);
+    HC_T sinx = HC_SIN(-radians[0]);
 
     dst[0]  = cosz*cosy;
     dst[1]  = (cosz*siny*sinx) - (sinz*cosx);
@@ -1923,19 +5334,19 @@ hc_rotate_xyz_mat4(hc_mat4_t dst, const hc_vec3_t radians)
 
 
 HCSAPI void
-h_rotate_zyx_mat4(hc_mat4_t dst, const hc_vec3_t radians)
+HC_FN(h_rotate_zyx_, mat4)(HC_MAT4_T dst, const HC_VEC3_T radians)
 {
     // hc_mat4_identity()
     for (int_fast8_t i = 0; i < 16; i++) {
-        dst[i] = (float)(!(i % 5));
+        dst[i] = (HC_T)(!(i % 5));
     }
 
-    float cz = cosf(radians[2]);
-    float sz = sinf(radians[2]);
-    float cy = cosf(radians[1]);
-    float sy = sinf(radians[1]);
-    float cx = cosf(radians[0]);
-    float sx = sinf(radians[0]);
+    HC_T cz = HC_COS(radians[2]);
+    HC_T sz = HC_SIN(radians[2]);
+    HC_T cy = HC_COS(radians[1]);
+    HC_T sy = HC_SIN(radians[1]);
+    HC_T cx = HC_COS(radians[0]);
+    HC_T sx = HC_SIN(radians[0]);
 
     dst[0] = cz*cy;
     dst[4] = cz*sy*sx - cx*sz;
@@ -1951,113 +5362,113 @@ h_rotate_zyx_mat4(hc_mat4_t dst, const hc_vec3_t radians)
 }
 
 HCSAPI void
-hc_mat4_scale(hc_mat4_t dst, float x, float y, float z)
+HC_FN(hc_, mat4_scale)(HC_MAT4_T dst, HC_T x, HC_T y, HC_T z)
 {
     for (int_fast8_t i = 0; i < 16; i++) dst[i] = 0;
     dst[0] = x, dst[5] = y, dst[10] = z, dst[15] = 1.0;
 }
 
 HCSAPI void
-hc_mat4_frustum(hc_mat4_t dst, float left, float right, float bottom, float top, float znear, float zfar)
+HC_FN(hc_, mat4_frustum)(HC_MAT4_T dst, HC_T left, HC_T right, HC_T bottom, HC_T top, HC_T znear, HC_T zfar)
 {
     for (int_fast8_t i = 0; i < 16; i++) {
         dst[i] = 0;
     }
 
-    float rl = right - left;
-    float tb = top - bottom;
-    float fn = zfar - znear;
+    HC_T rl = right - left;
+    HC_T tb = top - bottom;
+    HC_T fn = zfar - znear;
 
-    dst[0] = (znear * 2.0f) / rl;
-    dst[5] = (znear * 2.0f) / tb;
+    dst[0] = (znear * HC_R(2.0)) / rl;
+    dst[5] = (znear * HC_R(2.0)) / tb;
 
     dst[8] = (right + left) / rl;
     dst[9] = (top + bottom) / tb;
     dst[10] = -(zfar + znear) / fn;
-    dst[11] = -1.0f;
+    dst[11] = -HC_R(1.0);
 
-    dst[14] = -(zfar * znear * 2.0f) / fn;
+    dst[14] = -(zfar * znear * HC_R(2.0)) / fn;
 }
 
 HCSAPI void
-hc_mat4_perspective(hc_mat4_t dst, float fovy_rad, float aspect, float znear, float zfar)
+HC_FN(hc_, mat4_perspective)(HC_MAT4_T dst, HC_T fovy_rad, HC_T aspect, HC_T znear, HC_T zfar)
 {
     for (int_fast8_t i = 0; i < 16; i++) {
         dst[i] = 0;
     }
 
-    float top = znear * tanf(fovy_rad * 0.5f);
-    float bottom = -top;
-    float right = top * aspect;
-    float left = -right;
+    HC_T top = znear * HC_TAN(fovy_rad * HC_R(0.5));
+    HC_T bottom = -top;
+    HC_T right = top * aspect;
+    HC_T left = -right;
 
     // hc_mat4_frustum(-right, right, -top, top, near, far);
-    float rl = right - left;
-    float tb = top - bottom;
-    float fn = zfar - znear;
+    HC_T rl = right - left;
+    HC_T tb = top - bottom;
+    HC_T fn = zfar - znear;
 
-    dst[0] = (znear * 2.0f) / rl;
-    dst[5] = (znear * 2.0f) / tb;
+    dst[0] = (znear * HC_R(2.0)) / rl;
+    dst[5] = (znear * HC_R(2.0)) / tb;
 
     dst[8] = (right + left) / rl;
     dst[9] = (top + bottom) / tb;
     dst[10] = -(zfar + znear) / fn;
-    dst[11] = -1.0f;
+    dst[11] = -HC_R(1.0);
 
-    dst[14] = -(zfar * znear * 2.0f) / fn;
+    dst[14] = -(zfar * znear * HC_R(2.0)) / fn;
 }
 
 HCSAPI void
-hc_mat4_ortho(hc_mat4_t dst, float left, float right, float bottom, float top, float znear, float zfar)
+HC_FN(hc_, mat4_ortho)(HC_MAT4_T dst, HC_T left, HC_T right, HC_T bottom, HC_T top, HC_T znear, HC_T zfar)
 {
     for (int_fast8_t i = 0; i < 16; i++) {
         dst[i] = 0;
     }
 
-    float rl = (right - left);
-    float tb = (top - bottom);
-    float fn = (zfar - znear);
+    HC_T rl = (right - left);
+    HC_T tb = (top - bottom);
+    HC_T fn = (zfar - znear);
 
-    dst[0] = 2.0f / rl;
-    dst[5] = 2.0f / tb;
+    dst[0] = HC_R(2.0) / rl;
+    dst[5] = HC_R(2.0) / tb;
 
-    dst[10] = -2.0f / fn;
-    dst[11] = 0.0f;
+    dst[10] = -HC_R(2.0) / fn;
+    dst[11] = HC_R(0.0);
     dst[12] = -(left + right) / rl;
     dst[13] = -(top + bottom) / tb;
 
     dst[14] = -(zfar + znear) / fn;
-    dst[15] = 1.0f;
+    dst[15] = HC_R(1.0);
 }
 
 HCSAPI void
-hc_look_at_mat4(hc_mat4_t dst, const hc_vec3_t eye, const hc_vec3_t target, const hc_vec3_t up)
+HC_FN(hc_look_at_, mat4)(HC_MAT4_T dst, const HC_VEC3_T eye, const HC_VEC3_T target, const HC_VEC3_T up)
 {
     for (int_fast8_t i = 0; i < 16; i++) {
         dst[i] = 0;
     }
 
-    float length = 0.0f;
-    float invLenght = 0.0f;
+    HC_T length = HC_R(0.0);
+    HC_T invLenght = HC_R(0.0);
 
     // hc_sub_ve3(eye, target)
-    hc_vec3_t vz = {
+    HC_VEC3_T vz = {
         eye[0] - target[0],
         eye[1] - target[1],
         eye[2] - target[2]
     };
 
     // hc_vec3_normalize(vz)
-    hc_vec3_t v = { vz[0], vz[1], vz[2] };
-    length = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
-    if (length == 0.0f) length = 1.0f;
-    invLenght = 1.0f/length;
+    HC_VEC3_T v = { vz[0], vz[1], vz[2] };
+    length = HC_SQRT(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (length == HC_R(0.0)) length = HC_R(1.0);
+    invLenght = HC_R(1.0)/length;
     vz[0] *= invLenght;
     vz[1] *= invLenght;
     vz[2] *= invLenght;
 
     // hc_vec3_cross(up, vz)
-    hc_vec3_t vx = {
+    HC_VEC3_T vx = {
         up[1] * vz[2] - up[2] * vz[1],
         up[2] * vz[0] - up[0] * vz[2],
         up[0] * vz[1] - up[1] * vz[0]
@@ -2065,15 +5476,15 @@ hc_look_at_mat4(hc_mat4_t dst, const hc_vec3_t eye, const hc_vec3_t target, cons
 
     // hc_vec3_normalize(x)
     for (int_fast8_t i = 0; i < 3; i++) v[i] = vx[i];
-    length = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
-    if (length == 0.0f) length = 1.0f;
-    invLenght = 1.0f/length;
+    length = HC_SQRT(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (length == HC_R(0.0)) length = HC_R(1.0);
+    invLenght = HC_R(1.0)/length;
     vx[0] *= invLenght;
     vx[1] *= invLenght;
     vx[2] *= invLenght;
 
     // hc_vec3_cross(vz, vx)
-    hc_vec3_t vy = {
+    HC_VEC3_T vy = {
         vz[1] * vx[2] - vz[2] * vx[1],
         vz[2] * vx[0] - vz[0] * vx[2],
         vz[0] * vx[1] - vz[1] * vx[0]
@@ -2094,19 +5505,19 @@ hc_look_at_mat4(hc_mat4_t dst, const hc_vec3_t eye, const hc_vec3_t target, cons
     dst[12] = -(vx[0]*eye[0] + vx[1]*eye[1] + vx[2]*eye[2]);   // hc_vec3_dot(vx, eye)
     dst[13] = -(vy[0]*eye[0] + vy[1]*eye[1] + vy[2]*eye[2]);   // hc_vec3_dot(vy, eye)
     dst[14] = -(vz[0]*eye[0] + vz[1]*eye[1] + vz[2]*eye[2]);   // hc_vec3_dot(vz, eye)
-    dst[15] = 1.0f;
+    dst[15] = HC_R(1.0);
 }
 
-HCSAPI float
-hc_mat4_determinant(const hc_mat4_t mat)
+HCSAPI HC_T
+HC_FN(hc_, mat4_determinant)(const HC_MAT4_T mat)
 {
-    float result = 0.0f;
+    HC_T result = HC_R(0.0);
 
     // Cache the matrix values (speed optimization)
-    float a00 = mat[0],  a01 = mat[1],  a02 = mat[2],  a03 = mat[3];
-    float a10 = mat[4],  a11 = mat[5],  a12 = mat[6],  a13 = mat[7];
-    float a20 = mat[8],  a21 = mat[9],  a22 = mat[10], a23 = mat[11];
-    float a30 = mat[12], a31 = mat[13], a32 = mat[14], a33 = mat[15];
+    HC_T a00 = mat[0],  a01 = mat[1],  a02 = mat[2],  a03 = mat[3];
+    HC_T a10 = mat[4],  a11 = mat[5],  a12 = mat[6],  a13 = mat[7];
+    HC_T a20 = mat[8],  a21 = mat[9],  a22 = mat[10], a23 = mat[11];
+    HC_T a30 = mat[12], a31 = mat[13], a32 = mat[14], a33 = mat[15];
 
     result = a30*a21*a12*a03 - a20*a31*a12*a03 - a30*a11*a22*a03 + a10*a31*a22*a03 +
              a20*a11*a32*a03 - a10*a21*a32*a03 - a30*a21*a02*a13 + a20*a31*a02*a13 +
@@ -2119,9 +5530,9 @@ hc_mat4_determinant(const hc_mat4_t mat)
 }
 
 HCSAPI void
-hc_mat4_transpose(hc_mat4_t dst, const hc_mat4_t src)
+HC_FN(hc_, mat4_transpose)(HC_MAT4_T dst, const HC_MAT4_T src)
 {
-    hc_mat4_t result;
+    HC_MAT4_T result;
     for (int_fast8_t i = 0; i < 4; i++) {
         for (int_fast8_t j = 0; j < 4; j++) {
             result[i * 4 + j] = src[j * 4 + i];
@@ -2133,7 +5544,7 @@ hc_mat4_transpose(hc_mat4_t dst, const hc_mat4_t src)
 }
 
 HCSAPI void
-hc_mat4_transpose_r(hc_mat4_ptr_t HC_RESTRICT dst, const hc_mat4_t src)
+HC_FN(hc_, mat4_transpose_r)(HC_MAT4_PTR_T HC_RESTRICT dst, const HC_MAT4_T src)
 {
     for (int_fast8_t i = 0; i < 4; i++) {
         for (int_fast8_t j = 0; j < 4; j++) {
@@ -2143,29 +5554,29 @@ hc_mat4_transpose_r(hc_mat4_ptr_t HC_RESTRICT dst, const hc_mat4_t src)
 }
 
 HCSAPI void
-hc_mat4_invert(hc_mat4_t dst, const hc_mat4_t src)
+HC_FN(hc_, mat4_invert)(HC_MAT4_T dst, const HC_MAT4_T src)
 {
     // Cache the matrix values (speed optimization)
-    float a00 = src[0],  a01 = src[1],  a02 = src[2],  a03 = src[3];
-    float a10 = src[4],  a11 = src[5],  a12 = src[6],  a13 = src[7];
-    float a20 = src[8],  a21 = src[9],  a22 = src[10], a23 = src[11];
-    float a30 = src[12], a31 = src[13], a32 = src[14], a33 = src[15];
-
-    float b00 = a00*a11 - a01*a10;
-    float b01 = a00*a12 - a02*a10;
-    float b02 = a00*a13 - a03*a10;
-    float b03 = a01*a12 - a02*a11;
-    float b04 = a01*a13 - a03*a11;
-    float b05 = a02*a13 - a03*a12;
-    float b06 = a20*a31 - a21*a30;
-    float b07 = a20*a32 - a22*a30;
-    float b08 = a20*a33 - a23*a30;
-    float b09 = a21*a32 - a22*a31;
-    float b10 = a21*a33 - a23*a31;
-    float b11 = a22*a33 - a23*a32;
+    HC_T a00 = src[0],  a01 = src[1],  a02 = src[2],  a03 = src[3];
+    HC_T a10 = src[4],  a11 = src[5],  a12 = src[6],  a13 = src[7];
+    HC_T a20 = src[8],  a21 = src[9],  a22 = src[10], a23 = src[11];
+    HC_T a30 = src[12], a31 = src[13], a32 = src[14], a33 = src[15];
+
+    HC_T b00 = a00*a11 - a01*a10;
+    HC_T b01 = a00*a12 - a02*a10;
+    HC_T b02 = a00*a13 - a03*a10;
+    HC_T b03 = a01*a12 - a02*a11;
+    HC_T b04 = a01*a13 - a03*a11;
+    HC_T b05 = a02*a13 - a03*a12;
+    HC_T b06 = a20*a31 - a21*a30;
+    HC_T b07 = a20*a32 - a22*a30;
+    HC_T b08 = a20*a33 - a23*a30;
+    HC_T b09 = a21*a32 - a22*a31;
+    HC_T b10 = a21*a33 - a23*a31;
+    HC_T b11 = a22*a33 - a23*a32;
 
     // Calculate the invert determinant (inlined to avoid double-caching)
-    float invDet = 1.0f/(b00*b11 - b01*b10 + b02*b09 + b03*b08 - b04*b07 + b05*b06);
+    HC_T invDet = HC_R(1.0)/(b00*b11 - b01*b10 + b02*b09 + b03*b08 - b04*b07 + b05*b06);
 
     dst[0] = (a11*b11 - a12*b10 + a13*b09)*invDet;
     dst[1] = (-a01*b11 + a02*b10 - a03*b09)*invDet;
@@ -2185,14 +5596,100 @@ hc_mat4_invert(hc_mat4_t dst, const hc_mat4_t src)
     dst[15] = (a20*b03 - a21*b01 + a22*b00)*invDet;
 }
 
-HCSAPI float
-hc_mat4_trace(const hc_mat4_t mat)
+/*
+ * Inverse of the affine transform stored as 4 columns of 'stride' values
+ * (4 for the 4x4 matrices, 3 for hc_mat3x4_t), only the upper 3x4 part is read and written.
+ * The 3x3 block is inverted with its cofactors, the translation becomes -inv(M)*t.
+ */
+HCSAPI void
+HC_FN(hc_, affine_invert_columns)(HC_T* dst, const HC_T* src, int_fast8_t stride)
+{
+    const HC_T *c0 = src, *c1 = src + stride, *c2 = src + 2 * stride, *c3 = src + 3 * stride;
+    HC_T m00 = c0[0], m10 = c0[1], m20 = c0[2];
+    HC_T m01 = c1[0], m11 = c1[1], m21 = c1[2];
+    HC_T m02 = c2[0], m12 = c2[1], m22 = c2[2];
+    HC_T tx = c3[0], ty = c3[1], tz = c3[2];
+
+    HC_T cof00 = m11*m22 - m12*m21;
+    HC_T cof01 = m12*m20 - m10*m22;
+    HC_T cof02 = m10*m21 - m11*m20;
+
+    HC_T invDet = HC_R(1.0)/(m00*cof00 + m01*cof01 + m02*cof02);
+
+    HC_T i00 = cof00*invDet, i01 = (m02*m21 - m01*m22)*invDet, i02 = (m01*m12 - m02*m11)*invDet;
+    HC_T i10 = cof01*invDet, i11 = (m00*m22 - m02*m20)*invDet, i12 = (m02*m10 - m00*m12)*invDet;
+    HC_T i20 = cof02*invDet, i21 = (m01*m20 - m00*m21)*invDet, i22 = (m00*m11 - m01*m10)*invDet;
+
+    HC_T *d0 = dst, *d1 = dst + stride, *d2 = dst + 2 * stride, *d3 = dst + 3 * stride;
+    d0[0] = i00, d0[1] = i10, d0[2] = i20;
+    d1[0] = i01, d1[1] = i11, d1[2] = i21;
+    d2[0] = i02, d2[1] = i12, d2[2] = i22;
+    d3[0] = -(i00*tx + i01*ty + i02*tz);
+    d3[1] = -(i10*tx + i11*ty + i12*tz);
+    d3[2] = -(i20*tx + i21*ty + i22*tz);
+}
+
+/* Same as hc_affine_invert_columns() for rotation + translation only, the rotation is transposed */
+HCSAPI void
+HC_FN(hc_, rigid_invert_columns)(HC_T* dst, const HC_T* src, int_fast8_t stride)
+{
+    const HC_T *c0 = src, *c1 = src + stride, *c2 = src + 2 * stride, *c3 = src + 3 * stride;
+    HC_T m00 = c0[0], m10 = c0[1], m20 = c0[2];
+    HC_T m01 = c1[0], m11 = c1[1], m21 = c1[2];
+    HC_T m02 = c2[0], m12 = c2[1], m22 = c2[2];
+    HC_T tx = c3[0], ty = c3[1], tz = c3[2];
+
+    HC_T *d0 = dst, *d1 = dst + stride, *d2 = dst + 2 * stride, *d3 = dst + 3 * stride;
+    d0[0] = m00, d0[1] = m01, d0[2] = m02;
+    d1[0] = m10, d1[1] = m11, d1[2] = m12;
+    d2[0] = m20, d2[1] = m21, d2[2] = m22;
+    d3[0] = -(m00*tx + m10*ty + m20*tz);
+    d3[1] = -(m01*tx + m11*ty + m21*tz);
+    d3[2] = -(m02*tx + m12*ty + m22*tz);
+}
+
+/* Inverse of a matrix whose last row is (0, 0, 0, 1), about half the cost of hc_mat4_invert() */
+HCSAPI void
+HC_FN(hc_, mat4_invert_affine)(HC_MAT4_T dst, const HC_MAT4_T src)
+{
+    HC_FN(hc_, affine_invert_columns)(dst, src, 4);
+    dst[3] = dst[7] = dst[11] = HC_R(0.0);
+    dst[15] = HC_R(1.0);
+}
+
+/* Inverse of a rotation + translation matrix (no scaling), such as a view matrix */
+HCSAPI void
+HC_FN(hc_, mat4_invert_rigid)(HC_MAT4_T dst, const HC_MAT4_T src)
+{
+    HC_FN(hc_, rigid_invert_columns)(dst, src, 4);
+    dst[3] = dst[7] = dst[11] = HC_R(0.0);
+    dst[15] = HC_R(1.0);
+}
+
+HCSAPI void
+HC_FN(hc_, mat4_invert_affine_batch)(HC_MAT4_PTR_T dst, HC_MAT4_CPTR_T src, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        HC_FN(hc_, mat4_invert_affine)(dst + 16 * i, src + 16 * i);
+    }
+}
+
+HCSAPI void
+HC_FN(hc_, mat4_invert_rigid_batch)(HC_MAT4_PTR_T dst, HC_MAT4_CPTR_T src, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        HC_FN(hc_, mat4_invert_rigid)(dst + 16 * i, src + 16 * i);
+    }
+}
+
+HCSAPI HC_T
+HC_FN(hc_, mat4_trace)(const HC_MAT4_T mat)
 {
     return mat[0] + mat[5] + mat[10] + mat[15];
 }
 
 HCSAPI void
-hc_mat4_add(hc_mat4_t dst, const hc_mat4_t left, const hc_mat4_t right)
+HC_FN(hc_, mat4_add)(HC_MAT4_T dst, const HC_MAT4_T left, const HC_MAT4_T right)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -2203,7 +5700,7 @@ hc_mat4_add(hc_mat4_t dst, const hc_mat4_t left, const hc_mat4_t right)
 }
 
 HCSAPI void
-hc_mat4_add_r(hc_mat4_ptr_t HC_RESTRICT dst, const hc_mat4_t left, const hc_mat4_t right)
+HC_FN(hc_, mat4_add_r)(HC_MAT4_PTR_T HC_RESTRICT dst, const HC_MAT4_T left, const HC_MAT4_T right)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -2214,7 +5711,7 @@ hc_mat4_add_r(hc_mat4_ptr_t HC_RESTRICT dst, const hc_mat4_t left, const hc_mat4
 }
 
 HCSAPI void
-hc_mat4_sub(hc_mat4_t dst, const hc_mat4_t left, const hc_mat4_t right)
+HC_FN(hc_, mat4_sub)(HC_MAT4_T dst, const HC_MAT4_T left, const HC_MAT4_T right)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -2225,7 +5722,7 @@ hc_mat4_sub(hc_mat4_t dst, const hc_mat4_t left, const hc_mat4_t right)
 }
 
 HCSAPI void
-hc_mat4_sub_r(hc_mat4_ptr_t HC_RESTRICT dst, const hc_mat4_t left, const hc_mat4_t right)
+HC_FN(hc_, mat4_sub_r)(HC_MAT4_PTR_T HC_RESTRICT dst, const HC_MAT4_T left, const HC_MAT4_T right)
 {
 #   ifdef _OPENMP
 #       pragma omp simd
@@ -2235,42 +5732,207 @@ hc_mat4_sub_r(hc_mat4_ptr_t HC_RESTRICT dst, const hc_mat4_t left, const hc_mat4
     }
 }
 
-HCSAPI void
-hc_mat4_mul(hc_mat4_t dst, const hc_mat4_t left, const hc_mat4_t right)
+#endif // HC_MATH_TEMPLATE
+
+/*
+ * Register forms of the fast approximations, instantiated for each vector width
+ * (see "Fast approximations" above) when this header includes itself.
+ */
+
+#ifdef HC_MATH_FAST_TEMPLATE
+
+// Reduces 'x' to 'r' in [-pi/4, pi/4] such as x = r + q*pi/2, returns q
+HCSAPI HC_VI
+HC_VFN(reduce_pio2)(HC_VF x, HC_VF* r)
 {
-    hc_mat4_t result;
-#   ifdef _OPENMP
-#       pragma omp simd
-#   endif
-    for (int_fast8_t i = 0; i < 4; i++) {
-        for (int_fast8_t j = 0; j < 4; j++) {
-            float sum = 0.0;
-            for (int_fast8_t k = 0; k < 4; k++) {
-                sum += left[i * 4 + k] * right[k * 4 + j];
-            }
-            result[i * 4 + j] = sum;
-        }
-    }
-    for (int_fast8_t i = 0; i < 16; i++) {
-        dst[i] = result[i];
-    }
+    HC_VI q = HC_VCVTI(HC_VMUL(x, HC_VSET1(0.636619772f)));
+    HC_VF qf = HC_VCVTF(q);
+    HC_VF res = HC_VSUB(x, HC_VMUL(qf, HC_VSET1(HC_FAST_PIO2_1)));
+    res = HC_VSUB(res, HC_VMUL(qf, HC_VSET1(HC_FAST_PIO2_2)));
+    res = HC_VSUB(res, HC_VMUL(qf, HC_VSET1(HC_FAST_PIO2_3)));
+    *r = HC_VSUB(res, HC_VMUL(qf, HC_VSET1(HC_FAST_PIO2_4)));
+    return q;
+}
+
+HCSAPI HC_VF
+HC_VFN(sin_poly)(HC_VF r, HC_VF z)
+{
+    HC_VF p = HC_VMADD(z, HC_VSET1(-1.9515295891e-4f), HC_VSET1(8.3321608736e-3f));
+    p = HC_VMADD(p, z, HC_VSET1(-1.6666654611e-1f));
+    return HC_VMADD(HC_VMUL(r, z), p, r);
+}
+
+HCSAPI HC_VF
+HC_VFN(cos_poly)(HC_VF z)
+{
+    HC_VF p = HC_VMADD(z, HC_VSET1(2.443315711809948e-5f), HC_VSET1(-1.388731625493765e-3f));
+    p = HC_VMADD(p, z, HC_VSET1(4.166664568298827e-2f));
+    return HC_VMADD(HC_VMUL(z, z), p, HC_VSUB(HC_VSET1(1.0f), HC_VMUL(HC_VSET1(0.5f), z)));
 }
 
 HCSAPI void
-hc_mat4_mul_r(hc_mat4_ptr_t HC_RESTRICT dst, const hc_mat4_t left, const hc_mat4_t right)
+HC_VFN(sincos)(HC_VF x, HC_VF* s, HC_VF* c)
 {
-#   ifdef _OPENMP
-#       pragma omp simd
-#   endif
-    for (int_fast8_t i = 0; i < 4; i++) {
-        for (int_fast8_t j = 0; j < 4; j++) {
-            float sum = 0.0;
-            for (int_fast8_t k = 0; k < 4; k++) {
-                sum += left[i * 4 + k] * right[k * 4 + j];
-            }
-            dst[i * 4 + j] = sum;
-        }
-    }
+    HC_VF r;
+    HC_VI q = HC_VFN(reduce_pio2)(x, &r);
+    HC_VF z = HC_VMUL(r, r);
+    HC_VF ps = HC_VFN(sin_poly)(r, z);
+    HC_VF pc = HC_VFN(cos_poly)(z);
+
+    HC_VI one = HC_VISET1(1), two = HC_VISET1(2);
+    HC_VF swap = HC_VASF(HC_VICMPEQ(HC_VIAND(q, one), one));
+    HC_VF signs = HC_VASF(HC_VISLLI(HC_VIAND(q, two), 30));
+    HC_VF signc = HC_VASF(HC_VISLLI(HC_VIAND(HC_VIADD(q, one), two), 30));
+
+    *s = HC_VXOR(HC_VSEL(swap, pc, ps), signs);
+    *c = HC_VXOR(HC_VSEL(swap, ps, pc), signc);
 }
 
-#endif //HC_MATH_H
+HCSAPI HC_VF
+HC_VFN(sin)(HC_VF x)
+{
+    HC_VF r;
+    HC_VI q = HC_VFN(reduce_pio2)(x, &r);
+    HC_VF z = HC_VMUL(r, r);
+
+    HC_VI one = HC_VISET1(1);
+    HC_VF swap = HC_VASF(HC_VICMPEQ(HC_VIAND(q, one), one));
+    HC_VF y = HC_VSEL(swap, HC_VFN(cos_poly)(z), HC_VFN(sin_poly)(r, z));
+    return HC_VXOR(y, HC_VASF(HC_VISLLI(HC_VIAND(q, HC_VISET1(2)), 30)));
+}
+
+HCSAPI HC_VF
+HC_VFN(cos)(HC_VF x)
+{
+    HC_VF r;
+    HC_VI q = HC_VFN(reduce_pio2)(x, &r);
+    HC_VF z = HC_VMUL(r, r);
+
+    HC_VI one = HC_VISET1(1);
+    HC_VF swap = HC_VASF(HC_VICMPEQ(HC_VIAND(q, one), one));
+    HC_VF y = HC_VSEL(swap, HC_VFN(sin_poly)(r, z), HC_VFN(cos_poly)(z));
+    return HC_VXOR(y, HC_VASF(HC_VISLLI(HC_VIAND(HC_VIADD(q, one), HC_VISET1(2)), 30)));
+}
+
+HCSAPI HC_VF
+HC_VFN(tan)(HC_VF x)
+{
+    HC_VF r;
+    HC_VI q = HC_VFN(reduce_pio2)(x, &r);
+    HC_VF z = HC_VMUL(r, r);
+
+    HC_VF y = HC_VMADD(HC_VSET1(9.38540185543e-3f), z, HC_VSET1(3.11992232697e-3f));
+    y = HC_VMADD(y, z, HC_VSET1(2.44301354525e-2f));
+    y = HC_VMADD(y, z, HC_VSET1(5.34112807005e-2f));
+    y = HC_VMADD(y, z, HC_VSET1(1.33387994085e-1f));
+    y = HC_VMADD(y, z, HC_VSET1(3.33331568548e-1f));
+    y = HC_VMADD(HC_VMUL(y, z), r, r);
+
+    // tan(r + pi/2) = -1/tan(r)
+    HC_VI one = HC_VISET1(1);
+    HC_VF odd = HC_VASF(HC_VICMPEQ(HC_VIAND(q, one), one));
+    return HC_VSEL(odd, HC_VDIV(HC_VSET1(-1.0f), y), y);
+}
+
+HCSAPI HC_VF
+HC_VFN(atan2)(HC_VF y, HC_VF x)
+{
+    HC_VF sign = HC_VSET1(-0.0f);
+    HC_VF ax = HC_VANDNOT(sign, x), ay = HC_VANDNOT(sign, y);
+    HC_VF mx = HC_VMAX(ax, ay), mn = HC_VMIN(ax, ay);
+    HC_VF a = HC_VAND(HC_VCMPGT(mx, HC_VSET1(0.0f)), HC_VDIV(mn, mx));
+
+    // atan(a) for a in [0, 1], reduced to [-tan(pi/8), tan(pi/8)]
+    HC_VF one = HC_VSET1(1.0f);
+    HC_VF big = HC_VCMPGT(a, HC_VSET1(0.414213562f));
+    a = HC_VSEL(big, HC_VDIV(HC_VSUB(a, one), HC_VADD(a, one)), a);
+    HC_VF offset = HC_VAND(big, HC_VSET1(0.785398163f));
+
+    HC_VF z = HC_VMUL(a, a);
+    HC_VF p = HC_VMADD(HC_VSET1(8.05374449538e-2f), z, HC_VSET1(-1.38776856032e-1f));
+    p = HC_VMADD(p, z, HC_VSET1(1.99777106478e-1f));
+    p = HC_VMADD(p, z, HC_VSET1(-3.33329491539e-1f));
+    p = HC_VADD(HC_VMADD(HC_VMUL(p, z), a, a), offset);
+
+    // Back to the octant, then the quadrant
+    p = HC_VSEL(HC_VCMPGT(ay, ax), HC_VSUB(HC_VSET1(1.57079633f), p), p);
+    p = HC_VSEL(HC_VASF(HC_VISRAI(HC_VASI(x), 31)), HC_VSUB(HC_VSET1(3.14159265f), p), p);
+    p = HC_VOR(p, HC_VAND(sign, y));
+    return HC_VOR(p, HC_VCMPUNORD(x, y));
+}
+
+HCSAPI HC_VF
+HC_VFN(exp)(HC_VF x)
+{
+    HC_VF hi = HC_VSET1(88.7228394f), lo = HC_VSET1(-103.972084f);
+    HC_VF xc = HC_VMAX(HC_VMIN(x, hi), lo);
+
+    // exp(x) = 2^n * exp(r) with |r| <= ln(2)/2
+    HC_VI n = HC_VCVTI(HC_VMUL(xc, HC_VSET1(1.44269504f)));
+    HC_VF nf = HC_VCVTF(n);
+    HC_VF r = HC_VADD(HC_VSUB(xc, HC_VMUL(nf, HC_VSET1(0.693359375f))), HC_VMUL(nf, HC_VSET1(2.12194440e-4f)));
+
+    HC_VF p = HC_VMADD(HC_VSET1(1.9875691500e-4f), r, HC_VSET1(1.3981999507e-3f));
+    p = HC_VMADD(p, r, HC_VSET1(8.3334519073e-3f));
+    p = HC_VMADD(p, r, HC_VSET1(4.1665795894e-2f));
+    p = HC_VMADD(p, r, HC_VSET1(1.6666665459e-1f));
+    p = HC_VMADD(p, r, HC_VSET1(5.0000001201e-1f));
+    p = HC_VADD(HC_VMADD(HC_VMUL(p, r), r, r), HC_VSET1(1.0f));
+
+    // 2^n in two factors, so that both stay normal down to the subnormal results
+    HC_VI n1 = HC_VISRAI(n, 1), n2 = HC_VISUB(n, n1);
+    HC_VI bias = HC_VISET1(127);
+    p = HC_VMUL(p, HC_VASF(HC_VISLLI(HC_VIADD(n1, bias), 23)));
+    p = HC_VMUL(p, HC_VASF(HC_VISLLI(HC_VIADD(n2, bias), 23)));
+
+    p = HC_VSEL(HC_VCMPGT(x, hi), HC_VSET1(HUGE_VALF), p);
+    p = HC_VANDNOT(HC_VCMPLT(x, lo), p);
+    return HC_VOR(p, HC_VCMPUNORD(x, x));
+}
+
+HCSAPI HC_VF
+HC_VFN(log)(HC_VF x)
+{
+    // Subnormals scaled by 2^23
+    HC_VF sub = HC_VCMPLT(x, HC_VSET1(1.17549435e-38f));
+    HC_VI bits = HC_VASI(HC_VSEL(sub, HC_VMUL(x, HC_VSET1(8388608.0f)), x));
+    HC_VI e = HC_VIAND(HC_VASI(sub), HC_VISET1(-23));
+
+    // x = m * 2^e with m in [sqrt(1/2), sqrt(2)), f = m - 1
+    e = HC_VIADD(e, HC_VISUB(HC_VISRLI(bits, 23), HC_VISET1(126)));
+    HC_VF m = HC_VOR(HC_VAND(HC_VASF(bits), HC_VASF(HC_VISET1(0x007fffff))), HC_VASF(HC_VISET1(0x3f000000)));
+    HC_VF small = HC_VCMPLT(m, HC_VSET1(0.707106781f));
+    e = HC_VIADD(e, HC_VASI(small));
+    m = HC_VADD(m, HC_VAND(small, m));
+    HC_VF f = HC_VSUB(m, HC_VSET1(1.0f));
+    HC_VF z = HC_VMUL(f, f);
+
+    HC_VF y = HC_VMADD(HC_VSET1(7.0376836292e-2f), f, HC_VSET1(-1.1514610310e-1f));
+    y = HC_VMADD(y, f, HC_VSET1(1.1676998740e-1f));
+    y = HC_VMADD(y, f, HC_VSET1(-1.2420140846e-1f));
+    y = HC_VMADD(y, f, HC_VSET1(1.4249322787e-1f));
+    y = HC_VMADD(y, f, HC_VSET1(-1.6668057665e-1f));
+    y = HC_VMADD(y, f, HC_VSET1(2.0000714765e-1f));
+    y = HC_VMADD(y, f, HC_VSET1(-2.4999993993e-1f));
+    y = HC_VMADD(y, f, HC_VSET1(3.3333331174e-1f));
+    y = HC_VMUL(HC_VMUL(y, f), z);
+
+    HC_VF ef = HC_VCVTF(e);
+    y = HC_VMADD(HC_VSET1(-2.12194440e-4f), ef, y);
+    y = HC_VMADD(HC_VSET1(-0.5f), z, y);
+    HC_VF res = HC_VMADD(HC_VSET1(0.693359375f), ef, HC_VADD(f, y));
+
+    res = HC_VSEL(HC_VCMPEQ(x, HC_VSET1(HUGE_VALF)), x, res);
+    res = HC_VSEL(HC_VCMPEQ(x, HC_VSET1(0.0f)), HC_VSET1(-HUGE_VALF), res);
+    return HC_VOR(res, HC_VCMPNGE(x, HC_VSET1(0.0f)));
+}
+
+HCSAPI HC_VF
+HC_VFN(pow)(HC_VF x, HC_VF y)
+{
+    HC_VF one = HC_VSET1(1.0f);
+    HC_VF res = HC_VFN(exp)(HC_VMUL(y, HC_VFN(log)(x)));
+    return HC_VSEL(HC_VOR(HC_VCMPEQ(y, HC_VSET1(0.0f)), HC_VCMPEQ(x, one)), one, res);
+}
+
+#endif // HC_MATH_FAST_TEMPLATE
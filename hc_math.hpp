@@ -0,0 +1,727 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2024-2025 Le Juez Victor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * C++14 wrapper of hc_math.h: value types with the layout of the C types
+ * (hc::Vec3 is a hc_vec3_t, hc::Mat4 a hc_mat4_t, hc::Quat a hc_quat_t), so
+ * that arrays of one can be used as arrays of the other, with constexpr
+ * constructors and vector operators.
+ *
+ * The vector operators build expressions instead of vectors, evaluated in one
+ * pass by the assignment to a vector: 'a * s + b - c' is a single loop over the
+ * components, without temporaries. The same operators apply to spans (views
+ * over packed arrays of vectors), an assignment to a span evaluating the whole
+ * expression element by element in a single loop over the arrays:
+ *
+ *     hc::Span<hc::Vec3> pos(positions, count);
+ *     pos += hc::Span<const hc::Vec3>(velocities, count) * dt;
+ *
+ * Assigning to a span writes its elements (it doesn't rebind the view), and
+ * stops at the shortest span of the expression. The expressions being element
+ * wise, the destination may be one of the operands, but must not partially
+ * overlap them.
+ *
+ * NOTE: Expressions reference the vectors they use, keeping one in an 'auto'
+ *       variable beyond the statement is only safe if these vectors outlive it.
+ *
+ * Matrix and quaternion products, normalization and the batch functions over
+ * spans are computed by the C functions, with their SIMD paths.
+ */
+
+#ifndef HC_MATH_HPP
+#define HC_MATH_HPP
+
+#include "hc_math.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace hc {
+
+/* Expressions */
+
+// Base of the expressions of N-component vectors, evaluated with 'self()[i]'
+template <class E, std::size_t N>
+struct VecExpr {
+    constexpr const E& self() const { return static_cast<const E&>(*this); }
+};
+
+// Base of the expressions over spans, evaluated with 'self().at(i, c)'
+template <class E, std::size_t N>
+struct SpanExpr {
+    constexpr const E& self() const { return static_cast<const E&>(*this); }
+};
+
+template <std::size_t N>
+struct Vec;
+
+namespace detail {
+
+struct Add { static constexpr float apply(float a, float b) { return a + b; } };
+struct Sub { static constexpr float apply(float a, float b) { return a - b; } };
+struct Mul { static constexpr float apply(float a, float b) { return a * b; } };
+struct Div { static constexpr float apply(float a, float b) { return a / b; } };
+
+// Vectors are referenced by the expressions, the other nodes (and spans) copied
+template <class E> struct Operand { using type = E; };
+template <std::size_t N> struct Operand<Vec<N>> { using type = const Vec<N>&; };
+
+template <class... T> struct AllArithmetic : std::true_type { };
+template <class T, class... U> struct AllArithmetic<T, U...>
+    : std::integral_constant<bool, std::is_arithmetic<T>::value && AllArithmetic<U...>::value> { };
+
+// Scalar operand, in vector and span expressions
+struct Scalar {
+    float s;
+    constexpr float operator[](std::size_t) const { return s; }
+    constexpr float at(std::size_t, std::size_t) const { return s; }
+    constexpr std::size_t size() const { return SIZE_MAX; }
+};
+
+} // namespace detail
+
+template <class Op, class L, class R, std::size_t N>
+struct VecBinary : VecExpr<VecBinary<Op, L, R, N>, N> {
+    typename detail::Operand<L>::type l;
+    typename detail::Operand<R>::type r;
+
+    constexpr VecBinary(const L& l, const R& r) : l(l), r(r) { }
+    constexpr float operator[](std::size_t i) const { return Op::apply(l[i], r[i]); }
+};
+
+/* Types definitions */
+
+template <std::size_t N>
+struct Vec : VecExpr<Vec<N>, N> {
+    float v[N];
+
+    static constexpr std::size_t dimension = N;
+
+    constexpr Vec() : v{} { }
+
+    template <class... T, class = std::enable_if_t<sizeof...(T) == N && detail::AllArithmetic<T...>::value>>
+    constexpr Vec(T... c) : v{ static_cast<float>(c)... } { }
+
+    // Vector with one more component, as in Vec4(position, 1.0f)
+    template <std::size_t M, class = std::enable_if_t<M + 1 == N>>
+    constexpr Vec(const Vec<M>& a, float last) : v{}
+    {
+        for (std::size_t i = 0; i < M; i++) v[i] = a.v[i];
+        v[M] = last;
+    }
+
+    // From the C type (hc_vec2_t, hc_vec3_t or hc_vec4_t)
+    constexpr Vec(const float (&a)[N]) : v{}
+    {
+        for (std::size_t i = 0; i < N; i++) v[i] = a[i];
+    }
+
+    template <class E>
+    constexpr Vec(const VecExpr<E, N>& e) : v{}
+    {
+        for (std::size_t i = 0; i < N; i++) v[i] = e.self()[i];
+    }
+
+    template <class E>
+    constexpr Vec& operator=(const VecExpr<E, N>& e)
+    {
+        for (std::size_t i = 0; i < N; i++) v[i] = e.self()[i];
+        return *this;
+    }
+
+    template <class E>
+    constexpr Vec& operator+=(const VecExpr<E, N>& e)
+    {
+        for (std::size_t i = 0; i < N; i++) v[i] += e.self()[i];
+        return *this;
+    }
+
+    template <class E>
+    constexpr Vec& operator-=(const VecExpr<E, N>& e)
+    {
+        for (std::size_t i = 0; i < N; i++) v[i] -= e.self()[i];
+        return *this;
+    }
+
+    template <class E>
+    constexpr Vec& operator*=(const VecExpr<E, N>& e)
+    {
+        for (std::size_t i = 0; i < N; i++) v[i] *= e.self()[i];
+        return *this;
+    }
+
+    constexpr Vec& operator*=(float s)
+    {
+        for (std::size_t i = 0; i < N; i++) v[i] *= s;
+        return *this;
+    }
+
+    constexpr Vec& operator/=(float s)
+    {
+        for (std::size_t i = 0; i < N; i++) v[i] /= s;
+        return *this;
+    }
+
+    constexpr float& operator[](std::size_t i) { return v[i]; }
+    constexpr float operator[](std::size_t i) const { return v[i]; }
+
+    float* data() { return v; }
+    const float* data() const { return v; }
+
+    constexpr float& x() { return v[0]; }
+    constexpr float x() const { return v[0]; }
+    constexpr float& y() { return v[1]; }
+    constexpr float y() const { return v[1]; }
+
+    template <std::size_t M = N, class = std::enable_if_t<(M >= 3)>>
+    constexpr float& z() { return v[2]; }
+    template <std::size_t M = N, class = std::enable_if_t<(M >= 3)>>
+    constexpr float z() const { return v[2]; }
+
+    template <std::size_t M = N, class = std::enable_if_t<(M >= 4)>>
+    constexpr float& w() { return v[3]; }
+    template <std::size_t M = N, class = std::enable_if_t<(M >= 4)>>
+    constexpr float w() const { return v[3]; }
+};
+
+using Vec2 = Vec<2>;
+using Vec3 = Vec<3>;
+using Vec4 = Vec<4>;
+
+struct Mat4 {
+    float m[16];        // Column-major, as hc_mat4_t
+
+    constexpr Mat4() : m{} { }
+
+    constexpr Mat4(const float (&a)[16]) : m{}
+    {
+        for (std::size_t i = 0; i < 16; i++) m[i] = a[i];
+    }
+
+    static constexpr Mat4 identity()
+    {
+        Mat4 r;
+        for (std::size_t i = 0; i < 16; i++) r.m[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+        return r;
+    }
+
+    static constexpr Mat4 translate(float x, float y, float z)
+    {
+        Mat4 r = identity();
+        r.m[12] = x, r.m[13] = y, r.m[14] = z;
+        return r;
+    }
+
+    static constexpr Mat4 scale(float x, float y, float z)
+    {
+        Mat4 r = identity();
+        r.m[0] = x, r.m[5] = y, r.m[10] = z;
+        return r;
+    }
+
+    static Mat4 rotate(const Vec3& axis, float radians)
+    {
+        Mat4 r;
+        hc_mat4_rotate(r.m, axis.v, radians);
+        return r;
+    }
+
+    static Mat4 perspective(float fovy_rad, float aspect, float znear, float zfar)
+    {
+        Mat4 r;
+        hc_mat4_perspective(r.m, fovy_rad, aspect, znear, zfar);
+        return r;
+    }
+
+    static Mat4 ortho(float left, float right, float bottom, float top, float znear, float zfar)
+    {
+        Mat4 r;
+        hc_mat4_ortho(r.m, left, right, bottom, top, znear, zfar);
+        return r;
+    }
+
+    static Mat4 look_at(const Vec3& eye, const Vec3& target, const Vec3& up)
+    {
+        Mat4 r;
+        hc_look_at_mat4(r.m, eye.v, target.v, up.v);
+        return r;
+    }
+
+    constexpr float& operator[](std::size_t i) { return m[i]; }
+    constexpr float operator[](std::size_t i) const { return m[i]; }
+
+    constexpr float& operator()(std::size_t row, std::size_t col) { return m[4 * col + row]; }
+    constexpr float operator()(std::size_t row, std::size_t col) const { return m[4 * col + row]; }
+
+    float* data() { return m; }
+    const float* data() const { return m; }
+
+    constexpr Mat4 transposed() const
+    {
+        Mat4 r;
+        for (std::size_t i = 0; i < 4; i++) {
+            for (std::size_t j = 0; j < 4; j++) r.m[4 * i + j] = m[4 * j + i];
+        }
+        return r;
+    }
+
+    Mat4 inverted() const
+    {
+        Mat4 r;
+        hc_mat4_invert(r.m, m);
+        return r;
+    }
+};
+
+struct Quat {
+    float v[4];         // x, y, z, w, as hc_quat_t
+
+    constexpr Quat() : v{ 0.0f, 0.0f, 0.0f, 1.0f } { }     // Identity
+    constexpr Quat(float x, float y, float z, float w) : v{ x, y, z, w } { }
+
+    constexpr Quat(const float (&a)[4]) : v{ a[0], a[1], a[2], a[3] } { }
+
+    static Quat from_axis_angle(const Vec3& axis, float radians)
+    {
+        Quat r;
+        hc_quat_from_axis_angle(r.v, axis.v, radians);
+        return r;
+    }
+
+    static Quat from_euler(const Vec3& radians)
+    {
+        Quat r;
+        hc_quat_from_euler(r.v, radians.v);
+        return r;
+    }
+
+    static Quat from_mat4(const Mat4& mat)
+    {
+        Quat r;
+        hc_quat_from_mat4(r.v, mat.m);
+        return r;
+    }
+
+    Mat4 to_mat4() const
+    {
+        Mat4 r;
+        hc_quat_to_mat4(r.m, v);
+        return r;
+    }
+
+    constexpr Quat conjugate() const { return Quat(-v[0], -v[1], -v[2], v[3]); }
+
+    constexpr float& operator[](std::size_t i) { return v[i]; }
+    constexpr float operator[](std::size_t i) const { return v[i]; }
+
+    float* data() { return v; }
+    const float* data() const { return v; }
+
+    constexpr float& x() { return v[0]; }
+    constexpr float x() const { return v[0]; }
+    constexpr float& y() { return v[1]; }
+    constexpr float y() const { return v[1]; }
+    constexpr float& z() { return v[2]; }
+    constexpr float z() const { return v[2]; }
+    constexpr float& w() { return v[3]; }
+    constexpr float w() const { return v[3]; }
+};
+
+static_assert(sizeof(Vec2) == sizeof(hc_vec2_t) && std::is_standard_layout<Vec2>::value, "Vec2 must have the layout of hc_vec2_t");
+static_assert(sizeof(Vec3) == sizeof(hc_vec3_t) && std::is_standard_layout<Vec3>::value, "Vec3 must have the layout of hc_vec3_t");
+static_assert(sizeof(Vec4) == sizeof(hc_vec4_t) && std::is_standard_layout<Vec4>::value, "Vec4 must have the layout of hc_vec4_t");
+static_assert(sizeof(Mat4) == sizeof(hc_mat4_t) && std::is_standard_layout<Mat4>::value, "Mat4 must have the layout of hc_mat4_t");
+static_assert(sizeof(Quat) == sizeof(hc_quat_t) && std::is_standard_layout<Quat>::value, "Quat must have the layout of hc_quat_t");
+
+/* Spans */
+
+namespace detail {
+
+// Vector repeated for each element of a span expression
+template <std::size_t N>
+struct SpanVec {
+    Vec<N> vec;
+    constexpr float at(std::size_t, std::size_t c) const { return vec.v[c]; }
+    constexpr std::size_t size() const { return SIZE_MAX; }
+};
+
+} // namespace detail
+
+// View over 'size()' packed vectors, V being Vec2, Vec3, Vec4 or one of them const
+template <class V>
+class Span : public SpanExpr<Span<V>, std::remove_const_t<V>::dimension> {
+public:
+    static constexpr std::size_t N = std::remove_const_t<V>::dimension;
+    using CType = std::conditional_t<std::is_const<V>::value, const float, float>[N];
+
+    constexpr Span() : ptr(nullptr), count(0) { }
+    constexpr Span(V* data, std::size_t size) : ptr(data), count(size) { }
+
+    // From an array of the C type (hc_vec3_t* for a Span<Vec3>)
+    Span(CType* data, std::size_t size) : ptr(reinterpret_cast<V*>(data)), count(size) { }
+
+    template <std::size_t M>
+    constexpr Span(V (&a)[M]) : ptr(a), count(M) { }
+
+    // From a contiguous container such as std::vector<Vec3> or std::array<Vec3, M>
+    template <class C, class = std::enable_if_t<std::is_convertible<decltype(std::declval<C&>().data()), V*>::value>>
+    constexpr Span(C& c) : ptr(c.data()), count(c.size()) { }
+
+    // Span<const Vec3> from Span<Vec3>
+    template <class U, class = std::enable_if_t<std::is_convertible<U*, V*>::value>>
+    constexpr Span(const Span<U>& s) : ptr(s.data()), count(s.size()) { }
+
+    constexpr Span(const Span&) = default;
+
+    Span& operator=(const Span& s) { assign(s); return *this; }
+
+    template <class E>
+    Span& operator=(const SpanExpr<E, N>& e) { assign(e.self()); return *this; }
+
+    // Fills the span with one vector
+    template <class E>
+    Span& operator=(const VecExpr<E, N>& e) { assign(detail::SpanVec<N>{ Vec<N>(e) }); return *this; }
+
+    template <class E>
+    Span& operator+=(const SpanExpr<E, N>& e) { return *this = *this + e; }
+    template <class E>
+    Span& operator+=(const VecExpr<E, N>& e) { return *this = *this + e; }
+    template <class E>
+    Span& operator-=(const SpanExpr<E, N>& e) { return *this = *this - e; }
+    template <class E>
+    Span& operator-=(const VecExpr<E, N>& e) { return *this = *this - e; }
+    template <class E>
+    Span& operator*=(const SpanExpr<E, N>& e) { return *this = *this * e; }
+    Span& operator*=(float s) { return *this = *this * s; }
+    Span& operator/=(float s) { return *this = *this / s; }
+
+    constexpr V* data() const { return ptr; }
+    constexpr std::size_t size() const { return count; }
+    constexpr bool empty() const { return count == 0; }
+
+    constexpr V* begin() const { return ptr; }
+    constexpr V* end() const { return ptr + count; }
+
+    constexpr V& operator[](std::size_t i) const { return ptr[i]; }
+    constexpr float at(std::size_t i, std::size_t c) const { return ptr[i].v[c]; }
+
+    constexpr Span subspan(std::size_t offset, std::size_t size) const { return Span(ptr + offset, size); }
+
+    // Components of the first vector, for the C functions (valid even if the span is empty)
+    constexpr std::conditional_t<std::is_const<V>::value, const float*, float*> components() const
+    {
+        return reinterpret_cast<std::conditional_t<std::is_const<V>::value, const float*, float*>>(ptr);
+    }
+
+private:
+    template <class E>
+    void assign(const E& e)
+    {
+        std::size_t n = (e.size() < count) ? e.size() : count;
+        for (std::size_t i = 0; i < n; i++) {
+            /* Fully unrolled so that GCC vectorizes the interleaved components at -O2 */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC unroll 4
+#endif
+            for (std::size_t c = 0; c < N; c++) ptr[i].v[c] = e.at(i, c);
+        }
+    }
+
+    V* ptr;
+    std::size_t count;
+};
+
+template <class Op, class L, class R, std::size_t N>
+struct SpanBinary : SpanExpr<SpanBinary<Op, L, R, N>, N> {
+    L l;
+    R r;
+
+    constexpr SpanBinary(const L& l, const R& r) : l(l), r(r) { }
+    constexpr float at(std::size_t i, std::size_t c) const { return Op::apply(l.at(i, c), r.at(i, c)); }
+    constexpr std::size_t size() const { return (l.size() < r.size()) ? l.size() : r.size(); }
+};
+
+/* Operators */
+
+// Element wise operators between vector or span expressions; vectors are repeated
+// over the elements of spans, and scalars over the components of both
+#define HC_MATH_BINARY_OP(op, Op)                                                       \
+    template <class L, class R, std::size_t N>                                          \
+    constexpr auto operator op(const VecExpr<L, N>& l, const VecExpr<R, N>& r)          \
+    {                                                                                   \
+        return VecBinary<detail::Op, L, R, N>(l.self(), r.self());                      \
+    }                                                                                   \
+    template <class L, std::size_t N>                                                   \
+    constexpr auto operator op(const VecExpr<L, N>& l, float r)                         \
+    {                                                                                   \
+        return VecBinary<detail::Op, L, detail::Scalar, N>(l.self(), detail::Scalar{ r }); \
+    }                                                                                   \
+    template <class R, std::size_t N>                                                   \
+    constexpr auto operator op(float l, const VecExpr<R, N>& r)                         \
+    {                                                                                   \
+        return VecBinary<detail::Op, detail::Scalar, R, N>(detail::Scalar{ l }, r.self()); \
+    }                                                                                   \
+    template <class L, class R, std::size_t N>                                          \
+    constexpr auto operator op(const SpanExpr<L, N>& l, const SpanExpr<R, N>& r)        \
+    {                                                                                   \
+        return SpanBinary<detail::Op, L, R, N>(l.self(), r.self());                     \
+    }                                                                                   \
+    template <class L, class R, std::size_t N>                                          \
+    constexpr auto operator op(const SpanExpr<L, N>& l, const VecExpr<R, N>& r)         \
+    {                                                                                   \
+        return SpanBinary<detail::Op, L, detail::SpanVec<N>, N>(l.self(), detail::SpanVec<N>{ Vec<N>(r) }); \
+    }                                                                                   \
+    template <class L, class R, std::size_t N>                                          \
+    constexpr auto operator op(const VecExpr<L, N>& l, const SpanExpr<R, N>& r)         \
+    {                                                                                   \
+        return SpanBinary<detail::Op, detail::SpanVec<N>, R, N>(detail::SpanVec<N>{ Vec<N>(l) }, r.self()); \
+    }                                                                                   \
+    template <class L, std::size_t N>                                                   \
+    constexpr auto operator op(const SpanExpr<L, N>& l, float r)                        \
+    {                                                                                   \
+        return SpanBinary<detail::Op, L, detail::Scalar, N>(l.self(), detail::Scalar{ r }); \
+    }                                                                                   \
+    template <class R, std::size_t N>                                                   \
+    constexpr auto operator op(float l, const SpanExpr<R, N>& r)                        \
+    {                                                                                   \
+        return SpanBinary<detail::Op, detail::Scalar, R, N>(detail::Scalar{ l }, r.self()); \
+    }
+
+HC_MATH_BINARY_OP(+, Add)
+HC_MATH_BINARY_OP(-, Sub)
+HC_MATH_BINARY_OP(*, Mul)
+HC_MATH_BINARY_OP(/, Div)
+
+#undef HC_MATH_BINARY_OP
+
+template <class E, std::size_t N>
+constexpr auto operator-(const VecExpr<E, N>& e) { return e * -1.0f; }
+
+template <class E, std::size_t N>
+constexpr auto operator-(const SpanExpr<E, N>& e) { return e * -1.0f; }
+
+template <class A, class B, std::size_t N>
+constexpr bool operator==(const VecExpr<A, N>& a, const VecExpr<B, N>& b)
+{
+    for (std::size_t i = 0; i < N; i++) {
+        if (a.self()[i] != b.self()[i]) return false;
+    }
+    return true;
+}
+
+template <class A, class B, std::size_t N>
+constexpr bool operator!=(const VecExpr<A, N>& a, const VecExpr<B, N>& b) { return !(a == b); }
+
+constexpr bool operator==(const Mat4& a, const Mat4& b)
+{
+    for (std::size_t i = 0; i < 16; i++) {
+        if (a.m[i] != b.m[i]) return false;
+    }
+    return true;
+}
+
+constexpr bool operator!=(const Mat4& a, const Mat4& b) { return !(a == b); }
+
+/* Product in the mathematical order: 'a * b' applies 'b' then 'a' (hc_mat4_mul(dst, b, a)) */
+inline Mat4 operator*(const Mat4& a, const Mat4& b)
+{
+    Mat4 r;
+    hc_mat4_mul(r.m, b.m, a.m);
+    return r;
+}
+
+inline Vec4 operator*(const Mat4& mat, const Vec4& v)
+{
+    Vec4 r;
+    hc_vec4_transform(r.v, v.v, mat.m);
+    return r;
+}
+
+/* Hamilton product, 'a * b' rotates by 'b' then by 'a' */
+inline Quat operator*(const Quat& a, const Quat& b)
+{
+    Quat r;
+    hc_quat_mul(r.v, a.v, b.v);
+    return r;
+}
+
+inline Vec3 operator*(const Quat& q, const Vec3& v)
+{
+    Vec3 r;
+    hc_vec3_rotate(r.v, v.v, q.v);
+    return r;
+}
+
+/* Vector functions */
+
+template <class A, class B, std::size_t N>
+constexpr float dot(const VecExpr<A, N>& a, const VecExpr<B, N>& b)
+{
+    float r = 0.0f;
+    for (std::size_t i = 0; i < N; i++) r += a.self()[i] * b.self()[i];
+    return r;
+}
+
+template <class A, class B>
+constexpr Vec3 cross(const VecExpr<A, 3>& a, const VecExpr<B, 3>& b)
+{
+    const Vec3 u(a), v(b);
+    return Vec3(u.v[1] * v.v[2] - u.v[2] * v.v[1],
+                u.v[2] * v.v[0] - u.v[0] * v.v[2],
+                u.v[0] * v.v[1] - u.v[1] * v.v[0]);
+}
+
+template <class E, std::size_t N>
+constexpr float length_sq(const VecExpr<E, N>& e)
+{
+    const Vec<N> v(e);
+    return dot(v, v);
+}
+
+template <class E, std::size_t N>
+inline float length(const VecExpr<E, N>& e)
+{
+    return sqrtf(length_sq(e));
+}
+
+template <class A, class B, std::size_t N>
+inline float distance(const VecExpr<A, N>& a, const VecExpr<B, N>& b)
+{
+    return length(a - b);
+}
+
+/* Zero vectors stay zero, the precision is HC_RSQRT_PRECISION */
+template <class E, std::size_t N>
+inline Vec<N> normalize(const VecExpr<E, N>& e)
+{
+    Vec<N> v(e);
+    float sq = dot(v, v);
+    if (sq > 0.0f) v *= hc_rsqrtf(sq);
+    return v;
+}
+
+template <class A, class B, std::size_t N>
+constexpr auto lerp(const VecExpr<A, N>& a, const VecExpr<B, N>& b, float t)
+{
+    return a + (b - a) * t;
+}
+
+inline Vec3 transform_point(const Mat4& mat, const Vec3& v)
+{
+    Vec3 r;
+    hc_vec3_transform(r.v, v.v, mat.m);
+    return r;
+}
+
+inline Vec3 transform_direction(const Mat4& mat, const Vec3& v)
+{
+    Vec3 r;
+    hc_vec3_transform_wt(r.v, v.v, 0.0f, mat.m);
+    return r;
+}
+
+/* Quaternion functions */
+
+constexpr float dot(const Quat& a, const Quat& b)
+{
+    return a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2] + a.v[3] * b.v[3];
+}
+
+inline Quat normalize(const Quat& q)
+{
+    Quat r;
+    hc_quat_normalize(r.v, q.v);
+    return r;
+}
+
+inline Quat nlerp(const Quat& a, const Quat& b, float t)
+{
+    Quat r;
+    hc_quat_nlerp(r.v, a.v, b.v, t);
+    return r;
+}
+
+inline Quat slerp(const Quat& a, const Quat& b, float t)
+{
+    Quat r;
+    hc_quat_slerp(r.v, a.v, b.v, t);
+    return r;
+}
+
+/* Batch functions over spans (the C batch functions, with their SIMD kernels), up to the shortest span */
+
+namespace detail {
+
+template <class A, class B>
+constexpr std::size_t min_size(const A& a, const B& b) { return (a.size() < b.size()) ? a.size() : b.size(); }
+
+} // namespace detail
+
+inline void normalize(Span<Vec2> dst, Span<const Vec2> src)
+{
+    hc_vec2_normalize_batch(dst.components(), src.components(), detail::min_size(dst, src), 0);
+}
+
+inline void normalize(Span<Vec3> dst, Span<const Vec3> src)
+{
+    hc_vec3_normalize_batch(dst.components(), src.components(), detail::min_size(dst, src), 0);
+}
+
+inline void normalize(Span<Vec4> dst, Span<const Vec4> src)
+{
+    hc_vec4_normalize_batch(dst.components(), src.components(), detail::min_size(dst, src), 0);
+}
+
+/* dst[i] = distance(a[i], b[i]), 'dst' having at least the size of the shortest span */
+inline void distance(float* dst, Span<const Vec2> a, Span<const Vec2> b)
+{
+    hc_vec2_distance_batch(dst, a.components(), b.components(), detail::min_size(a, b), 0);
+}
+
+inline void distance(float* dst, Span<const Vec3> a, Span<const Vec3> b)
+{
+    hc_vec3_distance_batch(dst, a.components(), b.components(), detail::min_size(a, b), 0);
+}
+
+/* Same as transform_point() for each vector (hc_vec*_transform_batch), 'dst' may be 'src' */
+inline void transform(Span<Vec2> dst, Span<const Vec2> src, const Mat4& mat)
+{
+    hc_vec2_transform_batch(dst.components(), src.components(), detail::min_size(dst, src), 0, mat.m);
+}
+
+inline void transform(Span<Vec3> dst, Span<const Vec3> src, const Mat4& mat)
+{
+    hc_vec3_transform_batch(dst.components(), src.components(), detail::min_size(dst, src), 0, mat.m);
+}
+
+inline void transform(Span<Vec4> dst, Span<const Vec4> src, const Mat4& mat)
+{
+    hc_vec4_transform_batch(dst.components(), src.components(), detail::min_size(dst, src), 0, mat.m);
+}
+
+} // namespace hc
+
+#endif // HC_MATH_HPP
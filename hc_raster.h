@@ -0,0 +1,441 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2024-2025 Le Juez Victor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Triangle rasterization into spans of 8 pixels, for software renderers.
+ *
+ * Vertices are snapped to 1/16 of a pixel and the triangle is walked in 8x8
+ * tiles: a tile outside one of the edges is skipped, a tile inside all of
+ * them is covered without testing its pixels, and the others evaluate the
+ * edges incrementally on 8 pixels at once. Edges use exact integer arithmetic
+ * and the top-left fill rule, so triangles sharing an edge cover each pixel
+ * along it exactly once.
+ *
+ * Each row of a tile with covered pixels is passed to a callback as a span:
+ * a coverage mask, the depth and the attributes of its 8 pixels (stored
+ * attribute after attribute, for SIMD shading). Attributes are interpolated
+ * with perspective correction, either smoothly or taken from the vertex of
+ * greatest weight, as hc_vec*_barysmooth and hc_vec*_baryflat of hc_math.h
+ * do for a single pixel; the depth is interpolated linearly in screen space.
+ *
+ * NOTE: Triangles must be clipped against the near plane (w > 0) and lie within
+ * the guard band, (-HC_RASTER_GUARD_BAND, HC_RASTER_GUARD_BAND) pixels on both
+ * axes. Nothing is shared between calls, so several threads can rasterize at
+ * once, for instance each into its own scissor rectangle.
+ */
+
+#ifndef HC_RASTER_H
+#define HC_RASTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+/* Macros and defintions */
+
+#ifndef HC_RASTER_MAX_ATTRIBS
+#   define HC_RASTER_MAX_ATTRIBS 16         // Interpolated floats per vertex at most
+#endif
+
+#define HC_RASTER_SUBPIXEL_BITS 4           // Vertices are snapped to 1/16 of a pixel
+#define HC_RASTER_GUARD_BAND 16384          // Vertex coordinates must stay below, in pixels
+
+/* SIMD support (define HC_RASTER_NO_SIMD to only use the scalar paths) */
+
+#ifndef HC_RASTER_NO_SIMD
+#   if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#       define HC_RASTER_AVX2
+#       include <immintrin.h>
+#   elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define HC_RASTER_SSE2
+#       include <immintrin.h>
+#   endif
+#endif // HC_RASTER_NO_SIMD
+
+/* Types definitions */
+
+enum hc_retcode_raster {
+    HC_RASTER_ERROR_INVALID         = -1,
+    HC_RASTER_SUCCESS               = 0
+};
+
+typedef enum {
+    HC_RASTER_SMOOTH,       // Attributes blended with the barycentric weights
+    HC_RASTER_FLAT          // Attributes of the vertex of greatest weight (the first one on ties)
+} hc_raster_interp_t;
+
+typedef struct {
+    float x, y;             // Window position in pixels, pixel centers being at +0.5
+    float z;                // Depth, interpolated linearly in screen space
+    float w;                // Clip space w (1 with an orthographic projection), for perspective correction
+    const float* attribs;   // 'attrib_count' floats (may be NULL without attributes)
+} hc_raster_vertex_t;
+
+typedef struct {
+    int x, y;                                   // Pixel of the first lane, 'x' being a multiple of 8
+    uint32_t mask;                              // Covered pixels, bit 'i' for the pixel (x + i, y)
+    float depth[8];
+    float attribs[HC_RASTER_MAX_ATTRIBS][8];    // Attribute 'a' of the pixel (x + i, y) in attribs[a][i]
+} hc_raster_span_t;
+
+typedef void (*hc_raster_span_fn)(const hc_raster_span_t* span, void* user);
+
+typedef struct {
+    int min_x, min_y;               // Scissor rectangle in pixels, the max being excluded
+    int max_x, max_y;
+    int attrib_count;               // Attributes per vertex, up to HC_RASTER_MAX_ATTRIBS
+    hc_raster_interp_t interp;
+    hc_raster_span_fn span;         // Called for each span with at least one covered pixel
+    void* user;                     // Passed to 'span'
+} hc_raster_state_t;
+
+/* Function declarations */
+
+int hc_raster_triangle(const hc_raster_state_t* state, const hc_raster_vertex_t* v1, const hc_raster_vertex_t* v2, const hc_raster_vertex_t* v3);
+
+#endif // HC_RASTER_H
+
+#ifdef HC_RASTER_IMPL
+
+/* Private definitions */
+
+#define HC_RASTER_SUBPIXEL (1 << HC_RASTER_SUBPIXEL_BITS)
+#define HC_RASTER_TILE 8
+
+typedef struct {
+    int64_t a, b, c;        // E(x, y) = a*x + b*y + c in subpixels, positive inside
+    int64_t bias;           // 1 for the edges neither top nor left, whose pixels belong to the neighbor
+} hc_raster_edge_t;
+
+typedef struct {
+    float l2, l3;           // Weights of the second and third vertices at the first lane
+    float dl2, dl3;         // Their steps from one lane to the next
+    float z1, dz2, dz3;     // Depth of the first vertex, differences with the others
+    float q1, q2, q3;       // 1/w of the vertices
+    float a1[HC_RASTER_MAX_ATTRIBS];
+    float a2[HC_RASTER_MAX_ATTRIBS];    // Differences with 'a1' when smooth
+    float a3[HC_RASTER_MAX_ATTRIBS];
+    int attrib_count;
+    bool flat;
+} hc_raster_setup_t;
+
+/*
+ * Coverage of 8 pixels: 'e' holds the biased edge values at the first one and
+ * 'dx' their steps (per edge, in lanes). Only the edges of 'partial' are tested.
+ */
+static inline uint32_t hc_raster_coverage(const int32_t e[3], int32_t dx[3][8], int partial)
+{
+#if defined(HC_RASTER_AVX2)
+    __m256i negative = _mm256_setzero_si256();
+    for (int k = 0; k < 3; k++) {
+        if (!(partial & (1 << k))) continue;
+        __m256i v = _mm256_add_epi32(_mm256_set1_epi32(e[k]), _mm256_loadu_si256((const __m256i*)dx[k]));
+        negative = _mm256_or_si256(negative, v);
+    }
+    return ~(uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(negative)) & 0xFF;
+#elif defined(HC_RASTER_SSE2)
+    __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+    for (int k = 0; k < 3; k++) {
+        if (!(partial & (1 << k))) continue;
+        __m128i ek = _mm_set1_epi32(e[k]);
+        lo = _mm_or_si128(lo, _mm_add_epi32(ek, _mm_loadu_si128((const __m128i*)dx[k])));
+        hi = _mm_or_si128(hi, _mm_add_epi32(ek, _mm_loadu_si128((const __m128i*)(dx[k] + 4))));
+    }
+    uint32_t negative = (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(lo))
+                      | (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(hi)) << 4;
+    return ~negative & 0xFF;
+#else
+    uint32_t mask = 0xFF;
+    for (int k = 0; k < 3; k++) {
+        if (!(partial & (1 << k))) continue;
+        for (int i = 0; i < 8; i++) {
+            if (e[k] + dx[k][i] < 0) mask &= ~(1u << i);
+        }
+    }
+    return mask;
+#endif
+}
+
+#if defined(HC_RASTER_SSE2)
+
+/* Interpolates 4 lanes of a span, from 'lane' */
+static inline void hc_raster_interpolate4(const hc_raster_setup_t* s, hc_raster_span_t* span, int lane)
+{
+    const __m128 index = _mm_add_ps(_mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f), _mm_set1_ps((float)lane));
+
+    __m128 l2 = _mm_add_ps(_mm_set1_ps(s->l2), _mm_mul_ps(index, _mm_set1_ps(s->dl2)));
+    __m128 l3 = _mm_add_ps(_mm_set1_ps(s->l3), _mm_mul_ps(index, _mm_set1_ps(s->dl3)));
+    __m128 l1 = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.0f), l2), l3);
+
+    __m128 z = _mm_add_ps(_mm_set1_ps(s->z1), _mm_add_ps(_mm_mul_ps(l2, _mm_set1_ps(s->dz2)), _mm_mul_ps(l3, _mm_set1_ps(s->dz3))));
+    _mm_storeu_ps(span->depth + lane, z);
+
+    __m128 u1 = _mm_mul_ps(l1, _mm_set1_ps(s->q1));
+    __m128 u2 = _mm_mul_ps(l2, _mm_set1_ps(s->q2));
+    __m128 u3 = _mm_mul_ps(l3, _mm_set1_ps(s->q3));
+
+    if (s->flat) {
+        __m128 sel1 = _mm_and_ps(_mm_cmpge_ps(u1, u2), _mm_cmpge_ps(u1, u3));
+        __m128 sel2 = _mm_andnot_ps(sel1, _mm_cmpge_ps(u2, u3));
+        __m128 sel3 = _mm_andnot_ps(_mm_or_ps(sel1, sel2), _mm_castsi128_ps(_mm_set1_epi32(-1)));
+        for (int i = 0; i < s->attrib_count; i++) {
+            __m128 a = _mm_or_ps(_mm_or_ps(_mm_and_ps(sel1, _mm_set1_ps(s->a1[i])),
+                _mm_and_ps(sel2, _mm_set1_ps(s->a2[i]))), _mm_and_ps(sel3, _mm_set1_ps(s->a3[i])));
+            _mm_storeu_ps(span->attribs[i] + lane, a);
+        }
+    } else {
+        __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), _mm_add_ps(_mm_add_ps(u1, u2), u3));
+        __m128 p2 = _mm_mul_ps(u2, inv), p3 = _mm_mul_ps(u3, inv);
+        for (int i = 0; i < s->attrib_count; i++) {
+            __m128 a = _mm_add_ps(_mm_set1_ps(s->a1[i]), _mm_add_ps(_mm_mul_ps(p2, _mm_set1_ps(s->a2[i])), _mm_mul_ps(p3, _mm_set1_ps(s->a3[i]))));
+            _mm_storeu_ps(span->attribs[i] + lane, a);
+        }
+    }
+}
+
+#endif // HC_RASTER_SSE2
+
+/* Depth and attributes of the 8 lanes of a span */
+static inline void hc_raster_interpolate(const hc_raster_setup_t* s, hc_raster_span_t* span)
+{
+#if defined(HC_RASTER_AVX2)
+    const __m256 index = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+    __m256 l2 = _mm256_fmadd_ps(index, _mm256_set1_ps(s->dl2), _mm256_set1_ps(s->l2));
+    __m256 l3 = _mm256_fmadd_ps(index, _mm256_set1_ps(s->dl3), _mm256_set1_ps(s->l3));
+    __m256 l1 = _mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), l2), l3);
+
+    __m256 z = _mm256_fmadd_ps(l3, _mm256_set1_ps(s->dz3), _mm256_fmadd_ps(l2, _mm256_set1_ps(s->dz2), _mm256_set1_ps(s->z1)));
+    _mm256_storeu_ps(span->depth, z);
+
+    __m256 u1 = _mm256_mul_ps(l1, _mm256_set1_ps(s->q1));
+    __m256 u2 = _mm256_mul_ps(l2, _mm256_set1_ps(s->q2));
+    __m256 u3 = _mm256_mul_ps(l3, _mm256_set1_ps(s->q3));
+
+    if (s->flat) {
+        __m256 sel1 = _mm256_and_ps(_mm256_cmp_ps(u1, u2, _CMP_GE_OQ), _mm256_cmp_ps(u1, u3, _CMP_GE_OQ));
+        __m256 sel2 = _mm256_cmp_ps(u2, u3, _CMP_GE_OQ);
+        for (int i = 0; i < s->attrib_count; i++) {
+            __m256 a = _mm256_blendv_ps(_mm256_set1_ps(s->a3[i]), _mm256_set1_ps(s->a2[i]), sel2);
+            _mm256_storeu_ps(span->attribs[i], _mm256_blendv_ps(a, _mm256_set1_ps(s->a1[i]), sel1));
+        }
+    } else {
+        __m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_add_ps(_mm256_add_ps(u1, u2), u3));
+        __m256 p2 = _mm256_mul_ps(u2, inv), p3 = _mm256_mul_ps(u3, inv);
+        for (int i = 0; i < s->attrib_count; i++) {
+            __m256 a = _mm256_fmadd_ps(p3, _mm256_set1_ps(s->a3[i]), _mm256_fmadd_ps(p2, _mm256_set1_ps(s->a2[i]), _mm256_set1_ps(s->a1[i])));
+            _mm256_storeu_ps(span->attribs[i], a);
+        }
+    }
+#elif defined(HC_RASTER_SSE2)
+    hc_raster_interpolate4(s, span, 0);
+    hc_raster_interpolate4(s, span, 4);
+#else
+    for (int lane = 0; lane < 8; lane++) {
+        float l2 = s->l2 + lane * s->dl2;
+        float l3 = s->l3 + lane * s->dl3;
+        float l1 = 1.0f - l2 - l3;
+
+        span->depth[lane] = s->z1 + l2 * s->dz2 + l3 * s->dz3;
+
+        float u1 = l1 * s->q1, u2 = l2 * s->q2, u3 = l3 * s->q3;
+
+        if (s->flat) {
+            const float* a = (u1 >= u2 && u1 >= u3) ? s->a1 : (u2 >= u3) ? s->a2 : s->a3;
+            for (int i = 0; i < s->attrib_count; i++) {
+                span->attribs[i][lane] = a[i];
+            }
+        } else {
+            float inv = 1.0f / (u1 + u2 + u3);
+            float p2 = u2 * inv, p3 = u3 * inv;
+            for (int i = 0; i < s->attrib_count; i++) {
+                span->attribs[i][lane] = s->a1[i] + p2 * s->a2[i] + p3 * s->a3[i];
+            }
+        }
+    }
+#endif
+}
+
+static inline bool hc_raster_vertex_valid(const hc_raster_vertex_t* v, int attrib_count)
+{
+    // The negated comparisons also reject NaN
+    if (!(fabsf(v->x) < HC_RASTER_GUARD_BAND) || !(fabsf(v->y) < HC_RASTER_GUARD_BAND)) return false;
+    if (!(v->w > 0.0f) || !isfinite(v->z)) return false;
+    return attrib_count == 0 || v->attribs != NULL;
+}
+
+/* Public functions */
+
+int hc_raster_triangle(const hc_raster_state_t* state, const hc_raster_vertex_t* v1, const hc_raster_vertex_t* v2, const hc_raster_vertex_t* v3)
+{
+    if (!state || !state->span || !v1 || !v2 || !v3) return HC_RASTER_ERROR_INVALID;
+    if (state->attrib_count < 0 || state->attrib_count > HC_RASTER_MAX_ATTRIBS) return HC_RASTER_ERROR_INVALID;
+    if (state->min_x < 0 || state->min_y < 0 || state->max_x > HC_RASTER_GUARD_BAND || state->max_y > HC_RASTER_GUARD_BAND) {
+        return HC_RASTER_ERROR_INVALID;
+    }
+
+    const hc_raster_vertex_t* v[3] = { v1, v2, v3 };
+    int32_t x[3], y[3];
+
+    for (int k = 0; k < 3; k++) {
+        if (!hc_raster_vertex_valid(v[k], state->attrib_count)) return HC_RASTER_ERROR_INVALID;
+        x[k] = (int32_t)floorf(v[k]->x * HC_RASTER_SUBPIXEL + 0.5f);
+        y[k] = (int32_t)floorf(v[k]->y * HC_RASTER_SUBPIXEL + 0.5f);
+    }
+
+    // Twice the signed area, its sign gives the winding (both are drawn)
+    int64_t area = (int64_t)(x[1] - x[0]) * (y[2] - y[0]) - (int64_t)(y[1] - y[0]) * (x[2] - x[0]);
+    if (area == 0) return HC_RASTER_SUCCESS;
+    int64_t sign = (area > 0) ? 1 : -1;
+    area *= sign;
+
+    // Edge 'k' is opposite to the vertex 'k', its value divided by the area is the weight of that vertex
+    hc_raster_edge_t edge[3];
+    for (int k = 0; k < 3; k++) {
+        int a = (k + 1) % 3, b = (k + 2) % 3;
+        edge[k].a = sign * (y[a] - y[b]);
+        edge[k].b = sign * (x[b] - x[a]);
+        edge[k].c = -(edge[k].a * x[a] + edge[k].b * y[a]);
+        edge[k].bias = (edge[k].a > 0 || (edge[k].a == 0 && edge[k].b > 0)) ? 0 : 1;
+    }
+
+    // Pixels of the bounding box within the scissor, the max being included
+    int32_t min_x = x[0], max_x = x[0], min_y = y[0], max_y = y[0];
+    for (int k = 1; k < 3; k++) {
+        if (x[k] < min_x) min_x = x[k];
+        if (x[k] > max_x) max_x = x[k];
+        if (y[k] < min_y) min_y = y[k];
+        if (y[k] > max_y) max_y = y[k];
+    }
+
+    int x0 = min_x / HC_RASTER_SUBPIXEL, x1 = max_x / HC_RASTER_SUBPIXEL;
+    int y0 = min_y / HC_RASTER_SUBPIXEL, y1 = max_y / HC_RASTER_SUBPIXEL;
+    if (x0 < state->min_x) x0 = state->min_x;
+    if (y0 < state->min_y) y0 = state->min_y;
+    if (x1 > state->max_x - 1) x1 = state->max_x - 1;
+    if (y1 > state->max_y - 1) y1 = state->max_y - 1;
+    if (x0 > x1 || y0 > y1) return HC_RASTER_SUCCESS;
+
+    // Steps between neighbor pixels (within a tile they fit in 32 bits) and tiles
+    int32_t dx[3][8], dy[3];
+    int64_t tile_lo[3], tile_hi[3], tile_step[3];
+    for (int k = 0; k < 3; k++) {
+        for (int i = 0; i < 8; i++) {
+            dx[k][i] = (int32_t)(edge[k].a * HC_RASTER_SUBPIXEL * i);
+        }
+        dy[k] = (int32_t)(edge[k].b * HC_RASTER_SUBPIXEL);
+
+        // Range of the biased edge over a tile, from its value at the first pixel
+        int64_t ext_x = edge[k].a * HC_RASTER_SUBPIXEL * (HC_RASTER_TILE - 1);
+        int64_t ext_y = edge[k].b * HC_RASTER_SUBPIXEL * (HC_RASTER_TILE - 1);
+        tile_lo[k] = (ext_x < 0 ? ext_x : 0) + (ext_y < 0 ? ext_y : 0) - edge[k].bias;
+        tile_hi[k] = (ext_x > 0 ? ext_x : 0) + (ext_y > 0 ? ext_y : 0) - edge[k].bias;
+        tile_step[k] = edge[k].a * HC_RASTER_SUBPIXEL * HC_RASTER_TILE;
+    }
+
+    // Interpolation constants, the weights being computed from the edges
+    hc_raster_setup_t s;
+    double inv_area = 1.0 / (double)area;
+
+    s.dl2 = (float)(edge[1].a * HC_RASTER_SUBPIXEL * inv_area);
+    s.dl3 = (float)(edge[2].a * HC_RASTER_SUBPIXEL * inv_area);
+    s.z1 = v1->z, s.dz2 = v2->z - v1->z, s.dz3 = v3->z - v1->z;
+    s.q1 = 1.0f / v1->w, s.q2 = 1.0f / v2->w, s.q3 = 1.0f / v3->w;
+    s.attrib_count = state->attrib_count;
+    s.flat = (state->interp == HC_RASTER_FLAT);
+
+    float row_dl2 = (float)(edge[1].b * HC_RASTER_SUBPIXEL * inv_area);
+    float row_dl3 = (float)(edge[2].b * HC_RASTER_SUBPIXEL * inv_area);
+
+    for (int i = 0; i < s.attrib_count; i++) {
+        s.a1[i] = v1->attribs[i];
+        s.a2[i] = s.flat ? v2->attribs[i] : v2->attribs[i] - v1->attribs[i];
+        s.a3[i] = s.flat ? v3->attribs[i] : v3->attribs[i] - v1->attribs[i];
+    }
+
+    hc_raster_span_t span;
+    int tx0 = x0 & ~(HC_RASTER_TILE - 1);
+
+    for (int ty = y0 & ~(HC_RASTER_TILE - 1); ty <= y1; ty += HC_RASTER_TILE) {
+        int row_begin = (ty < y0) ? y0 - ty : 0;
+        int row_end = (ty + HC_RASTER_TILE - 1 > y1) ? y1 - ty + 1 : HC_RASTER_TILE;
+
+        // Edges at the center of the first pixel of the first tile of the row
+        int64_t e[3];
+        for (int k = 0; k < 3; k++) {
+            e[k] = edge[k].a * (tx0 * HC_RASTER_SUBPIXEL + HC_RASTER_SUBPIXEL / 2)
+                 + edge[k].b * (ty * HC_RASTER_SUBPIXEL + HC_RASTER_SUBPIXEL / 2) + edge[k].c;
+        }
+
+        for (int tx = tx0; tx <= x1; tx += HC_RASTER_TILE) {
+            // Skip the tiles outside an edge, only test the pixels against the edges crossing the tile
+            int32_t er[3] = { 0 };
+            int partial = 0;
+            bool outside = false;
+
+            for (int k = 0; k < 3; k++) {
+                if (e[k] + tile_hi[k] < 0) outside = true;
+                else if (e[k] + tile_lo[k] < 0) {
+                    partial |= 1 << k;
+                    er[k] = (int32_t)(e[k] - edge[k].bias + row_begin * (int64_t)dy[k]);
+                }
+            }
+
+            if (!outside) {
+                // Columns of the tile within the bounding box
+                uint32_t columns = 0xFF;
+                if (tx < x0) columns &= 0xFFu << (x0 - tx);
+                if (tx + HC_RASTER_TILE - 1 > x1) columns &= 0xFFu >> (tx + HC_RASTER_TILE - 1 - x1);
+
+                float l2 = (float)((double)e[1] * inv_area) + row_begin * row_dl2;
+                float l3 = (float)((double)e[2] * inv_area) + row_begin * row_dl3;
+
+                for (int row = row_begin; row < row_end; row++) {
+                    uint32_t mask = columns;
+                    if (partial) {
+                        mask &= hc_raster_coverage(er, dx, partial);
+                        for (int k = 0; k < 3; k++) er[k] += dy[k];
+                    }
+                    if (mask) {
+                        s.l2 = l2, s.l3 = l3;
+                        span.x = tx;
+                        span.y = ty + row;
+                        span.mask = mask;
+                        hc_raster_interpolate(&s, &span);
+                        state->span(&span, state->user);
+                    }
+                    l2 += row_dl2;
+                    l3 += row_dl3;
+                }
+            }
+
+            for (int k = 0; k < 3; k++) e[k] += tile_step[k];
+        }
+    }
+
+    return HC_RASTER_SUCCESS;
+}
+
+#endif // HC_RASTER_IMPL
@@ -0,0 +1,731 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2024-2025 Le Juez Victor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Transform hierarchy: nodes with a local translation, rotation and scale
+ * whose world matrices are composed with the world matrix of their parent.
+ *
+ * Nodes are designated by ids that stay valid until they are removed. Their
+ * data is stored in arrays (one per component) sorted by depth, with the
+ * children of a node next to each other, so an update walks the levels in
+ * order and the nodes of a level can be computed by several threads.
+ *
+ * Only the nodes whose local transform changed since the last update, and
+ * their descendants, are recomputed. They are handled as runs of consecutive
+ * slots, a moved subtree being one run per level, so changed subtrees stream
+ * through memory like a full update. Isolated nodes scattered over the scene
+ * are bound by memory latency instead and cost a few times more per node.
+ *
+ * The world matrices are hc_mat4_t (column-major, applying the local
+ * transform then the parent one, as with hc_mat4_mul(dst, local, parent)).
+ * Rotations are unit hc_quat_t (x, y, z, w), vectors are hc_vec3_t.
+ *
+ * NOTE: Adding, removing or reparenting nodes only marks the order as stale,
+ * the arrays are sorted again by the next update (linear in the node count).
+ */
+
+#ifndef HC_SCENE_H
+#define HC_SCENE_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Macros and defintions */
+
+#ifndef HC_MALLOC
+#   define HC_MALLOC(sz) malloc(sz)
+#endif
+
+#ifndef HC_CALLOC
+#   define HC_CALLOC(nb, sz) calloc(nb, sz)
+#endif
+
+#ifndef HC_REALLOC
+#   define HC_REALLOC(ptr, new_sz) realloc(ptr, new_sz)
+#endif
+
+#ifndef HC_FREE
+#   define HC_FREE(ptr) free(ptr)
+#endif
+
+#ifndef HC_SCENE_PARALLEL_LEVEL
+#   define HC_SCENE_PARALLEL_LEVEL 4096     // Levels with fewer nodes are updated by one thread
+#endif
+
+#define HC_SCENE_NONE UINT32_MAX            // No node (parent of the roots, failed additions)
+
+/* SIMD support (define HC_SCENE_NO_SIMD to only use the scalar paths) */
+
+#ifndef HC_SCENE_NO_SIMD
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define HC_SCENE_SSE2
+#       include <immintrin.h>
+#   endif
+#endif // HC_SCENE_NO_SIMD
+
+/* Multi-threading (used by hc_scene_update when compiled with OpenMP) */
+
+#ifdef _OPENMP
+#   include <omp.h>
+#endif
+
+/* Types definitions */
+
+enum hc_retcode_scene {
+    HC_SCENE_ERROR_OUT_OF_MEMORY    = -2,
+    HC_SCENE_ERROR_INVALID          = -1,
+    HC_SCENE_SUCCESS                = 0
+};
+
+typedef struct {
+    /* Node data, indexed by slot (sorted by depth after an update) */
+    float (*translation)[3];
+    float (*rotation)[4];
+    float (*scale)[3];
+    float (*world)[16];
+    uint32_t *parent;       // Slot of the parent, HC_SCENE_NONE for roots
+    uint32_t *id;           // Id of the node in each slot
+    uint8_t *flags;         // Local transform dirty, world changed by the last update, removed
+    uint32_t *first_child;  // Slot of the first child, the children being next to each other
+    uint32_t *child_count;
+    uint32_t slot_count;    // Used slots (removed nodes keep theirs until the next update)
+
+    /* Levels of the sorted slots: level 'd' is [level_start[d], level_start[d + 1]) */
+    uint32_t *level_start;
+    uint32_t level_count;
+
+    /* Update state */
+    uint64_t *dirty_bits;   // One bit per slot whose local transform was set since the last update
+    uint32_t dirty_count;
+    uint32_t *changed;      // Runs of slots recomputed by the last update, [begin, end) pairs in slot order
+    uint32_t changed_count; // Number of runs
+
+    /* Node ids */
+    uint32_t *slot;         // Slot of each id, HC_SCENE_NONE for unused ids
+    uint32_t *parent_id;    // Parent id of each id, HC_SCENE_NONE for roots
+    uint32_t *free_ids;     // Ids of removed nodes, reused by the next additions
+    uint32_t free_count;
+    uint32_t id_count;      // Ids handed out so far, including freed ones
+
+    uint32_t capacity;
+    bool sorted;            // Slots are sorted by depth
+} hc_scene_t;
+
+/* Function declarations */
+
+hc_scene_t hc_scene_create(uint32_t capacity);
+void hc_scene_destroy(hc_scene_t* scene);
+uint32_t hc_scene_add(hc_scene_t* scene, uint32_t parent);
+int hc_scene_remove(hc_scene_t* scene, uint32_t node);
+int hc_scene_set_parent(hc_scene_t* scene, uint32_t node, uint32_t parent);
+int hc_scene_set_local(hc_scene_t* scene, uint32_t node, const float translation[3], const float rotation[4], const float scale[3]);
+const float* hc_scene_world(const hc_scene_t* scene, uint32_t node);
+bool hc_scene_changed(const hc_scene_t* scene, uint32_t node);
+int hc_scene_update(hc_scene_t* scene, int num_threads);
+
+#endif // HC_SCENE_H
+
+#ifdef HC_SCENE_IMPL
+
+/* Private definitions */
+
+#define HC_SCENE_DIRTY      (1 << 0)    // Local transform set since the last update
+#define HC_SCENE_CHANGED    (1 << 1)    // World matrix recomputed by the last update
+#define HC_SCENE_REMOVED    (1 << 2)    // Removed, with its descendants, at the next update
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#   include <intrin.h>
+static inline int hc_scene_ctz64(uint64_t x) { unsigned long i; _BitScanForward64(&i, x); return (int)i; }
+#   define hc_scene_popcount64(x) ((int)__popcnt64(x))
+#else
+#   define hc_scene_ctz64(x) __builtin_ctzll(x)
+#   define hc_scene_popcount64(x) __builtin_popcountll(x)
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#   define HC_SCENE_PREFETCH(ptr) __builtin_prefetch(ptr)
+#elif defined(HC_SCENE_SSE2)
+#   define HC_SCENE_PREFETCH(ptr) _mm_prefetch((const char*)(ptr), _MM_HINT_T0)
+#else
+#   define HC_SCENE_PREFETCH(ptr) ((void)0)
+#endif
+
+#define HC_SCENE_PREFETCH_AHEAD 8   // Runs ahead whose data is requested during an update
+
+static inline bool hc_scene_is_node(const hc_scene_t* scene, uint32_t node)
+{
+    return node < scene->id_count && scene->slot[node] != HC_SCENE_NONE
+        && !(scene->flags[scene->slot[node]] & HC_SCENE_REMOVED);
+}
+
+static int hc_scene_reserve(hc_scene_t* scene, uint32_t capacity)
+{
+    if (capacity <= scene->capacity) return HC_SCENE_SUCCESS;
+
+    // Each array is only replaced once reallocated, so a failure leaves the scene intact
+#define HC_SCENE_GROW(field, size)                                          \
+    do {                                                                    \
+        void *ptr = HC_REALLOC(scene->field, (size_t)capacity * (size));    \
+        if (!ptr) return HC_SCENE_ERROR_OUT_OF_MEMORY;                      \
+        scene->field = ptr;                                                 \
+    } while (0)
+
+    HC_SCENE_GROW(translation, sizeof(*scene->translation));
+    HC_SCENE_GROW(rotation, sizeof(*scene->rotation));
+    HC_SCENE_GROW(scale, sizeof(*scene->scale));
+    HC_SCENE_GROW(world, sizeof(*scene->world));
+    HC_SCENE_GROW(parent, sizeof(uint32_t));
+    HC_SCENE_GROW(id, sizeof(uint32_t));
+    HC_SCENE_GROW(flags, sizeof(uint8_t));
+    HC_SCENE_GROW(first_child, sizeof(uint32_t));
+    HC_SCENE_GROW(child_count, sizeof(uint32_t));
+    HC_SCENE_GROW(changed, 2 * sizeof(uint32_t));
+    HC_SCENE_GROW(slot, sizeof(uint32_t));
+    HC_SCENE_GROW(parent_id, sizeof(uint32_t));
+    HC_SCENE_GROW(free_ids, sizeof(uint32_t));
+
+#undef HC_SCENE_GROW
+
+    // The bitmap is rebuilt by the sort, the new words only need to be clear
+    size_t words = ((size_t)scene->capacity + 63) / 64, new_words = ((size_t)capacity + 63) / 64;
+    uint64_t *bits = HC_REALLOC(scene->dirty_bits, new_words * sizeof(uint64_t));
+    if (!bits) return HC_SCENE_ERROR_OUT_OF_MEMORY;
+    memset(bits + words, 0, (new_words - words) * sizeof(uint64_t));
+    scene->dirty_bits = bits;
+
+    scene->capacity = capacity;
+    return HC_SCENE_SUCCESS;
+}
+
+/*
+ * Sorts the slots breadth-first from the roots: the levels become contiguous,
+ * and the children of each node are next to each other, in the order of their
+ * parents. Removed nodes and their descendants are dropped and their ids freed.
+ */
+static int hc_scene_sort(hc_scene_t* scene)
+{
+    uint32_t ids = scene->id_count;
+    uint32_t n = scene->slot_count;
+
+    // Children of each id (CSR), with the roots under the extra id 'ids'
+    uint32_t *child_start = HC_CALLOC((size_t)ids + 2, sizeof(uint32_t));
+    uint32_t *children = HC_MALLOC(((size_t)n + 1) * sizeof(uint32_t));
+    uint32_t *order = HC_MALLOC(((size_t)n + 1) * sizeof(uint32_t));
+    uint32_t *depth = HC_MALLOC(((size_t)n + 1) * sizeof(uint32_t));
+    void *scratch = HC_MALLOC(((size_t)n + 1) * sizeof(*scene->world));    // For moving the slots
+    if (!child_start || !children || !order || !depth || !scratch) {
+        HC_FREE(child_start);
+        HC_FREE(children);
+        HC_FREE(order);
+        HC_FREE(depth);
+        HC_FREE(scratch);
+        return HC_SCENE_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (uint32_t id = 0; id < ids; id++) {
+        if (scene->slot[id] == HC_SCENE_NONE) continue;
+        uint32_t p = scene->parent_id[id];
+        child_start[(p == HC_SCENE_NONE ? ids : p) + 1]++;
+    }
+    for (uint32_t id = 0; id <= ids; id++) {
+        child_start[id + 1] += child_start[id];
+    }
+    for (uint32_t id = 0; id < ids; id++) {
+        if (scene->slot[id] == HC_SCENE_NONE) continue;
+        uint32_t p = scene->parent_id[id];
+        children[child_start[p == HC_SCENE_NONE ? ids : p]++] = id;
+    }
+    for (uint32_t id = ids; id > 0; id--) {
+        child_start[id] = child_start[id - 1];
+    }
+    child_start[0] = 0;
+
+    // Breadth-first order, 'order' doubling as the queue
+    uint32_t head = 0, tail = 0;
+    for (uint32_t c = child_start[ids]; c < child_start[ids + 1]; c++) {
+        uint32_t id = children[c];
+        if (scene->flags[scene->slot[id]] & HC_SCENE_REMOVED) continue;
+        depth[tail] = 0;
+        order[tail++] = id;
+    }
+    // The position in the queue is the new slot, so the children ranges can be written directly
+    while (head < tail) {
+        uint32_t id = order[head];
+        uint32_t d = depth[head];
+        scene->first_child[head] = tail;
+        for (uint32_t c = child_start[id]; c < child_start[id + 1]; c++) {
+            uint32_t child = children[c];
+            if (scene->flags[scene->slot[child]] & HC_SCENE_REMOVED) continue;
+            depth[tail] = d + 1;
+            order[tail++] = child;
+        }
+        scene->child_count[head] = tail - scene->first_child[head];
+        head++;
+    }
+    HC_FREE(child_start);
+    HC_FREE(children);
+
+    uint32_t levels = tail ? depth[tail - 1] + 1 : 0;
+    uint32_t *level_start = HC_REALLOC(scene->level_start, ((size_t)levels + 1) * sizeof(uint32_t));
+    if (!level_start) {
+        HC_FREE(order);
+        HC_FREE(depth);
+        HC_FREE(scratch);
+        return HC_SCENE_ERROR_OUT_OF_MEMORY;
+    }
+    scene->level_start = level_start;
+    scene->level_count = levels;
+    for (uint32_t i = 0, d = 0; i < tail; i++) {
+        while (d <= depth[i]) level_start[d++] = i;
+    }
+    level_start[levels] = tail;
+    HC_FREE(depth);
+
+    // Nodes not reached were removed or descend from removed ones
+    for (uint32_t s = 0; s < n; s++) {
+        scene->flags[s] |= HC_SCENE_REMOVED;
+    }
+    for (uint32_t i = 0; i < tail; i++) {
+        scene->flags[scene->slot[order[i]]] &= (uint8_t)~HC_SCENE_REMOVED;
+    }
+    for (uint32_t s = 0; s < n; s++) {
+        if (!(scene->flags[s] & HC_SCENE_REMOVED)) continue;
+        uint32_t id = scene->id[s];
+        scene->slot[id] = HC_SCENE_NONE;
+        scene->free_ids[scene->free_count++] = id;
+    }
+
+    // Moves the slots into the new order, one array at a time through the scratch buffer
+#define HC_SCENE_PERMUTE(field)                                                         \
+    do {                                                                                \
+        size_t size = sizeof(*scene->field);                                            \
+        for (uint32_t i = 0; i < tail; i++) {                                           \
+            memcpy((char*)scratch + i * size, &scene->field[scene->slot[order[i]]], size); \
+        }                                                                               \
+        memcpy(scene->field, scratch, (size_t)tail * size);                             \
+    } while (0)
+
+    HC_SCENE_PERMUTE(translation);
+    HC_SCENE_PERMUTE(rotation);
+    HC_SCENE_PERMUTE(scale);
+    HC_SCENE_PERMUTE(world);
+    HC_SCENE_PERMUTE(flags);
+
+#undef HC_SCENE_PERMUTE
+
+    HC_FREE(scratch);
+
+    for (uint32_t i = 0; i < tail; i++) {
+        scene->id[i] = order[i];
+        scene->slot[order[i]] = i;
+    }
+    for (uint32_t i = 0; i < tail; i++) {
+        uint32_t p = scene->parent_id[order[i]];
+        scene->parent[i] = (p == HC_SCENE_NONE) ? HC_SCENE_NONE : scene->slot[p];
+    }
+
+    HC_FREE(order);
+    scene->slot_count = tail;
+    scene->sorted = true;
+
+    // The dirty slots moved, mark them again
+    memset(scene->dirty_bits, 0, (((size_t)n + 63) / 64) * sizeof(uint64_t));
+    scene->dirty_count = 0;
+    for (uint32_t i = 0; i < tail; i++) {
+        if (!(scene->flags[i] & HC_SCENE_DIRTY)) continue;
+        scene->dirty_bits[i / 64] |= (uint64_t)1 << (i % 64);
+        scene->dirty_count++;
+    }
+    return HC_SCENE_SUCCESS;
+}
+
+/* Local matrix, scaling then rotating then translating */
+static inline void hc_scene_local_matrix(float* m, const float* t, const float* q, const float* s)
+{
+    float x = q[0], y = q[1], z = q[2], w = q[3];
+    float x2 = x + x, y2 = y + y, z2 = z + z;
+    float xx = x*x2, yy = y*y2, zz = z*z2;
+    float xy = x*y2, xz = x*z2, yz = y*z2;
+    float wx = w*x2, wy = w*y2, wz = w*z2;
+
+    m[0]  = (1.0f - (yy + zz)) * s[0];
+    m[1]  = (xy + wz) * s[0];
+    m[2]  = (xz - wy) * s[0];
+    m[3]  = 0.0f;
+
+    m[4]  = (xy - wz) * s[1];
+    m[5]  = (1.0f - (xx + zz)) * s[1];
+    m[6]  = (yz + wx) * s[1];
+    m[7]  = 0.0f;
+
+    m[8]  = (xz + wy) * s[2];
+    m[9]  = (yz - wx) * s[2];
+    m[10] = (1.0f - (xx + yy)) * s[2];
+    m[11] = 0.0f;
+
+    m[12] = t[0];
+    m[13] = t[1];
+    m[14] = t[2];
+    m[15] = 1.0f;
+}
+
+/* World matrix of a node from the world matrix of its parent, both being affine */
+static inline void hc_scene_compose(float* dst, const float* parent, const float* local)
+{
+#if defined(HC_SCENE_SSE2)
+    __m128 c0 = _mm_loadu_ps(parent + 0), c1 = _mm_loadu_ps(parent + 4);
+    __m128 c2 = _mm_loadu_ps(parent + 8), c3 = _mm_loadu_ps(parent + 12);
+    for (int j = 0; j < 4; j++) {
+        __m128 r = _mm_mul_ps(c0, _mm_set1_ps(local[j * 4 + 0]));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(local[j * 4 + 1])));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(local[j * 4 + 2])));
+        if (j == 3) r = _mm_add_ps(r, c3);
+        _mm_storeu_ps(dst + j * 4, r);
+    }
+#else
+    for (int j = 0; j < 4; j++) {
+        const float *l = local + j * 4;
+        for (int r = 0; r < 4; r++) {
+            float v = parent[r] * l[0] + parent[4 + r] * l[1] + parent[8 + r] * l[2];
+            dst[j * 4 + r] = (j == 3) ? v + parent[12 + r] : v;
+        }
+    }
+#endif
+}
+
+static inline void hc_scene_update_slot(hc_scene_t* scene, uint32_t slot)
+{
+    uint32_t parent = scene->parent[slot];
+    float local[16];
+    hc_scene_local_matrix(local, scene->translation[slot], scene->rotation[slot], scene->scale[slot]);
+
+    if (parent == HC_SCENE_NONE) {
+        memcpy(scene->world[slot], local, sizeof(local));
+    } else {
+        hc_scene_compose(scene->world[slot], scene->world[parent], local);
+    }
+    scene->flags[slot] = (uint8_t)((scene->flags[slot] & ~HC_SCENE_DIRTY) | HC_SCENE_CHANGED);
+}
+
+/* First dirty slot in [slot, end), or 'end' */
+static inline uint32_t hc_scene_next_dirty(const hc_scene_t* scene, uint32_t slot, uint32_t end)
+{
+    while (slot < end) {
+        uint64_t word = scene->dirty_bits[slot / 64] >> (slot % 64);
+        if (word) {
+            slot += (uint32_t)hc_scene_ctz64(word);
+            return (slot < end) ? slot : end;
+        }
+        slot = (slot | 63) + 1;
+    }
+    return end;
+}
+
+/* Number of dirty slots in [start, end) */
+static inline uint32_t hc_scene_count_dirty(const hc_scene_t* scene, uint32_t start, uint32_t end)
+{
+    if (start == end) return 0;
+    uint32_t first = start / 64, last = (end - 1) / 64, count = 0;
+    for (uint32_t w = first; w <= last; w++) {
+        uint64_t word = scene->dirty_bits[w];
+        if (w == first) word &= ~(uint64_t)0 << (start % 64);
+        if (w == last && end % 64) word &= ~(uint64_t)0 >> (64 - end % 64);
+        count += (uint32_t)hc_scene_popcount64(word);
+    }
+    return count;
+}
+
+/* Appends the slots [begin, end) to the runs, extending the last one (from 'first') when they follow it */
+static inline uint32_t hc_scene_push_run(uint32_t* runs, uint32_t count, uint32_t first, uint32_t begin, uint32_t end)
+{
+    if (count > first && runs[2 * count - 1] == begin) {
+        runs[2 * count - 1] = end;
+        return count;
+    }
+    runs[2 * count] = begin;
+    runs[2 * count + 1] = end;
+    return count + 1;
+}
+
+/* Recomputes 'take' slots of the runs, starting 'skip' slots in */
+static void hc_scene_update_runs(hc_scene_t* scene, const uint32_t* runs, uint32_t run_count, uint64_t skip, uint64_t take)
+{
+    uint32_t r = 0;
+    while (r < run_count && skip >= runs[2 * r + 1] - runs[2 * r]) {
+        skip -= runs[2 * r + 1] - runs[2 * r];
+        r++;
+    }
+    for (; r < run_count && take > 0; r++) {
+        // Short runs jump between slots, request the next ones early (long ones are read forward)
+        if (r + HC_SCENE_PREFETCH_AHEAD < run_count) {
+            uint32_t next = runs[2 * (r + HC_SCENE_PREFETCH_AHEAD)];
+            HC_SCENE_PREFETCH(scene->translation[next]);
+            HC_SCENE_PREFETCH(scene->rotation[next]);
+            HC_SCENE_PREFETCH(scene->scale[next]);
+            HC_SCENE_PREFETCH(scene->world[next]);
+            HC_SCENE_PREFETCH(&scene->flags[next]);
+            HC_SCENE_PREFETCH(&scene->parent[next]);
+        }
+        uint32_t slot = runs[2 * r] + (uint32_t)skip, end = runs[2 * r + 1];
+        if (end - slot > take) end = slot + (uint32_t)take;
+        take -= end - slot;
+        skip = 0;
+        for (; slot < end; slot++) {
+            hc_scene_update_slot(scene, slot);
+        }
+    }
+}
+
+/* Public functions */
+
+hc_scene_t hc_scene_create(uint32_t capacity)
+{
+    hc_scene_t scene;
+    memset(&scene, 0, sizeof(hc_scene_t));
+    scene.sorted = true;
+
+    if (capacity > 0 && hc_scene_reserve(&scene, capacity) != HC_SCENE_SUCCESS) {
+        hc_scene_destroy(&scene);
+    }
+    return scene;
+}
+
+void hc_scene_destroy(hc_scene_t* scene)
+{
+    if (!scene) return;
+    HC_FREE(scene->translation);
+    HC_FREE(scene->rotation);
+    HC_FREE(scene->scale);
+    HC_FREE(scene->world);
+    HC_FREE(scene->parent);
+    HC_FREE(scene->id);
+    HC_FREE(scene->flags);
+    HC_FREE(scene->first_child);
+    HC_FREE(scene->child_count);
+    HC_FREE(scene->dirty_bits);
+    HC_FREE(scene->changed);
+    HC_FREE(scene->level_start);
+    HC_FREE(scene->slot);
+    HC_FREE(scene->parent_id);
+    HC_FREE(scene->free_ids);
+    memset(scene, 0, sizeof(hc_scene_t));
+    scene->sorted = true;
+}
+
+/*
+ * Adds a node under 'parent' (HC_SCENE_NONE for a root) with an identity local
+ * transform, returns its id or HC_SCENE_NONE if 'parent' isn't a node or on
+ * allocation failure. The world matrix is valid after the next update.
+ */
+uint32_t hc_scene_add(hc_scene_t* scene, uint32_t parent)
+{
+    if (!scene || (parent != HC_SCENE_NONE && !hc_scene_is_node(scene, parent))) {
+        return HC_SCENE_NONE;
+    }
+
+    // Removed nodes keep their slot until the next update, so slots are the tighter bound
+    if (scene->slot_count == scene->capacity || (!scene->free_count && scene->id_count == scene->capacity)) {
+        uint32_t capacity = scene->capacity ? scene->capacity : 16;
+        if (capacity >= UINT32_MAX / 2) return HC_SCENE_NONE;
+        if (hc_scene_reserve(scene, 2 * capacity) != HC_SCENE_SUCCESS) return HC_SCENE_NONE;
+    }
+
+    uint32_t id = scene->free_count ? scene->free_ids[--scene->free_count] : scene->id_count++;
+    uint32_t s = scene->slot_count++;
+
+    static const float identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+    memset(scene->translation[s], 0, sizeof(scene->translation[s]));
+    memcpy(scene->rotation[s], (const float[4]) { 0.0f, 0.0f, 0.0f, 1.0f }, sizeof(scene->rotation[s]));
+    memcpy(scene->scale[s], (const float[3]) { 1.0f, 1.0f, 1.0f }, sizeof(scene->scale[s]));
+    memcpy(scene->world[s], identity, sizeof(identity));
+    scene->flags[s] = HC_SCENE_DIRTY;
+    scene->id[s] = id;
+    scene->parent[s] = (parent == HC_SCENE_NONE) ? HC_SCENE_NONE : scene->slot[parent];
+
+    scene->slot[id] = s;
+    scene->parent_id[id] = parent;
+    scene->sorted = false;
+    return id;
+}
+
+/* Removes a node and its descendants, their ids are reused after the next update */
+int hc_scene_remove(hc_scene_t* scene, uint32_t node)
+{
+    if (!scene || !hc_scene_is_node(scene, node)) return HC_SCENE_ERROR_INVALID;
+    scene->flags[scene->slot[node]] |= HC_SCENE_REMOVED;
+    scene->sorted = false;
+    return HC_SCENE_SUCCESS;
+}
+
+/* Moves a node under 'parent' (HC_SCENE_NONE to make it a root), keeping its local transform */
+int hc_scene_set_parent(hc_scene_t* scene, uint32_t node, uint32_t parent)
+{
+    if (!scene || !hc_scene_is_node(scene, node)) return HC_SCENE_ERROR_INVALID;
+    if (parent != HC_SCENE_NONE && !hc_scene_is_node(scene, parent)) return HC_SCENE_ERROR_INVALID;
+
+    // The node can't go under itself or one of its descendants
+    for (uint32_t p = parent; p != HC_SCENE_NONE; p = scene->parent_id[p]) {
+        if (p == node) return HC_SCENE_ERROR_INVALID;
+    }
+
+    uint32_t s = scene->slot[node];
+    scene->parent_id[node] = parent;
+    scene->parent[s] = (parent == HC_SCENE_NONE) ? HC_SCENE_NONE : scene->slot[parent];
+    scene->flags[s] |= HC_SCENE_DIRTY;
+    scene->sorted = false;
+    return HC_SCENE_SUCCESS;
+}
+
+/* Sets the local transform of a node, NULL components are left unchanged */
+int hc_scene_set_local(hc_scene_t* scene, uint32_t node, const float translation[3], const float rotation[4], const float scale[3])
+{
+    if (!scene || !hc_scene_is_node(scene, node)) return HC_SCENE_ERROR_INVALID;
+
+    uint32_t s = scene->slot[node];
+    if (translation) memcpy(scene->translation[s], translation, sizeof(scene->translation[s]));
+    if (rotation) memcpy(scene->rotation[s], rotation, sizeof(scene->rotation[s]));
+    if (scale) memcpy(scene->scale[s], scale, sizeof(scene->scale[s]));
+
+    if (!(scene->flags[s] & HC_SCENE_DIRTY)) {
+        scene->flags[s] |= HC_SCENE_DIRTY;
+        scene->dirty_bits[s / 64] |= (uint64_t)1 << (s % 64);
+        scene->dirty_count++;
+    }
+    return HC_SCENE_SUCCESS;
+}
+
+/* World matrix of a node as of the last update (16 floats), NULL if it isn't a node */
+const float* hc_scene_world(const hc_scene_t* scene, uint32_t node)
+{
+    if (!scene || !hc_scene_is_node(scene, node)) return NULL;
+    return scene->world[scene->slot[node]];
+}
+
+/* Whether the world matrix of a node was recomputed by the last update */
+bool hc_scene_changed(const hc_scene_t* scene, uint32_t node)
+{
+    if (!scene || !hc_scene_is_node(scene, node)) return false;
+    return (scene->flags[scene->slot[node]] & HC_SCENE_CHANGED) != 0;
+}
+
+/*
+ * Recomputes the world matrices of the nodes whose local transform changed and
+ * of their descendants, level by level. The cost follows the number of changed
+ * nodes rather than the scene size. Levels with at least HC_SCENE_PARALLEL_LEVEL
+ * nodes to recompute are split among threads.
+ */
+int hc_scene_update(hc_scene_t* scene, int num_threads)
+{
+    if (!scene) return HC_SCENE_ERROR_INVALID;
+
+#ifdef _OPENMP
+    int threads = num_threads > 0 ? num_threads : omp_get_max_threads();
+#else
+    (void)num_threads;
+#endif
+
+    // Flags of the last update, before the slots move
+    for (uint32_t r = 0; r < scene->changed_count; r++) {
+        for (uint32_t i = scene->changed[2 * r]; i < scene->changed[2 * r + 1]; i++) {
+            scene->flags[i] &= (uint8_t)~HC_SCENE_CHANGED;
+        }
+    }
+    scene->changed_count = 0;
+
+    if (!scene->sorted) {
+        int ret = hc_scene_sort(scene);
+        if (ret != HC_SCENE_SUCCESS) return ret;
+    }
+    if (scene->dirty_count == 0) return HC_SCENE_SUCCESS;
+
+    /*
+     * The changed slots are kept as runs: the children of a run of parents are
+     * one range of the next level (even childless nodes have their first child
+     * set to where it would be), so subtrees stay runs as they go down. Those
+     * ranges are merged with the dirty slots of the level, both in increasing
+     * slot order, and the runs are then recomputed reading memory forward, so
+     * the cost follows the number of changed nodes rather than the scene size.
+     */
+    uint32_t *runs = scene->changed;
+    uint32_t count = 0, prev_begin = 0, prev_end = 0, dirty_left = scene->dirty_count;
+
+    for (uint32_t d = 0; d < scene->level_count; d++) {
+        if (prev_begin == prev_end && dirty_left == 0) break;
+
+        uint32_t start = scene->level_start[d], end = scene->level_start[d + 1];
+        uint32_t begin = count;
+        uint64_t nodes = 0;
+        dirty_left -= hc_scene_count_dirty(scene, start, end);
+
+        uint32_t dirty = hc_scene_next_dirty(scene, start, end);
+        uint32_t run = prev_begin, child = 0, child_end = 0;
+
+        for (;;) {
+            while (child == child_end && run < prev_end) {
+                uint32_t first = runs[2 * run], last = runs[2 * run + 1] - 1;
+                child = scene->first_child[first];
+                child_end = scene->first_child[last] + scene->child_count[last];
+                run++;
+            }
+            if (child < child_end && child <= dirty) {
+                // The dirty slots among the children are recomputed with them
+                count = hc_scene_push_run(runs, count, begin, child, child_end);
+                nodes += child_end - child;
+                if (dirty < child_end) dirty = hc_scene_next_dirty(scene, child_end, end);
+                child = child_end;
+            } else if (dirty < end) {
+                count = hc_scene_push_run(runs, count, begin, dirty, dirty + 1);
+                nodes++;
+                dirty = hc_scene_next_dirty(scene, dirty + 1, end);
+            } else {
+                break;
+            }
+        }
+
+        // The nodes of a level only read the matrices of the previous one
+#ifdef _OPENMP
+        if (nodes >= HC_SCENE_PARALLEL_LEVEL && threads > 1) {
+#           pragma omp parallel num_threads(threads)
+            {
+                uint64_t t = (uint64_t)omp_get_thread_num(), n = (uint64_t)omp_get_num_threads();
+                uint64_t first = nodes * t / n, last = nodes * (t + 1) / n;
+                hc_scene_update_runs(scene, runs + 2 * begin, count - begin, first, last - first);
+            }
+        } else
+#endif
+        hc_scene_update_runs(scene, runs + 2 * begin, count - begin, 0, nodes);
+
+        prev_begin = begin;
+        prev_end = count;
+    }
+
+    memset(scene->dirty_bits, 0, (((size_t)scene->slot_count + 63) / 64) * sizeof(uint64_t));
+    scene->dirty_count = 0;
+    scene->changed_count = count;
+    return HC_SCENE_SUCCESS;
+}
+
+#endif // HC_SCENE_IMPL
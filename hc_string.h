@@ -27,9 +27,11 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <stdbool.h>
 #include <stdarg.h>
+#include <stddef.h>
 #include <ctype.h>
 
 /* Macros and defintions */
@@ -50,6 +52,58 @@
 #   define HC_FREE(ptr) free(ptr)
 #endif
 
+/* Atomic reference counting (used by shared strings) */
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#   include <intrin.h>
+#   define HC_STRING_ATOMIC_INC(ptr) _InterlockedIncrement(ptr)
+#   define HC_STRING_ATOMIC_DEC(ptr) _InterlockedDecrement(ptr)
+#   define HC_STRING_ATOMIC_LOAD(ptr) (*(ptr))
+#else
+#   define HC_STRING_ATOMIC_INC(ptr) __atomic_add_fetch(ptr, 1, __ATOMIC_RELAXED)
+#   define HC_STRING_ATOMIC_DEC(ptr) __atomic_sub_fetch(ptr, 1, __ATOMIC_ACQ_REL)
+#   define HC_STRING_ATOMIC_LOAD(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#endif
+
+/* Capacity value used to mark a string as shared (immutable, reference counted) */
+#define HC_STRING_SHARED ((size_t)-1)
+
+/* SIMD support (define HC_STRING_NO_SIMD to only use the scalar paths) */
+
+#ifndef HC_STRING_NO_SIMD
+#   if defined(__AVX2__)
+#       define HC_STRING_AVX2
+#   endif
+#   if defined(__SSSE3__) || defined(__AVX__)
+#       define HC_STRING_SSSE3
+#   endif
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define HC_STRING_SSE2
+#   endif
+#   if defined(HC_STRING_SSE2)
+#       include <immintrin.h>
+#   endif
+#endif // HC_STRING_NO_SIMD
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#   include <intrin.h>
+static inline int hc_string_ctz32(uint32_t x) { unsigned long i; _BitScanForward(&i, x); return (int)i; }
+#   define hc_string_popcount32(x) ((int)__popcnt(x))
+#else
+#   define hc_string_ctz32(x) __builtin_ctz(x)
+#   define hc_string_popcount32(x) __builtin_popcount(x)
+#endif
+
+/* Multi-threading (used by the *_parallel functions when compiled with OpenMP) */
+
+#ifdef _OPENMP
+#   include <omp.h>
+#endif
+
+#ifndef HC_STRING_PARALLEL_CHUNK
+#   define HC_STRING_PARALLEL_CHUNK (4 << 20)  // Minimal size of the chunks scanned by each thread
+#endif
+
 /* Types definitions */
 
 enum hc_retcode_array {
@@ -62,9 +116,45 @@ enum hc_retcode_array {
 typedef struct {
     char *data;
     size_t length;
-    size_t capacity;
+    size_t capacity;        // HC_STRING_SHARED if the string data is shared
 } hc_string_t;
 
+/*
+ * Non-owning reference to a sequence of characters, not necessarily null-terminated.
+ */
+typedef struct {
+    const char *data;
+    size_t length;
+} hc_string_view_t;
+
+/*
+ * State of a chunked base64 / hex conversion, must be zero-initialized.
+ */
+typedef struct {
+    uint8_t pending[4];     // Input carried over to the next chunk
+    uint8_t count;          // Number of pending bytes
+    bool done;              // Decoding: padding was reached, no more data allowed
+} hc_string_codec_t;
+
+/*
+ * Pattern precompiled for bit-parallel edit distance (Myers' algorithm).
+ * Compiling once lets the same query be compared against many strings.
+ */
+typedef struct {
+    uint64_t *peq;          // Match bit-vectors, 256 per block of 64 characters
+    size_t length;          // Length of the pattern
+    size_t blocks;          // Number of 64-bit blocks
+} hc_string_pattern_t;
+
+/*
+ * Header stored just before the bytes of a shared string.
+ * The padding keeps the string data aligned like a regular allocation.
+ */
+typedef union {
+    volatile long refcount;
+    long double _align;
+} hc_string_shared_t;
+
 /* Function declarations */
 
 hc_string_t hc_string_create(size_t capacity);
@@ -72,8 +162,31 @@ hc_string_t hc_string_create_from_cstr(const char* str);
 hc_string_t hc_string_create_with_char(char c, size_t count);
 void hc_string_destroy(hc_string_t* str);
 hc_string_t hc_string_copy(const hc_string_t* src);
+int hc_string_freeze(hc_string_t* str);
+int hc_string_make_unique(hc_string_t* str);
+bool hc_string_is_shared(const hc_string_t* str);
 int hc_string_concat(hc_string_t *dst, const char* src);
 int hc_string_concat_hc(hc_string_t *dst, const hc_string_t* src);
+int hc_string_concat_many(hc_string_t* dst, const hc_string_view_t* pieces, size_t count);
+int hc_string_reserve(hc_string_t* str, size_t capacity);
+hc_string_t hc_string_join(const hc_string_t* pieces, size_t count, const char* separator);
+hc_string_t hc_string_join_cstr(const char* const* pieces, size_t count, const char* separator);
+hc_string_t hc_string_join_view(const hc_string_view_t* pieces, size_t count, const char* separator);
+hc_string_view_t hc_string_view(const hc_string_t* str);
+hc_string_view_t hc_string_view_cstr(const char* str);
+int hc_string_append_base64(hc_string_t* dst, const void* data, size_t size);
+int hc_string_decode_base64(hc_string_t* dst, const char* src, size_t length);
+int hc_string_append_hex(hc_string_t* dst, const void* data, size_t size);
+int hc_string_decode_hex(hc_string_t* dst, const char* src, size_t length);
+int hc_string_base64_encode_update(hc_string_codec_t* codec, hc_string_t* dst, const void* data, size_t size);
+int hc_string_base64_encode_final(hc_string_codec_t* codec, hc_string_t* dst);
+int hc_string_base64_decode_update(hc_string_codec_t* codec, hc_string_t* dst, const char* src, size_t length);
+int hc_string_base64_decode_final(hc_string_codec_t* codec, hc_string_t* dst);
+int hc_string_hex_decode_update(hc_string_codec_t* codec, hc_string_t* dst, const char* src, size_t length);
+int hc_string_hex_decode_final(hc_string_codec_t* codec, hc_string_t* dst);
+int hc_string_append_escaped(hc_string_t* dst, const char* src, size_t length);
+int hc_string_append_unescaped(hc_string_t* dst, const char* src, size_t length);
+int hc_string_unescape(hc_string_t* str);
 hc_string_t hc_string_format(const char* format, ...);
 void hc_string_tolower(hc_string_t* str);
 void hc_string_toupper(hc_string_t* str);
@@ -87,6 +200,16 @@ int hc_string_occurrences(const hc_string_t* str, const char* keyword);
 int hc_string_word_count(const hc_string_t* str);
 bool hc_string_is_empty(const hc_string_t* str);
 bool hc_string_compare(const hc_string_t* a, const hc_string_t* b);
+size_t hc_string_occurrences_parallel(const hc_string_t* str, const char* keyword, int num_threads);
+size_t hc_string_find_all_parallel(const hc_string_t* str, const char* keyword, size_t* positions, size_t max_positions, int num_threads);
+size_t hc_string_word_count_parallel(const hc_string_t* str, int num_threads);
+int hc_string_pattern_create(hc_string_pattern_t* pattern, const char* str, size_t length);
+void hc_string_pattern_destroy(hc_string_pattern_t* pattern);
+size_t hc_string_pattern_distance(const hc_string_pattern_t* pattern, const char* text, size_t length, size_t max_distance);
+bool hc_string_pattern_search(const hc_string_pattern_t* pattern, const char* text, size_t length, size_t max_distance, size_t* match_end, size_t* distance);
+size_t hc_string_edit_distance(const hc_string_t* a, const hc_string_t* b);
+size_t hc_string_edit_distance_bounded(const hc_string_t* a, const hc_string_t* b, size_t max_distance);
+bool hc_string_fuzzy_find(const hc_string_t* str, const char* pattern, size_t max_distance, size_t* match_end, size_t* distance);
 
 #endif // HC_STRING_H
 
@@ -137,7 +260,14 @@ hc_string_t hc_string_create_with_char(char c, size_t count)
 void hc_string_destroy(hc_string_t* str)
 {
     if (str && str->data) {
-        HC_FREE(str->data);
+        if (str->capacity == HC_STRING_SHARED) {
+            hc_string_shared_t *header = (hc_string_shared_t*)str->data - 1;
+            if (HC_STRING_ATOMIC_DEC(&header->refcount) == 0) {
+                HC_FREE(header);
+            }
+        } else {
+            HC_FREE(str->data);
+        }
         str->data = NULL;
         str->length = 0;
         str->capacity = 0;
@@ -148,10 +278,93 @@ hc_string_t hc_string_copy(const hc_string_t* src)
 {
     hc_string_t new_str = { 0 };
     if (!src || !src->data) return new_str;
-    new_str = hc_string_create_from_cstr(src->data);
+
+    // Shared strings are immutable, a copy is just a new reference
+    if (src->capacity == HC_STRING_SHARED) {
+        hc_string_shared_t *header = (hc_string_shared_t*)src->data - 1;
+        HC_STRING_ATOMIC_INC(&header->refcount);
+        return *src;
+    }
+
+    new_str.data = HC_MALLOC(src->length + 1);
+    if (new_str.data == NULL) return new_str;
+
+    memcpy(new_str.data, src->data, src->length);
+    new_str.data[src->length] = '\0';
+    new_str.length = src->length;
+    new_str.capacity = src->length + 1;
+
     return new_str;
 }
 
+int hc_string_freeze(hc_string_t* str)
+{
+    if (!str || !str->data) {
+        return HC_STRING_ERROR_INVALID_DST;
+    }
+
+    if (str->capacity == HC_STRING_SHARED) {
+        return HC_STRING_SUCCESS;
+    }
+
+    // The refcount lives in a header placed just before the bytes,
+    // so the string is moved once into a block that has room for it
+    hc_string_shared_t *header = HC_MALLOC(sizeof(hc_string_shared_t) + str->length + 1);
+    if (!header) return HC_STRING_ERROR_OUT_OF_MEMORY;
+
+    header->refcount = 1;
+
+    char *data = (char*)(header + 1);
+    memcpy(data, str->data, str->length);
+    data[str->length] = '\0';
+
+    HC_FREE(str->data);
+    str->data = data;
+    str->capacity = HC_STRING_SHARED;
+
+    return HC_STRING_SUCCESS;
+}
+
+int hc_string_make_unique(hc_string_t* str)
+{
+    if (!str || !str->data) {
+        return HC_STRING_ERROR_INVALID_DST;
+    }
+
+    if (str->capacity != HC_STRING_SHARED) {
+        return HC_STRING_SUCCESS;
+    }
+
+    hc_string_shared_t *header = (hc_string_shared_t*)str->data - 1;
+
+    // Last reference, we can take back the bytes without copying them again
+    if (HC_STRING_ATOMIC_LOAD(&header->refcount) == 1) {
+        memmove(header, str->data, str->length + 1);
+        str->data = (char*)header;
+        str->capacity = str->length + 1 + sizeof(hc_string_shared_t);
+        return HC_STRING_SUCCESS;
+    }
+
+    char *data = HC_MALLOC(str->length + 1);
+    if (!data) return HC_STRING_ERROR_OUT_OF_MEMORY;
+
+    memcpy(data, str->data, str->length + 1);
+
+    if (HC_STRING_ATOMIC_DEC(&header->refcount) == 0) {
+        HC_FREE(header);
+    }
+
+    str->data = data;
+    str->capacity = str->length + 1;
+
+    return HC_STRING_SUCCESS;
+}
+
+bool hc_string_is_shared(const hc_string_t* str)
+{
+    return str && str->data && str->capacity == HC_STRING_SHARED;
+}
+
 int hc_string_concat(hc_string_t *dst, const char* src)
 {
     if (!dst || !dst->data) {
@@ -162,6 +375,9 @@ int hc_string_concat(hc_string_t *dst, const char* src)
         return HC_STRING_ERROR_INVALID_SRC;
     }
 
+    int ret = hc_string_make_unique(dst);
+    if (ret < 0) return ret;
+
     size_t src_length = strlen(src);
     size_t new_length = dst->length + src_length;
 
@@ -174,7 +390,7 @@ int hc_string_concat(hc_string_t *dst, const char* src)
         dst->capacity = new_capacity;
     }
 
-    strcat(dst->data, src);
+    memcpy(dst->data + dst->length, src, src_length + 1);
     dst->length = new_length;
 
     return HC_STRING_SUCCESS;
@@ -189,6 +405,209 @@ int hc_string_concat_hc(hc_string_t *dst, const hc_string_t* src)
     return hc_string_concat(dst, src->data);
 }
 
+int hc_string_concat_many(hc_string_t* dst, const hc_string_view_t* pieces, size_t count)
+{
+    if (!dst) {
+        return HC_STRING_ERROR_INVALID_DST;
+    }
+
+    if (!pieces && count > 0) {
+        return HC_STRING_ERROR_INVALID_SRC;
+    }
+
+    // Sum all lengths first so that the destination grows only once
+    size_t new_length = dst->length;
+    for (size_t i = 0; i < count; i++) {
+        new_length += pieces[i].length;
+    }
+
+    // Pieces may be views into dst itself, if its bytes have to move they
+    // are copied into a new buffer and the old one is released afterwards
+    bool aliased = false;
+    if (dst->data && (dst->capacity == HC_STRING_SHARED || dst->capacity < new_length + 1)) {
+        uintptr_t begin = (uintptr_t)dst->data;
+        uintptr_t end = begin + dst->length + 1;
+        for (size_t i = 0; i < count && !aliased; i++) {
+            uintptr_t piece = (uintptr_t)pieces[i].data;
+            aliased = pieces[i].length > 0 && piece >= begin && piece < end;
+        }
+    }
+
+    hc_string_t old = { 0 };
+
+    if (aliased) {
+        hc_string_t grown = { 0 };
+        size_t capacity = new_length + 1;
+        if (dst->capacity != HC_STRING_SHARED && capacity < dst->capacity * 2) {
+            capacity = dst->capacity * 2;
+        }
+
+        int ret = hc_string_reserve(&grown, capacity);
+        if (ret < 0) return ret;
+
+        memcpy(grown.data, dst->data, dst->length);
+        grown.length = dst->length;
+
+        old = *dst;
+        *dst = grown;
+    } else {
+        int ret = hc_string_reserve(dst, new_length + 1);
+        if (ret < 0) return ret;
+    }
+
+    char *ptr = dst->data + dst->length;
+    for (size_t i = 0; i < count; i++) {
+        if (pieces[i].length == 0) continue;
+        memcpy(ptr, pieces[i].data, pieces[i].length);
+        ptr += pieces[i].length;
+    }
+    *ptr = '\0';
+    dst->length = new_length;
+
+    hc_string_destroy(&old);
+
+    return HC_STRING_SUCCESS;
+}
+
+int hc_string_reserve(hc_string_t* str, size_t capacity)
+{
+    if (!str) {
+        return HC_STRING_ERROR_INVALID_DST;
+    }
+
+    // There is always room for the terminator
+    if (capacity == 0) capacity = 1;
+
+    if (str->data) {
+        int ret = hc_string_make_unique(str);
+        if (ret < 0) return ret;
+        if (str->capacity >= capacity) {
+            return HC_STRING_SUCCESS;
+        }
+        // Grow geometrically so that repeated appends copy each byte a constant number of times
+        if (capacity < str->capacity * 2) {
+            capacity = str->capacity * 2;
+        }
+    }
+
+    char *new_data = (char*)HC_REALLOC(str->data, capacity);
+    if (!new_data) return HC_STRING_ERROR_OUT_OF_MEMORY;
+
+    if (!str->data) new_data[0] = '\0';
+
+    str->data = new_data;
+    str->capacity = capacity;
+
+    return HC_STRING_SUCCESS;
+}
+
+hc_string_t hc_string_join(const hc_string_t* pieces, size_t count, const char* separator)
+{
+    hc_string_t result = { 0 };
+    if (!pieces && count > 0) return result;
+    if (count == 0) return hc_string_join_view(NULL, 0, separator);
+
+    // The pieces are passed on as views, kept on the stack for small counts
+    hc_string_view_t views_small[64];
+    hc_string_view_t *views = views_small;
+
+    if (count > 64) {
+        views = HC_MALLOC(count * sizeof(hc_string_view_t));
+        if (!views) return result;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        views[i] = hc_string_view(&pieces[i]);
+    }
+
+    result = hc_string_join_view(views, count, separator);
+
+    if (views != views_small) HC_FREE(views);
+
+    return result;
+}
+
+hc_string_t hc_string_join_cstr(const char* const* pieces, size_t count, const char* separator)
+{
+    hc_string_t result = { 0 };
+    if (!pieces && count > 0) return result;
+    if (count == 0) return hc_string_join_view(NULL, 0, separator);
+
+    // The lengths are needed twice, the pieces are measured once into views
+    // (kept on the stack for small counts)
+    hc_string_view_t views_small[64];
+    hc_string_view_t *views = views_small;
+
+    if (count > 64) {
+        views = HC_MALLOC(count * sizeof(hc_string_view_t));
+        if (!views) return result;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        views[i] = hc_string_view_cstr(pieces[i]);
+    }
+
+    result = hc_string_join_view(views, count, separator);
+
+    if (views != views_small) HC_FREE(views);
+
+    return result;
+}
+
+hc_string_t hc_string_join_view(const hc_string_view_t* pieces, size_t count, const char* separator)
+{
+    hc_string_t result = { 0 };
+    if (!pieces && count > 0) return result;
+
+    size_t sep_length = separator ? strlen(separator) : 0;
+
+    size_t length = (count > 0) ? (count - 1) * sep_length : 0;
+    for (size_t i = 0; i < count; i++) {
+        length += pieces[i].length;
+    }
+
+    result.data = HC_MALLOC(length + 1);
+    if (!result.data) return result;
+
+    char *ptr = result.data;
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0 && sep_length > 0) {
+            memcpy(ptr, separator, sep_length);
+            ptr += sep_length;
+        }
+        if (pieces[i].length > 0) {
+            memcpy(ptr, pieces[i].data, pieces[i].length);
+            ptr += pieces[i].length;
+        }
+    }
+    *ptr = '\0';
+
+    result.length = length;
+    result.capacity = length + 1;
+
+    return result;
+}
+
+hc_string_view_t hc_string_view(const hc_string_t* str)
+{
+    hc_string_view_t view = { 0 };
+    if (str && str->data) {
+        view.data = str->data;
+        view.length = str->length;
+    }
+    return view;
+}
+
+hc_string_view_t hc_string_view_cstr(const char* str)
+{
+    hc_string_view_t view = { 0 };
+    if (str) {
+        view.data = str;
+        view.length = strlen(str);
+    }
+    return view;
+}
+
 hc_string_t hc_string_format(const char* format, ...)
 {
     hc_string_t formatted_str = { 0 };
@@ -216,6 +635,8 @@ hc_string_t hc_string_format(const char* format, ...)
 
 void hc_string_tolower(hc_string_t* str)
 {
+    if (hc_string_make_unique(str) < 0) return;
+
     char* ptr = str->data;
     while (*ptr) {
         *ptr = tolower((unsigned char)*ptr);
@@ -225,6 +646,8 @@ void hc_string_tolower(hc_string_t* str)
 
 void hc_string_toupper(hc_string_t* str)
 {
+    if (hc_string_make_unique(str) < 0) return;
+
     char* ptr = str->data;
     while (*ptr) {
         *ptr = toupper((unsigned char)*ptr);
@@ -254,6 +677,11 @@ int hc_string_replace(hc_string_t* str, const char* old_word, const char* new_wo
         occurrences++;      // Increment occurrence count
     }
 
+    // Nothing to replace, a shared string stays shared
+    if (occurrences == 0) {
+        return HC_STRING_SUCCESS;
+    }
+
     // Calculate the new string length based on the number of occurrences and word length differences
     size_t result_len = str->length + occurrences * (new_len - old_len);
 
@@ -281,8 +709,8 @@ int hc_string_replace(hc_string_t* str, const char* old_word, const char* new_wo
     }
     *dst = '\0';  // Null-terminate the result string
 
-    // Free the old string data and replace the original string with the result
-    HC_FREE(str->data);
+    // Release the old string data (or our reference to it) and replace it with the result
+    hc_string_destroy(str);
     *str = result;
 
     return HC_STRING_SUCCESS;  // Return success
@@ -294,6 +722,9 @@ int hc_string_trim(hc_string_t* str)
         return HC_STRING_ERROR_INVALID_DST;
     }
 
+    int ret = hc_string_make_unique(str);
+    if (ret < 0) return ret;
+
     char* start = str->data;
     while (isspace((unsigned char)*start)) start++;
 
@@ -314,6 +745,9 @@ int hc_string_append_char(hc_string_t* str, char c)
         return HC_STRING_ERROR_INVALID_DST;
     }
 
+    int ret = hc_string_make_unique(str);
+    if (ret < 0) return ret;
+
     if (str->length + 1 >= str->capacity) {
         // Here we increase the capacity of the
         // string to the nearest power of two
@@ -351,6 +785,9 @@ int hc_string_substring(hc_string_t *str, size_t start, size_t length)
         return HC_STRING_ERROR_INVALID_DST;
     }
 
+    int ret = hc_string_make_unique(str);
+    if (ret < 0) return ret;
+
     size_t max_length = str->length - start;
     if (length > max_length) length = max_length;
 
@@ -420,4 +857,1432 @@ bool hc_string_compare(const hc_string_t* a, const hc_string_t* b)
     return !strncmp(a->data, b->data, a->length);
 }
 
+/* Base64 and hex encoding */
+
+static const char hc_string_base64_chars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static const int8_t hc_string_base64_values[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+    -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+    -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+static const char hc_string_hex_chars[] = "0123456789abcdef";
+
+/* Makes room for 'extra' more bytes (plus the SIMD store slack), growing geometrically */
+static int hc_string_grow(hc_string_t* str, size_t extra)
+{
+    return hc_string_reserve(str, str->length + extra + 1 + 32);
+}
+
+static int hc_string_hex_value(uint8_t c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+#ifdef HC_STRING_SSSE3
+
+/* 12 bytes (in the low part of 'in') to 16 base64 characters, see W. Mula, "Base64 encoding with SIMD instructions" */
+static inline __m128i hc_string_base64_encode_sse(__m128i in)
+{
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+    __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    __m128i indices = _mm_or_si128(t1, t3);
+
+    // Map each 6-bit index range to the offset that turns it into its character
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    range = _mm_or_si128(range, _mm_and_si128(less, _mm_set1_epi8(13)));
+
+    const __m128i offsets = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+    return _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices);
+}
+
+/* 16 base64 characters to 16 6-bit values, returns false if one of them is not in the alphabet */
+static inline bool hc_string_base64_values_sse(__m128i in, __m128i* values)
+{
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), in));
+    __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), in));
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), in));
+    __m128i plus = _mm_cmpeq_epi8(in, _mm_set1_epi8('+'));
+    __m128i slash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+
+    __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(plus, slash)));
+    if (_mm_movemask_epi8(valid) != 0xFFFF) return false;
+
+    __m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+    shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+    shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+    shift = _mm_or_si128(shift, _mm_and_si128(plus, _mm_set1_epi8(62 - '+')));
+    shift = _mm_or_si128(shift, _mm_and_si128(slash, _mm_set1_epi8(63 - '/')));
+
+    *values = _mm_add_epi8(in, shift);
+    return true;
+}
+
+/* Packs 16 6-bit values into 12 bytes (in the low part of the result) */
+static inline __m128i hc_string_base64_pack_sse(__m128i values)
+{
+    __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+/* 16 hex characters to 16 nibbles, returns false on invalid characters */
+static inline bool hc_string_hex_values_sse(__m128i in, __m128i* values)
+{
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), in));
+    __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), in));
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('F' + 1), in));
+
+    __m128i valid = _mm_or_si128(digit, _mm_or_si128(lower, upper));
+    if (_mm_movemask_epi8(valid) != 0xFFFF) return false;
+
+    __m128i shift = _mm_and_si128(digit, _mm_set1_epi8(-'0'));
+    shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(10 - 'a')));
+    shift = _mm_or_si128(shift, _mm_and_si128(upper, _mm_set1_epi8(10 - 'A')));
+
+    *values = _mm_add_epi8(in, shift);
+    return true;
+}
+
+#endif // HC_STRING_SSSE3
+
+#ifdef HC_STRING_AVX2
+
+static inline __m256i hc_string_base64_encode_avx2(__m256i in)
+{
+    in = _mm256_shuffle_epi8(in, _mm256_set_epi8(
+        10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+        10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+    __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+    __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+    __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    __m256i indices = _mm256_or_si256(t1, t3);
+
+    __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    range = _mm256_or_si256(range, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+
+    const __m256i offsets = _mm256_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+    return _mm256_add_epi8(_mm256_shuffle_epi8(offsets, range), indices);
+}
+
+static inline bool hc_string_base64_values_avx2(__m256i in, __m256i* values)
+{
+    __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), in));
+    __m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), in));
+    __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), in));
+    __m256i plus = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('+'));
+    __m256i slash = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('/'));
+
+    __m256i valid = _mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, _mm256_or_si256(plus, slash)));
+    if ((uint32_t)_mm256_movemask_epi8(valid) != 0xFFFFFFFFu) return false;
+
+    __m256i shift = _mm256_and_si256(upper, _mm256_set1_epi8(-'A'));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(plus, _mm256_set1_epi8(62 - '+')));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(slash, _mm256_set1_epi8(63 - '/')));
+
+    *values = _mm256_add_epi8(in, shift);
+    return true;
+}
+
+/* Packs 32 6-bit values into 24 contiguous bytes (in the low part of the result) */
+static inline __m256i hc_string_base64_pack_avx2(__m256i values)
+{
+    __m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    merged = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+    merged = _mm256_shuffle_epi8(merged, _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    return _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+}
+
+static inline bool hc_string_hex_values_avx2(__m256i in, __m256i* values)
+{
+    __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), in));
+    __m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), in));
+    __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('F' + 1), in));
+
+    __m256i valid = _mm256_or_si256(digit, _mm256_or_si256(lower, upper));
+    if ((uint32_t)_mm256_movemask_epi8(valid) != 0xFFFFFFFFu) return false;
+
+    __m256i shift = _mm256_and_si256(digit, _mm256_set1_epi8(-'0'));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(lower, _mm256_set1_epi8(10 - 'a')));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(upper, _mm256_set1_epi8(10 - 'A')));
+
+    *values = _mm256_add_epi8(in, shift);
+    return true;
+}
+
+#endif // HC_STRING_AVX2
+
+/* Encodes all complete 3-byte groups of 'src', returns the number of bytes consumed */
+static size_t hc_string_base64_encode_block(char* dst, const uint8_t* src, size_t size)
+{
+    size_t i = 0;
+
+#if defined(HC_STRING_AVX2)
+    // Two overlapping 16-byte loads, 12 bytes of each are used
+    for (; i + 28 <= size; i += 24, dst += 32) {
+        __m128i lo = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i hi = _mm_loadu_si128((const __m128i*)(src + i + 12));
+        __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        _mm256_storeu_si256((__m256i*)dst, hc_string_base64_encode_avx2(in));
+    }
+#endif
+
+#if defined(HC_STRING_SSSE3)
+    for (; i + 16 <= size; i += 12, dst += 16) {
+        __m128i in = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)dst, hc_string_base64_encode_sse(in));
+    }
+#endif
+
+    for (; i + 3 <= size; i += 3, dst += 4) {
+        uint32_t v = ((uint32_t)src[i] << 16) | ((uint32_t)src[i + 1] << 8) | src[i + 2];
+        dst[0] = hc_string_base64_chars[(v >> 18) & 63];
+        dst[1] = hc_string_base64_chars[(v >> 12) & 63];
+        dst[2] = hc_string_base64_chars[(v >> 6) & 63];
+        dst[3] = hc_string_base64_chars[v & 63];
+    }
+
+    return i;
+}
+
+/* Decodes one group of 4 characters, returns the number of bytes written or -1 if invalid */
+static int hc_string_base64_decode_quad(uint8_t* dst, const uint8_t* q)
+{
+    int a = hc_string_base64_values[q[0]];
+    int b = hc_string_base64_values[q[1]];
+    if (a < 0 || b < 0) return -1;
+
+    if (q[2] == '=') {
+        // "xx==", the unused bits must be zero for the encoding to be canonical
+        if (q[3] != '=' || (b & 0x0F)) return -1;
+        dst[0] = (uint8_t)((a << 2) | (b >> 4));
+        return 1;
+    }
+
+    int c = hc_string_base64_values[q[2]];
+    if (c < 0) return -1;
+
+    if (q[3] == '=') {
+        if (c & 0x03) return -1;
+        dst[0] = (uint8_t)((a << 2) | (b >> 4));
+        dst[1] = (uint8_t)((b << 4) | (c >> 2));
+        return 2;
+    }
+
+    int d = hc_string_base64_values[q[3]];
+    if (d < 0) return -1;
+
+    dst[0] = (uint8_t)((a << 2) | (b >> 4));
+    dst[1] = (uint8_t)((b << 4) | (c >> 2));
+    dst[2] = (uint8_t)((c << 6) | d);
+
+    return 3;
+}
+
+/*
+ * Decodes the complete groups of 'src' that contain no padding.
+ * Returns the number of characters consumed (multiple of 4), the caller
+ * handles what remains, which begins with a padded or invalid group if any.
+ */
+static size_t hc_string_base64_decode_block(uint8_t* dst, const uint8_t* src, size_t length, size_t* written)
+{
+    size_t i = 0;
+    uint8_t *out = dst;
+
+#if defined(HC_STRING_AVX2)
+    for (; i + 32 <= length; i += 32, out += 24) {
+        __m256i values;
+        __m256i in = _mm256_loadu_si256((const __m256i*)(src + i));
+        if (!hc_string_base64_values_avx2(in, &values)) break;
+        _mm256_storeu_si256((__m256i*)out, hc_string_base64_pack_avx2(values));
+    }
+#endif
+
+#if defined(HC_STRING_SSSE3)
+    for (; i + 16 <= length; i += 16, out += 12) {
+        __m128i values;
+        __m128i in = _mm_loadu_si128((const __m128i*)(src + i));
+        if (!hc_string_base64_values_sse(in, &values)) break;
+        _mm_storeu_si128((__m128i*)out, hc_string_base64_pack_sse(values));
+    }
+#endif
+
+    for (; i + 4 <= length; i += 4, out += 3) {
+        int a = hc_string_base64_values[src[i]];
+        int b = hc_string_base64_values[src[i + 1]];
+        int c = hc_string_base64_values[src[i + 2]];
+        int d = hc_string_base64_values[src[i + 3]];
+        if ((a | b | c | d) < 0) break;
+        uint32_t v = ((uint32_t)a << 18) | ((uint32_t)b << 12) | ((uint32_t)c << 6) | (uint32_t)d;
+        out[0] = (uint8_t)(v >> 16);
+        out[1] = (uint8_t)(v >> 8);
+        out[2] = (uint8_t)v;
+    }
+
+    *written = (size_t)(out - dst);
+    return i;
+}
+
+static void hc_string_hex_encode_block(char* dst, const uint8_t* src, size_t size)
+{
+    size_t i = 0;
+
+#if defined(HC_STRING_AVX2)
+    const __m256i lut32 = _mm256_setr_epi8(
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    for (; i + 32 <= size; i += 32, dst += 64) {
+        __m256i in = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i hi = _mm256_shuffle_epi8(lut32, _mm256_and_si256(_mm256_srli_epi16(in, 4), _mm256_set1_epi8(0x0F)));
+        __m256i lo = _mm256_shuffle_epi8(lut32, _mm256_and_si256(in, _mm256_set1_epi8(0x0F)));
+        __m256i a = _mm256_unpacklo_epi8(hi, lo);
+        __m256i b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256((__m256i*)dst, _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i*)(dst + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+#endif
+
+#if defined(HC_STRING_SSSE3)
+    const __m128i lut16 = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    for (; i + 16 <= size; i += 16, dst += 32) {
+        __m128i in = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i hi = _mm_shuffle_epi8(lut16, _mm_and_si128(_mm_srli_epi16(in, 4), _mm_set1_epi8(0x0F)));
+        __m128i lo = _mm_shuffle_epi8(lut16, _mm_and_si128(in, _mm_set1_epi8(0x0F)));
+        _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+#endif
+
+    for (; i < size; i++, dst += 2) {
+        dst[0] = hc_string_hex_chars[src[i] >> 4];
+        dst[1] = hc_string_hex_chars[src[i] & 0x0F];
+    }
+}
+
+/* Decodes complete character pairs, returns the number of characters consumed or -1 if invalid */
+static ptrdiff_t hc_string_hex_decode_block(uint8_t* dst, const uint8_t* src, size_t length)
+{
+    size_t i = 0;
+
+#if defined(HC_STRING_AVX2)
+    for (; i + 64 <= length; i += 64, dst += 32) {
+        __m256i a, b;
+        if (!hc_string_hex_values_avx2(_mm256_loadu_si256((const __m256i*)(src + i)), &a)) break;
+        if (!hc_string_hex_values_avx2(_mm256_loadu_si256((const __m256i*)(src + i + 32)), &b)) break;
+        a = _mm256_maddubs_epi16(a, _mm256_set1_epi16(0x0110));
+        b = _mm256_maddubs_epi16(b, _mm256_set1_epi16(0x0110));
+        _mm256_storeu_si256((__m256i*)dst, _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8));
+    }
+#endif
+
+#if defined(HC_STRING_SSSE3)
+    for (; i + 32 <= length; i += 32, dst += 16) {
+        __m128i a, b;
+        if (!hc_string_hex_values_sse(_mm_loadu_si128((const __m128i*)(src + i)), &a)) break;
+        if (!hc_string_hex_values_sse(_mm_loadu_si128((const __m128i*)(src + i + 16)), &b)) break;
+        a = _mm_maddubs_epi16(a, _mm_set1_epi16(0x0110));
+        b = _mm_maddubs_epi16(b, _mm_set1_epi16(0x0110));
+        _mm_storeu_si128((__m128i*)dst, _mm_packus_epi16(a, b));
+    }
+#endif
+
+    for (; i + 2 <= length; i += 2, dst++) {
+        int hi = hc_string_hex_value(src[i]);
+        int lo = hc_string_hex_value(src[i + 1]);
+        if ((hi | lo) < 0) return -1;
+        *dst = (uint8_t)((hi << 4) | lo);
+    }
+
+    return (ptrdiff_t)i;
+}
+
+int hc_string_base64_encode_update(hc_string_codec_t* codec, hc_string_t* dst, const void* data, size_t size)
+{
+    if (!dst) {
+        return HC_STRING_ERROR_INVALID_DST;
+    }
+
+    if (!codec || (!data && size > 0)) {
+        return HC_STRING_ERROR_INVALID_SRC;
+    }
+
+    const uint8_t *src = (const uint8_t*)data;
+
+    int ret = hc_string_grow(dst, ((codec->count + size) / 3) * 4);
+    if (ret < 0) return ret;
+
+    char *out = dst->data + dst->length;
+
+    // Complete the group left over by the previous chunk
+    if (codec->count > 0) {
+        while (codec->count < 3 && size > 0) {
+            codec->pending[codec->count++] = *src++;
+            size--;
+        }
+        if (codec->count < 3) return HC_STRING_SUCCESS;
+        hc_string_base64_encode_block(out, codec->pending, 3);
+        out += 4;
+        codec->count = 0;
+    }
+
+    size_t consumed = hc_string_base64_encode_block(out, src, size);
+    out += (consumed / 3) * 4;
+
+    for (size_t i = consumed; i < size; i++) {
+        codec->pending[codec->count++] = src[i];
+    }
+
+    dst->length = (size_t)(out - dst->data);
+    dst->data[dst->length] = '\0';
+
+    return HC_STRING_SUCCESS;
+}
+
+int hc_string_base64_encode_final(hc_string_codec_t* codec, hc_string_t* dst)
+{
+    if (!dst) {
+        return HC_STRING_ERROR_INVALID_DST;
+    }
+
+    if (!codec) {
+        return HC_STRING_ERROR_INVALID_SRC;
+    }
+
+    int ret = hc_string_grow(dst, 4);
+    if (ret < 0) return ret;
+
+    char *out = dst->data + dst->length;
+
+    if (codec->count == 1) {
+        uint8_t a = codec->pending[0];
+        out[0] = hc_string_base64_chars[a >> 2];
+        out[1] = hc_string_base64_chars[(a & 0x03) << 4];
+        out[2] = out[3] = '=';
+        dst->length += 4;
+    } else if (codec->count == 2) {
+        uint8_t a = codec->pending[0], b = codec->pending[1];
+        out[0] = hc_string_base64_chars[a >> 2];
+        out[1] = hc_string_base64_chars[((a & 0x03) << 4) | (b >> 4)];
+        out[2] = hc_string_base64_chars[(b & 0x0F) << 2];
+        out[3] = '=';
+        dst->length += 4;
+    }
+
+    dst->data[dst->length] = '\0';
+    codec->count = 0;
+
+    return HC_STRING_SUCCESS;
+}
+
+/* Error of a decoding update: the decoded bytes past the end are dropped and the codec is restored */
+static int hc_string_decode_fail(hc_string_codec_t* codec, const hc_string_codec_t* saved, hc_string_t* dst)
+{
+    *codec = *saved;
+    dst->data[dst->length] = '\0';
+    return HC_STRING_ERROR_INVALID_SRC;
+}
+
+int hc_string_base64_decode_update(hc_string_codec_t* codec, hc_string_t* dst, const char* src, size_t length)
+{
+    if (!dst) {
+        return HC_STRING_ERROR_INVALID_DST;
+    }
+
+    if (!codec || (!src && length > 0)) {
+        return HC_STRING_ERROR_INVALID_SRC;
+    }
+
+    if (length == 0) {
+        return HC_STRING_SUCCESS;
+    }
+
+    // Nothing may follow the padding
+    if (codec->done) {
+        return HC_STRING_ERROR_INVALID_SRC;
+    }
+
+    const uint8_t *ptr = (const uint8_t*)src;
+    const uint8_t *end = ptr + length;
+
+    int ret = hc_string_grow(dst, ((codec->count + length) / 4) * 3);
+    if (ret < 0) return ret;
+
+    // Bytes are decoded past the end of 'dst', which only grows once the whole chunk is valid
+    const hc_string_codec_t saved = *codec;
+
+    uint8_t *out = (uint8_t*)dst->data + dst->length;
+
+    while (ptr < end) {
+        if (codec->count > 0 || end - ptr < 4) {
+            while (codec->count < 4 && ptr < end) {
+                codec->pending[codec->count++] = *ptr++;
+            }
+            if (codec->count < 4) break;
+
+            int n = hc_string_base64_decode_quad(out, codec->pending);
+            if (n < 0) return hc_string_decode_fail(codec, &saved, dst);
+            out += n;
+            codec->count = 0;
+
+            if (n < 3) {
+                codec->done = true;
+                if (ptr < end) return hc_string_decode_fail(codec, &saved, dst);
+            }
+            continue;
+        }
+
+        size_t written = 0;
+        size_t consumed = hc_string_base64_decode_block(out, ptr, (size_t)(end - ptr), &written);
+        out += written;
+        ptr += consumed;
+
+        // The bulk decoder stopped on a group it cannot handle, which
+        // is either the padded group or an error, so we go through the
+        // pending path with it
+        if (end - ptr >= 4) {
+            memcpy(codec->pending, ptr, 4);
+            codec->count = 4;
+            ptr += 4;
+
+            int n = hc_string_base64_decode_quad(out, codec->pending);
+            if (n < 0) return hc_string_decode_fail(codec, &saved, dst);
+            out += n;
+            codec->count = 0;
+
+            if (n < 3) {
+                codec->done = true;
+                if (ptr < end) return hc_string_decode_fail(codec, &saved, dst);
+            }
+        }
+    }
+
+    dst->length = (size_t)((char*)out - dst->data);
+    dst->data[dst->length] = '\0';
+
+    return HC_STRING_SUCCESS;
+}
+
+int hc_string_base64_decode_final(hc_string_codec_t* codec, hc_string_t* dst)
+{
+    if (!dst) {
+        return HC_STRING_ERROR_INVALID_DST;
+    }
+
+    if (!codec) {
+        return HC_STRING_ERROR_INVALID_SRC;
+    }
+
+    // Strict mode: the input length must be a multiple of 4
+    bool complete = (codec->count == 0);
+    codec->count = 0;
+    codec->done = false;
+
+    return complete ? HC_STRING_SUCCESS : HC_STRING_ERROR_INVALID_SRC;
+}
+
+int hc_string_hex_decode_update(hc_string_codec_t* codec, hc_string_t* dst, const char* src, size_t length)
+{
+    if (!dst) {
+        return HC_STRING_ERROR_INVALID_DST;
+    }
+
+    if (!codec || (!src && length > 0)) {
+        return HC_STRING_ERROR_INVALID_SRC;
+    }
+
+    if (length == 0) {
+        return HC_STRING_SUCCESS;
+    }
+
+    const uint8_t *ptr = (const uint8_t*)src;
+
+    int ret = hc_string_grow(dst, (codec->count + length) / 2);
+    if (ret < 0) return ret;
+
+    const hc_string_codec_t saved = *codec;
+
+    uint8_t *out = (uint8_t*)dst->data + dst->length;
+
+    if (codec->count > 0) {
+        int hi = hc_string_hex_value(codec->pending[0]);
+        int lo = hc_string_hex_value(*ptr);
+        if ((hi | lo) < 0) return hc_string_decode_fail(codec, &saved, dst);
+        *out++ = (uint8_t)((hi << 4) | lo);
+        codec->count = 0;
+        ptr++, length--;
+    }
+
+    ptrdiff_t consumed = hc_string_hex_decode_block(out, ptr, length);
+    if (consumed < 0) return hc_string_decode_fail(codec, &saved, dst);
+
+    out += consumed / 2;
+
+    if ((size_t)consumed < length) {
+        codec->pending[0] = ptr[consumed];
+        codec->count = 1;
+    }
+
+    dst->length = (size_t)((char*)out - dst->data);
+    dst->data[dst->length] = '\0';
+
+    return HC_STRING_SUCCESS;
+}
+
+int hc_string_hex_decode_final(hc_string_codec_t* codec, hc_string_t* dst)
+{
+    if (!dst) {
+        return HC_STRING_ERROR_INVALID_DST;
+    }
+
+    if (!codec) {
+        return HC_STRING_ERROR_INVALID_SRC;
+    }
+
+    bool complete = (codec->count == 0);
+    codec->count = 0;
+
+    return complete ? HC_STRING_SUCCESS : HC_STRING_ERROR_INVALID_SRC;
+}
+
+int hc_string_append_base64(hc_string_t* dst, const void* data, size_t size)
+{
+    hc_string_codec_t codec = { 0 };
+
+    int ret = hc_string_base64_encode_update(&codec, dst, data, size);
+    if (ret < 0) return ret;
+
+    return hc_string_base64_encode_final(&codec, dst);
+}
+
+int hc_string_decode_base64(hc_string_t* dst, const char* src, size_t length)
+{
+    hc_string_codec_t codec = { 0 };
+    size_t old_length = dst ? dst->length : 0;
+
+    int ret = hc_string_base64_decode_update(&codec, dst, src, length);
+    if (ret == HC_STRING_SUCCESS) ret = hc_string_base64_decode_final(&codec, dst);
+
+    // Nothing is appended if the input is invalid
+    if (ret < 0 && dst && dst->data) {
+        dst->length = old_length;
+        dst->data[old_length] = '\0';
+    }
+
+    return ret;
+}
+
+int hc_string_append_hex(hc_string_t* dst, const void* data, size_t size)
+{
+    if (!dst) {
+        return HC_STRING_ERROR_INVALID_DST;
+    }
+
+    if (!data && size > 0) {
+        return HC_STRING_ERROR_INVALID_SRC;
+    }
+
+    int ret = hc_string_grow(dst, size * 2);
+    if (ret < 0) return ret;
+
+    hc_string_hex_encode_block(dst->data + dst->length, (const uint8_t*)data, size);
+    dst->length += size * 2;
+    dst->data[dst->length] = '\0';
+
+    return HC_STRING_SUCCESS;
+}
+
+int hc_string_decode_hex(hc_string_t* dst, const char* src, size_t length)
+{
+    hc_string_codec_t codec = { 0 };
+    size_t old_length = dst ? dst->length : 0;
+
+    int ret = hc_string_hex_decode_update(&codec, dst, src, length);
+    if (ret == HC_STRING_SUCCESS) ret = hc_string_hex_decode_final(&codec, dst);
+
+    if (ret < 0 && dst && dst->data) {
+        dst->length = old_length;
+        dst->data[old_length] = '\0';
+    }
+
+    return ret;
+}
+
+/* JSON-style escaping */
+
+/* Escape character following the backslash for each byte, 'u' means \u00XX, 0 means no escape */
+static const uint8_t hc_string_escape_table[256] = {
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+      0,   0, '"',   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, '\\',   0,   0,   0
+    // Remaining bytes (including UTF-8 sequences) are copied as is
+};
+
+/* Returns the offset of the first byte of 'src' that must be escaped, or 'length' if none */
+static size_t hc_string_escape_scan(const uint8_t* src, size_t length)
+{
+    size_t i = 0;
+
+#if defined(HC_STRING_AVX2)
+    const __m256i quote32 = _mm256_set1_epi8('"');
+    const __m256i bslash32 = _mm256_set1_epi8('\\');
+    const __m256i ctrl32 = _mm256_set1_epi8(0x1F);
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i m = _mm256_or_si256(_mm256_cmpeq_epi8(v, quote32), _mm256_cmpeq_epi8(v, bslash32));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(_mm256_min_epu8(v, ctrl32), v));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(m);
+        if (mask) return i + hc_string_ctz32(mask);
+    }
+#endif
+
+#if defined(HC_STRING_SSE2)
+    const __m128i quote16 = _mm_set1_epi8('"');
+    const __m128i bslash16 = _mm_set1_epi8('\\');
+    const __m128i ctrl16 = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, quote16), _mm_cmpeq_epi8(v, bslash16));
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(_mm_min_epu8(v, ctrl16), v));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(m);
+        if (mask) return i + hc_string_ctz32(mask);
+    }
+#endif
+
+    while (i < length && !hc_string_escape_table[src[i]]) i++;
+
+    return i;
+}
+
+/* Returns the offset of the first backslash of 'src', or 'length' if none */
+static size_t hc_string_backslash_scan(const uint8_t* src, size_t length)
+{
+    const void *found = memchr(src, '\\', length);
+    return found ? (size_t)((const uint8_t*)found - src) : length;
+}
+
+/* Parses the 4 hex digits of a \uXXXX escape, returns -1 if invalid */
+static long hc_string_parse_u16(const uint8_t* src)
+{
+    long value = 0;
+    for (int i = 0; i < 4; i++) {
+        int v = hc_string_hex_value(src[i]);
+        if (v < 0) return -1;
+        value = (value << 4) | v;
+    }
+    return value;
+}
+
+/*
+ * Unescapes 'src' into 'dst', which may be 'src' itself since the output is never longer.
+ * Returns the number of bytes written, or -1 if the input contains an invalid escape.
+ */
+static ptrdiff_t hc_string_unescape_block(uint8_t* dst, const uint8_t* src, size_t length)
+{
+    const uint8_t *end = src + length;
+    uint8_t *out = dst;
+
+    while (src < end) {
+        // Clean runs are moved in bulk
+        size_t run = hc_string_backslash_scan(src, (size_t)(end - src));
+        if (out != src) memmove(out, src, run);
+        out += run;
+        src += run;
+
+        if (src >= end) break;
+        if (end - src < 2) return -1;
+
+        uint8_t esc = src[1];
+        src += 2;
+
+        switch (esc) {
+            case '"': *out++ = '"'; break;
+            case '\\': *out++ = '\\'; break;
+            case '/': *out++ = '/'; break;
+            case 'b': *out++ = '\b'; break;
+            case 'f': *out++ = '\f'; break;
+            case 'n': *out++ = '\n'; break;
+            case 'r': *out++ = '\r'; break;
+            case 't': *out++ = '\t'; break;
+            case 'u': {
+                if (end - src < 4) return -1;
+                long cp = hc_string_parse_u16(src);
+                if (cp < 0) return -1;
+                src += 4;
+
+                // Surrogate pairs must be complete, lone surrogates are rejected
+                if (cp >= 0xD800 && cp <= 0xDBFF) {
+                    if (end - src < 6 || src[0] != '\\' || src[1] != 'u') return -1;
+                    long low = hc_string_parse_u16(src + 2);
+                    if (low < 0xDC00 || low > 0xDFFF) return -1;
+                    src += 6;
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                    return -1;
+                }
+
+                // UTF-8 encoding
+                if (cp < 0x80) {
+                    *out++ = (uint8_t)cp;
+                } else if (cp < 0x800) {
+                    *out++ = (uint8_t)(0xC0 | (cp >> 6));
+                    *out++ = (uint8_t)(0x80 | (cp & 0x3F));
+                } else if (cp < 0x10000) {
+                    *out++ = (uint8_t)(0xE0 | (cp >> 12));
+                    *out++ = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+                    *out++ = (uint8_t)(0x80 | (cp & 0x3F));
+                } else {
+                    *out++ = (uint8_t)(0xF0 | (cp >> 18));
+                    *out++ = (uint8_t)(0x80 | ((cp >> 12) & 0x3F));
+                    *out++ = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+                    *out++ = (uint8_t)(0x80 | (cp & 0x3F));
+                }
+            } break;
+            default:
+                return -1;
+        }
+    }
+
+    return (ptrdiff_t)(out - dst);
+}
+
+int hc_string_append_escaped(hc_string_t* dst, const char* src, size_t length)
+{
+    if (!dst) {
+        return HC_STRING_ERROR_INVALID_DST;
+    }
+
+    if (!src && length > 0) {
+        return HC_STRING_ERROR_INVALID_SRC;
+    }
+
+    const uint8_t *ptr = (const uint8_t*)src;
+    const uint8_t *end = ptr + length;
+
+    // Most strings need few escapes, we start with the input size
+    // and only grow when the escapes no longer fit
+    int ret = hc_string_grow(dst, length);
+    if (ret < 0) return ret;
+
+    while (ptr < end) {
+        size_t run = hc_string_escape_scan(ptr, (size_t)(end - ptr));
+
+        memcpy(dst->data + dst->length, ptr, run);
+        dst->length += run;
+        ptr += run;
+
+        if (ptr >= end) break;
+
+        // Escape the run of special characters, at most 6 bytes per character
+        size_t remaining = (size_t)(end - ptr);
+        if (dst->length + 6 + remaining + 1 > dst->capacity) {
+            ret = hc_string_grow(dst, 6 + remaining);
+            if (ret < 0) return ret;
+        }
+
+        char *out = dst->data + dst->length;
+        uint8_t esc = hc_string_escape_table[*ptr];
+
+        *out++ = '\\';
+        *out++ = (char)esc;
+
+        if (esc == 'u') {
+            *out++ = '0';
+            *out++ = '0';
+            *out++ = hc_string_hex_chars[*ptr >> 4];
+            *out++ = hc_string_hex_chars[*ptr & 0x0F];
+        }
+
+        dst->length = (size_t)(out - dst->data);
+        ptr++;
+    }
+
+    dst->data[dst->length] = '\0';
+
+    return HC_STRING_SUCCESS;
+}
+
+int hc_string_append_unescaped(hc_string_t* dst, const char* src, size_t length)
+{
+    if (!dst) {
+        return HC_STRING_ERROR_INVALID_DST;
+    }
+
+    if (!src && length > 0) {
+        return HC_STRING_ERROR_INVALID_SRC;
+    }
+
+    int ret = hc_string_grow(dst, length);
+    if (ret < 0) return ret;
+
+    ptrdiff_t written = hc_string_unescape_block((uint8_t*)dst->data + dst->length, (const uint8_t*)src, length);
+    if (written < 0) {
+        dst->data[dst->length] = '\0';
+        return HC_STRING_ERROR_INVALID_SRC;
+    }
+
+    dst->length += (size_t)written;
+    dst->data[dst->length] = '\0';
+
+    return HC_STRING_SUCCESS;
+}
+
+int hc_string_unescape(hc_string_t* str)
+{
+    if (!str || !str->data) {
+        return HC_STRING_ERROR_INVALID_DST;
+    }
+
+    // Decoded into a new buffer which replaces the string only on success,
+    // so an invalid escape leaves it unchanged (and shared strings need no copy)
+    hc_string_t result = { 0 };
+
+    int ret = hc_string_append_unescaped(&result, str->data, str->length);
+    if (ret < 0) {
+        hc_string_destroy(&result);
+        return ret;
+    }
+
+    hc_string_destroy(str);
+    *str = result;
+
+    return HC_STRING_SUCCESS;
+}
+
+/* Chunked parallel scans */
+
+/* Bounded substring search, candidates are filtered on the first and last needle bytes */
+static const char* hc_string_memmem(const char* hay, size_t n, const char* needle, size_t m)
+{
+    if (m == 0) return hay;
+    if (m > n) return NULL;
+    if (m == 1) return (const char*)memchr(hay, needle[0], n);
+
+    size_t i = 0;
+    size_t positions = n - m + 1;
+
+#if defined(HC_STRING_AVX2)
+    const __m256i first32 = _mm256_set1_epi8(needle[0]);
+    const __m256i last32 = _mm256_set1_epi8(needle[m - 1]);
+    for (; i + 32 <= positions; i += 32) {
+        __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(hay + i)), first32);
+        __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(hay + i + m - 1)), last32);
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(a, b));
+        while (mask) {
+            int bit = hc_string_ctz32(mask);
+            if (!memcmp(hay + i + bit + 1, needle + 1, m - 2)) return hay + i + bit;
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+#if defined(HC_STRING_SSE2)
+    const __m128i first16 = _mm_set1_epi8(needle[0]);
+    const __m128i last16 = _mm_set1_epi8(needle[m - 1]);
+    for (; i + 16 <= positions; i += 16) {
+        __m128i a = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(hay + i)), first16);
+        __m128i b = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(hay + i + m - 1)), last16);
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(a, b));
+        while (mask) {
+            int bit = hc_string_ctz32(mask);
+            if (!memcmp(hay + i + bit + 1, needle + 1, m - 2)) return hay + i + bit;
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    for (; i < positions; i++) {
+        if (hay[i] == needle[0] && hay[i + m - 1] == needle[m - 1] && !memcmp(hay + i + 1, needle + 1, m - 2)) {
+            return hay + i;
+        }
+    }
+
+    return NULL;
+}
+
+/* Counts the words starting in 'src[0..length)', 'prev_space' tells if the preceding byte is a space */
+static size_t hc_string_word_starts(const uint8_t* src, size_t length, bool prev_space)
+{
+    size_t count = 0;
+    size_t i = 0;
+    uint32_t carry = prev_space ? 1 : 0;
+
+#if defined(HC_STRING_AVX2)
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i ctrl = _mm256_sub_epi8(v, _mm256_set1_epi8('\t'));
+        __m256i space = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                        _mm256_cmpeq_epi8(_mm256_min_epu8(ctrl, _mm256_set1_epi8(4)), ctrl));
+        uint32_t s = (uint32_t)_mm256_movemask_epi8(space);
+        count += hc_string_popcount32(~s & ((s << 1) | carry));
+        carry = s >> 31;
+    }
+#endif
+
+#if defined(HC_STRING_SSE2)
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i ctrl = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+        __m128i space = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                     _mm_cmpeq_epi8(_mm_min_epu8(ctrl, _mm_set1_epi8(4)), ctrl));
+        uint32_t s = (uint32_t)_mm_movemask_epi8(space);
+        count += hc_string_popcount32(~s & ((s << 1) | carry) & 0xFFFF);
+        carry = (s >> 15) & 1;
+    }
+#endif
+
+    for (; i < length; i++) {
+        uint32_t s = (src[i] == ' ' || (uint8_t)(src[i] - '\t') <= 4);
+        count += (!s) & carry;
+        carry = s;
+    }
+
+    return count;
+}
+
+static int hc_string_thread_count(int num_threads)
+{
+#ifdef _OPENMP
+    return num_threads > 0 ? num_threads : omp_get_max_threads();
+#else
+    (void)num_threads;
+    return 1;
+#endif
+}
+
+static size_t hc_string_chunk_count(size_t length, int threads)
+{
+    // A few chunks per thread balance the load, but each must stay large
+    size_t chunks = (size_t)threads * 4;
+    size_t max_chunks = length / HC_STRING_PARALLEL_CHUNK + 1;
+    return chunks < max_chunks ? chunks : max_chunks;
+}
+
+typedef struct {
+    size_t count;           // Greedy matches starting in the chunk, scanning from its beginning
+    size_t tail;            // End of the last of these matches (or chunk beginning if none)
+    size_t *positions;      // Their positions, if requested
+} hc_string_chunk_result_t;
+
+/*
+ * Greedy non-overlapping matches starting in [begin, end), the last one may extend beyond 'end'.
+ * Only the first 'max_stored' positions are stored, the matches are still counted beyond.
+ * Returns (size_t)-1 if the positions could not be stored.
+ */
+static size_t hc_string_chunk_scan(const hc_string_t* str, const char* keyword, size_t m,
+                                   size_t begin, size_t end, size_t* tail,
+                                   size_t** positions, size_t* capacity, size_t max_stored)
+{
+    size_t limit = (end + m - 1 < str->length) ? end + m - 1 : str->length;
+    size_t pos = begin;
+    size_t count = 0;
+
+    while (pos < end) {
+        const char *found = hc_string_memmem(str->data + pos, limit - pos, keyword, m);
+        if (!found) break;
+
+        size_t p = (size_t)(found - str->data);
+        if (p >= end) break;
+
+        if (positions && count < max_stored) {
+            if (count >= *capacity) {
+                size_t new_capacity = (*capacity) ? (*capacity) * 2 : 64;
+                if (new_capacity > max_stored) new_capacity = max_stored;
+                size_t *new_positions = HC_REALLOC(*positions, new_capacity * sizeof(size_t));
+                if (!new_positions) return (size_t)-1;
+                *positions = new_positions;
+                *capacity = new_capacity;
+            }
+            (*positions)[count] = p;
+        }
+
+        count++;
+        pos = p + m;
+    }
+
+    *tail = (count > 0) ? pos : begin;
+
+    return count;
+}
+
+/*
+ * Common implementation of the parallel occurrence functions.
+ * Each chunk is scanned independently from its beginning. As matches are
+ * non-overlapping (like hc_string_occurrences), a match straddling a chunk
+ * boundary shifts the scan of the next chunk; that rare chunk is then
+ * scanned again sequentially from the right position while merging.
+ * Returns (size_t)-1 if memory could not be allocated.
+ */
+static size_t hc_string_occurrences_impl(const hc_string_t* str, const char* keyword,
+                                         size_t* positions, size_t max_positions, int num_threads)
+{
+    if (!str || !str->data || !keyword) return 0;
+
+    size_t m = strlen(keyword);
+    if (m == 0 || m > str->length) return 0;
+
+    int threads = hc_string_thread_count(num_threads);
+    size_t chunks = hc_string_chunk_count(str->length, threads);
+    size_t chunk_size = (str->length + chunks - 1) / chunks;
+
+    hc_string_chunk_result_t *results = HC_CALLOC(chunks, sizeof(hc_string_chunk_result_t));
+    if (!results) return (size_t)-1;
+
+    // No chunk can contribute more than 'max_positions' positions
+    bool want_positions = (positions && max_positions > 0);
+    bool failed = false;
+
+#ifdef _OPENMP
+#   pragma omp parallel for schedule(dynamic, 1) num_threads(threads)
+#endif
+    for (long long k = 0; k < (long long)chunks; k++) {
+        size_t begin = (size_t)k * chunk_size;
+        size_t end = (begin + chunk_size < str->length) ? begin + chunk_size : str->length;
+        size_t capacity = 0;
+
+        hc_string_chunk_result_t *r = &results[k];
+        r->count = hc_string_chunk_scan(str, keyword, m, begin, end, &r->tail,
+                                        want_positions ? &r->positions : NULL, &capacity, max_positions);
+    }
+
+    for (size_t k = 0; k < chunks; k++) {
+        if (results[k].count == (size_t)-1) failed = true;
+    }
+
+    // Ordered merge
+    size_t total = 0;
+    size_t carry = 0;
+
+    for (size_t k = 0; k < chunks && !failed; k++) {
+        size_t begin = k * chunk_size;
+        size_t end = (begin + chunk_size < str->length) ? begin + chunk_size : str->length;
+        hc_string_chunk_result_t *r = &results[k];
+
+        if (carry > begin) {
+            // The previous match ends inside this chunk, scan it again from there
+            size_t capacity = 0;
+            HC_FREE(r->positions);
+            r->positions = NULL;
+            r->count = (carry < end) ? hc_string_chunk_scan(str, keyword, m, carry, end, &r->tail,
+                                                            want_positions ? &r->positions : NULL, &capacity, max_positions) : 0;
+            if (r->count == (size_t)-1) {
+                failed = true;
+                break;
+            }
+            if (r->count == 0) r->tail = carry;
+        }
+
+        if (want_positions && r->positions) {
+            for (size_t i = 0; i < r->count && total + i < max_positions; i++) {
+                positions[total + i] = r->positions[i];
+            }
+        }
+
+        total += r->count;
+        if (r->count > 0) carry = r->tail;
+    }
+
+    for (size_t k = 0; k < chunks; k++) {
+        HC_FREE(results[k].positions);
+    }
+
+    HC_FREE(results);
+
+    return failed ? (size_t)-1 : total;
+}
+
+size_t hc_string_occurrences_parallel(const hc_string_t* str, const char* keyword, int num_threads)
+{
+    return hc_string_occurrences_impl(str, keyword, NULL, 0, num_threads);
+}
+
+size_t hc_string_find_all_parallel(const hc_string_t* str, const char* keyword, size_t* positions, size_t max_positions, int num_threads)
+{
+    return hc_string_occurrences_impl(str, keyword, positions, max_positions, num_threads);
+}
+
+size_t hc_string_word_count_parallel(const hc_string_t* str, int num_threads)
+{
+    if (!str || !str->data || str->length == 0) return 0;
+
+    int threads = hc_string_thread_count(num_threads);
+    size_t chunks = hc_string_chunk_count(str->length, threads);
+    size_t chunk_size = (str->length + chunks - 1) / chunks;
+    size_t count = 0;
+
+    // A word starts on a non-space byte preceded by a space, so each
+    // chunk only needs the byte just before it to count its own words
+#ifdef _OPENMP
+#   pragma omp parallel for schedule(dynamic, 1) num_threads(threads) reduction(+:count)
+#endif
+    for (long long k = 0; k < (long long)chunks; k++) {
+        size_t begin = (size_t)k * chunk_size;
+        size_t end = (begin + chunk_size < str->length) ? begin + chunk_size : str->length;
+        if (begin >= end) continue;
+
+        bool prev_space = true;
+        if (begin > 0) {
+            uint8_t c = (uint8_t)str->data[begin - 1];
+            prev_space = (c == ' ' || (uint8_t)(c - '\t') <= 4);
+        }
+
+        count += hc_string_word_starts((const uint8_t*)str->data + begin, end - begin, prev_space);
+    }
+
+    return count;
+}
+
+/* Bit-parallel edit distance (Myers 1999, multi-block form from Hyyrö 2003) */
+
+static void hc_string_pattern_fill(uint64_t* peq, size_t blocks, const char* str, size_t length)
+{
+    memset(peq, 0, blocks * 256 * sizeof(uint64_t));
+    for (size_t i = 0; i < length; i++) {
+        peq[(i >> 6) * 256 + (uint8_t)str[i]] |= (uint64_t)1 << (i & 63);
+    }
+}
+
+/*
+ * Runs the DP column by column over 'text', the pattern being the vertical axis.
+ * In global mode the first row grows by one per column (edit distance), in search
+ * mode it stays at zero so a match may start anywhere in the text (approximate search).
+ * Returns the last row score, or 'max_distance + 1' as soon as it cannot end below the bound.
+ */
+static size_t hc_string_myers(const uint64_t* peq, size_t blocks, size_t m,
+                              const char* text, size_t n, size_t max_distance,
+                              bool search, size_t* match_end)
+{
+    uint64_t pv_small[4], mv_small[4];
+    uint64_t *pv = pv_small, *mv = mv_small;
+
+    if (blocks > 4) {
+        pv = HC_MALLOC(2 * blocks * sizeof(uint64_t));
+        if (!pv) return (size_t)-1;
+        mv = pv + blocks;
+    }
+
+    for (size_t b = 0; b < blocks; b++) {
+        pv[b] = ~(uint64_t)0;
+        mv[b] = 0;
+    }
+
+    const uint64_t last_bit = (uint64_t)1 << ((m - 1) & 63);
+    size_t score = m;
+
+    for (size_t j = 0; j < n; j++) {
+        const uint64_t *eq_col = peq + (uint8_t)text[j];
+        int hin = search ? 0 : 1;
+
+        for (size_t b = 0; b < blocks; b++) {
+            uint64_t eq = eq_col[b * 256];
+            uint64_t p = pv[b], v = mv[b];
+            uint64_t high = (b == blocks - 1) ? last_bit : ((uint64_t)1 << 63);
+
+            uint64_t xv = eq | v;
+            if (hin < 0) eq |= 1;
+            uint64_t xh = (((eq & p) + p) ^ p) | eq;
+            uint64_t ph = v | ~(xh | p);
+            uint64_t mh = p & xh;
+
+            int hout = (ph & high) ? 1 : ((mh & high) ? -1 : 0);
+
+            ph <<= 1;
+            mh <<= 1;
+            if (hin < 0) mh |= 1;
+            else if (hin > 0) ph |= 1;
+
+            pv[b] = mh | ~(xv | ph);
+            mv[b] = ph & xv;
+            hin = hout;
+        }
+
+        score += hin;
+
+        if (search) {
+            if (score <= max_distance) {
+                if (match_end) *match_end = j + 1;
+                break;
+            }
+        } else if (score > max_distance && score - max_distance > n - j - 1) {
+            // The last row changes by at most one per column
+            score = max_distance + 1;
+            break;
+        }
+    }
+
+    if (pv != pv_small) HC_FREE(pv);
+
+    return score;
+}
+
+int hc_string_pattern_create(hc_string_pattern_t* pattern, const char* str, size_t length)
+{
+    if (!pattern) {
+        return HC_STRING_ERROR_INVALID_DST;
+    }
+
+    if (!str && length > 0) {
+        return HC_STRING_ERROR_INVALID_SRC;
+    }
+
+    pattern->length = length;
+    pattern->blocks = (length + 63) / 64;
+    pattern->peq = NULL;
+
+    if (pattern->blocks > 0) {
+        pattern->peq = HC_MALLOC(pattern->blocks * 256 * sizeof(uint64_t));
+        if (!pattern->peq) return HC_STRING_ERROR_OUT_OF_MEMORY;
+        hc_string_pattern_fill(pattern->peq, pattern->blocks, str, length);
+    }
+
+    return HC_STRING_SUCCESS;
+}
+
+void hc_string_pattern_destroy(hc_string_pattern_t* pattern)
+{
+    if (pattern && pattern->peq) {
+        HC_FREE(pattern->peq);
+        pattern->peq = NULL;
+        pattern->length = 0;
+        pattern->blocks = 0;
+    }
+}
+
+size_t hc_string_pattern_distance(const hc_string_pattern_t* pattern, const char* text, size_t length, size_t max_distance)
+{
+    size_t m = pattern->length;
+
+    if (m == 0) return length <= max_distance ? length : max_distance + 1;
+    if (length == 0) return m <= max_distance ? m : max_distance + 1;
+
+    size_t diff = (m > length) ? m - length : length - m;
+    if (diff > max_distance) return max_distance + 1;
+
+    size_t d = hc_string_myers(pattern->peq, pattern->blocks, m, text, length, max_distance, false, NULL);
+    return d <= max_distance ? d : max_distance + 1;
+}
+
+bool hc_string_pattern_search(const hc_string_pattern_t* pattern, const char* text, size_t length, size_t max_distance, size_t* match_end, size_t* distance)
+{
+    size_t m = pattern->length;
+
+    // An empty match (or one made only of deletions) ends before the first character
+    if (m <= max_distance) {
+        if (match_end) *match_end = 0;
+        if (distance) *distance = m;
+        return true;
+    }
+
+    size_t end = 0;
+    size_t d = hc_string_myers(pattern->peq, pattern->blocks, m, text, length, max_distance, true, &end);
+    if (d > max_distance) return false;
+
+    if (match_end) *match_end = end;
+    if (distance) *distance = d;
+
+    return true;
+}
+
+size_t hc_string_edit_distance(const hc_string_t* a, const hc_string_t* b)
+{
+    return hc_string_edit_distance_bounded(a, b, (size_t)-2);
+}
+
+size_t hc_string_edit_distance_bounded(const hc_string_t* a, const hc_string_t* b, size_t max_distance)
+{
+    // The shorter string is used as the pattern to minimize the number of blocks
+    if (a->length > b->length) {
+        const hc_string_t *tmp = a;
+        a = b, b = tmp;
+    }
+
+    hc_string_pattern_t pattern = { 0 };
+    uint64_t peq_small[256];
+
+    pattern.length = a->length;
+    pattern.blocks = (a->length + 63) / 64;
+
+    if (pattern.blocks <= 1) {
+        pattern.peq = peq_small;
+        hc_string_pattern_fill(peq_small, pattern.blocks, a->data, a->length);
+    } else if (hc_string_pattern_create(&pattern, a->data, a->length) < 0) {
+        return (size_t)-1;
+    }
+
+    size_t d = hc_string_pattern_distance(&pattern, b->data, b->length, max_distance);
+
+    if (pattern.peq != peq_small) {
+        hc_string_pattern_destroy(&pattern);
+    }
+
+    return d;
+}
+
+bool hc_string_fuzzy_find(const hc_string_t* str, const char* pattern, size_t max_distance, size_t* match_end, size_t* distance)
+{
+    if (!str || !str->data || !pattern) return false;
+
+    hc_string_pattern_t compiled = { 0 };
+    uint64_t peq_small[256];
+    size_t length = strlen(pattern);
+
+    compiled.length = length;
+    compiled.blocks = (length + 63) / 64;
+
+    if (compiled.blocks <= 1) {
+        compiled.peq = peq_small;
+        hc_string_pattern_fill(peq_small, compiled.blocks, pattern, length);
+    } else if (hc_string_pattern_create(&compiled, pattern, length) < 0) {
+        return false;
+    }
+
+    bool found = hc_string_pattern_search(&compiled, str->data, str->length, max_distance, match_end, distance);
+
+    if (compiled.peq != peq_small) {
+        hc_string_pattern_destroy(&compiled);
+    }
+
+    return found;
+}
+
 #endif // HC_STRING_IMPL